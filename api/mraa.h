@@ -35,8 +35,10 @@ extern "C" {
 #include "mraa/spi.h"
 #include "mraa/i2c.h"
 #include "mraa/uart.h"
+#include "mraa/uart_group.h"
 #include "mraa/uart_ow.h"
 #include "mraa/led.h"
+#include "mraa/poller.h"
 
 #ifdef __cplusplus
 }
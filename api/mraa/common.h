@@ -181,6 +181,19 @@ const char* mraa_get_platform_version(int platform_offset);
  */
 int mraa_set_priority(const int priority);
 
+/**
+ * Dispatch gpio isr, iio buffer trigger and iio event callbacks from a shared
+ * pool of threads waiting on one epoll set, instead of starting a thread per
+ * callback. Only affects callbacks registered afterwards, and can't be changed
+ * while callbacks are registered with the shared pool.
+ *
+ * @param num_workers Number of dispatcher threads, 0 to go back to a thread per callback
+ * @param cpu CPU the dispatcher threads are pinned to, -1 for no affinity
+ * @param priority Priority given to the dispatcher threads through mraa_set_priority(), 0 to leave it unchanged
+ * @return Result of operation
+ */
+mraa_result_t mraa_set_event_loop(unsigned int num_workers, int cpu, int priority);
+
 /** Get the version string of mraa autogenerated from git tag
  *
  * The version returned may not be what is expected however it is a reliable
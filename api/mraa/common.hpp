@@ -87,6 +87,22 @@ setPriority(const int priority)
     return mraa_set_priority(priority);
 }
 
+/**
+ * Dispatch gpio isr, iio buffer trigger and iio event callbacks from a shared
+ * pool of threads waiting on one epoll set, instead of starting a thread per
+ * callback. Only affects callbacks registered afterwards.
+ *
+ * @param numWorkers Number of dispatcher threads, 0 to go back to a thread per callback
+ * @param cpu CPU the dispatcher threads are pinned to, -1 for no affinity
+ * @param priority Priority given to the dispatcher threads, 0 to leave it unchanged
+ * @return Result of operation
+ */
+inline Result
+setEventLoop(unsigned int numWorkers, int cpu = -1, int priority = 0)
+{
+    return (Result) mraa_set_event_loop(numWorkers, cpu, priority);
+}
+
 /**
  * Get platform type, board must be initialised.
  *
@@ -114,10 +114,88 @@ typedef long long unsigned int mraa_timestamp_t;
 typedef struct {
     int id; /**< id of event */
     mraa_timestamp_t timestamp; /**< timestamp */
+    unsigned int seqno; /**< sequence number of the event on its gpio chip, 0 if unsupported */
+    unsigned int line_seqno; /**< sequence number of the event on its line, a gap means dropped edges. 0 if unsupported */
 } mraa_gpio_event;
 
 typedef mraa_gpio_event* mraa_gpio_events_t;
 
+/**
+ * Gpio edge event record, as queued in the per context event ring
+ */
+typedef struct {
+    int pin; /**< pin the edge was seen on */
+    mraa_timestamp_t timestamp; /**< timestamp */
+    mraa_gpio_edge_t edge; /**< MRAA_GPIO_EDGE_RISING or MRAA_GPIO_EDGE_FALLING, MRAA_GPIO_EDGE_NONE if unknown (sysfs) */
+    unsigned int seqno; /**< per pin sequence number, a gap means the kernel dropped edges (chardev v2 only) */
+} mraa_gpio_edge_event;
+
+/**
+ * One step of a gpio waveform, bit n refers to the n-th pin of the init array
+ */
+typedef struct {
+    uint64_t mask; /**< pins driven by this step, the others keep their level */
+    uint64_t value; /**< levels of the masked pins */
+    uint32_t delay_ns; /**< time until the next step */
+} mraa_gpio_waveform_step_t;
+
+/**
+ * Timing of the last waveform replay
+ */
+typedef struct {
+    uint64_t steps; /**< steps replayed, over all repetitions */
+    uint64_t requested_ns; /**< sum of the requested delays */
+    uint64_t achieved_ns; /**< measured time from the first step to the end of the last delay */
+    uint64_t max_late_ns; /**< worst lag of a step behind its schedule */
+    uint64_t mean_late_ns; /**< mean lag of a step behind its schedule */
+} mraa_gpio_waveform_stats_t;
+
+/**
+ * Opaque pointer to a compiled gpio waveform
+ */
+typedef struct _gpio_waveform* mraa_gpio_waveform_t;
+
+/**
+ * Gpio capture trigger types
+ */
+typedef enum {
+    MRAA_GPIO_TRIGGER_NONE = 0,   /**< Capture starts with the first sample */
+    MRAA_GPIO_TRIGGER_EDGE = 1,   /**< Edge on one pin */
+    MRAA_GPIO_TRIGGER_PATTERN = 2 /**< Masked pins match a pattern */
+} mraa_gpio_trigger_t;
+
+/**
+ * Highest capture rate, one sample per nanosecond of the sampling grid
+ */
+#define MRAA_GPIO_CAPTURE_MAX_RATE_HZ 1000000000U
+
+/**
+ * Gpio capture settings, bit n refers to the n-th pin of the init array
+ */
+typedef struct {
+    unsigned int rate_hz; /**< sampling rate, 1 Hz to MRAA_GPIO_CAPTURE_MAX_RATE_HZ */
+    unsigned int pre_samples; /**< samples kept from before the trigger */
+    unsigned int post_samples; /**< samples taken from the trigger on, at least 1 */
+    unsigned int timeout_ms; /**< give up waiting for the trigger, 0 to wait forever */
+    mraa_gpio_trigger_t trigger; /**< what starts the capture */
+    unsigned int trigger_pin; /**< MRAA_GPIO_TRIGGER_EDGE: index of the pin */
+    mraa_gpio_edge_t trigger_edge; /**< MRAA_GPIO_TRIGGER_EDGE: rising, falling or both */
+    uint64_t trigger_mask; /**< MRAA_GPIO_TRIGGER_PATTERN: pins compared */
+    uint64_t trigger_value; /**< MRAA_GPIO_TRIGGER_PATTERN: levels to match */
+} mraa_gpio_capture_config_t;
+
+/**
+ * Gpio capture result
+ */
+typedef struct {
+    uint64_t* samples; /**< one packed bitmask per sample, oldest first */
+    unsigned int num_samples; /**< valid samples */
+    unsigned int trigger_index; /**< index of the sample that matched the trigger */
+    unsigned int num_pins; /**< pins in each sample, at most 64 */
+    unsigned int rate_hz; /**< sampling rate */
+    uint64_t missed; /**< sample periods skipped because a read was slower than the rate */
+} mraa_gpio_capture_t;
+
 /**
  * Initialise gpio_context, based on board number
  *
@@ -161,6 +239,17 @@ mraa_gpio_context mraa_gpio_init_raw(int gpiopin);
  */
 mraa_result_t mraa_gpio_edge_mode(mraa_gpio_context dev, mraa_gpio_edge_t mode);
 
+/**
+ * Set the kernel debounce period applied to the pin(s) when edge detection is
+ * requested. Only available with the v2 gpio character device interface, it
+ * takes effect on the next call to mraa_gpio_edge_mode() or mraa_gpio_isr().
+ *
+ * @param dev The Gpio context
+ * @param period_us Debounce period in microseconds, 0 disables debouncing
+ * @return Result of operation
+ */
+mraa_result_t mraa_gpio_debounce(mraa_gpio_context dev, unsigned int period_us);
+
 /**
  * Set an interrupt on pin(s).
  *
@@ -183,6 +272,26 @@ mraa_result_t mraa_gpio_isr(mraa_gpio_context dev, mraa_gpio_edge_t edge, void (
  */
 mraa_gpio_events_t mraa_gpio_get_events(mraa_gpio_context dev);
 
+/**
+ * Consume queued edge events. While an isr is registered every edge seen on
+ * the pin(s) is queued, so bursts are not collapsed into a single event the
+ * way mraa_gpio_get_events() reports them.
+ *
+ * @param dev The Gpio context
+ * @param events Buffer receiving the oldest queued events
+ * @param max Maximum number of events to copy into the buffer
+ * @return Number of events copied, -1 on failure
+ */
+int mraa_gpio_events_read(mraa_gpio_context dev, mraa_gpio_edge_event* events, unsigned int max);
+
+/**
+ * Get the number of edge events dropped because the event queue was full.
+ *
+ * @param dev The Gpio context
+ * @return Number of dropped events since the first edge mode was set
+ */
+unsigned int mraa_gpio_events_overflow(mraa_gpio_context dev);
+
 /**
  * Stop the current interrupt watcher on this Gpio, and set the Gpio edge mode
  * to MRAA_GPIO_EDGE_NONE(only for sysfs interface).
@@ -268,6 +377,19 @@ mraa_result_t mraa_gpio_write(mraa_gpio_context dev, int value);
  */
 mraa_result_t mraa_gpio_write_multi(mraa_gpio_context dev, int input_values[]);
 
+/**
+ * Write to a subset of the Gpio(s) provided to mraa_gpio_init_multi(). Bit n of
+ * values and mask corresponds to the n-th pin of the init array, so only the
+ * first 64 pins are addressable. Only gpio chips holding a masked pin are
+ * written, pins outside the mask keep their current value.
+ *
+ * @param dev The Gpio context
+ * @param values Bitmask of the values to write
+ * @param mask Bitmask of the pins to change
+ * @return Result of operation
+ */
+mraa_result_t mraa_gpio_write_mask(mraa_gpio_context dev, uint64_t values, uint64_t mask);
+
 /**
  * Change ownership of the context.
  *
@@ -279,7 +401,9 @@ mraa_result_t mraa_gpio_owner(mraa_gpio_context dev, mraa_boolean_t owner);
 
 /**
  * Enable using memory mapped io instead of sysfs, chardev based I/O can be
- * considered memorymapped
+ * considered memorymapped. On a context from mraa_gpio_init_multi() the pins
+ * are grouped by register bank, so multi pin reads and writes cost one
+ * register access per bank
  *
  * @deprecated
  * @param dev The Gpio context
@@ -322,6 +446,94 @@ mraa_result_t mraa_gpio_input_mode(mraa_gpio_context dev, mraa_gpio_input_mode_t
  */
 mraa_result_t mraa_gpio_out_driver_mode(mraa_gpio_context dev, mraa_gpio_out_driver_mode_t mode);
 
+/**
+ * Compile a waveform for the context's current backend: steps become one
+ * store per register bank when mmap is enabled on the context, so enable it
+ * first, and masked chardev/sysfs writes otherwise. The steps are copied.
+ *
+ * @param dev The Gpio context, usually from mraa_gpio_init_multi(), with its pins set as outputs
+ * @param steps Steps to replay, in order
+ * @param num_steps Number of steps
+ * @return Waveform or NULL
+ */
+mraa_gpio_waveform_t mraa_gpio_waveform_init(mraa_gpio_context dev,
+                                             const mraa_gpio_waveform_step_t* steps,
+                                             unsigned int num_steps);
+
+/**
+ * Start replaying the waveform on a dedicated thread. Delays are busy waited
+ * against a schedule, so a late step doesn't shift the ones after it.
+ *
+ * @param wf The waveform
+ * @param repeat Number of times to replay the steps, at least 1
+ * @param cpu CPU to pin the thread to, -1 to leave it unpinned
+ * @param priority Priority given through mraa_set_priority(), 0 to leave it unchanged
+ * @return Result of operation
+ */
+mraa_result_t mraa_gpio_waveform_start(mraa_gpio_waveform_t wf, unsigned int repeat, int cpu, int priority);
+
+/**
+ * Wait for a started replay to finish.
+ *
+ * @param wf The waveform
+ * @param stats Receives the achieved timing, may be NULL
+ * @return Result of the replay
+ */
+mraa_result_t mraa_gpio_waveform_wait(mraa_gpio_waveform_t wf, mraa_gpio_waveform_stats_t* stats);
+
+/**
+ * Stop a running replay after its current step and free the waveform. The
+ * gpio context is left open.
+ *
+ * @param wf The waveform
+ * @return Result of operation
+ */
+mraa_result_t mraa_gpio_waveform_close(mraa_gpio_waveform_t wf);
+
+/**
+ * Sample the pins of a context at a fixed rate, logic analyzer style. Once
+ * the trigger matches, the last pre_samples samples and post_samples more are
+ * returned. Each sample is one register load per bank when the platform
+ * describes the pins' registers, which are mapped for the length of the
+ * capture unless mmap is already enabled on the context, and one
+ * mraa_gpio_read_multi() otherwise. Blocks the caller until the capture is
+ * complete.
+ *
+ * @param dev The Gpio context, usually from mraa_gpio_init_multi()
+ * @param config Capture settings
+ * @return Capture to free with mraa_gpio_capture_free(), NULL on failure or timeout
+ */
+mraa_gpio_capture_t* mraa_gpio_capture(mraa_gpio_context dev, const mraa_gpio_capture_config_t* config);
+
+/**
+ * Write a capture as a Value Change Dump, readable by GTKWave, sigrok and
+ * most logic analyzer software.
+ *
+ * @param capture The capture
+ * @param path File to write
+ * @return Result of operation
+ */
+mraa_result_t mraa_gpio_capture_write_vcd(const mraa_gpio_capture_t* capture, const char* path);
+
+/**
+ * Write a capture in the compact binary format: the 8 bytes "MRAACAP1",
+ * then num_pins, rate_hz, num_samples and trigger_index as little endian
+ * 32 bit integers, then each sample packed into (num_pins + 7) / 8 little
+ * endian bytes.
+ *
+ * @param capture The capture
+ * @param path File to write
+ * @return Result of operation
+ */
+mraa_result_t mraa_gpio_capture_write_raw(const mraa_gpio_capture_t* capture, const char* path);
+
+/**
+ * Free a capture
+ *
+ * @param capture The capture
+ */
+void mraa_gpio_capture_free(mraa_gpio_capture_t* capture);
+
 #ifdef __cplusplus
 }
 #endif
@@ -157,6 +157,18 @@ class Gpio
     {
         return (Result) mraa_gpio_edge_mode(m_gpio, (mraa_gpio_edge_t) mode);
     }
+    /**
+     * Set the kernel debounce period used by the next edge request. Needs
+     * the v2 gpio character device interface
+     *
+     * @param period_us Debounce period in microseconds, 0 to disable
+     * @return Result of operation
+     */
+    Result
+    debounce(unsigned int period_us)
+    {
+        return (Result) mraa_gpio_debounce(m_gpio, period_us);
+    }
 #if defined(SWIGPYTHON)
     Result
     isr(Edge mode, PyObject* pyfunc, PyObject* args)
@@ -54,6 +54,11 @@ extern "C" {
  */
 typedef struct _i2c* mraa_i2c_context;
 
+/**
+ * Opaque pointer definition to the internal struct _i2c_txn
+ */
+typedef struct _i2c_txn* mraa_i2c_txn_t;
+
 /**
  * Initialise i2c context, using board defintions
  *
@@ -116,7 +121,8 @@ int mraa_i2c_read_byte_data(mraa_i2c_context dev, const uint8_t command);
 int mraa_i2c_read_word_data(mraa_i2c_context dev, const uint8_t command);
 
 /**
- * Bulk read from i2c context, starting from designated register
+ * Bulk read from i2c context, starting from designated register. The data is
+ * read straight into the buffer as one transfer.
  *
  * @param dev The i2c context
  * @param command The register
@@ -128,7 +134,9 @@ int mraa_i2c_read_bytes_data(mraa_i2c_context dev, uint8_t command, uint8_t* dat
 
 /**
  * Write length bytes to the bus, the first byte in the array is the
- * command/register to write
+ * command/register to write. The buffer goes out as one transfer. SMBus
+ * only adapters send it as one block write, so at most 32 bytes may follow
+ * the command there, longer writes fail with MRAA_ERROR_FEATURE_NOT_SUPPORTED.
  *
  * @param dev The i2c context
  * @param data pointer to the byte array to be written
@@ -183,6 +191,293 @@ mraa_result_t mraa_i2c_address(mraa_i2c_context dev, uint8_t address);
  */
 mraa_result_t mraa_i2c_stop(mraa_i2c_context dev);
 
+/**
+ * Enable or disable the register shadow of an i2c context. With it on,
+ * mraa_i2c_read_byte_data() and mraa_i2c_read_byte_data_at() serve registers
+ * they have seen before from memory and fill the shadow on a miss, and
+ * mraa_i2c_write_byte_data() and its _at variant write through it. Every
+ * other write, transactions included, drops what it may have changed:
+ * mraa_i2c_write_word_data() the two registers, mraa_i2c_write(),
+ * mraa_i2c_write_byte() and their _at variants the whole slave. Word and
+ * block reads, mraa_i2c_read_word_data() and mraa_i2c_read_bytes_data(),
+ * always go to the bus and neither use nor fill the shadow. Registers the
+ * slave changes by itself have to be declared with mraa_i2c_cache_volatile().
+ * Disabling frees the shadow.
+ *
+ * @param dev The i2c context
+ * @param enable 1 to shadow registers, 0 to stop
+ * @return Result of operation
+ */
+mraa_result_t mraa_i2c_cache_enable(mraa_i2c_context dev, mraa_boolean_t enable);
+
+/**
+ * Declare a register of the current slave as volatile, so it is always read
+ * from the bus
+ *
+ * @param dev The i2c context, with the shadow enabled
+ * @param command The register
+ * @param is_volatile 1 for volatile, 0 to shadow it again
+ * @return Result of operation
+ */
+mraa_result_t mraa_i2c_cache_volatile(mraa_i2c_context dev, uint8_t command, mraa_boolean_t is_volatile);
+
+/**
+ * Forget every shadowed register, e.g. after resetting a slave. Volatile
+ * declarations are kept.
+ *
+ * @param dev The i2c context
+ * @return Result of operation
+ */
+mraa_result_t mraa_i2c_cache_invalidate(mraa_i2c_context dev);
+
+/**
+ * Number of register reads served from the shadow and from the bus since the
+ * shadow was enabled
+ *
+ * @param dev The i2c context
+ * @param hits Receives the reads served from memory, may be NULL
+ * @param misses Receives the reads that went to the bus, may be NULL
+ * @return Result of operation
+ */
+mraa_result_t mraa_i2c_cache_stats(mraa_i2c_context dev, uint64_t* hits, uint64_t* misses);
+
+/**
+ * Change some bits of a register. Reads through the shadow when enabled and
+ * skips the write when the bits already have the wanted value.
+ *
+ * @param dev The i2c context
+ * @param command The register
+ * @param mask Bits to change
+ * @param value New value of the bits in mask
+ * @return Result of operation
+ */
+mraa_result_t mraa_i2c_update_bits(mraa_i2c_context dev, uint8_t command, uint8_t mask, uint8_t value);
+
+/**
+ * Simple bulk read from the slave at address. Like the other _at calls it
+ * leaves the context's address alone and, on adapters capable of plain i2c,
+ * doesn't have to switch the slave address of the bus device, which saves a
+ * syscall per address change when polling several slaves.
+ *
+ * @param dev The i2c context
+ * @param address 7-bit address of the slave
+ * @param data pointer to the byte array to read data in to
+ * @param length number of bytes to read
+ * @return length of the read in bytes or -1
+ */
+int mraa_i2c_read_at(mraa_i2c_context dev, uint8_t address, uint8_t* data, int length);
+
+/**
+ * Read a single byte from the slave at address, see mraa_i2c_read_at()
+ *
+ * @param dev The i2c context
+ * @param address 7-bit address of the slave
+ * @return The result of the read or -1 if failed
+ */
+int mraa_i2c_read_byte_at(mraa_i2c_context dev, uint8_t address);
+
+/**
+ * Read a single byte from a register of the slave at address, see
+ * mraa_i2c_read_at()
+ *
+ * @param dev The i2c context
+ * @param address 7-bit address of the slave
+ * @param command The register
+ * @return The result of the read or -1 if failed
+ */
+int mraa_i2c_read_byte_data_at(mraa_i2c_context dev, uint8_t address, const uint8_t command);
+
+/**
+ * Read a single word from a register of the slave at address, see
+ * mraa_i2c_read_at()
+ *
+ * @param dev The i2c context
+ * @param address 7-bit address of the slave
+ * @param command The register
+ * @return The result of the read or -1 if failed
+ */
+int mraa_i2c_read_word_data_at(mraa_i2c_context dev, uint8_t address, const uint8_t command);
+
+/**
+ * Bulk read from the slave at address, starting from designated register,
+ * see mraa_i2c_read_at()
+ *
+ * @param dev The i2c context
+ * @param address 7-bit address of the slave
+ * @param command The register
+ * @param data pointer to the byte array to read data in to
+ * @param length number of bytes to read
+ * @return The length in bytes passed to the function or -1
+ */
+int mraa_i2c_read_bytes_data_at(mraa_i2c_context dev, uint8_t address, uint8_t command, uint8_t* data, int length);
+
+/**
+ * Write length bytes to the slave at address, the first byte in the array
+ * is the command/register to write, see mraa_i2c_read_at()
+ *
+ * @param dev The i2c context
+ * @param address 7-bit address of the slave
+ * @param data pointer to the byte array to be written
+ * @param length the number of bytes to transmit
+ * @return Result of operation
+ */
+mraa_result_t mraa_i2c_write_at(mraa_i2c_context dev, uint8_t address, const uint8_t* data, int length);
+
+/**
+ * Write a single byte to the slave at address, see mraa_i2c_read_at()
+ *
+ * @param dev The i2c context
+ * @param address 7-bit address of the slave
+ * @param data The byte to write
+ * @return Result of operation
+ */
+mraa_result_t mraa_i2c_write_byte_at(mraa_i2c_context dev, uint8_t address, const uint8_t data);
+
+/**
+ * Write a single byte to a register of the slave at address, see
+ * mraa_i2c_read_at()
+ *
+ * @param dev The i2c context
+ * @param address 7-bit address of the slave
+ * @param data The byte to write
+ * @param command The register
+ * @return Result of operation
+ */
+mraa_result_t mraa_i2c_write_byte_data_at(mraa_i2c_context dev, uint8_t address, const uint8_t data, const uint8_t command);
+
+/**
+ * Write a single word to a register of the slave at address, see
+ * mraa_i2c_read_at()
+ *
+ * @param dev The i2c context
+ * @param address 7-bit address of the slave
+ * @param data The word to write
+ * @param command The register
+ * @return Result of operation
+ */
+mraa_result_t mraa_i2c_write_word_data_at(mraa_i2c_context dev, uint8_t address, const uint16_t data, const uint8_t command);
+
+/**
+ * Create an empty transaction on an i2c context. Messages queued on it are
+ * issued in order by mraa_i2c_txn_submit(), on Linux as a single I2C_RDWR
+ * ioctl per 42 messages instead of one ioctl each, and may address several
+ * slaves. A transaction can be submitted again as is, which suits polling
+ * the same registers every cycle.
+ *
+ * @param dev The i2c context
+ * @return transaction or NULL
+ */
+mraa_i2c_txn_t mraa_i2c_txn_init(mraa_i2c_context dev);
+
+/**
+ * Queue a write. The data is copied, the buffer can be reused straight away.
+ *
+ * @param txn The transaction
+ * @param address 7-bit address of the slave
+ * @param data pointer to the byte array to be written
+ * @param length the number of bytes to write, at most 8192
+ * @return Result of operation
+ */
+mraa_result_t mraa_i2c_txn_add_write(mraa_i2c_txn_t txn, uint8_t address, const uint8_t* data, int length);
+
+/**
+ * Queue a read. The buffer is filled in by mraa_i2c_txn_submit() and has to
+ * stay valid until then.
+ *
+ * @param txn The transaction
+ * @param address 7-bit address of the slave
+ * @param data pointer to the byte array to read data in to
+ * @param length the number of bytes to read, at most 8192
+ * @return Result of operation
+ */
+mraa_result_t mraa_i2c_txn_add_read(mraa_i2c_txn_t txn, uint8_t address, uint8_t* data, int length);
+
+/**
+ * Queue a write followed by a read from the same slave with a repeated start
+ * in between, i.e. a register read. The pair is never split across ioctls.
+ * Platforms without I2C_RDWR may only manage a single byte write, or no
+ * repeated start at all, mraa_i2c_txn_submit() then fails with
+ * MRAA_ERROR_FEATURE_NOT_SUPPORTED before sending anything.
+ *
+ * @param txn The transaction
+ * @param address 7-bit address of the slave
+ * @param wdata pointer to the byte array to be written, usually the register
+ * @param wlength the number of bytes to write
+ * @param rdata pointer to the byte array to read data in to, see mraa_i2c_txn_add_read()
+ * @param rlength the number of bytes to read
+ * @return Result of operation
+ */
+mraa_result_t mraa_i2c_txn_add_write_read(mraa_i2c_txn_t txn,
+                                          uint8_t address,
+                                          const uint8_t* wdata,
+                                          int wlength,
+                                          uint8_t* rdata,
+                                          int rlength);
+
+/**
+ * Issue all queued messages. The messages stay queued afterwards.
+ *
+ * @param txn The transaction
+ * @return Result of operation, on failure some messages may have gone out
+ */
+mraa_result_t mraa_i2c_txn_submit(mraa_i2c_txn_t txn);
+
+/**
+ * Drop all queued messages, keeping the allocations for reuse
+ *
+ * @param txn The transaction
+ * @return Result of operation
+ */
+mraa_result_t mraa_i2c_txn_clear(mraa_i2c_txn_t txn);
+
+/**
+ * Free a transaction, the i2c context is left open
+ *
+ * @param txn The transaction
+ * @return Result of operation
+ */
+mraa_result_t mraa_i2c_txn_free(mraa_i2c_txn_t txn);
+
+/**
+ * Completion callback of mraa_i2c_submit(), called from the bus worker thread
+ */
+typedef void (*mraa_i2c_callback_t)(mraa_result_t result, void* data);
+
+/**
+ * Queue a transaction to the worker of its bus and return straight away.
+ * Every call on an i2c context holds a lock shared by all contexts on the
+ * same bus, so contexts in different threads can share a bus safely. The
+ * worker issues what was queued in order and merges transactions queued
+ * back to back into shared I2C_RDWR ioctls where it can. The transaction
+ * must not be changed, submitted again or freed until the callback ran,
+ * mraa_i2c_stop() waits for the context's queued transactions.
+ *
+ * @param txn The transaction
+ * @param callback Called with the result once the transaction is done, can be NULL
+ * @param data Passed to the callback
+ * @return Result of queueing the transaction
+ */
+mraa_result_t mraa_i2c_submit(mraa_i2c_txn_t txn, mraa_i2c_callback_t callback, void* data);
+
+/**
+ * Take the bus lock, so that several calls go out without other contexts'
+ * traffic in between, e.g. a read-modify-write. The lock is recursive and
+ * must be released with mraa_i2c_unlock() from the same thread,
+ * mraa_i2c_stop() fails while the calling thread holds it.
+ *
+ * @param dev The i2c context
+ * @return Result of operation
+ */
+mraa_result_t mraa_i2c_lock(mraa_i2c_context dev);
+
+/**
+ * Release the bus lock taken by mraa_i2c_lock()
+ *
+ * @param dev The i2c context
+ * @return Result of operation
+ */
+mraa_result_t mraa_i2c_unlock(mraa_i2c_context dev);
+
 #ifdef __cplusplus
 }
 #endif
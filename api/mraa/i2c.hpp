@@ -246,7 +246,315 @@ class I2c
         return (Result) mraa_i2c_write_word_data(m_i2c, data, reg);
     }
 
+    /**
+     * Enable or disable the register shadow, see mraa_i2c_cache_enable()
+     *
+     * @param enable true to shadow registers
+     * @return Result of operation
+     */
+    Result
+    enableCache(bool enable = true)
+    {
+        return (Result) mraa_i2c_cache_enable(m_i2c, enable);
+    }
+
+    /**
+     * Declare a register of the current slave as volatile, it is then always
+     * read from the bus
+     *
+     * @param reg Register
+     * @param isVolatile false to shadow it again
+     * @return Result of operation
+     */
+    Result
+    setVolatile(uint8_t reg, bool isVolatile = true)
+    {
+        return (Result) mraa_i2c_cache_volatile(m_i2c, reg, isVolatile);
+    }
+
+    /**
+     * Forget every shadowed register
+     *
+     * @return Result of operation
+     */
+    Result
+    invalidateCache()
+    {
+        return (Result) mraa_i2c_cache_invalidate(m_i2c);
+    }
+
+    /**
+     * Register reads served from the shadow since it was enabled
+     *
+     * @return number of hits
+     */
+    uint64_t
+    cacheHits()
+    {
+        uint64_t hits;
+        mraa_i2c_cache_stats(m_i2c, &hits, NULL);
+        return hits;
+    }
+
+    /**
+     * Register reads that went to the bus since the shadow was enabled
+     *
+     * @return number of misses
+     */
+    uint64_t
+    cacheMisses()
+    {
+        uint64_t misses;
+        mraa_i2c_cache_stats(m_i2c, NULL, &misses);
+        return misses;
+    }
+
+    /**
+     * Change some bits of a register, without touching the bus when the
+     * shadow already knows they have the wanted value
+     *
+     * @param reg Register
+     * @param mask Bits to change
+     * @param value New value of the bits in mask
+     * @return Result of operation
+     */
+    Result
+    updateBits(uint8_t reg, uint8_t mask, uint8_t value)
+    {
+        return (Result) mraa_i2c_update_bits(m_i2c, reg, mask, value);
+    }
+
+    /**
+     * Take the bus lock, shared by every context on the bus, so that
+     * several calls go out back to back. The lock is recursive.
+     *
+     * @return Result of operation
+     */
+    Result
+    lock()
+    {
+        return (Result) mraa_i2c_lock(m_i2c);
+    }
+
+    /**
+     * Release the bus lock taken by lock()
+     *
+     * @return Result of operation
+     */
+    Result
+    unlock()
+    {
+        return (Result) mraa_i2c_unlock(m_i2c);
+    }
+
+    /**
+     * Read byte from a register of the slave at address, without changing
+     * the address set with address()
+     *
+     * @param address 7-bit address of the slave
+     * @param reg Register to read from
+     *
+     * @throws std::invalid_argument in case of error
+     * @return char read from register
+     */
+    uint8_t
+    readRegAt(uint8_t address, uint8_t reg)
+    {
+        int x = mraa_i2c_read_byte_data_at(m_i2c, address, reg);
+        if (x == -1) {
+            throw std::invalid_argument("Unknown error in I2c::readRegAt()");
+        }
+        return (uint8_t) x;
+    }
+
+    /**
+     * Read word from a register of the slave at address, without changing
+     * the address set with address()
+     *
+     * @param address 7-bit address of the slave
+     * @param reg Register to read from
+     *
+     * @throws std::invalid_argument in case of error
+     * @return word read from register
+     */
+    uint16_t
+    readWordRegAt(uint8_t address, uint8_t reg)
+    {
+        int x = mraa_i2c_read_word_data_at(m_i2c, address, reg);
+        if (x == -1) {
+            throw std::invalid_argument("Unknown error in I2c::readWordRegAt()");
+        }
+        return (uint16_t) x;
+    }
+
+    /**
+     * Read length bytes from the slave at address starting from a register,
+     * without changing the address set with address()
+     *
+     * @param address 7-bit address of the slave
+     * @param reg Register to read from
+     * @param data pointer to the byte array to read data in to
+     * @param length number of bytes to read
+     * @return length passed to the function or -1
+     */
+    int
+    readBytesRegAt(uint8_t address, uint8_t reg, uint8_t* data, int length)
+    {
+        return mraa_i2c_read_bytes_data_at(m_i2c, address, reg, data, length);
+    }
+
+    /**
+     * Write length bytes to the slave at address, the first byte in the
+     * array is the command/register to write, without changing the address
+     * set with address()
+     *
+     * @param address 7-bit address of the slave
+     * @param data Buffer to send on the bus, first byte is i2c command
+     * @param length Size of buffer to send
+     * @return Result of operation
+     */
+    Result
+    writeAt(uint8_t address, const uint8_t* data, int length)
+    {
+        return (Result) mraa_i2c_write_at(m_i2c, address, data, length);
+    }
+
+    /**
+     * Write a byte to a register of the slave at address, without changing
+     * the address set with address()
+     *
+     * @param address 7-bit address of the slave
+     * @param reg Register to write to
+     * @param data Value to write to register
+     * @return Result of operation
+     */
+    Result
+    writeRegAt(uint8_t address, uint8_t reg, uint8_t data)
+    {
+        return (Result) mraa_i2c_write_byte_data_at(m_i2c, address, data, reg);
+    }
+
+    /**
+     * Write a word to a register of the slave at address, without changing
+     * the address set with address()
+     *
+     * @param address 7-bit address of the slave
+     * @param reg Register to write to
+     * @param data Value to write to register
+     * @return Result of operation
+     */
+    Result
+    writeWordRegAt(uint8_t address, uint8_t reg, uint16_t data)
+    {
+        return (Result) mraa_i2c_write_word_data_at(m_i2c, address, data, reg);
+    }
+
   private:
     mraa_i2c_context m_i2c;
+    friend class I2cTransaction;
+};
+
+/**
+ * @brief API to batched i2c transfers
+ *
+ * An I2cTransaction queues writes and reads to any slave on the bus of an
+ * I2c object and issues them all with submit(), which costs one kernel round
+ * trip per 42 messages on Linux. Read buffers are filled in by submit() and
+ * must outlive it.
+ */
+class I2cTransaction
+{
+  public:
+    /**
+     * Create an empty transaction on an i2c bus
+     *
+     * @param i2c The bus, which must outlive the transaction
+     */
+    I2cTransaction(I2c& i2c)
+    {
+        m_txn = mraa_i2c_txn_init(i2c.m_i2c);
+        if (m_txn == NULL) {
+            throw std::invalid_argument("Invalid i2c transaction");
+        }
+    }
+
+    /**
+     * Frees the transaction
+     */
+    ~I2cTransaction()
+    {
+        mraa_i2c_txn_free(m_txn);
+    }
+
+    /**
+     * Queue a write, the data is copied
+     *
+     * @param address 7-bit address of the slave
+     * @param data Buffer to send on the bus
+     * @param length Size of buffer to send
+     * @return Result of operation
+     */
+    Result
+    addWrite(uint8_t address, const uint8_t* data, int length)
+    {
+        return (Result) mraa_i2c_txn_add_write(m_txn, address, data, length);
+    }
+
+    /**
+     * Queue a read
+     *
+     * @param address 7-bit address of the slave
+     * @param data Buffer filled in by submit()
+     * @param length Number of bytes to read
+     * @return Result of operation
+     */
+    Result
+    addRead(uint8_t address, uint8_t* data, int length)
+    {
+        return (Result) mraa_i2c_txn_add_read(m_txn, address, data, length);
+    }
+
+    /**
+     * Queue a write and a read with a repeated start in between
+     *
+     * @param address 7-bit address of the slave
+     * @param wdata Buffer to send on the bus, usually the register
+     * @param wlength Size of buffer to send
+     * @param rdata Buffer filled in by submit()
+     * @param rlength Number of bytes to read
+     * @return Result of operation
+     */
+    Result
+    addWriteRead(uint8_t address, const uint8_t* wdata, int wlength, uint8_t* rdata, int rlength)
+    {
+        return (Result) mraa_i2c_txn_add_write_read(m_txn, address, wdata, wlength, rdata, rlength);
+    }
+
+    /**
+     * Issue all queued messages, they stay queued for the next submit()
+     *
+     * @return Result of operation
+     */
+    Result
+    submit()
+    {
+        return (Result) mraa_i2c_txn_submit(m_txn);
+    }
+
+    /**
+     * Drop all queued messages
+     *
+     * @return Result of operation
+     */
+    Result
+    clear()
+    {
+        return (Result) mraa_i2c_txn_clear(m_txn);
+    }
+
+  private:
+    mraa_i2c_txn_t m_txn;
+    I2cTransaction(const I2cTransaction&);
+    I2cTransaction& operator=(const I2cTransaction&);
 };
 }
@@ -0,0 +1,167 @@
+/*
+ * Copyright (c) 2026 Intel Corporation.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+/**
+ * @file
+ * @brief Periodic sensor polling
+ *
+ * The poller reads i2c registers, spi transfers and aio channels at fixed
+ * rates on one timerfd driven thread and hands the timestamped results to
+ * the application through a ring buffer. Reads falling due together on the
+ * same bus go out as one batch: one i2c transaction, or one hold of the spi
+ * bus lock.
+ *
+ * @snippet sensor_poller.c Interesting
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+#include "common.h"
+#include "aio.h"
+#include "i2c.h"
+#include "spi.h"
+
+/**
+ * Most bytes a single job reads
+ */
+#define MRAA_POLLER_MAX_DATA 32
+
+/**
+ * Opaque pointer to the internal struct _poller
+ */
+typedef struct _poller* mraa_poller_t;
+
+/**
+ * One result of a job
+ */
+typedef struct {
+    unsigned int job; /**< job id returned when the job was added */
+    mraa_result_t result; /**< result of the read, data is only valid on success */
+    uint64_t timestamp_ns; /**< CLOCK_MONOTONIC time the read was issued at */
+    int value; /**< aio reading */
+    int length; /**< bytes in data */
+    uint8_t data[MRAA_POLLER_MAX_DATA]; /**< i2c register contents or spi receive buffer */
+} mraa_poller_sample_t;
+
+/**
+ * Timing of a job since the poller was started
+ */
+typedef struct {
+    uint64_t samples; /**< reads issued */
+    uint64_t errors; /**< reads that failed */
+    uint64_t missed; /**< periods skipped because the job ran a period or more late */
+    uint64_t dropped; /**< samples lost because the ring was full */
+    uint64_t max_jitter_ns; /**< worst lag of a read behind its schedule */
+    uint64_t mean_jitter_ns; /**< mean lag of a read behind its schedule */
+} mraa_poller_stats_t;
+
+/**
+ * Create a stopped poller without jobs
+ *
+ * @param ring_size Samples the ring holds, rounded up to a power of two
+ * @return Poller or NULL
+ */
+mraa_poller_t mraa_poller_init(unsigned int ring_size);
+
+/**
+ * Read length bytes from register reg of the slave at address every period.
+ * Jobs can only be added while the poller is stopped.
+ *
+ * @param poller The poller
+ * @param dev i2c context of the bus, the address set on it is left alone
+ * @param address 7-bit address of the slave
+ * @param reg Register to start reading at
+ * @param length Bytes to read, at most MRAA_POLLER_MAX_DATA
+ * @param period_us Period in microseconds
+ * @return Job id, -1 on failure
+ */
+int mraa_poller_add_i2c(mraa_poller_t poller,
+                        mraa_i2c_context dev,
+                        uint8_t address,
+                        uint8_t reg,
+                        int length,
+                        unsigned int period_us);
+
+/**
+ * Run a spi transfer every period, the received bytes make the sample
+ *
+ * @param poller The poller
+ * @param dev spi context of the chip select
+ * @param tx Bytes to send, copied
+ * @param length Bytes to transfer, at most MRAA_POLLER_MAX_DATA
+ * @param period_us Period in microseconds
+ * @return Job id, -1 on failure
+ */
+int mraa_poller_add_spi(mraa_poller_t poller, mraa_spi_context dev, const uint8_t* tx, int length, unsigned int period_us);
+
+/**
+ * Read an aio channel every period
+ *
+ * @param poller The poller
+ * @param dev aio context of the channel
+ * @param period_us Period in microseconds
+ * @return Job id, -1 on failure
+ */
+int mraa_poller_add_aio(mraa_poller_t poller, mraa_aio_context dev, unsigned int period_us);
+
+/**
+ * Start polling on a dedicated thread, every job is run straight away and
+ * then once per period. Periods are kept against absolute deadlines, so a
+ * late read doesn't shift the ones after it.
+ *
+ * @param poller The poller
+ * @param cpu CPU to pin the thread to, -1 to leave it unpinned
+ * @param priority Priority given through mraa_set_priority(), 0 to leave it unchanged
+ * @return Result of operation
+ */
+mraa_result_t mraa_poller_start(mraa_poller_t poller, int cpu, int priority);
+
+/**
+ * Stop polling after the current batch. Samples still in the ring can be
+ * read afterwards.
+ *
+ * @param poller The poller
+ * @return Result of operation
+ */
+mraa_result_t mraa_poller_stop(mraa_poller_t poller);
+
+/**
+ * Take samples out of the ring, oldest first. Never blocks, and must only
+ * be called from one thread at a time.
+ *
+ * @param poller The poller
+ * @param samples Receives the samples
+ * @param max_samples Size of samples
+ * @return Number of samples read, -1 on failure
+ */
+int mraa_poller_read(mraa_poller_t poller, mraa_poller_sample_t* samples, int max_samples);
+
+/**
+ * Timing statistics of a job, to size rates with
+ *
+ * @param poller The poller
+ * @param job Job id
+ * @param stats Receives the statistics
+ * @return Result of operation
+ */
+mraa_result_t mraa_poller_stats(mraa_poller_t poller, unsigned int job, mraa_poller_stats_t* stats);
+
+/**
+ * Stop the poller and free it, the contexts of the jobs are left open
+ *
+ * @param poller The poller
+ * @return Result of operation
+ */
+mraa_result_t mraa_poller_close(mraa_poller_t poller);
+
+#ifdef __cplusplus
+}
+#endif
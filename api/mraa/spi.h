@@ -68,6 +68,24 @@ typedef enum {
  */
 typedef struct _spi* mraa_spi_context;
 
+/**
+ * Most segments mraa_spi_transfer_segments() takes at once
+ */
+#define MRAA_SPI_MAX_SEGMENTS 64
+
+/**
+ * One segment of a spi transaction, see mraa_spi_transfer_segments()
+ */
+typedef struct {
+    const uint8_t* tx; /**< bytes to send, NULL to clock out zeros */
+    uint8_t* rx; /**< receives the bytes clocked in, may be NULL */
+    int length; /**< bytes in the segment */
+    int speed_hz; /**< clock of this segment, 0 for the context's */
+    unsigned int bits_per_word; /**< word size of this segment, 0 for the context's */
+    uint16_t delay_usecs; /**< delay after the segment, before the next one or deselecting */
+    mraa_boolean_t cs_change; /**< deselect between this segment and the next, on the last one keep the chip selected */
+} mraa_spi_segment_t;
+
 /**
  * Initialise SPI_context, uses board mapping. Sets the muxes
  *
@@ -127,7 +145,7 @@ int mraa_spi_write_word(mraa_spi_context dev, uint16_t data);
  *
  * @param dev The Spi context
  * @param data to send
- * @param length elements within buffer, Max 4096
+ * @param length elements within buffer
  * @return Data received on the miso line, same length as passed in
  */
 uint8_t* mraa_spi_write_buf(mraa_spi_context dev, uint8_t* data, int length);
@@ -138,37 +156,91 @@ uint8_t* mraa_spi_write_buf(mraa_spi_context dev, uint8_t* data, int length);
  *
  * @param dev The Spi context
  * @param data to send
- * @param length elements (in bytes) within buffer, Max 4096
+ * @param length elements (in bytes) within buffer
  * @return Data received on the miso line, same length as passed in
  */
 uint16_t* mraa_spi_write_buf_word(mraa_spi_context dev, uint16_t* data, int length);
 
+/**
+ * Give the context a pool of receive buffers for the pooled writes, which
+ * avoid the allocation mraa_spi_write_buf() makes on every call. The
+ * buffers are used round robin, so the result of a pooled write stays
+ * valid for num_buffers - 1 further pooled writes on the context. For
+ * full control over the buffers use mraa_spi_transfer_buf() instead.
+ *
+ * @param dev The Spi context
+ * @param num_buffers Number of buffers, 0 to free the pool
+ * @param buffer_size Bytes per buffer, the longest pooled write
+ * @return Result of operation
+ */
+mraa_result_t mraa_spi_rx_pool(mraa_spi_context dev, unsigned int num_buffers, int buffer_size);
+
+/**
+ * Write Buffer of bytes to the SPI device, receiving into the next buffer
+ * of the context's pool. The buffer belongs to the context, don't free it.
+ *
+ * @param dev The Spi context
+ * @param data to send
+ * @param length elements within buffer, at most the pool's buffer size
+ * @return Data received on the miso line, NULL on error
+ */
+const uint8_t* mraa_spi_write_buf_pooled(mraa_spi_context dev, const uint8_t* data, int length);
+
+/**
+ * Write Buffer of uint16 to the SPI device, receiving into the next buffer
+ * of the context's pool. The buffer belongs to the context, don't free it.
+ *
+ * @param dev The Spi context
+ * @param data to send
+ * @param length elements (in bytes) within buffer, at most the pool's buffer size
+ * @return Data received on the miso line, NULL on error
+ */
+const uint16_t* mraa_spi_write_buf_word_pooled(mraa_spi_context dev, const uint16_t* data, int length);
+
 /**
  * Transfer Buffer of bytes to the SPI device. Both send and recv buffers
- * are passed in
+ * are passed in. Transfers longer than the spidev bufsiz, read from sysfs
+ * when the context is opened, are split with the chip kept selected.
  *
  * @param dev The Spi context
  * @param data to send
  * @param rxbuf buffer to recv data back, may be NULL
- * @param length elements within buffer, Max 4096
+ * @param length elements within buffer
  * @return Result of operation
  */
 mraa_result_t mraa_spi_transfer_buf(mraa_spi_context dev, uint8_t* data, uint8_t* rxbuf, int length);
 
 /**
  * Transfer Buffer of uint16 to the SPI device. Both send and recv buffers
- * are passed in
+ * are passed in. Long transfers are split as by mraa_spi_transfer_buf().
  *
  * @param dev The Spi context
  * @param data to send
  * @param rxbuf buffer to recv data back, may be NULL
- * @param length elements (in bytes) within buffer, Max 4096
+ * @param length elements (in bytes) within buffer
  * @return Result of operation
  */
 mraa_result_t mraa_spi_transfer_buf_word(mraa_spi_context dev, uint16_t* data, uint16_t* rxbuf, int length);
 
 /**
- * Change the SPI lsb mode
+ * Run several segments as one transaction, on Linux a single
+ * SPI_IOC_MESSAGE ioctl. The chip stays selected from the first segment to
+ * the last unless a segment asks for cs_change, so a command and its data
+ * or a run of register reads cost one syscall and one chip select. Segments
+ * beyond the spidev bufsiz take further ioctls, with the chip kept selected
+ * between them. Platforms without native support run the segments one by
+ * one, each with a chip select of its own.
+ *
+ * @param dev The Spi context
+ * @param segments The segments, in bus order
+ * @param num_segments Number of segments, at most MRAA_SPI_MAX_SEGMENTS
+ * @return Result of operation
+ */
+mraa_result_t mraa_spi_transfer_segments(mraa_spi_context dev, const mraa_spi_segment_t* segments, unsigned int num_segments);
+
+/**
+ * Change the SPI lsb mode. Controllers that can only send MSB first get the
+ * bits of every transfer reversed in software instead.
  *
  * @param dev The Spi context
  * @param lsb Use least significant bit transmission. 0 for msbi
@@ -177,7 +249,8 @@ mraa_result_t mraa_spi_transfer_buf_word(mraa_spi_context dev, uint16_t* data, u
 mraa_result_t mraa_spi_lsbmode(mraa_spi_context dev, mraa_boolean_t lsb);
 
 /**
- * Set bits per mode on transaction, defaults at 8
+ * Set bits per mode on transaction, defaults at 8. On controllers without
+ * 16 bit words they are sent as byte pairs, ordered in software.
  *
  * @param dev The Spi context
  * @param bits bits per word
@@ -185,6 +258,65 @@ mraa_result_t mraa_spi_lsbmode(mraa_spi_context dev, mraa_boolean_t lsb);
  */
 mraa_result_t mraa_spi_bit_per_word(mraa_spi_context dev, unsigned int bits);
 
+/**
+ * Completion callback of mraa_spi_submit(), called from the bus worker thread
+ */
+typedef void (*mraa_spi_callback_t)(mraa_result_t result, void* data);
+
+/**
+ * Queue a transfer to the worker of the bus and return straight away. Every
+ * call on a spi context holds a lock shared by all chip selects of the same
+ * bus, so contexts in different threads can share a bus safely. Transfers
+ * queued back to back go out under one hold of the lock. Both buffers must
+ * stay valid until the callback ran, mraa_spi_stop() waits for the
+ * context's queued transfers.
+ *
+ * @param dev The Spi context
+ * @param data to send
+ * @param rxbuf buffer to recv data back, may be NULL
+ * @param length elements within buffer
+ * @param callback Called with the result once the transfer is done, can be NULL
+ * @param cb_data Passed to the callback
+ * @return Result of queueing the transfer
+ */
+mraa_result_t mraa_spi_submit(mraa_spi_context dev,
+                              uint8_t* data,
+                              uint8_t* rxbuf,
+                              int length,
+                              mraa_spi_callback_t callback,
+                              void* cb_data);
+
+/**
+ * Take the bus lock, so that several transfers go out without other chip
+ * selects' traffic in between. The lock is recursive and must be released
+ * with mraa_spi_unlock() from the same thread, mraa_spi_stop() fails while
+ * the calling thread holds it.
+ *
+ * @param dev The Spi context
+ * @return Result of operation
+ */
+mraa_result_t mraa_spi_lock(mraa_spi_context dev);
+
+/**
+ * Release the bus lock taken by mraa_spi_lock()
+ *
+ * @param dev The Spi context
+ * @return Result of operation
+ */
+mraa_result_t mraa_spi_unlock(mraa_spi_context dev);
+
+/**
+ * Set the chunk size long transfers are split into. By default a chunk is
+ * the spidev bufsiz, the most a single ioctl can move. Smaller chunks are
+ * pipelined, as many go into one ioctl as the bufsiz allows, with the chip
+ * selected throughout. Only has an effect on spidev.
+ *
+ * @param dev The Spi context
+ * @param size Chunk size in bytes, 0 for the bufsiz
+ * @return Result of operation
+ */
+mraa_result_t mraa_spi_chunk_size(mraa_spi_context dev, int size);
+
 /**
  * De-inits an mraa_spi_context device
  *
@@ -28,7 +28,12 @@
 
 #include "spi.h"
 #include "types.hpp"
+#include <array>
 #include <stdexcept>
+#include <vector>
+#if __cplusplus >= 202002L
+#include <span>
+#endif
 
 namespace mraa
 {
@@ -165,6 +170,7 @@ class Spi
      * @param txBuf buffer to send
      * @param length size of buffer to send
      * @return uint8_t* data received on the miso line. Same length as passed in
+     * @see transfer() and writePooled() for variants without an allocation per call
      */
     uint8_t*
     write(uint8_t* txBuf, int length)
@@ -219,6 +225,177 @@ class Spi
     {
         return (Result) mraa_spi_transfer_buf_word(m_spi, txBuf, rxBuf, length);
     }
+
+    /**
+     * Transfer data to and from SPI device, the send buffer is left alone
+     *
+     * @param txBuf buffer to send
+     * @param rxBuf buffer to optionally receive data from spi device
+     * @param length size of buffer to send
+     * @return Result of operation
+     */
+    Result
+    transfer(const uint8_t* txBuf, uint8_t* rxBuf, int length)
+    {
+        return (Result) mraa_spi_transfer_buf(m_spi, const_cast<uint8_t*>(txBuf), rxBuf, length);
+    }
+
+    /**
+     * Transfer data to and from SPI device straight from and into the
+     * vectors' storage. rx is not resized, it has to be empty to discard
+     * the received data or at least as long as tx.
+     *
+     * @param tx bytes to send
+     * @param rx receives the bytes clocked in
+     * @return Result of operation
+     */
+    Result
+    transfer(const std::vector<uint8_t>& tx, std::vector<uint8_t>& rx)
+    {
+        if (!rx.empty() && rx.size() < tx.size()) {
+            return ERROR_INVALID_PARAMETER;
+        }
+        return transfer(tx.data(), rx.empty() ? NULL : rx.data(), (int) tx.size());
+    }
+
+    /**
+     * Transfer data to and from SPI device straight from and into the arrays
+     *
+     * @param tx bytes to send
+     * @param rx receives the bytes clocked in
+     * @return Result of operation
+     */
+    template <size_t N>
+    Result
+    transfer(const std::array<uint8_t, N>& tx, std::array<uint8_t, N>& rx)
+    {
+        return transfer(tx.data(), rx.data(), (int) N);
+    }
+
+#if __cplusplus >= 202002L
+    /**
+     * Transfer data to and from SPI device straight from and into the
+     * viewed memory. rx has to be empty to discard the received data or at
+     * least as long as tx.
+     *
+     * @param tx bytes to send
+     * @param rx receives the bytes clocked in
+     * @return Result of operation
+     */
+    Result
+    transfer(std::span<const uint8_t> tx, std::span<uint8_t> rx)
+    {
+        if (!rx.empty() && rx.size() < tx.size()) {
+            return ERROR_INVALID_PARAMETER;
+        }
+        return transfer(tx.data(), rx.empty() ? NULL : rx.data(), (int) tx.size());
+    }
+
+    /**
+     * Transfer words to and from SPI device straight from and into the
+     * viewed memory. rx has to be empty to discard the received data or at
+     * least as long as tx.
+     *
+     * @param tx words to send
+     * @param rx receives the words clocked in
+     * @return Result of operation
+     */
+    Result
+    transfer_word(std::span<const uint16_t> tx, std::span<uint16_t> rx)
+    {
+        if (!rx.empty() && rx.size() < tx.size()) {
+            return ERROR_INVALID_PARAMETER;
+        }
+        return (Result) mraa_spi_transfer_buf_word(m_spi, const_cast<uint16_t*>(tx.data()),
+                                                   rx.empty() ? NULL : rx.data(), (int) tx.size_bytes());
+    }
+#endif
+
+    /**
+     * Transfer words to and from SPI device straight from and into the
+     * vectors' storage. rx is not resized, it has to be empty to discard
+     * the received data or at least as long as tx.
+     *
+     * @param tx words to send
+     * @param rx receives the words clocked in
+     * @return Result of operation
+     */
+    Result
+    transfer_word(const std::vector<uint16_t>& tx, std::vector<uint16_t>& rx)
+    {
+        if (!rx.empty() && rx.size() < tx.size()) {
+            return ERROR_INVALID_PARAMETER;
+        }
+        return (Result) mraa_spi_transfer_buf_word(m_spi, const_cast<uint16_t*>(tx.data()),
+                                                   rx.empty() ? NULL : rx.data(), (int) (tx.size() * sizeof(uint16_t)));
+    }
+
+    /**
+     * Set the chunk size long transfers are split into, 0 for the spidev
+     * bufsiz. Smaller chunks are pipelined several to an ioctl.
+     *
+     * @param size Chunk size in bytes
+     * @return Result of operation
+     */
+    Result
+    chunkSize(int size)
+    {
+        return (Result) mraa_spi_chunk_size(m_spi, size);
+    }
+
+    /**
+     * Give the context a pool of receive buffers for writePooled()
+     *
+     * @param numBuffers Number of buffers, 0 to free the pool
+     * @param bufferSize Bytes per buffer, the longest pooled write
+     * @return Result of operation
+     */
+    Result
+    rxPool(unsigned int numBuffers, int bufferSize)
+    {
+        return (Result) mraa_spi_rx_pool(m_spi, numBuffers, bufferSize);
+    }
+
+    /**
+     * Write buffer of bytes to SPI device, receiving into the next buffer
+     * of the pool set up with rxPool(). The buffer is owned by the context
+     * and reused after numBuffers further pooled writes.
+     *
+     * @param txBuf buffer to send
+     * @param length size of buffer to send
+     * @return data received on the miso line, NULL on error
+     */
+    const uint8_t*
+    writePooled(const uint8_t* txBuf, int length)
+    {
+        return mraa_spi_write_buf_pooled(m_spi, txBuf, length);
+    }
+
+    /**
+     * Run several segments, each with its own buffers, clock, word size,
+     * delay and chip select behaviour, as one transaction
+     *
+     * @param segments The segments, in bus order
+     * @param numSegments Number of segments, at most MRAA_SPI_MAX_SEGMENTS
+     * @return Result of operation
+     */
+    Result
+    transfer(const mraa_spi_segment_t* segments, unsigned int numSegments)
+    {
+        return (Result) mraa_spi_transfer_segments(m_spi, segments, numSegments);
+    }
+
+    /**
+     * Run several segments as one transaction
+     *
+     * @param segments The segments, in bus order
+     * @return Result of operation
+     */
+    Result
+    transfer(const std::vector<mraa_spi_segment_t>& segments)
+    {
+        return (Result) mraa_spi_transfer_segments(m_spi, segments.data(), segments.size());
+    }
 #endif
 
     /**
@@ -245,6 +422,29 @@ class Spi
         return (Result) mraa_spi_bit_per_word(m_spi, bits);
     }
 
+    /**
+     * Take the bus lock, shared by every chip select on the bus, so that
+     * several transfers go out back to back. The lock is recursive.
+     *
+     * @return Result of operation
+     */
+    Result
+    lock()
+    {
+        return (Result) mraa_spi_lock(m_spi);
+    }
+
+    /**
+     * Release the bus lock taken by lock()
+     *
+     * @return Result of operation
+     */
+    Result
+    unlock()
+    {
+        return (Result) mraa_spi_unlock(m_spi);
+    }
+
   private:
     mraa_spi_context m_spi;
 };
@@ -90,7 +90,8 @@ mraa_result_t mraa_uart_sendbreak(mraa_uart_context dev, int duration);
 /**
  * Set the baudrate.
  * Takes an int and will attempt to decide what baudrate  is
- * to be used on the UART hardware.
+ * to be used on the UART hardware. Rates without a Bxxxx constant, such
+ * as 250000, are set through termios2 and rounded by the driver.
  *
  * @param dev The UART context
  * @param baud unsigned int of baudrate i.e. 9600
@@ -142,6 +143,19 @@ mraa_result_t mraa_uart_set_timeout(mraa_uart_context dev, int read, int write,
  */
 mraa_result_t mraa_uart_set_non_blocking(mraa_uart_context dev, mraa_boolean_t nonblock);
 
+/**
+ * Trade throughput for latency. Sets ASYNC_LOW_LATENCY on drivers that
+ * have it, so received bytes are pushed to the tty straight away, and
+ * makes reads return once frame_size bytes are in or the line has gone
+ * quiet for a tenth of a second, instead of on every byte.
+ *
+ * @param dev The UART context
+ * @param enable Turn low latency mode on or off
+ * @param frame_size Bytes a read waits for, at most 255, 0 or 1 to return on every byte
+ * @return Result of operation
+ */
+mraa_result_t mraa_uart_set_low_latency(mraa_uart_context dev, mraa_boolean_t enable, unsigned int frame_size);
+
 /**
  * Get Char pointer with tty device path within Linux
  * For example. Could point to "/dev/ttyS0"
@@ -187,7 +201,8 @@ mraa_uart_settings(int index,
     unsigned int* xonxoff);
 
 /**
- * Destroy a mraa_uart_context
+ * Destroy a mraa_uart_context. A port in a uart group has to be removed
+ * from it first, or this fails with MRAA_ERROR_INVALID_RESOURCE.
  *
  * @param dev uart context
  * @return mraa_result_t
@@ -223,6 +238,193 @@ int mraa_uart_write(mraa_uart_context dev, const char* buf, size_t length);
  */
 mraa_boolean_t mraa_uart_data_available(mraa_uart_context dev, unsigned int millis);
 
+/**
+ * How the background receiver cuts the byte stream into frames
+ */
+typedef enum {
+    MRAA_UART_FRAMING_NONE = 0, /**< no framing, frames are whatever has arrived */
+    MRAA_UART_FRAMING_NEWLINE = 1, /**< lines ended by '\n', a trailing '\r' is dropped */
+    MRAA_UART_FRAMING_SLIP = 2, /**< RFC 1055 SLIP */
+    MRAA_UART_FRAMING_COBS = 3, /**< COBS encoded frames ended by a zero byte */
+    MRAA_UART_FRAMING_LENGTH = 4 /**< payloads preceded by their length */
+} mraa_uart_framing_t;
+
+/**
+ * Background receiver settings, zero fields take the defaults
+ */
+typedef struct {
+    mraa_uart_framing_t framing; /**< framing of the stream */
+    unsigned int ring_size; /**< bytes buffered, rounded up to a power of two, default 65536 */
+    unsigned int max_frame; /**< longest frame, longer ones are framing errors, default 1024 */
+    unsigned int length_bytes; /**< MRAA_UART_FRAMING_LENGTH prefix size, 1 (default) or 2 */
+    mraa_boolean_t length_big_endian; /**< MRAA_UART_FRAMING_LENGTH prefix byte order */
+} mraa_uart_rx_config_t;
+
+/**
+ * Receiver counters since it was started
+ */
+typedef struct {
+    uint64_t bytes; /**< bytes received */
+    uint64_t frames; /**< frames decoded */
+    uint64_t overflows; /**< bytes dropped because the ring was full */
+    uint64_t framing_errors; /**< malformed or oversized frames dropped */
+    uint64_t truncated; /**< frames longer than the buffer mraa_uart_read_frame() was given */
+} mraa_uart_rx_stats_t;
+
+/**
+ * Frame callback of the background receiver
+ *
+ * @param dev uart context
+ * @param frame Decoded frame, only valid during the call
+ * @param length Bytes in frame
+ * @param data User data passed to mraa_uart_rx_start()
+ */
+typedef void (*mraa_uart_frame_callback_t)(mraa_uart_context dev, const uint8_t* frame, int length, void* data);
+
+/**
+ * Start a thread that reads the port as data arrives. Without a callback
+ * the bytes are buffered in a ring and taken out with
+ * mraa_uart_read_frame(), or raw with mraa_uart_read(), which then only
+ * returns what is buffered and never blocks; mraa_uart_data_available()
+ * waits on the ring. With a callback every frame is handed to it on the
+ * receiver thread, which should not be held up for long. Fails on a port
+ * that is in a uart group, start the receiver before adding it.
+ *
+ * @param dev uart context
+ * @param config Receiver settings, NULL for newline framing and the defaults
+ * @param callback Frame callback or NULL
+ * @param data User data passed to the callback
+ * @return Result of operation
+ */
+mraa_result_t mraa_uart_rx_start(mraa_uart_context dev,
+                                 const mraa_uart_rx_config_t* config,
+                                 mraa_uart_frame_callback_t callback,
+                                 void* data);
+
+/**
+ * Stop the background receiver, bytes still buffered are discarded. On ports
+ * whose reads are replaced by the platform, stop waits for a platform read in
+ * progress to return, so a read that blocks holds it up.
+ *
+ * @param dev uart context
+ * @return Result of operation
+ */
+mraa_result_t mraa_uart_rx_stop(mraa_uart_context dev);
+
+/**
+ * Take the next frame from the background receiver. Must only be called
+ * from one thread at a time.
+ *
+ * @param dev uart context
+ * @param buf Receives the frame. A longer frame fills it, the rest is lost
+ * and counted as truncated in the receiver stats.
+ * @param length Size of buf
+ * @param millis Milliseconds to wait for a frame, 0 to return immediately
+ * @return Bytes in the frame, more than length if it was truncated, 0 if
+ * none arrived in time, -1 on failure
+ */
+int mraa_uart_read_frame(mraa_uart_context dev, uint8_t* buf, int length, unsigned int millis);
+
+/**
+ * Counters of the background receiver
+ *
+ * @param dev uart context
+ * @param stats Receives the counters
+ * @return Result of operation
+ */
+mraa_result_t mraa_uart_rx_stats(mraa_uart_context dev, mraa_uart_rx_stats_t* stats);
+
+/**
+ * Who owns a buffer handed to the transmit queue
+ */
+typedef enum {
+    MRAA_UART_TX_REFERENCE = 0, /**< stays the caller's, left untouched until it has been written */
+    MRAA_UART_TX_TAKE = 1, /**< malloc()ed, the queue free()s it once written */
+    MRAA_UART_TX_COPY = 2 /**< copied when queued, for small records */
+} mraa_uart_tx_mode_t;
+
+/**
+ * Called by the transmit queue once a buffer has been handed to the driver,
+ * or has been dropped
+ *
+ * @param result MRAA_SUCCESS once written, an error if the write failed or
+ * the queue was stopped first
+ * @param buf Buffer as passed to mraa_uart_tx_enqueue(), not to be
+ * dereferenced for MRAA_UART_TX_COPY
+ * @param length Length as passed to mraa_uart_tx_enqueue()
+ * @param data User data passed to mraa_uart_tx_enqueue()
+ */
+typedef void (*mraa_uart_tx_done_t)(mraa_result_t result, const void* buf, size_t length, void* data);
+
+/**
+ * Transmit queue counters
+ */
+typedef struct {
+    uint64_t queued; /**< bytes waiting in the queue */
+    uint64_t in_flight; /**< bytes handed to the driver and not yet sent */
+    uint64_t completed; /**< bytes sent */
+    uint64_t segments; /**< buffers written */
+    uint64_t writes; /**< writev() calls they took */
+} mraa_uart_drain_stats_t;
+
+/**
+ * Start a thread that writes out queued buffers, as many as are waiting
+ * in one writev(). It keeps no more than outq_limit bytes in the driver's
+ * output queue, so that mraa_uart_tx_stop() can still drop the rest rather
+ * than leave it to the kernel. While the queue runs, mraa_uart_write()
+ * queues a copy behind what is already queued, waiting for room like a
+ * blocking write waits on the driver, or failing with errno EAGAIN on a
+ * non-blocking port. It returns once the copy is queued, write errors
+ * after that aren't reported to it. mraa_uart_flush() first waits for the
+ * queue to empty.
+ *
+ * @param dev The UART context
+ * @param queue_limit Most bytes waiting in the queue, 0 for 1 MiB
+ * @param outq_limit Most bytes in the driver's output queue, 0 for 4096
+ * @return Result of operation
+ */
+mraa_result_t mraa_uart_tx_start(mraa_uart_context dev, size_t queue_limit, size_t outq_limit);
+
+/**
+ * Queue a buffer for writing, never blocks. A buffer larger than the
+ * queue limit is only taken while the queue is empty.
+ *
+ * @param dev The UART context
+ * @param buf Bytes to write
+ * @param length Number of bytes
+ * @param mode Who owns buf, on failure it stays with the caller
+ * @param done Called once buf has been written or dropped, can be NULL
+ * @param data User data passed to done
+ * @return Result of operation, MRAA_ERROR_NO_RESOURCES if the queue is full
+ */
+mraa_result_t mraa_uart_tx_enqueue(mraa_uart_context dev,
+                                   const void* buf,
+                                   size_t length,
+                                   mraa_uart_tx_mode_t mode,
+                                   mraa_uart_tx_done_t done,
+                                   void* data);
+
+/**
+ * Stop the transmit queue. Buffers not yet written are dropped, call
+ * mraa_uart_flush() first to wait for them. Threads blocked in
+ * mraa_uart_write() for room or in mraa_uart_flush() are woken and fail,
+ * and the queue is only freed once they are out. Other calls on the
+ * context must not run concurrently with it.
+ *
+ * @param dev The UART context
+ * @return Result of operation
+ */
+mraa_result_t mraa_uart_tx_stop(mraa_uart_context dev);
+
+/**
+ * Counters of the transmit queue
+ *
+ * @param dev The UART context
+ * @param stats Receives the counters
+ * @return Result of operation
+ */
+mraa_result_t mraa_uart_drain_stats(mraa_uart_context dev, mraa_uart_drain_stats_t* stats);
+
 #ifdef __cplusplus
 }
 #endif
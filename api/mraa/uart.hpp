@@ -187,6 +187,78 @@ class Uart
             return false;
     }
 
+    /**
+     * Start a background receiver buffering frames for readFrame(), see
+     * mraa_uart_rx_start()
+     *
+     * @param config Receiver settings
+     * @return Result of operation
+     */
+    Result
+    rxStart(const mraa_uart_rx_config_t& config)
+    {
+        return (Result) mraa_uart_rx_start(m_uart, &config, NULL, NULL);
+    }
+
+    /**
+     * Stop the background receiver
+     *
+     * @return Result of operation
+     */
+    Result
+    rxStop()
+    {
+        return (Result) mraa_uart_rx_stop(m_uart);
+    }
+
+    /**
+     * Take the next frame from the background receiver
+     *
+     * @param maxLength Longest frame to return
+     * @param millis Milliseconds to wait for a frame, 0 to return immediately
+     * @throws std::runtime_error If no receiver is buffering frames
+     * @throws std::length_error If the frame was longer than maxLength
+     * @return Frame, empty if none arrived in time
+     */
+    std::string
+    readFrameStr(int maxLength, unsigned int millis = 0)
+    {
+        std::string ret(maxLength > 0 ? maxLength : 0, '\0');
+        int v = mraa_uart_read_frame(m_uart, (uint8_t*) &ret[0], maxLength, millis);
+        if (v < 0) {
+            throw std::runtime_error("No receiver buffering frames");
+        }
+        if (v > maxLength) {
+            throw std::length_error("Frame longer than maxLength");
+        }
+        ret.resize(v);
+        return ret;
+    }
+
+    /**
+     * Start a transmit queue that batches writes, see mraa_uart_tx_start()
+     *
+     * @param queueLimit Most bytes waiting in the queue, 0 for the default
+     * @param outqLimit Most bytes in the driver's output queue, 0 for the default
+     * @return Result of operation
+     */
+    Result
+    txStart(size_t queueLimit = 0, size_t outqLimit = 0)
+    {
+        return (Result) mraa_uart_tx_start(m_uart, queueLimit, outqLimit);
+    }
+
+    /**
+     * Stop the transmit queue, dropping what hasn't been written
+     *
+     * @return Result of operation
+     */
+    Result
+    txStop()
+    {
+        return (Result) mraa_uart_tx_stop(m_uart);
+    }
+
     /**
      * Flush the outbound data.
      * Blocks until complete.
@@ -284,6 +356,19 @@ class Uart
         return (Result) mraa_uart_set_non_blocking(m_uart, nonblock);
     }
 
+    /**
+     * Trade throughput for latency, see mraa_uart_set_low_latency()
+     *
+     * @param enable Turn low latency mode on or off
+     * @param frameSize Bytes a read waits for, 0 or 1 to return on every byte
+     * @return Result of operation
+     */
+    Result
+    setLowLatency(bool enable, unsigned int frameSize = 0)
+    {
+        return (Result) mraa_uart_set_low_latency(m_uart, enable, frameSize);
+    }
+
   private:
     mraa_uart_context m_uart;
 };
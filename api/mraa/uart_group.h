@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) 2026 Intel Corporation.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+/**
+ * @file
+ * @brief Waiting on many UARTs at once
+ *
+ * A group watches any number of UART contexts through one epoll set, so a
+ * gateway serving many serial ports makes one wait per round instead of a
+ * mraa_uart_data_available() call per port. Every port that is ready gets
+ * one read into a buffer of its own, and the reads are handed back
+ * together.
+ *
+ * Ports without a file descriptor to watch, those whose platform replaces
+ * uart reads and those with a background receiver, are checked through
+ * mraa_uart_data_available() every few milliseconds while the group waits.
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include "common.h"
+#include "uart.h"
+
+/**
+ * Opaque pointer to the internal struct _uart_group
+ */
+typedef struct _uart_group* mraa_uart_group_t;
+
+/**
+ * What one ready port produced
+ */
+typedef struct {
+    int port; /**< port id returned when the port was added */
+    mraa_uart_context dev; /**< context of the port */
+    const uint8_t* data; /**< bytes read, valid until the next wait on the group, NULL on failure */
+    int length; /**< bytes in data, -1 if the read failed or the port hung up */
+} mraa_uart_group_event_t;
+
+/**
+ * Create an empty group
+ *
+ * @param buffer_size Most bytes read from a port per wait, 0 for 4096
+ * @return Group or NULL
+ */
+mraa_uart_group_t mraa_uart_group_init(size_t buffer_size);
+
+/**
+ * Add a port to the group. A background receiver has to be started before
+ * the port is added, mraa_uart_rx_start() fails on a port in a group. A
+ * port can only be in one group, and has to be removed from it before
+ * mraa_uart_stop(), which fails otherwise.
+ *
+ * @param group The group
+ * @param dev UART context, still owned by the caller
+ * @return Port id, -1 on failure
+ */
+int mraa_uart_group_add(mraa_uart_group_t group, mraa_uart_context dev);
+
+/**
+ * Stop watching a port. Its id is not reused.
+ *
+ * @param group The group
+ * @param port Port id returned by mraa_uart_group_add()
+ * @return Result of operation
+ */
+mraa_result_t mraa_uart_group_remove(mraa_uart_group_t group, int port);
+
+/**
+ * Wait until at least one port has bytes, then read once from each ready
+ * port. A port appears at most once per call. A port that failed or hung
+ * up is reported once with a length of -1 and no longer watched.
+ *
+ * A group must only be used from one thread at a time.
+ *
+ * @param group The group
+ * @param events Receives one entry per port read
+ * @param max_events Size of events
+ * @param millis Milliseconds to wait, 0 to return immediately, -1 for ever
+ * @return Number of entries filled in, 0 on timeout, -1 on failure
+ */
+int mraa_uart_group_wait(mraa_uart_group_t group, mraa_uart_group_event_t* events, int max_events, int millis);
+
+/**
+ * Free the group, the contexts of its ports are left open and can be
+ * stopped or added to another group
+ *
+ * @param group The group
+ * @return Result of operation
+ */
+mraa_result_t mraa_uart_group_close(mraa_uart_group_t group);
+
+#ifdef __cplusplus
+}
+#endif
@@ -144,6 +144,30 @@ int mraa_uart_ow_read_byte(mraa_uart_ow_context dev);
  */
 int mraa_uart_ow_write_byte(mraa_uart_ow_context dev, uint8_t byte);
 
+/**
+ * Write a block of bytes to a 1-wire bus.  The time slots of up to 32
+ * bytes go out in a single uart write, and the bits read back are
+ * checked against what was written.
+ *
+ * @param dev uart_ow context
+ * @param data the bytes to write to the bus
+ * @param length the number of bytes
+ * @return one of the mraa_result_t values,
+ * MRAA_ERROR_UART_OW_DATA_ERROR if the bus did not echo the bytes back
+ */
+mraa_result_t mraa_uart_ow_write_block(mraa_uart_ow_context dev, const uint8_t* data, size_t length);
+
+/**
+ * Read a block of bytes from a 1-wire bus, with the time slots of up to
+ * 32 bytes in a single uart write
+ *
+ * @param dev uart_ow context
+ * @param data receives the bytes read
+ * @param length the number of bytes to read
+ * @return one of the mraa_result_t values
+ */
+mraa_result_t mraa_uart_ow_read_block(mraa_uart_ow_context dev, uint8_t* data, size_t length);
+
 /**
  * Write a bit to a 1-wire bus and read a bit corresponding to the
  * time slot back.  This is possible due to the way we wired the TX
@@ -198,6 +222,113 @@ mraa_result_t mraa_uart_ow_command(mraa_uart_ow_context dev, uint8_t command, ui
  */
 uint8_t mraa_uart_ow_crc8(uint8_t* buffer, uint16_t length);
 
+/**
+ * Opaque pointer to the internal struct _mraa_uart_ow_registry
+ */
+typedef struct _mraa_uart_ow_registry* mraa_uart_ow_registry_t;
+
+/**
+ * Create an empty registry of the devices on a 1-wire bus.  The registry
+ * drives the search state of dev, don't run mraa_uart_ow_rom_search() on
+ * it at the same time.
+ *
+ * @param dev uart_ow context of the bus, still owned by the caller
+ * @return registry or NULL
+ */
+mraa_uart_ow_registry_t mraa_uart_ow_registry_init(mraa_uart_ow_context dev);
+
+/**
+ * Search the bus and replace the cached rom codes with what was found
+ *
+ * @param registry the registry
+ * @param family only look for devices of this family code, 0 for all
+ * @return the number of devices found, or -1 for error
+ */
+int mraa_uart_ow_registry_scan(mraa_uart_ow_registry_t registry, uint8_t family);
+
+/**
+ * Check the cached devices are still on the bus, dropping those that
+ * aren't.  Each check is a search pass steered straight to the rom code,
+ * so it costs one device's worth of search rather than the whole bus.
+ * Successive calls carry on where the last one stopped.
+ *
+ * @param registry the registry
+ * @param max_devices the most devices to check, 0 for all of them
+ * @return the number of devices dropped, or -1 for error
+ */
+int mraa_uart_ow_registry_revalidate(mraa_uart_ow_registry_t registry, int max_devices);
+
+/**
+ * Number of cached devices
+ *
+ * @param registry the registry
+ * @return the number of devices, or -1 for error
+ */
+int mraa_uart_ow_registry_count(mraa_uart_ow_registry_t registry);
+
+/**
+ * Rom code of a cached device
+ *
+ * @param registry the registry
+ * @param index the device, from 0 to mraa_uart_ow_registry_count() - 1
+ * @param id receives the 8-byte rom code
+ * @return one of the mraa_result_t values
+ */
+mraa_result_t mraa_uart_ow_registry_get(mraa_uart_ow_registry_t registry, int index, uint8_t* id);
+
+/**
+ * Conditional search for the devices whose alarm flag is set, such as
+ * temperature sensors outside their TH/TL limits after a conversion.
+ * The cache is left alone.
+ *
+ * @param registry the registry
+ * @param ids receives the rom codes, MRAA_UART_OW_ROMCODE_SIZE bytes each
+ * @param max_ids the number of rom codes ids has room for
+ * @return the number of devices in alarm, or -1 for error
+ */
+int mraa_uart_ow_registry_alarm_search(mraa_uart_ow_registry_t registry, uint8_t* ids, int max_ids);
+
+/**
+ * Start a conversion on every device at once with a single Skip ROM
+ * command, then wait for the last of them to finish.  Devices running on
+ * parasite power need a strong pullup during the conversion, which a
+ * UART can't provide.
+ *
+ * @param registry the registry
+ * @param command the conversion command, 0x44 for DS18B20-class sensors
+ * @param timeout_ms the longest to wait, 0 for 750 ms
+ * @return one of the mraa_result_t values
+ */
+mraa_result_t mraa_uart_ow_registry_convert_all(mraa_uart_ow_registry_t registry, uint8_t command, unsigned int timeout_ms);
+
+/**
+ * Send a command to every cached device in turn with Match ROM and read
+ * its answer.  Each device takes a reset and one batch of time slots
+ * carrying the rom code, the command and the reads.  When length is
+ * more than 1, the last byte of each answer is checked as the CRC of the
+ * bytes before it.
+ *
+ * @param registry the registry
+ * @param command the command, 0xbe to read a DS18B20-class scratchpad
+ * @param data receives length bytes per device, in cache order
+ * @param length the number of bytes to read from each device
+ * @param results receives the result for each device, can be NULL
+ * @return the number of devices read successfully, or -1 for error
+ */
+int mraa_uart_ow_registry_read_all(mraa_uart_ow_registry_t registry,
+                                   uint8_t command,
+                                   uint8_t* data,
+                                   size_t length,
+                                   mraa_result_t* results);
+
+/**
+ * Free the registry, the uart_ow context is left open
+ *
+ * @param registry the registry
+ * @return one of the mraa_result_t values
+ */
+mraa_result_t mraa_uart_ow_registry_close(mraa_uart_ow_registry_t registry);
+
 #ifdef __cplusplus
 }
 #endif
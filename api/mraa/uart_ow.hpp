@@ -146,6 +146,32 @@ class UartOW
         return (uint8_t) res;
     }
 
+    /**
+     * Write a block of bytes to a 1-wire bus
+     *
+     * @param data the bytes to write to the bus
+     * @param length the number of bytes
+     * @return one of the mraa::Result values
+     */
+    mraa::Result
+    writeBlock(const uint8_t* data, size_t length)
+    {
+        return (mraa::Result) mraa_uart_ow_write_block(m_uart, data, length);
+    }
+
+    /**
+     * Read a block of bytes from a 1-wire bus
+     *
+     * @param data receives the bytes read
+     * @param length the number of bytes to read
+     * @return one of the mraa::Result values
+     */
+    mraa::Result
+    readBlock(uint8_t* data, size_t length)
+    {
+        return (mraa::Result) mraa_uart_ow_read_block(m_uart, data, length);
+    }
+
     /**
      * Write a bit to a 1-wire bus and read a bit corresponding to the
      * time slot back.  This is possible due to the way we wired the TX
@@ -0,0 +1,195 @@
+/*
+ * Copyright (c) 2026 Intel Corporation.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Example usage: Measures the cost of mraa_gpio_write(), mraa_gpio_read() and
+ * a redundant mraa_gpio_dir() on one pin, in time and in syscalls per
+ * operation. Syscalls are counted with a perf counter on the
+ * raw_syscalls:sys_enter tracepoint, which needs tracefs mounted and
+ * enough privileges (root, or a low kernel.perf_event_paranoid):
+ *
+ *     ./gpio_benchmark 23 100000
+ *
+ * The pin is driven as an output, don't point it at anything that minds.
+ */
+
+/* standard headers */
+#include <linux/perf_event.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+
+/* mraa header */
+#include "mraa/gpio.h"
+
+/* gpio declaration */
+#define GPIO_PIN 23
+#define ITERATIONS 100000
+
+static const char* tracepoint_ids[] = {
+    "/sys/kernel/tracing/events/raw_syscalls/sys_enter/id",
+    "/sys/kernel/debug/tracing/events/raw_syscalls/sys_enter/id",
+};
+
+typedef struct {
+    int fd;
+    struct timespec start;
+} counter_t;
+
+static double
+elapsed_ns(const struct timespec* start, const struct timespec* end)
+{
+    return (end->tv_sec - start->tv_sec) * 1e9 + (end->tv_nsec - start->tv_nsec);
+}
+
+/* -1 when syscalls can't be counted here, the timings still work */
+static int
+syscall_counter_open()
+{
+    struct perf_event_attr attr;
+    unsigned long long id = 0;
+
+    for (size_t i = 0; i < sizeof(tracepoint_ids) / sizeof(tracepoint_ids[0]) && id == 0; ++i) {
+        FILE* f = fopen(tracepoint_ids[i], "r");
+        if (f != NULL) {
+            if (fscanf(f, "%llu", &id) != 1) {
+                id = 0;
+            }
+            fclose(f);
+        }
+    }
+    if (id == 0) {
+        return -1;
+    }
+
+    memset(&attr, 0, sizeof(attr));
+    attr.type = PERF_TYPE_TRACEPOINT;
+    attr.size = sizeof(attr);
+    attr.config = id;
+    attr.disabled = 1;
+
+    return syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+}
+
+static void
+counter_start(counter_t* counter)
+{
+    if (counter->fd >= 0) {
+        ioctl(counter->fd, PERF_EVENT_IOC_RESET, 0);
+        ioctl(counter->fd, PERF_EVENT_IOC_ENABLE, 0);
+    }
+    clock_gettime(CLOCK_MONOTONIC, &counter->start);
+}
+
+static void
+counter_stop(counter_t* counter, const char* what, long iterations)
+{
+    struct timespec end;
+    uint64_t syscalls = 0;
+
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    if (counter->fd >= 0) {
+        ioctl(counter->fd, PERF_EVENT_IOC_DISABLE, 0);
+        if (read(counter->fd, &syscalls, sizeof(syscalls)) == sizeof(syscalls)) {
+            fprintf(stdout, "%-16s: %10.0f ns/op, %6.2f syscalls/op\n", what,
+                    elapsed_ns(&counter->start, &end) / iterations, (double) syscalls / iterations);
+            return;
+        }
+    }
+    fprintf(stdout, "%-16s: %10.0f ns/op\n", what, elapsed_ns(&counter->start, &end) / iterations);
+}
+
+int
+main(int argc, char** argv)
+{
+    mraa_result_t status = MRAA_SUCCESS;
+    mraa_gpio_context gpio;
+    counter_t counter;
+    int pin = (argc > 1) ? atoi(argv[1]) : GPIO_PIN;
+    long iterations = (argc > 2) ? atol(argv[2]) : ITERATIONS;
+
+    if (iterations <= 0) {
+        fprintf(stderr, "Invalid iteration count %ld\n", iterations);
+        return EXIT_FAILURE;
+    }
+
+    counter.fd = syscall_counter_open();
+    if (counter.fd < 0) {
+        fprintf(stderr, "Can't count syscalls here, timing only\n");
+    }
+
+    /* initialize mraa for the platform (not needed most of the times) */
+    mraa_init();
+
+    //! [Interesting]
+    gpio = mraa_gpio_init(pin);
+    if (gpio == NULL) {
+        fprintf(stderr, "Failed to initialize GPIO %d\n", pin);
+        close(counter.fd);
+        mraa_deinit();
+        return EXIT_FAILURE;
+    }
+
+    status = mraa_gpio_dir(gpio, MRAA_GPIO_OUT);
+    if (status != MRAA_SUCCESS) {
+        goto err_exit;
+    }
+
+    /* toggle the pin */
+    counter_start(&counter);
+    for (long i = 0; i < iterations; ++i) {
+        status = mraa_gpio_write(gpio, i & 1);
+        if (status != MRAA_SUCCESS) {
+            goto err_exit;
+        }
+    }
+    counter_stop(&counter, "write", iterations);
+
+    /* read back the pin */
+    counter_start(&counter);
+    for (long i = 0; i < iterations; ++i) {
+        if (mraa_gpio_read(gpio) == -1) {
+            status = MRAA_ERROR_UNSPECIFIED;
+            goto err_exit;
+        }
+    }
+    counter_stop(&counter, "read", iterations);
+
+    /* set the direction the pin already has */
+    counter_start(&counter);
+    for (long i = 0; i < iterations; ++i) {
+        status = mraa_gpio_dir(gpio, MRAA_GPIO_OUT);
+        if (status != MRAA_SUCCESS) {
+            goto err_exit;
+        }
+    }
+    counter_stop(&counter, "dir (unchanged)", iterations);
+
+    /* release gpio */
+    status = mraa_gpio_close(gpio);
+    if (status != MRAA_SUCCESS) {
+        goto err_exit;
+    }
+    //! [Interesting]
+
+    /* deinitialize mraa for the platform (not needed most of the times) */
+    close(counter.fd);
+    mraa_deinit();
+
+    return EXIT_SUCCESS;
+
+err_exit:
+    mraa_result_print(status);
+
+    /* deinitialize mraa for the platform (not needed most of the times) */
+    close(counter.fd);
+    mraa_deinit();
+
+    return EXIT_FAILURE;
+}
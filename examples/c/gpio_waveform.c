@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) 2026 Intel Corporation.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Example usage: Clocks a byte out on two pins, data on the first and clock on
+ * the second, from a precomputed waveform and prints the achieved timing:
+ *
+ *     ./gpio_waveform 23 24
+ *
+ * Both pins are driven as outputs, don't point them at anything that minds.
+ * Where the board describes the gpio registers, enabling mmap on the context
+ * before mraa_gpio_waveform_init() replays each step as register stores.
+ */
+
+/* standard headers */
+#include <stdio.h>
+#include <stdlib.h>
+
+/* mraa header */
+#include "mraa/gpio.h"
+
+/* gpio declaration */
+#define DATA_PIN 23
+#define CLOCK_PIN 24
+#define HALF_PERIOD_NS 1000
+#define REPEAT 1000
+
+int
+main(int argc, char** argv)
+{
+    mraa_result_t status = MRAA_SUCCESS;
+    mraa_gpio_context gpio;
+    mraa_gpio_waveform_t wf;
+    mraa_gpio_waveform_stats_t stats;
+    mraa_gpio_waveform_step_t steps[16];
+    int pins[2] = { DATA_PIN, CLOCK_PIN };
+    unsigned char byte = 0xa5;
+
+    if (argc > 2) {
+        pins[0] = atoi(argv[1]);
+        pins[1] = atoi(argv[2]);
+    }
+
+    /* initialize mraa for the platform (not needed most of the times) */
+    mraa_init();
+
+    //! [Interesting]
+    gpio = mraa_gpio_init_multi(pins, 2);
+    if (gpio == NULL) {
+        fprintf(stderr, "Failed to initialize GPIO %d and %d\n", pins[0], pins[1]);
+        mraa_deinit();
+        return EXIT_FAILURE;
+    }
+
+    status = mraa_gpio_dir(gpio, MRAA_GPIO_OUT);
+    if (status != MRAA_SUCCESS) {
+        goto err_exit;
+    }
+
+    /* data and clock low, then clock high, for each bit msb first */
+    for (int i = 0; i < 8; ++i) {
+        uint64_t data = (byte >> (7 - i)) & 1;
+        steps[2 * i] = (mraa_gpio_waveform_step_t){ .mask = 0x3, .value = data, .delay_ns = HALF_PERIOD_NS };
+        steps[2 * i + 1] = (mraa_gpio_waveform_step_t){ .mask = 0x2, .value = 0x2, .delay_ns = HALF_PERIOD_NS };
+    }
+
+    wf = mraa_gpio_waveform_init(gpio, steps, 16);
+    if (wf == NULL) {
+        status = MRAA_ERROR_UNSPECIFIED;
+        goto err_exit;
+    }
+
+    /* replay on cpu 0 */
+    status = mraa_gpio_waveform_start(wf, REPEAT, 0, 0);
+    if (status == MRAA_SUCCESS) {
+        status = mraa_gpio_waveform_wait(wf, &stats);
+    }
+    mraa_gpio_waveform_close(wf);
+    if (status != MRAA_SUCCESS) {
+        goto err_exit;
+    }
+
+    fprintf(stdout, "%llu steps: requested %llu ns, achieved %llu ns, late max %llu ns mean %llu ns\n",
+            (unsigned long long) stats.steps, (unsigned long long) stats.requested_ns,
+            (unsigned long long) stats.achieved_ns, (unsigned long long) stats.max_late_ns,
+            (unsigned long long) stats.mean_late_ns);
+
+    /* release gpio */
+    status = mraa_gpio_close(gpio);
+    if (status != MRAA_SUCCESS) {
+        goto err_exit;
+    }
+    //! [Interesting]
+
+    /* deinitialize mraa for the platform (not needed most of the times) */
+    mraa_deinit();
+
+    return EXIT_SUCCESS;
+
+err_exit:
+    mraa_result_print(status);
+
+    /* deinitialize mraa for the platform (not needed most of the times) */
+    mraa_deinit();
+
+    return EXIT_FAILURE;
+}
@@ -0,0 +1,113 @@
+/*
+ * Copyright (c) 2026 Intel Corporation.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Example usage: Measures i2c write and register read throughput for a range
+ * of transfer sizes against one slave. Against the mock board it shows the
+ * library's own overhead:
+ *
+ *     ./i2c_benchmark 0 0x33 1000
+ *
+ * The slave is written to, don't point it at anything that minds.
+ */
+
+/* standard headers */
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+/* mraa header */
+#include "mraa/i2c.h"
+
+/* i2c declaration */
+#define I2C_BUS 0
+#define I2C_ADDR 0x33
+#define ITERATIONS 1000
+#define MAX_SIZE 4096
+
+static double
+elapsed_ns(const struct timespec* start, const struct timespec* end)
+{
+    return (end->tv_sec - start->tv_sec) * 1e9 + (end->tv_nsec - start->tv_nsec);
+}
+
+int
+main(int argc, char** argv)
+{
+    mraa_result_t status = MRAA_SUCCESS;
+    mraa_i2c_context i2c;
+    struct timespec start, end;
+    int bus = (argc > 1) ? atoi(argv[1]) : I2C_BUS;
+    int addr = (argc > 2) ? (int) strtol(argv[2], NULL, 0) : I2C_ADDR;
+    long iterations = (argc > 3) ? atol(argv[3]) : ITERATIONS;
+    static uint8_t buf[MAX_SIZE + 1];
+
+    if (iterations <= 0) {
+        fprintf(stderr, "Invalid iteration count %ld\n", iterations);
+        return EXIT_FAILURE;
+    }
+
+    /* initialize mraa for the platform (not needed most of the times) */
+    mraa_init();
+
+    //! [Interesting]
+    i2c = mraa_i2c_init(bus);
+    if (i2c == NULL) {
+        fprintf(stderr, "Failed to initialize I2C bus %d\n", bus);
+        mraa_deinit();
+        return EXIT_FAILURE;
+    }
+
+    status = mraa_i2c_address(i2c, addr);
+    if (status != MRAA_SUCCESS) {
+        goto err_exit;
+    }
+
+    for (int size = 1; size <= MAX_SIZE; size *= 4) {
+        double ns;
+
+        /* register 0 then size bytes of data */
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        for (long i = 0; i < iterations; ++i) {
+            status = mraa_i2c_write(i2c, buf, size + 1);
+            if (status != MRAA_SUCCESS) {
+                goto err_exit;
+            }
+        }
+        clock_gettime(CLOCK_MONOTONIC, &end);
+        ns = elapsed_ns(&start, &end) / iterations;
+        fprintf(stdout, "write %5d bytes: %8.0f ns/op %8.2f MB/s\n", size, ns, size * 1e3 / ns);
+
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        for (long i = 0; i < iterations; ++i) {
+            if (mraa_i2c_read_bytes_data(i2c, 0, buf, size) < 0) {
+                status = MRAA_ERROR_UNSPECIFIED;
+                goto err_exit;
+            }
+        }
+        clock_gettime(CLOCK_MONOTONIC, &end);
+        ns = elapsed_ns(&start, &end) / iterations;
+        fprintf(stdout, "read  %5d bytes: %8.0f ns/op %8.2f MB/s\n", size, ns, size * 1e3 / ns);
+    }
+
+    /* stop i2c */
+    mraa_i2c_stop(i2c);
+    //! [Interesting]
+
+    /* deinitialize mraa for the platform (not needed most of the times) */
+    mraa_deinit();
+
+    return EXIT_SUCCESS;
+
+err_exit:
+    mraa_result_print(status);
+
+    /* stop i2c */
+    mraa_i2c_stop(i2c);
+
+    /* deinitialize mraa for the platform (not needed most of the times) */
+    mraa_deinit();
+
+    return EXIT_FAILURE;
+}
@@ -0,0 +1,131 @@
+/*
+ * Copyright (c) 2026 Intel Corporation.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Example usage: Polls two registers of an i2c slave at 100Hz and an aio
+ * channel at 10Hz for a second, then prints the samples and the timing of
+ * each job:
+ *
+ *     ./sensor_poller 0 0x33 0
+ *
+ * Arguments are the i2c bus, the slave address and the aio channel.
+ */
+
+/* standard headers */
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+/* mraa header */
+#include "mraa/poller.h"
+
+/* poller declaration */
+#define I2C_BUS 0
+#define I2C_ADDR 0x33
+#define I2C_REG 0x00
+#define AIO_PIN 0
+#define RING_SIZE 256
+
+int
+main(int argc, char** argv)
+{
+    mraa_result_t status = MRAA_SUCCESS;
+    mraa_i2c_context i2c;
+    mraa_aio_context aio;
+    mraa_poller_t poller;
+    mraa_poller_sample_t samples[RING_SIZE];
+    mraa_poller_stats_t stats;
+    int bus = I2C_BUS, addr = I2C_ADDR, pin = AIO_PIN;
+    int jobs[2], count;
+
+    if (argc > 3) {
+        bus = atoi(argv[1]);
+        addr = strtol(argv[2], NULL, 0);
+        pin = atoi(argv[3]);
+    }
+
+    /* initialize mraa for the platform (not needed most of the times) */
+    mraa_init();
+
+    i2c = mraa_i2c_init(bus);
+    if (i2c == NULL) {
+        fprintf(stderr, "Failed to initialize I2C bus %d\n", bus);
+        mraa_deinit();
+        return EXIT_FAILURE;
+    }
+
+    aio = mraa_aio_init(pin);
+    if (aio == NULL) {
+        fprintf(stderr, "Failed to initialize AIO %d\n", pin);
+        mraa_i2c_stop(i2c);
+        mraa_deinit();
+        return EXIT_FAILURE;
+    }
+
+    //! [Interesting]
+    poller = mraa_poller_init(RING_SIZE);
+    if (poller == NULL) {
+        status = MRAA_ERROR_NO_RESOURCES;
+        goto err_exit;
+    }
+
+    /* 2 bytes from the register every 10ms, the channel every 100ms */
+    jobs[0] = mraa_poller_add_i2c(poller, i2c, addr, I2C_REG, 2, 10000);
+    jobs[1] = mraa_poller_add_aio(poller, aio, 100000);
+    if (jobs[0] < 0 || jobs[1] < 0) {
+        status = MRAA_ERROR_INVALID_PARAMETER;
+        mraa_poller_close(poller);
+        goto err_exit;
+    }
+
+    status = mraa_poller_start(poller, -1, 0);
+    if (status != MRAA_SUCCESS) {
+        mraa_poller_close(poller);
+        goto err_exit;
+    }
+    sleep(1);
+    mraa_poller_stop(poller);
+
+    count = mraa_poller_read(poller, samples, RING_SIZE);
+    for (int i = 0; i < count; ++i) {
+        if (samples[i].result != MRAA_SUCCESS) {
+            fprintf(stdout, "%llu job %u failed\n", (unsigned long long) samples[i].timestamp_ns, samples[i].job);
+        } else if ((int) samples[i].job == jobs[0]) {
+            fprintf(stdout, "%llu i2c %02x %02x\n", (unsigned long long) samples[i].timestamp_ns,
+                    samples[i].data[0], samples[i].data[1]);
+        } else {
+            fprintf(stdout, "%llu aio %d\n", (unsigned long long) samples[i].timestamp_ns, samples[i].value);
+        }
+    }
+
+    for (int i = 0; i < 2; ++i) {
+        mraa_poller_stats(poller, jobs[i], &stats);
+        fprintf(stdout, "job %d: %llu samples, %llu errors, %llu missed, %llu dropped, jitter max %llu ns mean %llu ns\n",
+                jobs[i], (unsigned long long) stats.samples, (unsigned long long) stats.errors,
+                (unsigned long long) stats.missed, (unsigned long long) stats.dropped,
+                (unsigned long long) stats.max_jitter_ns, (unsigned long long) stats.mean_jitter_ns);
+    }
+
+    mraa_poller_close(poller);
+    //! [Interesting]
+
+    mraa_aio_close(aio);
+    mraa_i2c_stop(i2c);
+
+    /* deinitialize mraa for the platform (not needed most of the times) */
+    mraa_deinit();
+
+    return EXIT_SUCCESS;
+
+err_exit:
+    mraa_result_print(status);
+
+    mraa_aio_close(aio);
+    mraa_i2c_stop(i2c);
+
+    /* deinitialize mraa for the platform (not needed most of the times) */
+    mraa_deinit();
+
+    return EXIT_FAILURE;
+}
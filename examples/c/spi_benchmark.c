@@ -0,0 +1,109 @@
+/*
+ * Copyright (c) 2026 Intel Corporation.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Example usage: Measures spi transfer throughput for a range of sizes, up
+ * to a 320x240 16 bit display frame. Transfers beyond the spidev bufsiz are
+ * split by the library. Against the mock board it shows the library's own
+ * overhead:
+ *
+ *     ./spi_benchmark 0 100
+ *
+ * Data is clocked out on the bus, don't point it at anything that minds.
+ */
+
+/* standard headers */
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+/* mraa header */
+#include "mraa/spi.h"
+
+/* spi declaration */
+#define SPI_BUS 0
+#define ITERATIONS 100
+#define MAX_SIZE (320 * 240 * 2)
+
+static double
+elapsed_ns(const struct timespec* start, const struct timespec* end)
+{
+    return (end->tv_sec - start->tv_sec) * 1e9 + (end->tv_nsec - start->tv_nsec);
+}
+
+int
+main(int argc, char** argv)
+{
+    mraa_result_t status = MRAA_SUCCESS;
+    mraa_spi_context spi;
+    struct timespec start, end;
+    int bus = (argc > 1) ? atoi(argv[1]) : SPI_BUS;
+    long iterations = (argc > 2) ? atol(argv[2]) : ITERATIONS;
+    static const int sizes[] = { 16, 256, 4096, 16384, 65536, MAX_SIZE };
+    static uint8_t tx[MAX_SIZE], rx[MAX_SIZE];
+
+    if (iterations <= 0) {
+        fprintf(stderr, "Invalid iteration count %ld\n", iterations);
+        return EXIT_FAILURE;
+    }
+
+    /* initialize mraa for the platform (not needed most of the times) */
+    mraa_init();
+
+    //! [Interesting]
+    spi = mraa_spi_init(bus);
+    if (spi == NULL) {
+        fprintf(stderr, "Failed to initialize SPI bus %d\n", bus);
+        mraa_deinit();
+        return EXIT_FAILURE;
+    }
+
+    for (unsigned int s = 0; s < sizeof(sizes) / sizeof(sizes[0]); ++s) {
+        int size = sizes[s];
+        double ns;
+
+        /* transmit only, as when pushing a frame */
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        for (long i = 0; i < iterations; ++i) {
+            status = mraa_spi_transfer_buf(spi, tx, NULL, size);
+            if (status != MRAA_SUCCESS) {
+                goto err_exit;
+            }
+        }
+        clock_gettime(CLOCK_MONOTONIC, &end);
+        ns = elapsed_ns(&start, &end) / iterations;
+        fprintf(stdout, "write    %6d bytes: %10.0f ns/op %8.2f MB/s\n", size, ns, size * 1e3 / ns);
+
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        for (long i = 0; i < iterations; ++i) {
+            status = mraa_spi_transfer_buf(spi, tx, rx, size);
+            if (status != MRAA_SUCCESS) {
+                goto err_exit;
+            }
+        }
+        clock_gettime(CLOCK_MONOTONIC, &end);
+        ns = elapsed_ns(&start, &end) / iterations;
+        fprintf(stdout, "transfer %6d bytes: %10.0f ns/op %8.2f MB/s\n", size, ns, size * 1e3 / ns);
+    }
+
+    /* stop spi */
+    mraa_spi_stop(spi);
+    //! [Interesting]
+
+    /* deinitialize mraa for the platform (not needed most of the times) */
+    mraa_deinit();
+
+    return EXIT_SUCCESS;
+
+err_exit:
+    mraa_result_print(status);
+
+    /* stop spi */
+    mraa_spi_stop(spi);
+
+    /* deinitialize mraa for the platform (not needed most of the times) */
+    mraa_deinit();
+
+    return EXIT_FAILURE;
+}
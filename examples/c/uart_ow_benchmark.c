@@ -0,0 +1,178 @@
+/*
+ * Copyright (c) 2026 Intel Corporation.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Example usage: Finds the DS18B20s on the 1-wire bus with a registry,
+ * starts a temperature conversion on all of them at once and reads their
+ * scratchpads back. It then times reading a scratchpad a byte at a time
+ * against reading it as one block, and a whole bus sweep through the
+ * registry. Against the mock board, which simulates a bus with a few
+ * devices, it shows the library's own overhead:
+ *
+ *     ./uart_ow_benchmark 0 1000
+ */
+
+/* standard headers */
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+/* mraa header */
+#include "mraa/uart_ow.h"
+
+/* uart_ow declaration */
+#define UART_OW_BUS 0
+#define ITERATIONS 100
+#define MAX_DEVICES 16
+
+#define DS18B20_FAMILY 0x28
+#define DS18B20_CONVERT 0x44
+#define DS18B20_READ_SCRATCHPAD 0xbe
+#define SCRATCHPAD_SIZE 9
+
+static double
+elapsed_ns(const struct timespec* start, const struct timespec* end)
+{
+    return (end->tv_sec - start->tv_sec) * 1e9 + (end->tv_nsec - start->tv_nsec);
+}
+
+static mraa_result_t
+read_scratchpad(mraa_uart_ow_context uart_ow, uint8_t* id, uint8_t* scratchpad, mraa_boolean_t block)
+{
+    mraa_result_t status = mraa_uart_ow_command(uart_ow, DS18B20_READ_SCRATCHPAD, id);
+    if (status != MRAA_SUCCESS) {
+        return status;
+    }
+
+    if (block) {
+        return mraa_uart_ow_read_block(uart_ow, scratchpad, SCRATCHPAD_SIZE);
+    }
+
+    for (int i = 0; i < SCRATCHPAD_SIZE; i++) {
+        int byte = mraa_uart_ow_read_byte(uart_ow);
+        if (byte < 0) {
+            return MRAA_ERROR_NO_DATA_AVAILABLE;
+        }
+        scratchpad[i] = byte;
+    }
+
+    return MRAA_SUCCESS;
+}
+
+int
+main(int argc, char** argv)
+{
+    mraa_result_t status = MRAA_SUCCESS;
+    mraa_uart_ow_context uart_ow;
+    mraa_uart_ow_registry_t registry;
+    struct timespec start, end;
+    int bus = (argc > 1) ? atoi(argv[1]) : UART_OW_BUS;
+    long iterations = (argc > 2) ? atol(argv[2]) : ITERATIONS;
+    uint8_t ids[MAX_DEVICES][MRAA_UART_OW_ROMCODE_SIZE];
+    uint8_t scratchpad[SCRATCHPAD_SIZE];
+    uint8_t scratchpads[MAX_DEVICES][SCRATCHPAD_SIZE];
+    mraa_result_t results[MAX_DEVICES];
+    int count;
+
+    if (iterations <= 0) {
+        fprintf(stderr, "Invalid iteration count %ld\n", iterations);
+        return EXIT_FAILURE;
+    }
+
+    /* initialize mraa for the platform (not needed most of the times) */
+    mraa_init();
+
+    //! [Interesting]
+    uart_ow = mraa_uart_ow_init(bus);
+    if (uart_ow == NULL) {
+        fprintf(stderr, "Failed to initialize UART OW\n");
+        mraa_deinit();
+        return EXIT_FAILURE;
+    }
+
+    registry = mraa_uart_ow_registry_init(uart_ow);
+    if (registry == NULL) {
+        fprintf(stderr, "Failed to create 1-wire registry\n");
+        mraa_uart_ow_stop(uart_ow);
+        mraa_deinit();
+        return EXIT_FAILURE;
+    }
+
+    /* collect the DS18B20s on the bus */
+    count = mraa_uart_ow_registry_scan(registry, DS18B20_FAMILY);
+    if (count <= 0 || count > MAX_DEVICES) {
+        fprintf(stderr, "Found %d DS18B20s\n", count);
+        status = MRAA_ERROR_UART_OW_NO_DEVICES;
+        goto err_exit;
+    }
+    for (int d = 0; d < count; d++) {
+        mraa_uart_ow_registry_get(registry, d, ids[d]);
+    }
+
+    /* all of them convert at once, the mock has them done straight away */
+    status = mraa_uart_ow_registry_convert_all(registry, DS18B20_CONVERT, 0);
+    if (status != MRAA_SUCCESS) {
+        goto err_exit;
+    }
+
+    /* scratchpads come back CRC checked */
+    mraa_uart_ow_registry_read_all(registry, DS18B20_READ_SCRATCHPAD, scratchpads[0], SCRATCHPAD_SIZE, results);
+    for (int d = 0; d < count; d++) {
+        if (results[d] != MRAA_SUCCESS) {
+            status = results[d];
+            goto err_exit;
+        }
+        fprintf(stdout, "Device %02d: %.4f C\n", d,
+                (int16_t)(scratchpads[d][0] | (scratchpads[d][1] << 8)) / 16.0);
+    }
+
+    for (int block = 0; block < 2; block++) {
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        for (long i = 0; i < iterations; ++i) {
+            status = read_scratchpad(uart_ow, ids[i % count], scratchpad, block);
+            if (status != MRAA_SUCCESS) {
+                goto err_exit;
+            }
+        }
+        clock_gettime(CLOCK_MONOTONIC, &end);
+        fprintf(stdout, "scratchpad read, %s: %10.0f ns/op\n", block ? "block        " : "byte at a time",
+                elapsed_ns(&start, &end) / iterations);
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (long i = 0; i < iterations; ++i) {
+        status = mraa_uart_ow_registry_convert_all(registry, DS18B20_CONVERT, 0);
+        if (status != MRAA_SUCCESS) {
+            goto err_exit;
+        }
+        if (mraa_uart_ow_registry_read_all(registry, DS18B20_READ_SCRATCHPAD, scratchpads[0], SCRATCHPAD_SIZE, NULL) != count) {
+            status = MRAA_ERROR_UART_OW_DATA_ERROR;
+            goto err_exit;
+        }
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    fprintf(stdout, "bus sweep, %2d devices       : %10.0f ns/op\n", count, elapsed_ns(&start, &end) / iterations);
+
+    /* stop uart_ow */
+    mraa_uart_ow_registry_close(registry);
+    mraa_uart_ow_stop(uart_ow);
+    //! [Interesting]
+
+    /* deinitialize mraa for the platform (not needed most of the times) */
+    mraa_deinit();
+
+    return EXIT_SUCCESS;
+
+err_exit:
+    mraa_result_print(status);
+
+    /* stop uart_ow */
+    mraa_uart_ow_registry_close(registry);
+    mraa_uart_ow_stop(uart_ow);
+
+    /* deinitialize mraa for the platform (not needed most of the times) */
+    mraa_deinit();
+
+    return EXIT_FAILURE;
+}
@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) 2026 Intel Corporation.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "mraa_internal.h"
+
+/**
+ * Arbitration of i2c and spi buses. Every context on the same bus shares one
+ * recursive lock, held for the duration of each call, so contexts on other
+ * buses never contend. Asynchronous requests are queued to a worker per bus,
+ * started on first use, which hands everything queued so far to the bus
+ * type's dispatch function in one go so that adjacent requests can be merged.
+ */
+typedef struct _mraa_bus* mraa_bus_t;
+
+typedef enum {
+    MRAA_BUS_I2C = 0,
+    MRAA_BUS_SPI = 1
+} mraa_bus_type_t;
+
+typedef struct _mraa_bus_request {
+    struct _mraa_bus_request* next;
+    void* dev; /**< context the request was submitted on */
+    void* payload; /**< i2c transaction */
+    uint8_t* tx; /**< spi transmit buffer */
+    uint8_t* rx; /**< spi receive buffer */
+    int length; /**< spi transfer length */
+    mraa_result_t result; /**< set by the dispatch function */
+    void (*callback)(mraa_result_t result, void* data);
+    void* data;
+} mraa_bus_request_t;
+
+/**
+ * Runs a batch of requests, in order, with the bus lock held, and sets the
+ * result of each.
+ */
+typedef void (*mraa_bus_dispatch_t)(mraa_bus_request_t* batch);
+
+/**
+ * Reference to the arbiter of a bus, created on first use
+ *
+ * @param type Bus type
+ * @param platform Platform the bus belongs to, its adv_func table, so that
+ * bus N of a sub platform and of the main one don't share an arbiter
+ * @param busnum Bus number, as used to open the bus
+ * @param dispatch Runs queued requests for this bus type
+ * @return Arbiter, NULL on allocation failure
+ */
+mraa_bus_t mraa_bus_get(mraa_bus_type_t type, const void* platform, int busnum, mraa_bus_dispatch_t dispatch);
+
+/**
+ * Drop a reference, the last one stops the worker and frees the arbiter
+ */
+void mraa_bus_put(mraa_bus_t bus);
+
+/**
+ * Take the bus lock, recursive. Both lock calls accept NULL and do nothing.
+ *
+ * @return bus, for MRAA_BUS_LOCK_SCOPE()
+ */
+mraa_bus_t mraa_bus_lock(mraa_bus_t bus);
+void mraa_bus_unlock(mraa_bus_t bus);
+void mraa_bus_scope_unlock(mraa_bus_t* bus);
+
+/**
+ * Hold the bus lock until the end of the enclosing block
+ */
+#define MRAA_BUS_LOCK_SCOPE(bus)                                                                  \
+    mraa_bus_t mraa_bus_scope_ __attribute__((cleanup(mraa_bus_scope_unlock))) = mraa_bus_lock(bus)
+
+/**
+ * Queue a request to the bus worker. The request is copied.
+ *
+ * @param bus Arbiter of the bus
+ * @param request Request, the next and result fields are ignored
+ * @return Result of operation
+ */
+mraa_result_t mraa_bus_submit(mraa_bus_t bus, const mraa_bus_request_t* request);
+
+/**
+ * Wait until every request queued on the bus by dev has completed. Returns
+ * straight away when called from the worker, i.e. from a completion callback,
+ * so a context stopped from a callback must not have other requests queued.
+ * Fails without waiting when the calling thread holds the bus lock, the
+ * worker could never get to the queue.
+ *
+ * @param bus Arbiter of the bus
+ * @param dev Context whose requests to wait for
+ * @return Result of operation
+ */
+mraa_result_t mraa_bus_flush(mraa_bus_t bus, void* dev);
+
+#ifdef __cplusplus
+}
+#endif
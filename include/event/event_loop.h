@@ -0,0 +1,60 @@
+/*
+ * Copyright (c) 2026 Intel Corporation.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "mraa_internal.h"
+
+#include <stdint.h>
+
+typedef struct _mraa_event_source* mraa_event_source_t;
+
+/**
+ * Called from a loop worker when the registered fd is ready. A source is
+ * never dispatched on two workers at once.
+ */
+typedef void (*mraa_event_handler_t)(int fd, uint32_t events, void* data);
+
+/**
+ * Whether callbacks should be registered with the shared loop rather than
+ * getting a thread of their own.
+ *
+ * @return 1 if the loop workers are running
+ */
+mraa_boolean_t mraa_event_loop_is_active();
+
+/**
+ * Register a fd with the shared loop.
+ *
+ * @param fd File descriptor to watch, still owned by the caller
+ * @param events epoll events to wait for
+ * @param handler Function called when the fd is ready
+ * @param data Passed back to the handler
+ * @return Source handle, NULL on failure
+ */
+mraa_event_source_t mraa_event_loop_add(int fd, uint32_t events, mraa_event_handler_t handler, void* data);
+
+/**
+ * Unregister a source. Blocks until a handler running on another worker has
+ * returned; may be called from the source's own handler.
+ *
+ * @param source Handle returned by mraa_event_loop_add()
+ * @return Result of operation
+ */
+mraa_result_t mraa_event_loop_remove(mraa_event_source_t source);
+
+/**
+ * Stop the loop workers, used by mraa_deinit().
+ */
+void mraa_event_loop_stop();
+
+#ifdef __cplusplus
+}
+#endif
@@ -37,6 +37,12 @@ mraa_gpiod_line_info* mraa_get_line_info_by_chip_name(const char* chip_name, uns
 mraa_gpiod_line_info* mraa_get_line_info_by_chip_label(const char* chip_label, unsigned line_number);
 
 int mraa_get_lines_handle(int chip_fd, unsigned line_offsets[], unsigned num_lines, unsigned flags, unsigned default_value);
+int mraa_get_lines_handle_v2(int chip_fd,
+                             unsigned line_offsets[],
+                             unsigned num_lines,
+                             uint64_t flags,
+                             unsigned default_value,
+                             unsigned debounce_us);
 int mraa_set_line_values(int line_handle, unsigned int num_lines, unsigned char input_values[]);
 int mraa_get_line_values(int line_handle, unsigned int num_lines, unsigned char output_values[]);
 
@@ -47,6 +53,8 @@ mraa_boolean_t mraa_is_gpio_line_open_drain(mraa_gpiod_line_info *linfo);
 mraa_boolean_t mraa_is_gpio_line_open_source(mraa_gpiod_line_info *linfo);
 
 int mraa_get_number_of_gpio_chips();
+mraa_boolean_t mraa_is_gpio_chip_v2_compatible(int chip_fd);
+mraa_boolean_t mraa_is_gpio_chardev_v2_compatible();
 int mraa_get_chip_infos(mraa_gpiod_chip_info*** cinfos);
 
 /* Multiple gpio support. */
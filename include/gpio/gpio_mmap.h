@@ -0,0 +1,110 @@
+/*
+ * Copyright (c) 2026 Intel Corporation.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "mraa_internal.h"
+
+#include <stdint.h>
+
+/**
+ * Memory mapped gpio driven by the register description in mraa_mmap_pin_t,
+ * for platforms without a gpio_mmap_setup hook of their own. Mappings of the
+ * same (mem_dev, mem_offset, mem_sz) are shared by every context. Only value
+ * access goes through the registers, direction is still set by sysfs/chardev.
+ */
+typedef struct _mraa_mmap_region* mraa_mmap_region_t;
+
+/**
+ * Register description of the pin behind a single pin context
+ *
+ * @param dev The Gpio context
+ * @return Description, NULL if the pin has none
+ */
+mraa_mmap_pin_t* mraa_gpio_mmap_pin(mraa_gpio_context dev);
+
+/**
+ * Map the pin's registers and route mraa_gpio_read/write() through them, or
+ * undo it and drop the mapping once its last user is gone
+ *
+ * @param dev The Gpio context
+ * @param en 1 to enable, 0 to disable
+ * @return Result of operation
+ */
+mraa_result_t mraa_gpio_mmap_setup(mraa_gpio_context dev, mraa_boolean_t en);
+
+mraa_result_t mraa_gpio_mmap_write(mraa_gpio_context dev, int value);
+int mraa_gpio_mmap_read(mraa_gpio_context dev);
+
+/**
+ * Drive several pins of one bank. With separate set and clear registers each
+ * mask is a single store, so all pins change together. A plain data register
+ * is updated read-modify-write under the region's lock.
+ *
+ * @param region Mapping the registers belong to
+ * @param set Set register of the bank
+ * @param clr Clear register of the bank, equal to set for a data register
+ * @param set_mask Bits to drive high
+ * @param clr_mask Bits to drive low
+ */
+void mraa_gpio_mmap_write_bank(mraa_mmap_region_t region,
+                               volatile uint32_t* set,
+                               volatile uint32_t* clr,
+                               uint32_t set_mask,
+                               uint32_t clr_mask);
+
+/**
+ * Group the pins of a multi pin context by bank, so that
+ * mraa_gpio_write_multi() and mraa_gpio_write_mask() cost one store per set
+ * and clear register and mraa_gpio_read_multi() one load per bank. Every pin
+ * needs a register description.
+ *
+ * @param dev The Gpio context returned by mraa_gpio_init_multi()
+ * @param en 1 to enable, 0 to disable
+ * @return Result of operation
+ */
+mraa_result_t mraa_gpio_mmap_setup_multi(mraa_gpio_context dev, mraa_boolean_t en);
+
+mraa_result_t mraa_gpio_mmap_write_multi(mraa_gpio_context dev, int input_values[]);
+mraa_result_t mraa_gpio_mmap_write_mask(mraa_gpio_context dev, uint64_t values, uint64_t mask);
+mraa_result_t mraa_gpio_mmap_read_multi(mraa_gpio_context dev, int output_values[]);
+
+/**
+ * Number of banks of a multi pin context, 0 when mmap isn't enabled on it
+ */
+unsigned int mraa_gpio_mmap_num_banks(mraa_gpio_context dev);
+
+/**
+ * Precompute the per bank masks of a masked write, for replay with
+ * mraa_gpio_mmap_store_masks()
+ *
+ * @param dev The Gpio context, with mmap banks
+ * @param values Bitmask of the values to write
+ * @param mask Bitmask of the pins to change
+ * @param set_masks Receives one set mask per bank
+ * @param clr_masks Receives one clear mask per bank
+ */
+void mraa_gpio_mmap_compile_mask(mraa_gpio_context dev,
+                                 uint64_t values,
+                                 uint64_t mask,
+                                 uint32_t set_masks[],
+                                 uint32_t clr_masks[]);
+
+/**
+ * Levels of all pins of a context with mmap banks, bit n for the n-th pin of
+ * the init array, one load per bank
+ */
+uint64_t mraa_gpio_mmap_read_mask(mraa_gpio_context dev);
+
+void mraa_gpio_mmap_store_masks(mraa_gpio_context dev, const uint32_t set_masks[], const uint32_t clr_masks[]);
+
+#ifdef __cplusplus
+}
+#endif
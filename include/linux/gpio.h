@@ -78,4 +78,90 @@ struct gpioevent_data {
 #define GPIO_GET_LINEHANDLE_IOCTL _IOWR(0xB4, 0x03, struct gpiohandle_request)
 #define GPIO_GET_LINEEVENT_IOCTL _IOWR(0xB4, 0x04, struct gpioevent_request)
 
+/* GPIO v2 character device ABI (Linux 5.10+) */
+#define GPIO_V2_LINES_MAX 64
+#define GPIO_V2_LINE_NUM_ATTRS_MAX 10
+
+#define GPIO_V2_LINE_FLAG_USED                  (1ULL << 0)
+#define GPIO_V2_LINE_FLAG_ACTIVE_LOW            (1ULL << 1)
+#define GPIO_V2_LINE_FLAG_INPUT                 (1ULL << 2)
+#define GPIO_V2_LINE_FLAG_OUTPUT                (1ULL << 3)
+#define GPIO_V2_LINE_FLAG_EDGE_RISING           (1ULL << 4)
+#define GPIO_V2_LINE_FLAG_EDGE_FALLING          (1ULL << 5)
+#define GPIO_V2_LINE_FLAG_OPEN_DRAIN            (1ULL << 6)
+#define GPIO_V2_LINE_FLAG_OPEN_SOURCE           (1ULL << 7)
+#define GPIO_V2_LINE_FLAG_BIAS_PULL_UP          (1ULL << 8)
+#define GPIO_V2_LINE_FLAG_BIAS_PULL_DOWN        (1ULL << 9)
+#define GPIO_V2_LINE_FLAG_BIAS_DISABLED         (1ULL << 10)
+#define GPIO_V2_LINE_FLAG_EVENT_CLOCK_REALTIME  (1ULL << 11)
+
+struct gpio_v2_line_values {
+    __aligned_u64 bits;
+    __aligned_u64 mask;
+};
+
+#define GPIO_V2_LINE_ATTR_ID_FLAGS          1
+#define GPIO_V2_LINE_ATTR_ID_OUTPUT_VALUES  2
+#define GPIO_V2_LINE_ATTR_ID_DEBOUNCE       3
+
+struct gpio_v2_line_attribute {
+    __u32 id;
+    __u32 padding;
+    union {
+        __aligned_u64 flags;
+        __aligned_u64 values;
+        __u32 debounce_period_us;
+    };
+};
+
+struct gpio_v2_line_config_attribute {
+    struct gpio_v2_line_attribute attr;
+    __aligned_u64 mask;
+};
+
+struct gpio_v2_line_config {
+    __aligned_u64 flags;
+    __u32 num_attrs;
+    __u32 padding[5];
+    struct gpio_v2_line_config_attribute attrs[GPIO_V2_LINE_NUM_ATTRS_MAX];
+};
+
+struct gpio_v2_line_request {
+    __u32 offsets[GPIO_V2_LINES_MAX];
+    char consumer[32];
+    struct gpio_v2_line_config config;
+    __u32 num_lines;
+    __u32 event_buffer_size;
+    __u32 padding[5];
+    __s32 fd;
+};
+
+struct gpio_v2_line_info {
+    char name[32];
+    char consumer[32];
+    __u32 offset;
+    __u32 num_attrs;
+    __aligned_u64 flags;
+    struct gpio_v2_line_attribute attrs[GPIO_V2_LINE_NUM_ATTRS_MAX];
+    __u32 padding[4];
+};
+
+#define GPIO_V2_LINE_EVENT_RISING_EDGE  1
+#define GPIO_V2_LINE_EVENT_FALLING_EDGE 2
+
+struct gpio_v2_line_event {
+    __aligned_u64 timestamp_ns;
+    __u32 id;
+    __u32 offset;
+    __u32 seqno;
+    __u32 line_seqno;
+    __u32 padding[6];
+};
+
+#define GPIO_V2_GET_LINEINFO_IOCTL _IOWR(0xB4, 0x05, struct gpio_v2_line_info)
+#define GPIO_V2_GET_LINE_IOCTL _IOWR(0xB4, 0x07, struct gpio_v2_line_request)
+#define GPIO_V2_LINE_SET_CONFIG_IOCTL _IOWR(0xB4, 0x0D, struct gpio_v2_line_config)
+#define GPIO_V2_LINE_GET_VALUES_IOCTL _IOWR(0xB4, 0x0E, struct gpio_v2_line_values)
+#define GPIO_V2_LINE_SET_VALUES_IOCTL _IOWR(0xB4, 0x0F, struct gpio_v2_line_values)
+
 #endif /* _GPIO_H_ */
@@ -59,6 +59,9 @@ mraa_mock_i2c_write_byte_data_replace(mraa_i2c_context dev, const uint8_t data,
 mraa_result_t
 mraa_mock_i2c_write_word_data_replace(mraa_i2c_context dev, const uint16_t data, const uint8_t command);
 
+mraa_result_t
+mraa_mock_i2c_txn_submit_replace(mraa_i2c_context dev, mraa_i2c_txn_t txn);
+
 #ifdef __cplusplus
 }
 #endif
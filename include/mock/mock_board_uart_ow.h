@@ -0,0 +1,75 @@
+/*
+ * Copyright (c) 2026 Intel Corporation.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "mraa_internal.h"
+
+/*
+ * A 1-Wire bus wired to the mock UART the way uart_ow expects: every byte
+ * written comes back as an echo, shaped by the simulated devices. The bus
+ * takes over the UART once a reset pulse (0xf0 at 9600 baud) is written,
+ * until the UART is initialised again. Devices on it:
+ *
+ *   28 01 00 00 00 00 00 crc  DS18B20, 25.0625 C
+ *   28 02 00 00 00 00 00 crc  DS18B20, 21.5 C, in alarm
+ *   28 03 00 00 00 00 00 crc  DS18B20, -10.125 C
+ *   01 04 00 00 00 00 00 crc  DS2401 serial number
+ */
+
+// Devices on the simulated bus
+#define MOCK_UART_OW_DEVICES 4
+
+/**
+ * Put the bus back to its power-on state, detached from the UART
+ */
+void mraa_mock_uart_ow_init();
+
+/**
+ * Follow a baud rate change, which also drops the echoes not read yet
+ *
+ * @param baud New baud rate
+ */
+void mraa_mock_uart_ow_set_baudrate(unsigned int baud);
+
+/**
+ * Whether the bus has taken over the UART
+ *
+ * @return 1 once a reset pulse was seen
+ */
+mraa_boolean_t mraa_mock_uart_ow_active();
+
+/**
+ * Run the time slots of written bytes and queue their echoes
+ *
+ * @param buf Bytes written to the UART
+ * @param len Number of bytes
+ */
+void mraa_mock_uart_ow_write(const uint8_t* buf, size_t len);
+
+/**
+ * Take queued echoes
+ *
+ * @param buf Receives the echoes
+ * @param len Size of buf
+ * @return Number of echoes taken
+ */
+int mraa_mock_uart_ow_read(uint8_t* buf, size_t len);
+
+/**
+ * Whether echoes are queued
+ *
+ * @return 1 if a read would return bytes
+ */
+mraa_boolean_t mraa_mock_uart_ow_available();
+
+#ifdef __cplusplus
+}
+#endif
@@ -62,6 +62,14 @@ mraa_platform_t mraa_mips_platform();
  */
 mraa_platform_t mraa_mock_platform();
 
+/**
+ * add a second mock board as the subplatform of board
+ *
+ * @param board the main board
+ * @return mraa_platform_t of the subplatform, MRAA_NULL_PLATFORM on failure
+ */
+mraa_platform_t mraa_mock_subplatform(mraa_board_t* board);
+
 /**
  * runtime detect iio subsystem
  *
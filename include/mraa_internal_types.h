@@ -67,6 +67,14 @@
 #define IO_KEY "layout"
 #define PLATFORM_KEY "platform"
 #define BUS_KEY "bus"
+#define MMAP_KEY "mmap"
+#define MMAP_DEV_KEY "dev"
+#define MMAP_OFFSET_KEY "offset"
+#define MMAP_SIZE_KEY "size"
+#define MMAP_SET_KEY "set"
+#define MMAP_CLEAR_KEY "clear"
+#define MMAP_LEVEL_KEY "level"
+#define MMAP_BIT_KEY "bit"
 
 // IO keys
 #define AIO_KEY "a"
@@ -104,6 +112,8 @@ struct _gpio_group {
     unsigned char *rw_values;
     /* Reverse mapping to original pin number indexes. */
     unsigned int *gpio_group_to_pins_table;
+    /* Bitmask of the original pin indexes (first 64) served by this group. */
+    uint64_t pin_mask;
 
     unsigned int flags;
 
@@ -111,14 +121,28 @@ struct _gpio_group {
     int *event_handles;
 };
 
+/**
+ * Single producer (isr thread), single consumer ring of gpio edge events.
+ */
+typedef struct {
+    mraa_gpio_edge_event* records; /**< storage, size entries */
+    unsigned int size; /**< number of entries, a power of two */
+    unsigned int head; /**< next slot written by the isr thread */
+    unsigned int tail; /**< next slot consumed by mraa_gpio_events_read() */
+    unsigned int overflow; /**< events dropped because the ring was full */
+    unsigned int *line_seqno; /**< per pin event count when the kernel provides no seqno */
+} mraa_gpio_event_ring_t;
+
 /**
  * A structure representing a gpio pin.
  */
 struct _gpio {
     /*@{*/
     int pin; /**< the pin number, as known to the os. */
-    int phy_pin; /**< pin passed to clean init. -1 none and raw*/
+    int phy_pin; /**< pin passed to clean init. -1 none and raw, or a line found by name*/
     int value_fp; /**< the file pointer to the value of the gpio */
+    int sysfs_dir; /**< direction last written to sysfs, -1 if unknown */
+    int sysfs_edge; /**< edge mode last written to sysfs, -1 if unknown */
     void (* isr)(void *); /**< the interrupt service request */
     void *isr_args; /**< args return when interrupt service request triggered */
     pthread_t thread_id; /**< the isr handler thread id */
@@ -127,9 +151,19 @@ struct _gpio {
     int isr_control_pipe[2]; /**< a pipe used to interrupt the isr from polling the value fd*/
 #endif
     mraa_boolean_t isr_thread_terminating; /**< is the isr thread being terminated? */
+    struct _mraa_event_source *isr_source; /**< registration with the shared event loop, instead of thread_id */
+    int isr_epoll_fd; /**< epoll set of the isr fds, registered with the shared event loop */
+    int *isr_fds; /**< fds watched for the isr through the shared event loop */
+    int isr_num_fds;
     mraa_boolean_t owner; /**< If this context originally exported the pin */
     mraa_result_t (*mmap_write) (mraa_gpio_context dev, int value);
     int (*mmap_read) (mraa_gpio_context dev);
+    struct _mraa_mmap_region *mmap_region; /**< mapping held by the generic mmap engine */
+    volatile uint32_t *mmap_set; /**< set register of the pin's bank */
+    volatile uint32_t *mmap_clr; /**< clear register of the pin's bank */
+    volatile uint32_t *mmap_lev; /**< level register of the pin's bank */
+    uint32_t mmap_mask; /**< the pin's bit in its bank */
+    struct _mraa_gpio_mmap_banks *mmap_banks; /**< multi pin contexts: pins grouped by mmap bank */
     mraa_adv_func_t* advance_func; /**< override function table */
 #if defined(MOCKPLAT)
     mraa_gpio_dir_t mock_dir; /**< mock direction of the pin */
@@ -146,6 +180,8 @@ struct _gpio {
     unsigned int num_pins;
     mraa_gpio_events_t events;
     int *provided_pins;
+    unsigned int debounce_us; /**< kernel debounce period requested with edge detection (chardev v2) */
+    mraa_gpio_event_ring_t *event_ring; /**< every edge seen by the isr thread */
 
     struct _gpio *next;
 };
@@ -162,6 +198,28 @@ struct _gpio {
         idx < num_chips && (cinfo = cinfos[idx]); \
         (idx++))
 
+/**
+ * Shadow of the 8-bit registers of one slave
+ */
+typedef struct {
+    /*@{*/
+    uint8_t value[256]; /**< last value read or written */
+    uint32_t valid[8]; /**< bitmap of registers with a value */
+    uint32_t uncached[8]; /**< bitmap of volatile registers, always read from the bus */
+    /*@}*/
+} mraa_i2c_cache_page_t;
+
+/**
+ * Register shadow of an i2c context, one page per slave address in use
+ */
+struct _i2c_cache {
+    /*@{*/
+    mraa_i2c_cache_page_t* pages[128]; /**< allocated on first use of an address */
+    uint64_t hits; /**< reads served from the shadow */
+    uint64_t misses; /**< reads that had to go to the bus */
+    /*@}*/
+};
+
 /**
  * A structure representing a I2C bus
  */
@@ -173,6 +231,8 @@ struct _i2c {
     unsigned long funcs; /**< /dev/i2c-* device capabilities as per https://www.kernel.org/doc/Documentation/i2c/functionality */
     void *handle; /**< generic handle for non-standard drivers that don't use file descriptors  */
     mraa_adv_func_t* advance_func; /**< override function table */
+    struct _i2c_cache* cache; /**< register shadow, NULL unless enabled */
+    struct _mraa_bus* bus; /**< arbiter shared by every context on the bus */
 #if defined(MOCKPLAT)
     uint8_t mock_dev_addr; /**< address of the mock I2C device */
     uint8_t mock_dev_data_len; /**< mock device data register block length in bytes */
@@ -185,6 +245,35 @@ struct _i2c {
 #endif
 };
 
+/**
+ * A single message of an i2c transaction
+ */
+typedef struct {
+    /*@{*/
+    uint8_t addr; /**< 7-bit address of the slave */
+    mraa_boolean_t read; /**< read into data rather than write from it */
+    mraa_boolean_t joined; /**< no stop before the next message, which must not be split off */
+    int len; /**< length of data in bytes */
+    size_t offset; /**< start of the write data in the transaction's pool */
+    uint8_t* data; /**< caller's buffer for reads, resolved into the pool for writes on submit */
+    /*@}*/
+} mraa_i2c_txn_msg_t;
+
+/**
+ * An i2c transaction, the messages are issued in order by one submit
+ */
+struct _i2c_txn {
+    /*@{*/
+    mraa_i2c_context dev; /**< bus the transaction is submitted on */
+    mraa_i2c_txn_msg_t* msgs; /**< queued messages */
+    unsigned int num_msgs; /**< number of queued messages */
+    unsigned int max_msgs; /**< allocated length of msgs */
+    uint8_t* pool; /**< copies of the write data */
+    size_t pool_len; /**< bytes used in pool */
+    size_t pool_size; /**< allocated length of pool */
+    /*@}*/
+};
+
 /**
  * A structure representing the SPI device
  */
@@ -196,6 +285,17 @@ struct _spi {
     mraa_boolean_t lsb; /**< least significant bit mode */
     unsigned int bpw;   /**< Bits per word */
     mraa_adv_func_t* advance_func; /**< override function table */
+    struct _mraa_bus* bus; /**< arbiter shared by every context on the bus */
+    uint8_t* rx_pool; /**< receive buffers of the pooled writes, NULL unless set up */
+    unsigned int rx_pool_count; /**< number of buffers in rx_pool */
+    int rx_pool_size; /**< bytes per buffer */
+    unsigned int rx_pool_next; /**< buffer the next pooled write receives into */
+    int bufsiz; /**< most bytes spidev moves either way per ioctl, 0 if not spidev */
+    int chunk; /**< longest single transfer, longer ones are split */
+    mraa_boolean_t soft_lsb; /**< LSB first done by reversing bits in software */
+    mraa_boolean_t soft_word; /**< 16 bit words sent as byte pairs by software */
+    uint8_t* soft_buf; /**< scratch holding the transmit data of software modes */
+    int soft_size; /**< bytes allocated for soft_buf */
     /*@}*/
 #ifdef PERIPHERALMAN
     ASpiDevice *bspi;
@@ -240,6 +340,9 @@ struct _uart {
     const char* path; /**< the uart device path. */
     int fd; /**< file descriptor for device. */
     mraa_adv_func_t* advance_func; /**< override function table */
+    struct _mraa_uart_rx* rx; /**< background receiver, NULL unless started */
+    struct _mraa_uart_tx* tx; /**< transmit queue, NULL unless started */
+    struct _uart_group* group; /**< group watching the port, NULL if none */
     /*@}*/
 #if defined(PERIPHERALMAN)
     struct AUartDevice *buart;
@@ -260,6 +363,7 @@ struct _iio {
     void (* isr_event)(struct iio_event_data* data, void* args); /**< the event interrupt service request */
     int chan_num;
     pthread_t thread_id; /**< the isr handler thread id */
+    struct _mraa_event_source *event_source; /**< registration with the shared event loop, instead of thread_id */
     mraa_iio_channel* channels;
     int event_num;
     mraa_iio_event* events;
@@ -354,6 +458,12 @@ typedef struct {
     unsigned int mem_sz; /** Size of memory to map */
     unsigned int bit_pos; /** Position of value bit */
     mraa_pin_t gpio; /** GPio context containing none mmap info */
+    /* Register description used by the generic engine, see gpio/gpio_mmap.h */
+    mraa_boolean_t regs; /**< set/clr/lev_reg are valid, no platform hook needed */
+    uint64_t mem_offset; /**< Offset of the register block in mem_dev, page aligned */
+    unsigned int set_reg; /**< Write 1 to set register, relative to mem_offset */
+    unsigned int clr_reg; /**< Write 1 to clear register, same as set_reg for a plain data register */
+    unsigned int lev_reg; /**< Level register */
     /*@}*/
 } mraa_mmap_pin_t;
 
@@ -488,6 +598,7 @@ typedef struct _board_t {
     mraa_adv_func_t* adv_func;    /**< Pointer to advanced function disptach table */
     struct _board_t* sub_platform;     /**< Pointer to sub platform */
     mraa_boolean_t chardev_capable;  /**< Decide what interface is being used: old sysfs or new char device*/
+    mraa_boolean_t chardev_v2; /**< Kernel speaks the GPIO_V2_* char device ABI */
     mraa_led_dev_t led_dev[MAX_LED_COUNT]; /**< Array of LED devices */
     unsigned int led_dev_count; /**< Total onboard LED device count */
     /*@}*/
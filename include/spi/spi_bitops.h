@@ -0,0 +1,47 @@
+/*
+ * Copyright (c) 2026 Intel Corporation.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * Reverse the bit order of every byte, for LSB first transfers on
+ * controllers without SPI_LSB_FIRST. Uses SSE2 or NEON where the build
+ * targets them. dst may be src.
+ *
+ * @param dst Receives the reversed bytes
+ * @param src Bytes to reverse
+ * @param length Number of bytes
+ */
+void mraa_spi_bitrev(uint8_t* dst, const uint8_t* src, size_t length);
+
+/**
+ * Swap the bytes of every 16 bit word, in place. A trailing odd byte is
+ * left alone.
+ *
+ * @param buf Words to swap
+ * @param length Number of bytes
+ */
+void mraa_spi_swap16(uint8_t* buf, size_t length);
+
+/**
+ * Reverse the bytes of every 32 bit word, in place. Trailing bytes short of
+ * a word are left alone.
+ *
+ * @param buf Words to swap
+ * @param length Number of bytes
+ */
+void mraa_spi_swap32(uint8_t* buf, size_t length);
+
+#ifdef __cplusplus
+}
+#endif
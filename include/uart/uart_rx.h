@@ -0,0 +1,36 @@
+/*
+ * Copyright (c) 2026 Intel Corporation.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "mraa_internal.h"
+
+/**
+ * Raw read from the ring of a running background receiver, never blocks
+ *
+ * @param dev uart context with a receiver
+ * @param buf Receives the bytes
+ * @param length Size of buf
+ * @return Bytes read, -1 if the receiver hands frames to a callback
+ */
+int mraa_uart_rx_read(mraa_uart_context dev, char* buf, size_t length);
+
+/**
+ * Wait for bytes in the ring of a running background receiver
+ *
+ * @param dev uart context with a receiver
+ * @param millis Milliseconds to wait, 0 to return immediately
+ * @return 1 if bytes are buffered
+ */
+mraa_boolean_t mraa_uart_rx_available(mraa_uart_context dev, unsigned int millis);
+
+#ifdef __cplusplus
+}
+#endif
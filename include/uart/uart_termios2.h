@@ -0,0 +1,36 @@
+/*
+ * Copyright (c) 2026 Intel Corporation.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "mraa_internal.h"
+
+/**
+ * Set an arbitrary baudrate through TCSETSF2 and BOTHER. Kept apart from
+ * uart.c as the kernel termios headers clash with the libc ones.
+ *
+ * @param fd Open tty
+ * @param baud Baudrate in bits per second
+ * @return Result of operation
+ */
+mraa_result_t mraa_uart_termios2_set_baud(int fd, unsigned int baud);
+
+/**
+ * Read the output baudrate through TCGETS2, which also knows rates set
+ * with BOTHER
+ *
+ * @param fd Open tty
+ * @return Baudrate in bits per second, 0 on failure
+ */
+unsigned int mraa_uart_termios2_get_baud(int fd);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,39 @@
+/*
+ * Copyright (c) 2026 Intel Corporation.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "mraa_internal.h"
+
+/**
+ * Wait until everything queued on a running transmit queue has been
+ * handed to the driver
+ *
+ * @param dev uart context with a transmit queue
+ * @return Result of operation, MRAA_ERROR_INVALID_RESOURCE if the queue
+ * was stopped first
+ */
+mraa_result_t mraa_uart_tx_wait_idle(mraa_uart_context dev);
+
+/**
+ * mraa_uart_write() on a running transmit queue. Queues a copy behind what
+ * is already queued, waiting for room unless the port is non-blocking.
+ *
+ * @param dev uart context with a transmit queue
+ * @param buf Bytes to write
+ * @param length Number of bytes
+ * @return length once queued, -1 with errno EAGAIN if the queue is full
+ * and the port non-blocking
+ */
+int mraa_uart_tx_write(mraa_uart_context dev, const char* buf, size_t length);
+
+#ifdef __cplusplus
+}
+#endif
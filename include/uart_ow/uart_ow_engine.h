@@ -0,0 +1,40 @@
+/*
+ * Copyright (c) 2026 Intel Corporation.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "mraa_internal.h"
+#include "uart_ow.h"
+
+/**
+ * Send tx and receive into rx LSB first, the time slots of up to 32 bytes
+ * in one uart write. Read by sending 0xff.
+ *
+ * @param dev uart_ow context
+ * @param tx Bytes to send
+ * @param rx Receives the bytes on the bus, can be NULL
+ * @param len Number of bytes
+ * @return Result of operation
+ */
+mraa_result_t mraa_uart_ow_touch_bytes(mraa_uart_ow_context dev, const uint8_t* tx, uint8_t* rx, size_t len);
+
+/**
+ * One pass of the 1-wire search algorithm, starting with a reset and
+ * continuing from the search state in dev
+ *
+ * @param dev uart_ow context
+ * @param command MRAA_UART_OW_CMD_SEARCH_ROM or MRAA_UART_OW_CMD_SEARCH_ROM_ALARM
+ * @return 1 with the rom code in dev->ROM_NO, 0 at the end of the search
+ */
+mraa_boolean_t mraa_uart_ow_search(mraa_uart_ow_context dev, uint8_t command);
+
+#ifdef __cplusplus
+}
+#endif
@@ -43,6 +43,7 @@
 #define PLATFORM_RASPBERRY_PI3_A_PLUS 12
 #define PLATFORM_RASPBERRY_PI4_B 13
 #define MMAP_PATH "/dev/mem"
+#define GPIOMEM_PATH "/dev/gpiomem"
 #define BCM2835_PERI_BASE 0x20000000
 #define BCM2836_PERI_BASE 0x3f000000
 #define BCM2835_BLOCK_SIZE (4 * 1024)
@@ -79,11 +80,6 @@ static volatile unsigned* gpio_reg = NULL;
 static volatile unsigned* pwm_reg = NULL;
 
 
-// GPIO MMAP
-static uint8_t* mmap_reg = NULL;
-static int mmap_fd = 0;
-static int mmap_size;
-static unsigned int mmap_count = 0;
 static int platform_detected = 0;
 static uint32_t peripheral_base = BCM2835_PERI_BASE;
 static uint32_t block_size = BCM2835_BLOCK_SIZE;
@@ -335,96 +331,6 @@ mraa_raspberry_pi_i2c_init_pre(unsigned int bus)
     return MRAA_SUCCESS;
 }
 
-mraa_result_t
-mraa_raspberry_pi_mmap_write(mraa_gpio_context dev, int value)
-{
-    if (value) {
-        *(volatile uint32_t*) (mmap_reg + BCM283X_GPSET0 + (dev->pin / 32) * 4) =
-        (uint32_t)(1 << (dev->pin % 32));
-    } else {
-        *(volatile uint32_t*) (mmap_reg + BCM283X_GPCLR0 + (dev->pin / 32) * 4) =
-        (uint32_t)(1 << (dev->pin % 32));
-    }
-    return MRAA_SUCCESS;
-}
-
-static mraa_result_t
-mraa_raspberry_pi_mmap_unsetup()
-{
-    if (mmap_reg == NULL) {
-        syslog(LOG_ERR, "raspberry mmap: null register cant unsetup");
-        return MRAA_ERROR_INVALID_RESOURCE;
-    }
-    munmap(mmap_reg, mmap_size);
-    mmap_reg = NULL;
-    if (close(mmap_fd) != 0) {
-        return MRAA_ERROR_INVALID_RESOURCE;
-    }
-    return MRAA_SUCCESS;
-}
-
-int
-mraa_raspberry_pi_mmap_read(mraa_gpio_context dev)
-{
-    uint32_t value = *(volatile uint32_t*) (mmap_reg + BCM2835_GPLEV0 + (dev->pin / 32) * 4);
-    if (value & (uint32_t)(1 << (dev->pin % 32))) {
-        return 1;
-    }
-    return 0;
-}
-
-mraa_result_t
-mraa_raspberry_pi_mmap_setup(mraa_gpio_context dev, mraa_boolean_t en)
-{
-    if (dev == NULL) {
-        syslog(LOG_ERR, "raspberry mmap: context not valid");
-        return MRAA_ERROR_INVALID_HANDLE;
-    }
-
-    if (en == 0) {
-        if (dev->mmap_write == NULL && dev->mmap_read == NULL) {
-            syslog(LOG_ERR, "raspberry mmap: can't disable disabled mmap gpio");
-            return MRAA_ERROR_INVALID_PARAMETER;
-        }
-        dev->mmap_write = NULL;
-        dev->mmap_read = NULL;
-        mmap_count--;
-        if (mmap_count == 0) {
-            return mraa_raspberry_pi_mmap_unsetup();
-        }
-        return MRAA_SUCCESS;
-    }
-
-    if (dev->mmap_write != NULL && dev->mmap_read != NULL) {
-        syslog(LOG_ERR, "raspberry mmap: can't enable enabled mmap gpio");
-        return MRAA_ERROR_INVALID_PARAMETER;
-    }
-
-    // Might need to make some elements of this thread safe.
-    // For example only allow one thread to enter the following block
-    // to prevent mmap'ing twice.
-    if (mmap_reg == NULL) {
-        if ((mmap_fd = open(MMAP_PATH, O_RDWR)) < 0) {
-            syslog(LOG_ERR, "raspberry map: unable to open resource0 file");
-            return MRAA_ERROR_INVALID_HANDLE;
-        }
-
-        mmap_reg = (uint8_t*) mmap(NULL, block_size, PROT_READ | PROT_WRITE, MAP_FILE | MAP_SHARED,
-                                   mmap_fd, peripheral_base + GPIO_OFFSET);
-        if (mmap_reg == MAP_FAILED) {
-            syslog(LOG_ERR, "raspberry mmap: failed to mmap");
-            mmap_reg = NULL;
-            close(mmap_fd);
-            return MRAA_ERROR_NO_RESOURCES;
-        }
-    }
-    dev->mmap_write = &mraa_raspberry_pi_mmap_write;
-    dev->mmap_read = &mraa_raspberry_pi_mmap_read;
-    mmap_count++;
-
-    return MRAA_SUCCESS;
-}
-
 mraa_board_t*
 mraa_raspberry_pi()
 {
@@ -642,7 +548,6 @@ mraa_raspberry_pi()
 
     b->adv_func->spi_init_pre = &mraa_raspberry_pi_spi_init_pre;
     b->adv_func->i2c_init_pre = &mraa_raspberry_pi_i2c_init_pre;
-    b->adv_func->gpio_mmap_setup = &mraa_raspberry_pi_mmap_setup;
     b->adv_func->pwm_init_raw_replace = &mraa_raspberry_pi_pwm_initraw_replace;
     b->adv_func->pwm_write_replace = &mraa_raspberry_pi_pwm_write_duty_replace;
     b->adv_func->pwm_period_replace = &mraa_raspberry_pi_pwm_period_us_replace;
@@ -918,10 +823,30 @@ mraa_raspberry_pi()
         b->pins[40].gpio.mux_total = 0;
     }
 
+    // /dev/gpiomem maps just the gpio block and doesn't need root
+    const char* mem_dev = MMAP_PATH;
+    uint64_t mem_offset = peripheral_base + GPIO_OFFSET;
+    if (access(GPIOMEM_PATH, R_OK | W_OK) == 0) {
+        mem_dev = GPIOMEM_PATH;
+        mem_offset = 0;
+    }
+
     b->gpio_count = 0;
     int i;
     for (i = 0; i < b->phy_pin_count; i++) {
         if (b->pins[i].capabilities.gpio) {
+            // Describe the value registers for the generic mmap engine
+            int line = b->pins[i].gpio.pinmap - pin_base;
+            mraa_mmap_pin_t* pin_mmap = &b->pins[i].mmap;
+            strncpy(pin_mmap->mem_dev, mem_dev, sizeof(pin_mmap->mem_dev) - 1);
+            pin_mmap->mem_offset = mem_offset;
+            pin_mmap->mem_sz = block_size;
+            pin_mmap->set_reg = BCM283X_GPSET0 + (line / 32) * 4;
+            pin_mmap->clr_reg = BCM283X_GPCLR0 + (line / 32) * 4;
+            pin_mmap->lev_reg = BCM2835_GPLEV0 + (line / 32) * 4;
+            pin_mmap->bit_pos = line % 32;
+            pin_mmap->regs = 1;
+            b->pins[i].capabilities.fast_gpio = 1;
             b->gpio_count++;
         }
     }
@@ -0,0 +1,288 @@
+/*
+ * Copyright (c) 2026 Intel Corporation.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "bus/bus_arbiter.h"
+#include "mraa_internal.h"
+
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+
+struct _mraa_bus {
+    mraa_bus_type_t type;
+    const void* platform;
+    int busnum;
+    unsigned int refcount;
+    mraa_bus_dispatch_t dispatch;
+    pthread_mutex_t lock; /**< recursive, held by every call on the bus */
+    pthread_t owner; /**< thread holding lock, valid while depth > 0, accessed atomically */
+    unsigned int depth; /**< times owner took lock, accessed atomically */
+    pthread_mutex_t queue_lock; /**< guards the fields below */
+    pthread_cond_t queued; /**< signalled on submit and stop */
+    pthread_cond_t idle; /**< signalled whenever a batch completes */
+    mraa_bus_request_t* head;
+    mraa_bus_request_t* tail;
+    mraa_bus_request_t* running; /**< batch being dispatched */
+    mraa_boolean_t started;
+    mraa_boolean_t quit;
+    mraa_boolean_t orphaned; /**< last reference dropped from the worker, which frees the bus */
+    pthread_t worker;
+    struct _mraa_bus* next;
+};
+
+static pthread_mutex_t buses_lock = PTHREAD_MUTEX_INITIALIZER;
+static mraa_bus_t buses = NULL;
+
+static void
+_mraa_bus_free(mraa_bus_t bus)
+{
+    pthread_mutex_destroy(&bus->lock);
+    pthread_mutex_destroy(&bus->queue_lock);
+    pthread_cond_destroy(&bus->queued);
+    pthread_cond_destroy(&bus->idle);
+    free(bus);
+}
+
+static void*
+_mraa_bus_worker(void* arg)
+{
+    mraa_bus_t bus = (mraa_bus_t) arg;
+
+    pthread_mutex_lock(&bus->queue_lock);
+    for (;;) {
+        while (bus->head == NULL && !bus->quit) {
+            pthread_cond_wait(&bus->queued, &bus->queue_lock);
+        }
+        if (bus->head == NULL) {
+            break;
+        }
+
+        // Take everything queued so far, the dispatcher merges what it can
+        bus->running = bus->head;
+        bus->head = bus->tail = NULL;
+        pthread_mutex_unlock(&bus->queue_lock);
+
+        mraa_bus_lock(bus);
+        bus->dispatch(bus->running);
+        mraa_bus_unlock(bus);
+
+        // Callbacks run without the bus lock so they may submit again
+        for (mraa_bus_request_t* req = bus->running; req != NULL; req = req->next) {
+            if (req->callback != NULL) {
+                req->callback(req->result, req->data);
+            }
+        }
+
+        pthread_mutex_lock(&bus->queue_lock);
+        while (bus->running != NULL) {
+            mraa_bus_request_t* req = bus->running;
+            bus->running = req->next;
+            free(req);
+        }
+        pthread_cond_broadcast(&bus->idle);
+    }
+    pthread_mutex_unlock(&bus->queue_lock);
+
+    if (bus->orphaned) {
+        _mraa_bus_free(bus);
+    }
+
+    return NULL;
+}
+
+mraa_bus_t
+mraa_bus_get(mraa_bus_type_t type, const void* platform, int busnum, mraa_bus_dispatch_t dispatch)
+{
+    mraa_bus_t bus;
+    pthread_mutexattr_t attr;
+
+    pthread_mutex_lock(&buses_lock);
+    for (bus = buses; bus != NULL; bus = bus->next) {
+        if (bus->type == type && bus->platform == platform && bus->busnum == busnum) {
+            bus->refcount++;
+            pthread_mutex_unlock(&buses_lock);
+            return bus;
+        }
+    }
+
+    bus = (mraa_bus_t) calloc(1, sizeof(struct _mraa_bus));
+    if (bus == NULL) {
+        syslog(LOG_CRIT, "bus: Failed to allocate memory for bus %d arbiter", busnum);
+        pthread_mutex_unlock(&buses_lock);
+        return NULL;
+    }
+    bus->type = type;
+    bus->platform = platform;
+    bus->busnum = busnum;
+    bus->refcount = 1;
+    bus->dispatch = dispatch;
+
+    pthread_mutexattr_init(&attr);
+    pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
+    pthread_mutex_init(&bus->lock, &attr);
+    pthread_mutexattr_destroy(&attr);
+    pthread_mutex_init(&bus->queue_lock, NULL);
+    pthread_cond_init(&bus->queued, NULL);
+    pthread_cond_init(&bus->idle, NULL);
+
+    bus->next = buses;
+    buses = bus;
+    pthread_mutex_unlock(&buses_lock);
+
+    return bus;
+}
+
+void
+mraa_bus_put(mraa_bus_t bus)
+{
+    mraa_bus_t* it;
+
+    if (bus == NULL) {
+        return;
+    }
+
+    pthread_mutex_lock(&buses_lock);
+    if (--bus->refcount > 0) {
+        pthread_mutex_unlock(&buses_lock);
+        return;
+    }
+    for (it = &buses; *it != NULL; it = &(*it)->next) {
+        if (*it == bus) {
+            *it = bus->next;
+            break;
+        }
+    }
+    pthread_mutex_unlock(&buses_lock);
+
+    if (bus->started) {
+        pthread_mutex_lock(&bus->queue_lock);
+        bus->quit = 1;
+        pthread_cond_signal(&bus->queued);
+        if (pthread_equal(pthread_self(), bus->worker)) {
+            // Called from a completion callback, the worker cleans up after itself
+            bus->orphaned = 1;
+            pthread_detach(bus->worker);
+            pthread_mutex_unlock(&bus->queue_lock);
+            return;
+        }
+        pthread_mutex_unlock(&bus->queue_lock);
+        pthread_join(bus->worker, NULL);
+    }
+
+    _mraa_bus_free(bus);
+}
+
+mraa_bus_t
+mraa_bus_lock(mraa_bus_t bus)
+{
+    if (bus != NULL) {
+        pthread_mutex_lock(&bus->lock);
+        __atomic_store_n(&bus->owner, pthread_self(), __ATOMIC_RELAXED);
+        __atomic_store_n(&bus->depth, bus->depth + 1, __ATOMIC_RELEASE);
+    }
+    return bus;
+}
+
+void
+mraa_bus_unlock(mraa_bus_t bus)
+{
+    if (bus != NULL) {
+        __atomic_store_n(&bus->depth, bus->depth - 1, __ATOMIC_RELEASE);
+        pthread_mutex_unlock(&bus->lock);
+    }
+}
+
+// Read without the lock. Only the owner ever writes its own id into owner,
+// before its depth, so another thread may see a stale owner but never itself
+static mraa_boolean_t
+_mraa_bus_held(mraa_bus_t bus)
+{
+    return __atomic_load_n(&bus->depth, __ATOMIC_ACQUIRE) > 0 &&
+           pthread_equal(__atomic_load_n(&bus->owner, __ATOMIC_RELAXED), pthread_self());
+}
+
+void
+mraa_bus_scope_unlock(mraa_bus_t* bus)
+{
+    mraa_bus_unlock(*bus);
+}
+
+mraa_result_t
+mraa_bus_submit(mraa_bus_t bus, const mraa_bus_request_t* request)
+{
+    mraa_bus_request_t* req;
+
+    if (bus == NULL) {
+        return MRAA_ERROR_INVALID_RESOURCE;
+    }
+
+    req = (mraa_bus_request_t*) malloc(sizeof(mraa_bus_request_t));
+    if (req == NULL) {
+        syslog(LOG_CRIT, "bus: Failed to allocate memory for request");
+        return MRAA_ERROR_NO_RESOURCES;
+    }
+    *req = *request;
+    req->next = NULL;
+    req->result = MRAA_SUCCESS;
+
+    pthread_mutex_lock(&bus->queue_lock);
+    if (!bus->started) {
+        if (pthread_create(&bus->worker, NULL, _mraa_bus_worker, bus) != 0) {
+            pthread_mutex_unlock(&bus->queue_lock);
+            syslog(LOG_ERR, "bus: Failed to start worker for bus %d", bus->busnum);
+            free(req);
+            return MRAA_ERROR_NO_RESOURCES;
+        }
+        bus->started = 1;
+    }
+    if (bus->tail != NULL) {
+        bus->tail->next = req;
+    } else {
+        bus->head = req;
+    }
+    bus->tail = req;
+    pthread_cond_signal(&bus->queued);
+    pthread_mutex_unlock(&bus->queue_lock);
+
+    return MRAA_SUCCESS;
+}
+
+static mraa_boolean_t
+_mraa_bus_has_dev(const mraa_bus_request_t* req, void* dev)
+{
+    for (; req != NULL; req = req->next) {
+        if (req->dev == dev) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+mraa_result_t
+mraa_bus_flush(mraa_bus_t bus, void* dev)
+{
+    if (bus == NULL) {
+        return MRAA_SUCCESS;
+    }
+
+    // The worker needs the lock to run anything, waiting on it here would
+    // never end. The caller's lock would also outlive the context.
+    if (_mraa_bus_held(bus)) {
+        return MRAA_ERROR_INVALID_RESOURCE;
+    }
+
+    pthread_mutex_lock(&bus->queue_lock);
+    if (bus->started && pthread_equal(pthread_self(), bus->worker)) {
+        pthread_mutex_unlock(&bus->queue_lock);
+        return MRAA_SUCCESS;
+    }
+    while (_mraa_bus_has_dev(bus->head, dev) || _mraa_bus_has_dev(bus->running, dev)) {
+        pthread_cond_wait(&bus->idle, &bus->queue_lock);
+    }
+    pthread_mutex_unlock(&bus->queue_lock);
+
+    return MRAA_SUCCESS;
+}
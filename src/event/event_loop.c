@@ -0,0 +1,329 @@
+/*
+ * Copyright (c) 2026 Intel Corporation.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#define _GNU_SOURCE
+#include "event/event_loop.h"
+#include "mraa_internal.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/epoll.h>
+#include <unistd.h>
+
+#define EVENT_LOOP_MAX_WORKERS 64
+#define EVENT_LOOP_STOP_TOKEN UINT64_MAX
+
+struct _mraa_event_source {
+    int fd; /**< watched file descriptor, owned by the caller */
+    uint32_t events; /**< epoll events, rearmed after every dispatch */
+    mraa_event_handler_t handler;
+    void* data;
+    unsigned int slot; /**< index in the source table */
+    uint32_t generation; /**< tells a stale epoll event from the slot's current source */
+    mraa_boolean_t running; /**< a worker is inside the handler */
+    mraa_boolean_t removed; /**< unregistered, don't rearm */
+    mraa_boolean_t orphaned; /**< removed from its own handler, the worker frees it */
+    pthread_t worker;
+};
+
+static struct {
+    pthread_mutex_t config_lock; /**< serialises mraa_set_event_loop() and mraa_event_loop_stop() */
+    pthread_mutex_t lock;
+    pthread_cond_t idle; /**< signalled whenever a handler returns */
+    int epoll_fd;
+    int stop_pipe[2];
+    pthread_t workers[EVENT_LOOP_MAX_WORKERS];
+    unsigned int num_workers;
+    int cpu;
+    int priority;
+    mraa_event_source_t* sources;
+    unsigned int num_slots;
+    unsigned int num_sources;
+    uint32_t generation;
+} loop = {
+    .config_lock = PTHREAD_MUTEX_INITIALIZER,
+    .lock = PTHREAD_MUTEX_INITIALIZER,
+    .idle = PTHREAD_COND_INITIALIZER,
+    .epoll_fd = -1,
+    .stop_pipe = { -1, -1 },
+};
+
+static uint64_t
+_mraa_event_token(mraa_event_source_t source)
+{
+    return ((uint64_t) source->generation << 32) | source->slot;
+}
+
+static void
+_mraa_event_dispatch(uint64_t token, uint32_t events)
+{
+    unsigned int slot = token & 0xffffffff;
+    mraa_event_source_t source;
+
+    pthread_mutex_lock(&loop.lock);
+    source = (slot < loop.num_slots) ? loop.sources[slot] : NULL;
+    if (source == NULL || source->generation != (uint32_t)(token >> 32) || source->removed) {
+        pthread_mutex_unlock(&loop.lock);
+        return;
+    }
+    source->running = 1;
+    source->worker = pthread_self();
+    pthread_mutex_unlock(&loop.lock);
+
+    source->handler(source->fd, events, source->data);
+
+    pthread_mutex_lock(&loop.lock);
+    source->running = 0;
+    if (source->orphaned) {
+        if (source->slot < loop.num_slots) {
+            loop.sources[source->slot] = NULL;
+        }
+        free(source);
+    } else if (!source->removed) {
+        struct epoll_event ev = { .events = source->events | EPOLLONESHOT, .data.u64 = token };
+        if (epoll_ctl(loop.epoll_fd, EPOLL_CTL_MOD, source->fd, &ev) != 0) {
+            syslog(LOG_ERR, "event_loop: failed to rearm fd %d: %s", source->fd, strerror(errno));
+        }
+    }
+    pthread_cond_broadcast(&loop.idle);
+    pthread_mutex_unlock(&loop.lock);
+}
+
+static void*
+_mraa_event_worker(void* arg)
+{
+    struct epoll_event ev;
+
+    (void) arg;
+
+    if (loop.cpu >= 0) {
+        cpu_set_t cpus;
+        CPU_ZERO(&cpus);
+        CPU_SET(loop.cpu, &cpus);
+        if (pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus) != 0) {
+            syslog(LOG_WARNING, "event_loop: failed to pin worker to cpu %d", loop.cpu);
+        }
+    }
+
+    if (loop.priority > 0 && mraa_set_priority(loop.priority) != 0) {
+        syslog(LOG_WARNING, "event_loop: failed to set worker priority %d", loop.priority);
+    }
+
+    for (;;) {
+        int ret = epoll_wait(loop.epoll_fd, &ev, 1, -1);
+        if (ret < 0 && errno == EINTR) {
+            continue;
+        }
+        if (ret < 0 || ev.data.u64 == EVENT_LOOP_STOP_TOKEN) {
+            return NULL;
+        }
+        if (ret == 1) {
+            _mraa_event_dispatch(ev.data.u64, ev.events);
+        }
+    }
+}
+
+/* Called with config_lock held, workers take loop.lock so it must not be. */
+static void
+_mraa_event_loop_teardown()
+{
+    if (loop.stop_pipe[1] != -1) {
+        /* The stop pipe is level triggered, every worker sees it. */
+        if (write(loop.stop_pipe[1], "x", 1) != 1) {
+            syslog(LOG_ERR, "event_loop: failed to wake workers: %s", strerror(errno));
+        }
+    }
+
+    for (unsigned int i = 0; i < loop.num_workers; ++i) {
+        pthread_join(loop.workers[i], NULL);
+    }
+    loop.num_workers = 0;
+
+    if (loop.epoll_fd != -1) {
+        close(loop.epoll_fd);
+        loop.epoll_fd = -1;
+    }
+    for (int i = 0; i < 2; ++i) {
+        if (loop.stop_pipe[i] != -1) {
+            close(loop.stop_pipe[i]);
+            loop.stop_pipe[i] = -1;
+        }
+    }
+
+    pthread_mutex_lock(&loop.lock);
+    free(loop.sources);
+    loop.sources = NULL;
+    loop.num_slots = 0;
+    pthread_mutex_unlock(&loop.lock);
+}
+
+mraa_result_t
+mraa_set_event_loop(unsigned int num_workers, int cpu, int priority)
+{
+    struct epoll_event ev = { .events = EPOLLIN, .data.u64 = EVENT_LOOP_STOP_TOKEN };
+    mraa_result_t ret = MRAA_SUCCESS;
+
+    if (num_workers > EVENT_LOOP_MAX_WORKERS) {
+        syslog(LOG_ERR, "event_loop: at most %d workers are supported", EVENT_LOOP_MAX_WORKERS);
+        return MRAA_ERROR_INVALID_PARAMETER;
+    }
+
+    pthread_mutex_lock(&loop.config_lock);
+
+    /* Registered callbacks would be left without a dispatcher. */
+    if (loop.num_sources > 0) {
+        syslog(LOG_ERR, "event_loop: can't reconfigure while callbacks are registered");
+        pthread_mutex_unlock(&loop.config_lock);
+        return MRAA_ERROR_INVALID_RESOURCE;
+    }
+
+    _mraa_event_loop_teardown();
+
+    if (num_workers == 0) {
+        pthread_mutex_unlock(&loop.config_lock);
+        return MRAA_SUCCESS;
+    }
+
+    loop.cpu = cpu;
+    loop.priority = priority;
+    loop.epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    if (loop.epoll_fd == -1 || pipe2(loop.stop_pipe, O_CLOEXEC) != 0 ||
+        epoll_ctl(loop.epoll_fd, EPOLL_CTL_ADD, loop.stop_pipe[0], &ev) != 0) {
+        syslog(LOG_ERR, "event_loop: failed to create epoll set: %s", strerror(errno));
+        ret = MRAA_ERROR_NO_RESOURCES;
+        goto event_loop_cleanup;
+    }
+
+    for (unsigned int i = 0; i < num_workers; ++i) {
+        if (pthread_create(&loop.workers[i], NULL, _mraa_event_worker, NULL) != 0) {
+            syslog(LOG_ERR, "event_loop: failed to start worker %u", i);
+            ret = MRAA_ERROR_NO_RESOURCES;
+            goto event_loop_cleanup;
+        }
+        loop.num_workers++;
+    }
+
+event_loop_cleanup:
+    if (ret != MRAA_SUCCESS) {
+        _mraa_event_loop_teardown();
+    }
+    pthread_mutex_unlock(&loop.config_lock);
+
+    return ret;
+}
+
+mraa_boolean_t
+mraa_event_loop_is_active()
+{
+    return loop.num_workers > 0;
+}
+
+mraa_event_source_t
+mraa_event_loop_add(int fd, uint32_t events, mraa_event_handler_t handler, void* data)
+{
+    struct epoll_event ev;
+    unsigned int slot;
+
+    if (fd < 0 || handler == NULL) {
+        return NULL;
+    }
+
+    mraa_event_source_t source = calloc(1, sizeof(struct _mraa_event_source));
+    if (source == NULL) {
+        syslog(LOG_ERR, "event_loop: malloc error");
+        return NULL;
+    }
+
+    pthread_mutex_lock(&loop.lock);
+
+    if (loop.num_workers == 0) {
+        goto event_add_fail;
+    }
+
+    for (slot = 0; slot < loop.num_slots && loop.sources[slot] != NULL; ++slot)
+        ;
+    if (slot == loop.num_slots) {
+        unsigned int num_slots = loop.num_slots ? loop.num_slots * 2 : 16;
+        mraa_event_source_t* sources = realloc(loop.sources, num_slots * sizeof(mraa_event_source_t));
+        if (sources == NULL) {
+            syslog(LOG_ERR, "event_loop: malloc error");
+            goto event_add_fail;
+        }
+        memset(&sources[loop.num_slots], 0, (num_slots - loop.num_slots) * sizeof(mraa_event_source_t));
+        loop.sources = sources;
+        loop.num_slots = num_slots;
+    }
+
+    source->fd = fd;
+    source->events = events;
+    source->handler = handler;
+    source->data = data;
+    source->slot = slot;
+    source->generation = ++loop.generation;
+
+    ev.events = events | EPOLLONESHOT;
+    ev.data.u64 = _mraa_event_token(source);
+    if (epoll_ctl(loop.epoll_fd, EPOLL_CTL_ADD, fd, &ev) != 0) {
+        syslog(LOG_ERR, "event_loop: failed to watch fd %d: %s", fd, strerror(errno));
+        goto event_add_fail;
+    }
+
+    loop.sources[slot] = source;
+    loop.num_sources++;
+    pthread_mutex_unlock(&loop.lock);
+
+    return source;
+
+event_add_fail:
+    pthread_mutex_unlock(&loop.lock);
+    free(source);
+    return NULL;
+}
+
+mraa_result_t
+mraa_event_loop_remove(mraa_event_source_t source)
+{
+    if (source == NULL) {
+        return MRAA_ERROR_INVALID_HANDLE;
+    }
+
+    pthread_mutex_lock(&loop.lock);
+
+    epoll_ctl(loop.epoll_fd, EPOLL_CTL_DEL, source->fd, NULL);
+    source->removed = 1;
+    loop.num_sources--;
+
+    if (source->running && pthread_equal(source->worker, pthread_self())) {
+        source->orphaned = 1;
+        pthread_mutex_unlock(&loop.lock);
+        return MRAA_SUCCESS;
+    }
+
+    while (source->running) {
+        pthread_cond_wait(&loop.idle, &loop.lock);
+    }
+
+    /* The table is gone if mraa_deinit() stopped the loop first. */
+    if (source->slot < loop.num_slots) {
+        loop.sources[source->slot] = NULL;
+    }
+    free(source);
+    pthread_mutex_unlock(&loop.lock);
+
+    return MRAA_SUCCESS;
+}
+
+void
+mraa_event_loop_stop()
+{
+    pthread_mutex_lock(&loop.config_lock);
+    _mraa_event_loop_teardown();
+    pthread_mutex_unlock(&loop.config_lock);
+}
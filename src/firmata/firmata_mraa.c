@@ -331,6 +331,63 @@ mraa_firmata_i2c_write_word_data(mraa_i2c_context dev, const uint16_t data, cons
     return MRAA_ERROR_FEATURE_NOT_IMPLEMENTED;
 }
 
+/*
+ * Every request goes out over the uart before waiting on any reply, so the
+ * round trips to the board overlap. Replies land in i2cmsg by address and
+ * register, reads hitting the same slots within one transaction clash.
+ * Firmata only knows single byte registers, a longer joined write can't get
+ * its repeated start.
+ */
+static mraa_result_t
+mraa_firmata_i2c_txn_submit(mraa_i2c_context dev, mraa_i2c_txn_t txn)
+{
+    mraa_result_t status = MRAA_SUCCESS;
+    int addr = dev->addr;
+    unsigned int i;
+
+    for (i = 0; i < txn->num_msgs; ++i) {
+        if (txn->msgs[i].joined && txn->msgs[i].len != 1) {
+            syslog(LOG_ERR, "firmata: i2c: No repeated start after a %d byte write", txn->msgs[i].len);
+            return MRAA_ERROR_FEATURE_NOT_SUPPORTED;
+        }
+    }
+
+    for (i = 0; i < txn->num_msgs && status == MRAA_SUCCESS; ++i) {
+        mraa_i2c_txn_msg_t* msg = &txn->msgs[i];
+
+        dev->addr = msg->addr;
+        if (msg->joined && msg->len == 1) {
+            status = mraa_firmata_send_i2c_read_reg_req(dev, msg->data[0], txn->msgs[++i].len);
+        } else if (msg->read) {
+            status = mraa_firmata_send_i2c_read_req(dev, msg->len);
+        } else {
+            status = mraa_firmata_i2c_write(dev, msg->data, msg->len);
+        }
+    }
+    dev->addr = addr;
+
+    for (i = 0; i < txn->num_msgs && status == MRAA_SUCCESS; ++i) {
+        mraa_i2c_txn_msg_t* msg = &txn->msgs[i];
+        int reg = 0;
+
+        if (msg->joined && msg->len == 1) {
+            reg = msg->data[0];
+            msg = &txn->msgs[++i];
+        } else if (!msg->read) {
+            continue;
+        }
+        status = mraa_firmata_i2c_wait(msg->addr, reg);
+        if (status == MRAA_SUCCESS) {
+            int x = 0;
+            for (; x < msg->len; x++) {
+                msg->data[x] = (uint8_t) firmata_dev->i2cmsg[msg->addr][reg + x];
+            }
+        }
+    }
+
+    return status;
+}
+
 static mraa_result_t
 mraa_firmata_i2c_stop(mraa_i2c_context dev)
 {
@@ -688,6 +745,7 @@ mraa_firmata_plat_init(const char* uart_dev)
     b->adv_func->i2c_write_byte_replace = &mraa_firmata_i2c_write_byte;
     b->adv_func->i2c_write_byte_data_replace = &mraa_firmata_i2c_write_byte_data;
     b->adv_func->i2c_write_word_data_replace = &mraa_firmata_i2c_write_word_data;
+    b->adv_func->i2c_txn_submit_replace = &mraa_firmata_i2c_txn_submit;
     b->adv_func->i2c_stop_replace = &mraa_firmata_i2c_stop;
 
     return b;
@@ -6,7 +6,9 @@
  * SPDX-License-Identifier: MIT
  */
 #include "gpio.h"
+#include "event/event_loop.h"
 #include "gpio/gpio_chardev.h"
+#include "gpio/gpio_mmap.h"
 #include "linux/gpio.h"
 #include "mraa_internal.h"
 
@@ -18,6 +20,7 @@
 #include <signal.h>
 #include <stdlib.h>
 #include <string.h>
+#include <sys/epoll.h>
 #include <sys/ioctl.h>
 #include <sys/mman.h>
 #include <sys/stat.h>
@@ -28,6 +31,8 @@
 #define MAX_SIZE 64
 #define POLL_TIMEOUT
 #define INIT_WAITING 100
+#define GPIO_EVENT_BATCH 16
+#define GPIO_EVENT_RING_SIZE 1024
 
 static mraa_result_t
 _mraa_gpio_get_valfp(mraa_gpio_context dev)
@@ -100,6 +105,8 @@ mraa_gpio_init_internal(mraa_adv_func_t* func_table, int pin)
 #endif
     dev->isr_thread_terminating = 0;
     dev->phy_pin = -1;
+    dev->sysfs_dir = -1;
+    dev->sysfs_edge = -1;
 
     if ((plat != NULL) && (!plat->chardev_capable)) {
         char bu[MAX_SIZE];
@@ -136,6 +143,8 @@ mraa_gpio_init_internal(mraa_adv_func_t* func_table, int pin)
 
     /* Initialize events array. */
     dev->events = NULL;
+    dev->event_ring = NULL;
+    dev->isr_epoll_fd = -1;
 
 init_internal_cleanup:
     if (status != MRAA_SUCCESS) {
@@ -189,6 +198,8 @@ mraa_gpio_init_by_name(char* name)
 
     /* We are dealing with a single GPIO */
     dev->num_pins = 1;
+    /* A line found by name has no board pin behind it */
+    dev->phy_pin = -1;
 
     gpio_group = calloc(dev->num_chips, sizeof(struct _gpio_group));
     if (gpio_group == NULL) {
@@ -215,6 +226,12 @@ mraa_gpio_init_by_name(char* name)
                     gpio_group[idx].dev_fd = cinfo->chip_fd;
                     gpio_group[idx].is_required = 1;
                     gpio_group[idx].gpiod_handle = -1;
+
+                    if (plat->chardev_v2 && !mraa_is_gpio_chip_v2_compatible(cinfo->chip_fd)) {
+                        syslog(LOG_ERR, "[GPIOD_INTERFACE]: init: gpio chip %d doesn't support the v2 ABI", idx);
+                        mraa_gpio_close(dev);
+                        return NULL;
+                    }
                 }
 
                 /* Map pin to _gpio_group structure. */
@@ -223,6 +240,15 @@ mraa_gpio_init_by_name(char* name)
                 gpio_group[idx].gpio_lines[0] = i;
                 gpio_group[idx].num_gpio_lines++;
 
+                /* The only line of this context maps back to pin index 0. */
+                gpio_group[idx].gpio_group_to_pins_table = calloc(1, sizeof(unsigned int));
+                if (gpio_group[idx].gpio_group_to_pins_table == NULL) {
+                    syslog(LOG_CRIT, "[GPIOD_INTERFACE]: Failed to allocate memory for internal member");
+                    mraa_gpio_close(dev);
+                    return NULL;
+                }
+                gpio_group[idx].pin_mask = 1;
+
                 line_found = 1;
                 line_offset = i;
 
@@ -259,6 +285,8 @@ mraa_gpio_init_by_name(char* name)
     memcpy(dev->provided_pins, &line_offset, dev->num_pins * sizeof(int));
 
     dev->events = NULL;
+    dev->event_ring = NULL;
+    dev->isr_epoll_fd = -1;
 
     return dev;
 }
@@ -429,6 +457,12 @@ mraa_gpio_chardev_init(int pins[], int num_pins)
             gpio_group[chip_id].gpiod_handle = -1;
 
             free(cinfo);
+
+            if (plat->chardev_v2 && !mraa_is_gpio_chip_v2_compatible(gpio_group[chip_id].dev_fd)) {
+                syslog(LOG_ERR, "[GPIOD_INTERFACE]: init: gpio chip %d doesn't support the v2 ABI", chip_id);
+                mraa_gpio_close(dev);
+                return NULL;
+            }
         }
 
         int line_in_group;
@@ -479,6 +513,11 @@ mraa_gpio_chardev_init(int pins[], int num_pins)
         int chip = dev->pin_to_gpio_table[i];
         gpio_group[chip].gpio_group_to_pins_table[counters[chip]] = i;
         counters[chip]++;
+
+        /* Lets mraa_gpio_write_mask() skip the groups it doesn't touch. */
+        if (i < 64) {
+            gpio_group[chip].pin_mask |= (uint64_t) 1 << i;
+        }
     }
     free(counters);
 
@@ -494,6 +533,8 @@ mraa_gpio_chardev_init(int pins[], int num_pins)
 
     /* Initialize events array. */
     dev->events = NULL;
+    dev->event_ring = NULL;
+    dev->isr_epoll_fd = -1;
 
     return dev;
 }
@@ -554,6 +595,68 @@ _mraa_gpio_get_timestamp_sysfs()
     return (time.tv_sec * 1e6 + time.tv_usec);
 }
 
+static mraa_result_t
+_mraa_gpio_event_ring_init(mraa_gpio_context dev)
+{
+    mraa_gpio_event_ring_t* ring = calloc(1, sizeof(mraa_gpio_event_ring_t));
+    if (ring == NULL) {
+        return MRAA_ERROR_NO_RESOURCES;
+    }
+
+    ring->size = GPIO_EVENT_RING_SIZE;
+    ring->records = malloc(ring->size * sizeof(mraa_gpio_edge_event));
+    ring->line_seqno = calloc(dev->num_pins, sizeof(unsigned int));
+    if (ring->records == NULL || ring->line_seqno == NULL) {
+        free(ring->records);
+        free(ring->line_seqno);
+        free(ring);
+        return MRAA_ERROR_NO_RESOURCES;
+    }
+
+    dev->event_ring = ring;
+
+    return MRAA_SUCCESS;
+}
+
+static void
+_mraa_gpio_event_ring_free(mraa_gpio_context dev)
+{
+    if (dev->event_ring == NULL) {
+        return;
+    }
+
+    free(dev->event_ring->records);
+    free(dev->event_ring->line_seqno);
+    free(dev->event_ring);
+    dev->event_ring = NULL;
+}
+
+/* Only ever called from the isr thread, which is the ring's sole producer. */
+static void
+_mraa_gpio_event_push(mraa_gpio_context dev, int event_idx, int pin, mraa_timestamp_t timestamp,
+                      mraa_gpio_edge_t edge, unsigned int seqno)
+{
+    mraa_gpio_event_ring_t* ring = dev->event_ring;
+    unsigned int head = ring->head;
+
+    if (seqno == 0) {
+        seqno = ++ring->line_seqno[event_idx];
+    }
+
+    if (head - __atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE) == ring->size) {
+        __atomic_fetch_add(&ring->overflow, 1, __ATOMIC_RELAXED);
+        return;
+    }
+
+    mraa_gpio_edge_event* record = &ring->records[head & (ring->size - 1)];
+    record->pin = pin;
+    record->timestamp = timestamp;
+    record->edge = edge;
+    record->seqno = seqno;
+
+    __atomic_store_n(&ring->head, head + 1, __ATOMIC_RELEASE);
+}
+
 static mraa_result_t
 mraa_gpio_wait_interrupt(int fds[],
                          int num_fds
@@ -562,18 +665,14 @@ mraa_gpio_wait_interrupt(int fds[],
                          int control_fd
 #endif
                          ,
-                         mraa_gpio_events_t events)
+                         mraa_gpio_context dev,
+                         int timeout)
 {
     unsigned char c;
-#ifdef HAVE_PTHREAD_CANCEL
-    struct pollfd pfd[num_fds];
-#else
+    mraa_gpio_events_t events = dev->events;
+    mraa_gpio_context it = dev;
     struct pollfd pfd[num_fds + 1];
-
-    if (control_fd < 0) {
-        return MRAA_ERROR_INVALID_PARAMETER;
-    }
-#endif
+    int num_pfds = num_fds;
 
     if (!fds) {
         return MRAA_ERROR_INVALID_PARAMETER;
@@ -584,29 +683,39 @@ mraa_gpio_wait_interrupt(int fds[],
         // setup poll on POLLPRI
         pfd[i].events = POLLPRI;
 
-        // do an initial read to clear interrupt
-        lseek(fds[i], 0, SEEK_SET);
-        read(fds[i], &c, 1);
+        // do an initial read to clear interrupt, unless the shared event
+        // loop already knows one is pending
+        if (timeout < 0) {
+            lseek(fds[i], 0, SEEK_SET);
+            read(fds[i], &c, 1);
+        }
     }
 
-#ifdef HAVE_PTHREAD_CANCEL
-    // Wait for it forever or until pthread_cancel
-    // poll is a cancelable point like sleep()
-    poll(pfd, num_fds, -1);
-#else
-    // setup poll on the controling fd
-    pfd[num_fds].fd = control_fd;
-    pfd[num_fds].events = 0; //  POLLHUP, POLLERR, and POLLNVAL
+#ifndef HAVE_PTHREAD_CANCEL
+    if (timeout < 0) {
+        if (control_fd < 0) {
+            return MRAA_ERROR_INVALID_PARAMETER;
+        }
 
-    // Wait for it forever or until control fd is closed
-    poll(pfd, num_fds + 1, -1);
+        // setup poll on the controling fd
+        pfd[num_fds].fd = control_fd;
+        pfd[num_fds].events = 0; //  POLLHUP, POLLERR, and POLLNVAL
+        num_pfds++;
+    }
 #endif
 
-    for (int i = 0; i < num_fds; ++i) {
+    // Wait for it forever or until pthread_cancel / the control fd is closed
+    // poll is a cancelable point like sleep()
+    poll(pfd, num_pfds, timeout);
+
+    for (int i = 0; i < num_fds; ++i, it = it->next) {
         if (pfd[i].revents & POLLPRI) {
+            lseek(fds[i], 0, SEEK_SET);
             read(fds[i], &c, 1);
             events[i].id = i;
             events[i].timestamp = _mraa_gpio_get_timestamp_sysfs();
+            /* sysfs doesn't tell which edge fired. */
+            _mraa_gpio_event_push(dev, i, it->phy_pin, events[i].timestamp, MRAA_GPIO_EDGE_NONE, 0);
         } else
             events[i].id = -1;
     }
@@ -615,10 +724,13 @@ mraa_gpio_wait_interrupt(int fds[],
 }
 
 static mraa_result_t
-mraa_gpio_chardev_wait_interrupt(int fds[], int num_fds, mraa_gpio_events_t events)
+mraa_gpio_chardev_wait_interrupt(mraa_gpio_context dev, int fds[], int num_fds, int timeout)
 {
     struct pollfd pfd[num_fds];
-    struct gpioevent_data event_data;
+    struct gpioevent_data event_data[GPIO_EVENT_BATCH];
+    mraa_gpio_events_t events = dev->events;
+    mraa_gpiod_group_t gpio_iter;
+    int idx = 0;
 
     if (!fds) {
         return MRAA_ERROR_INVALID_PARAMETER;
@@ -631,15 +743,103 @@ mraa_gpio_chardev_wait_interrupt(int fds[], int num_fds, mraa_gpio_events_t even
         lseek(fds[i], 0, SEEK_SET);
     }
 
-    poll(pfd, num_fds, -1);
+    poll(pfd, num_fds, timeout);
+
+    /* One fd per line, fds[] was filled in group order. */
+    for_each_gpio_group(gpio_iter, dev)
+    {
+        for (int j = 0; j < gpio_iter->num_gpio_lines; ++j, ++idx) {
+            ssize_t len;
+
+            events[idx].id = -1;
+            if (!(pfd[idx].revents & POLLIN)) {
+                continue;
+            }
+
+            int pin = dev->provided_pins[gpio_iter->gpio_group_to_pins_table[j]];
+
+            /* Drain the non-blocking fd so a burst isn't collapsed into one event. */
+            while ((len = read(fds[idx], event_data, sizeof(event_data))) > 0) {
+                int count = len / sizeof(event_data[0]);
+
+                for (int e = 0; e < count; ++e) {
+                    mraa_gpio_edge_t edge = (event_data[e].id == GPIOEVENT_EVENT_RISING_EDGE) ?
+                                            MRAA_GPIO_EDGE_RISING :
+                                            MRAA_GPIO_EDGE_FALLING;
+                    _mraa_gpio_event_push(dev, idx, pin, event_data[e].timestamp, edge, 0);
+                }
+
+                events[idx].id = idx;
+                events[idx].timestamp = event_data[count - 1].timestamp;
+
+                if (len < (ssize_t) sizeof(event_data)) {
+                    break;
+                }
+            }
+        }
+    }
+
+    return MRAA_SUCCESS;
+}
+
+static mraa_result_t
+mraa_gpio_chardev_v2_wait_interrupt(mraa_gpio_context dev, int fds[], int num_fds, int timeout)
+{
+    struct pollfd pfd[num_fds];
+    struct gpio_v2_line_event event_data[GPIO_EVENT_BATCH];
+    mraa_gpiod_group_t gpio_iter;
+    int group_idx = 0, event_base = 0;
+
+    if (!fds) {
+        return MRAA_ERROR_INVALID_PARAMETER;
+    }
 
     for (int i = 0; i < num_fds; ++i) {
-        if (pfd[i].revents & POLLIN) {
-            read(fds[i], &event_data, sizeof(event_data));
-            events[i].id = i;
-            events[i].timestamp = event_data.timestamp;
-        } else
-            events[i].id = -1;
+        pfd[i].fd = fds[i];
+        pfd[i].events = POLLIN;
+    }
+
+    for (int i = 0; i < dev->num_pins; ++i) {
+        dev->events[i].id = -1;
+    }
+
+    poll(pfd, num_fds, timeout);
+
+    /* One fd per chip, fds[] was filled in group order. */
+    for_each_gpio_group(gpio_iter, dev)
+    {
+        ssize_t len = 0;
+
+        /* Drain the non-blocking fd so a burst isn't collapsed into one event. */
+        while ((pfd[group_idx].revents & POLLIN) &&
+               (len = read(fds[group_idx], event_data, sizeof(event_data))) > 0) {
+            for (int e = 0; e < len / (ssize_t) sizeof(event_data[0]); ++e) {
+                for (int j = 0; j < gpio_iter->num_gpio_lines; ++j) {
+                    if (gpio_iter->gpio_lines[j] == event_data[e].offset) {
+                        mraa_gpio_event* event = &dev->events[event_base + j];
+                        int pin = dev->provided_pins[gpio_iter->gpio_group_to_pins_table[j]];
+                        mraa_gpio_edge_t edge = (event_data[e].id == GPIO_V2_LINE_EVENT_RISING_EDGE) ?
+                                                MRAA_GPIO_EDGE_RISING :
+                                                MRAA_GPIO_EDGE_FALLING;
+
+                        event->id = event_base + j;
+                        event->timestamp = event_data[e].timestamp_ns;
+                        event->seqno = event_data[e].seqno;
+                        event->line_seqno = event_data[e].line_seqno;
+                        _mraa_gpio_event_push(dev, event_base + j, pin, event->timestamp, edge,
+                                              event->line_seqno);
+                        break;
+                    }
+                }
+            }
+
+            if (len < (ssize_t) sizeof(event_data)) {
+                break;
+            }
+        }
+
+        event_base += gpio_iter->num_gpio_lines;
+        group_idx++;
     }
 
     return MRAA_SUCCESS;
@@ -685,29 +885,55 @@ mraa_gpio_get_events(mraa_gpio_context dev)
     return dev->events;
 }
 
-static void*
-mraa_gpio_interrupt_handler(void* arg)
+int
+mraa_gpio_events_read(mraa_gpio_context dev, mraa_gpio_edge_event* events, unsigned int max)
 {
-    if (arg == NULL) {
-        syslog(LOG_ERR, "gpio: interrupt_handler: context is invalid");
-        return NULL;
+    if (dev == NULL || events == NULL) {
+        syslog(LOG_ERR, "gpio: events_read: context is invalid");
+        return -1;
     }
 
-    mraa_result_t ret;
-    mraa_gpio_context dev = (mraa_gpio_context) arg;
-    int idx = 0;
+    mraa_gpio_event_ring_t* ring = dev->event_ring;
+    if (ring == NULL) {
+        return 0;
+    }
 
-    if (IS_FUNC_DEFINED(dev, gpio_interrupt_handler_init_replace)) {
-        if (dev->advance_func->gpio_interrupt_handler_init_replace(dev) != MRAA_SUCCESS)
-            return NULL;
+    unsigned int tail = ring->tail;
+    unsigned int count = __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE) - tail;
+    if (count > max) {
+        count = max;
     }
 
-    int* fps = calloc(dev->num_pins, sizeof(int));
-    if (!fps) {
-        syslog(LOG_ERR, "mraa_gpio_interrupt_handler_multiple() malloc error");
-        return NULL;
+    /* Copy in at most two runs, the second one after the ring wraps. */
+    unsigned int start = tail & (ring->size - 1);
+    unsigned int first = ring->size - start;
+    if (first > count) {
+        first = count;
+    }
+    memcpy(events, &ring->records[start], first * sizeof(mraa_gpio_edge_event));
+    memcpy(events + first, ring->records, (count - first) * sizeof(mraa_gpio_edge_event));
+
+    __atomic_store_n(&ring->tail, tail + count, __ATOMIC_RELEASE);
+
+    return count;
+}
+
+unsigned int
+mraa_gpio_events_overflow(mraa_gpio_context dev)
+{
+    if (dev == NULL || dev->event_ring == NULL) {
+        return 0;
     }
 
+    return __atomic_load_n(&dev->event_ring->overflow, __ATOMIC_RELAXED);
+}
+
+/* Fills fps[] with the fds the isr waits on, returns their number or -1. */
+static int
+mraa_gpio_get_isr_fds(mraa_gpio_context dev, int fps[])
+{
+    int idx = 0;
+
     /* Is this pin on a subplatform? Do nothing... */
     if (mraa_is_sub_platform_id(dev->pin)) {
     }
@@ -717,6 +943,11 @@ mraa_gpio_interrupt_handler(void* arg)
 
         for_each_gpio_group(gpio_group, dev)
         {
+            if (plat->chardev_v2) {
+                fps[idx++] = gpio_group->gpiod_handle;
+                continue;
+            }
+
             for (int i = 0; i < gpio_group->num_gpio_lines; ++i) {
                 fps[idx++] = gpio_group->event_handles[i];
             }
@@ -734,8 +965,10 @@ mraa_gpio_interrupt_handler(void* arg)
             if (fps[idx] < 0) {
                 syslog(LOG_ERR, "gpio%i: interrupt_handler: failed to open 'value' : %s", it->pin,
                        strerror(errno));
-                mraa_gpio_close_event_handles_sysfs(fps, idx);
-                return NULL;
+                while (idx--) {
+                    close(fps[idx]);
+                }
+                return -1;
             }
 
             idx++;
@@ -743,6 +976,70 @@ mraa_gpio_interrupt_handler(void* arg)
         }
     }
 
+    return idx;
+}
+
+static mraa_result_t
+mraa_gpio_wait_events(mraa_gpio_context dev, int fps[], int num_fds, int timeout)
+{
+    if (IS_FUNC_DEFINED(dev, gpio_wait_interrupt_replace)) {
+        return dev->advance_func->gpio_wait_interrupt_replace(dev);
+    }
+
+    if (plat->chardev_v2) {
+        return mraa_gpio_chardev_v2_wait_interrupt(dev, fps, num_fds, timeout);
+    } else if (plat->chardev_capable) {
+        return mraa_gpio_chardev_wait_interrupt(dev, fps, num_fds, timeout);
+    }
+
+    return mraa_gpio_wait_interrupt(fps, num_fds
+#ifndef HAVE_PTHREAD_CANCEL
+                                    ,
+                                    dev->isr_control_pipe[0]
+#endif
+                                    ,
+                                    dev, timeout);
+}
+
+static void
+mraa_gpio_call_isr(mraa_gpio_context dev)
+{
+    if (lang_func->python_isr != NULL) {
+        lang_func->python_isr(dev->isr, dev->isr_args);
+    } else {
+        dev->isr(dev->isr_args);
+    }
+}
+
+static void*
+mraa_gpio_interrupt_handler(void* arg)
+{
+    if (arg == NULL) {
+        syslog(LOG_ERR, "gpio: interrupt_handler: context is invalid");
+        return NULL;
+    }
+
+    mraa_result_t ret;
+    mraa_gpio_context dev = (mraa_gpio_context) arg;
+    int idx;
+
+    if (IS_FUNC_DEFINED(dev, gpio_interrupt_handler_init_replace)) {
+        if (dev->advance_func->gpio_interrupt_handler_init_replace(dev) != MRAA_SUCCESS)
+            return NULL;
+    }
+
+    int* fps = calloc(dev->num_pins, sizeof(int));
+    if (!fps) {
+        syslog(LOG_ERR, "mraa_gpio_interrupt_handler_multiple() malloc error");
+        return NULL;
+    }
+
+    idx = mraa_gpio_get_isr_fds(dev, fps);
+    if (idx < 0) {
+        free(fps);
+        return NULL;
+    }
+
 #ifndef HAVE_PTHREAD_CANCEL
     if (pipe(dev->isr_control_pipe)) {
         syslog(LOG_ERR, "gpio%i: interrupt_handler: failed to create isr control pipe: %s",
@@ -762,31 +1059,13 @@ mraa_gpio_interrupt_handler(void* arg)
     }
 
     for (;;) {
-        if (IS_FUNC_DEFINED(dev, gpio_wait_interrupt_replace)) {
-            ret = dev->advance_func->gpio_wait_interrupt_replace(dev);
-        } else {
-            if (plat->chardev_capable) {
-                ret = mraa_gpio_chardev_wait_interrupt(fps, idx, dev->events);
-            } else {
-                ret = mraa_gpio_wait_interrupt(fps, idx
-#ifndef HAVE_PTHREAD_CANCEL
-                                               ,
-                                               dev->isr_control_pipe[0]
-#endif
-                                               ,
-                                               dev->events);
-            }
-        }
+        ret = mraa_gpio_wait_events(dev, fps, idx, -1);
 
         if (ret == MRAA_SUCCESS && !dev->isr_thread_terminating) {
 #ifdef HAVE_PTHREAD_CANCEL
             pthread_setcancelstate(PTHREAD_CANCEL_DISABLE, NULL);
 #endif
-            if (lang_func->python_isr != NULL) {
-                lang_func->python_isr(dev->isr, dev->isr_args);
-            } else {
-                dev->isr(dev->isr_args);
-            }
+            mraa_gpio_call_isr(dev);
 #ifdef HAVE_PTHREAD_CANCEL
             pthread_setcancelstate(PTHREAD_CANCEL_ENABLE, NULL);
 #endif
@@ -809,6 +1088,110 @@ mraa_gpio_interrupt_handler(void* arg)
     }
 }
 
+static void
+mraa_gpio_event_loop_handler(int fd, uint32_t events, void* data)
+{
+    mraa_gpio_context dev = (mraa_gpio_context) data;
+
+    (void) fd;
+    (void) events;
+
+    /* The loop already saw one of the fds in dev->isr_epoll_fd become ready. */
+    if (mraa_gpio_wait_events(dev, dev->isr_fds, dev->isr_num_fds, 0) != MRAA_SUCCESS ||
+        dev->isr_thread_terminating) {
+        return;
+    }
+
+    /* Attaching a worker that is already attached is a no-op. */
+    if (lang_func->java_attach_thread != NULL && dev->isr == lang_func->java_isr_callback) {
+        if (lang_func->java_attach_thread() != MRAA_SUCCESS) {
+            return;
+        }
+    }
+
+    mraa_gpio_call_isr(dev);
+}
+
+static void
+mraa_gpio_isr_event_loop_stop(mraa_gpio_context dev)
+{
+    if (dev->isr_source != NULL) {
+        mraa_event_loop_remove(dev->isr_source);
+        dev->isr_source = NULL;
+    }
+
+    if (dev->isr_epoll_fd != -1) {
+        close(dev->isr_epoll_fd);
+        dev->isr_epoll_fd = -1;
+    }
+
+    if (dev->isr_fds != NULL) {
+        /* Chardev event handles belong to the gpio groups, only sysfs fds are ours. */
+        if (!plat->chardev_capable) {
+            for (int i = 0; i < dev->isr_num_fds; ++i) {
+                close(dev->isr_fds[i]);
+            }
+        }
+        free(dev->isr_fds);
+        dev->isr_fds = NULL;
+        dev->isr_num_fds = 0;
+    }
+
+    if (lang_func->java_delete_global_ref != NULL && dev->isr == lang_func->java_isr_callback) {
+        lang_func->java_delete_global_ref(dev->isr_args);
+    }
+}
+
+static mraa_result_t
+mraa_gpio_isr_event_loop_start(mraa_gpio_context dev)
+{
+    struct epoll_event ev;
+    unsigned char c;
+
+    dev->isr_fds = calloc(dev->num_pins, sizeof(int));
+    if (!dev->isr_fds) {
+        syslog(LOG_ERR, "mraa_gpio_isr() malloc error");
+        return MRAA_ERROR_NO_RESOURCES;
+    }
+
+    dev->isr_num_fds = mraa_gpio_get_isr_fds(dev, dev->isr_fds);
+    if (dev->isr_num_fds < 0) {
+        dev->isr_num_fds = 0;
+        return MRAA_ERROR_INVALID_RESOURCE;
+    }
+
+    /* One epoll set per context keeps its callbacks serialised on the shared loop. */
+    dev->isr_epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    if (dev->isr_epoll_fd == -1) {
+        syslog(LOG_ERR, "gpio%i: isr: failed to create epoll set: %s", dev->pin, strerror(errno));
+        return MRAA_ERROR_NO_RESOURCES;
+    }
+
+    for (int i = 0; i < dev->isr_num_fds; ++i) {
+        if (plat->chardev_capable) {
+            ev.events = EPOLLIN;
+        } else {
+            // do an initial read to clear interrupt
+            lseek(dev->isr_fds[i], 0, SEEK_SET);
+            read(dev->isr_fds[i], &c, 1);
+            ev.events = EPOLLPRI;
+        }
+        ev.data.fd = dev->isr_fds[i];
+
+        if (epoll_ctl(dev->isr_epoll_fd, EPOLL_CTL_ADD, dev->isr_fds[i], &ev) != 0) {
+            syslog(LOG_ERR, "gpio%i: isr: failed to watch fd: %s", dev->pin, strerror(errno));
+            return MRAA_ERROR_INVALID_RESOURCE;
+        }
+    }
+
+    dev->isr_source = mraa_event_loop_add(dev->isr_epoll_fd, EPOLLIN, mraa_gpio_event_loop_handler, dev);
+    if (dev->isr_source == NULL) {
+        return MRAA_ERROR_NO_RESOURCES;
+    }
+
+    return MRAA_SUCCESS;
+}
+
 mraa_result_t
 mraa_gpio_chardev_edge_mode(mraa_gpio_context dev, mraa_gpio_edge_t mode)
 {
@@ -826,16 +1209,20 @@ mraa_gpio_chardev_edge_mode(mraa_gpio_context dev, mraa_gpio_edge_t mode)
     mraa_gpiod_group_t gpio_group;
 
     struct gpioevent_request req;
+    uint64_t v2_flags = GPIO_V2_LINE_FLAG_INPUT;
 
     switch (mode) {
         case MRAA_GPIO_EDGE_BOTH:
             req.eventflags = GPIOEVENT_REQUEST_BOTH_EDGES;
+            v2_flags |= GPIO_V2_LINE_FLAG_EDGE_RISING | GPIO_V2_LINE_FLAG_EDGE_FALLING;
             break;
         case MRAA_GPIO_EDGE_RISING:
             req.eventflags = GPIOEVENT_REQUEST_RISING_EDGE;
+            v2_flags |= GPIO_V2_LINE_FLAG_EDGE_RISING;
             break;
         case MRAA_GPIO_EDGE_FALLING:
             req.eventflags = GPIOEVENT_REQUEST_FALLING_EDGE;
+            v2_flags |= GPIO_V2_LINE_FLAG_EDGE_FALLING;
             break;
         /* Chardev interface doesn't handle EDGE_NONE. */
         case MRAA_GPIO_EDGE_NONE:
@@ -843,6 +1230,29 @@ mraa_gpio_chardev_edge_mode(mraa_gpio_context dev, mraa_gpio_edge_t mode)
             return MRAA_ERROR_FEATURE_NOT_IMPLEMENTED;
     }
 
+    if (plat->chardev_v2) {
+        /* A single request per chip carries the events of all its lines. */
+        for_each_gpio_group(gpio_group, dev)
+        {
+            if (gpio_group->gpiod_handle != -1) {
+                close(gpio_group->gpiod_handle);
+                gpio_group->gpiod_handle = -1;
+            }
+
+            status = mraa_get_lines_handle_v2(gpio_group->dev_fd, gpio_group->gpio_lines,
+                                              gpio_group->num_gpio_lines, v2_flags, 0, dev->debounce_us);
+            if (status <= 0) {
+                syslog(LOG_ERR, "error getting line event request for chip %i", gpio_group->gpio_chip);
+                return MRAA_ERROR_INVALID_RESOURCE;
+            }
+
+            gpio_group->gpiod_handle = status;
+            fcntl(status, F_SETFL, fcntl(status, F_GETFL) | O_NONBLOCK);
+        }
+
+        return MRAA_SUCCESS;
+    }
+
     for_each_gpio_group(gpio_group, dev)
     {
         if (gpio_group->gpiod_handle != -1) {
@@ -867,6 +1277,7 @@ mraa_gpio_chardev_edge_mode(mraa_gpio_context dev, mraa_gpio_edge_t mode)
             }
 
             gpio_group->event_handles[i] = req.fd;
+            fcntl(req.fd, F_SETFL, fcntl(req.fd, F_GETFL) | O_NONBLOCK);
         }
     }
 
@@ -886,7 +1297,7 @@ mraa_gpio_edge_mode(mraa_gpio_context dev, mraa_gpio_edge_t mode)
 
     /* Initialize events array. */
     if (dev->events == NULL && mode != MRAA_GPIO_EDGE_NONE) {
-        dev->events = malloc(dev->num_pins * sizeof(mraa_gpio_event));
+        dev->events = calloc(dev->num_pins, sizeof(mraa_gpio_event));
         if (dev->events == NULL) {
             syslog(LOG_ERR, "mraa_gpio_edge_mode() malloc error");
             return MRAA_ERROR_NO_RESOURCES;
@@ -897,12 +1308,25 @@ mraa_gpio_edge_mode(mraa_gpio_context dev, mraa_gpio_edge_t mode)
         }
     }
 
+    /* The ring outlives isr_exit() so queued events can still be read. */
+    if (dev->event_ring == NULL && mode != MRAA_GPIO_EDGE_NONE) {
+        if (_mraa_gpio_event_ring_init(dev) != MRAA_SUCCESS) {
+            syslog(LOG_ERR, "mraa_gpio_edge_mode() malloc error");
+            return MRAA_ERROR_NO_RESOURCES;
+        }
+    }
+
     if (plat->chardev_capable)
         return mraa_gpio_chardev_edge_mode(dev, mode);
 
     mraa_gpio_context it = dev;
 
     while (it) {
+        /* Already set through sysfs, skip the open/write/close. */
+        if (it->sysfs_edge == (int) mode) {
+            it = it->next;
+            continue;
+        }
 
         if (it->value_fp != -1) {
             close(it->value_fp);
@@ -941,10 +1365,12 @@ mraa_gpio_edge_mode(mraa_gpio_context dev, mraa_gpio_edge_t mode)
         if (write(edge, bu, length * sizeof(char)) == -1) {
             syslog(LOG_ERR, "gpio%i: edge_mode: Failed to write to 'edge': %s", it->pin, strerror(errno));
             close(edge);
+            it->sysfs_edge = -1;
             return MRAA_ERROR_UNSPECIFIED;
         }
 
         close(edge);
+        it->sysfs_edge = mode;
 
         it = it->next;
     }
@@ -952,6 +1378,24 @@ mraa_gpio_edge_mode(mraa_gpio_context dev, mraa_gpio_edge_t mode)
     return MRAA_SUCCESS;
 }
 
+mraa_result_t
+mraa_gpio_debounce(mraa_gpio_context dev, unsigned int period_us)
+{
+    if (dev == NULL) {
+        syslog(LOG_ERR, "gpio: debounce: context is invalid");
+        return MRAA_ERROR_INVALID_HANDLE;
+    }
+
+    if (!plat->chardev_capable || !plat->chardev_v2) {
+        syslog(LOG_ERR, "gpio: debounce: kernel debounce requires the v2 chardev interface");
+        return MRAA_ERROR_FEATURE_NOT_SUPPORTED;
+    }
+
+    dev->debounce_us = period_us;
+
+    return MRAA_SUCCESS;
+}
+
 mraa_result_t
 mraa_gpio_isr(mraa_gpio_context dev, mraa_gpio_edge_t mode, void (*fptr)(void*), void* args)
 {
@@ -965,7 +1409,7 @@ mraa_gpio_isr(mraa_gpio_context dev, mraa_gpio_edge_t mode, void (*fptr)(void*),
     }
 
     // we only allow one isr per mraa_gpio_context
-    if (dev->thread_id != 0) {
+    if (dev->thread_id != 0 || dev->isr_source != NULL) {
         return MRAA_ERROR_NO_RESOURCES;
     }
 
@@ -990,6 +1434,16 @@ mraa_gpio_isr(mraa_gpio_context dev, mraa_gpio_edge_t mode, void (*fptr)(void*),
 
     dev->isr_args = args;
 
+    if (mraa_event_loop_is_active() && !mraa_is_sub_platform_id(dev->pin) &&
+        !IS_FUNC_DEFINED(dev, gpio_interrupt_handler_init_replace)) {
+        ret = mraa_gpio_isr_event_loop_start(dev);
+        if (ret != MRAA_SUCCESS) {
+            mraa_gpio_isr_event_loop_stop(dev);
+        }
+
+        return ret;
+    }
+
     pthread_create(&dev->thread_id, NULL, mraa_gpio_interrupt_handler, (void*) dev);
 
     return MRAA_SUCCESS;
@@ -1009,12 +1463,17 @@ mraa_gpio_isr_exit(mraa_gpio_context dev)
     }
 
     // wasting our time, there is no isr to exit from
-    if (dev->thread_id == 0) {
+    if (dev->thread_id == 0 && dev->isr_source == NULL) {
         return ret;
     }
     // mark the beginning of the thread termination process for interested parties
     dev->isr_thread_terminating = 1;
 
+    // waits for a callback in flight on a shared event loop worker
+    if (dev->isr_source != NULL) {
+        mraa_gpio_isr_event_loop_stop(dev);
+    }
+
     // stop isr being useful
     if (plat && (plat->chardev_capable))
         _mraa_close_gpio_event_handles(dev);
@@ -1114,6 +1573,8 @@ mraa_gpio_mode(mraa_gpio_context dev, mraa_gpio_mode_t mode)
             }
 
             gpio_iter->gpiod_handle = line_handle;
+            /* A fresh handle drives its output lines low. */
+            memset(gpio_iter->rw_values, 0, gpio_iter->num_gpio_lines);
         }
     } else {
 
@@ -1170,6 +1631,7 @@ mraa_gpio_chardev_dir(mraa_gpio_context dev, mraa_gpio_dir_t dir)
 {
     int line_handle;
     unsigned flags = 0;
+    unsigned default_value = 0;
     mraa_gpiod_group_t gpio_iter;
 
     for_each_gpio_group(gpio_iter, dev)
@@ -1188,7 +1650,11 @@ mraa_gpio_chardev_dir(mraa_gpio_context dev, mraa_gpio_dir_t dir)
     }
 
     switch (dir) {
+        case MRAA_GPIO_OUT_HIGH:
+            default_value = 1;
+            /* fall through */
         case MRAA_GPIO_OUT:
+        case MRAA_GPIO_OUT_LOW:
             flags |= GPIOHANDLE_REQUEST_OUTPUT;
             flags &= ~GPIOHANDLE_REQUEST_INPUT;
             break;
@@ -1208,13 +1674,15 @@ mraa_gpio_chardev_dir(mraa_gpio_context dev, mraa_gpio_dir_t dir)
         }
 
         line_handle = mraa_get_lines_handle(gpio_iter->dev_fd, gpio_iter->gpio_lines,
-                                            gpio_iter->num_gpio_lines, flags, 0);
+                                            gpio_iter->num_gpio_lines, flags, default_value);
         if (line_handle <= 0) {
             syslog(LOG_ERR, "[GPIOD_INTERFACE]: error getting line handle");
             return MRAA_ERROR_INVALID_RESOURCE;
         }
 
         gpio_iter->gpiod_handle = line_handle;
+        /* A fresh handle drives its output lines at the default value. */
+        memset(gpio_iter->rw_values, default_value, gpio_iter->num_gpio_lines);
     }
 
     return MRAA_SUCCESS;
@@ -1245,6 +1713,12 @@ mraa_gpio_dir(mraa_gpio_context dev, mraa_gpio_dir_t dir)
     mraa_gpio_context it = dev;
 
     while (it) {
+        /* OUT_HIGH and OUT_LOW also drive the line, they are never skipped. */
+        if ((dir == MRAA_GPIO_IN || dir == MRAA_GPIO_OUT) && it->sysfs_dir == (int) dir) {
+            it = it->next;
+            continue;
+        }
+
         if (it->value_fp != -1) {
             close(it->value_fp);
             it->value_fp = -1;
@@ -1291,11 +1765,13 @@ mraa_gpio_dir(mraa_gpio_context dev, mraa_gpio_dir_t dir)
 
         if (write(direction, bu, length * sizeof(char)) == -1) {
             close(direction);
+            it->sysfs_dir = -1;
             syslog(LOG_ERR, "gpio%i: dir: Failed to write to 'direction': %s", it->pin, strerror(errno));
             return MRAA_ERROR_UNSPECIFIED;
         }
 
         close(direction);
+        it->sysfs_dir = (dir == MRAA_GPIO_IN) ? MRAA_GPIO_IN : MRAA_GPIO_OUT;
         it = it->next;
     }
 
@@ -1356,6 +1832,11 @@ mraa_gpio_read_dir(mraa_gpio_context dev, mraa_gpio_dir_t* dir)
             return MRAA_ERROR_INVALID_HANDLE;
         }
 
+        if (dev->sysfs_dir != -1) {
+            *dir = dev->sysfs_dir;
+            return MRAA_SUCCESS;
+        }
+
         snprintf(filepath, MAX_SIZE, SYSFS_CLASS_GPIO "/gpio%d/direction", dev->pin);
         fd = open(filepath, O_RDONLY);
         if (fd == -1) {
@@ -1373,9 +1854,9 @@ mraa_gpio_read_dir(mraa_gpio_context dev, mraa_gpio_dir_t* dir)
         }
 
         if (strcmp(value, "out\n") == 0) {
-            *dir = MRAA_GPIO_OUT;
+            *dir = dev->sysfs_dir = MRAA_GPIO_OUT;
         } else if (strcmp(value, "in\n") == 0) {
-            *dir = MRAA_GPIO_IN;
+            *dir = dev->sysfs_dir = MRAA_GPIO_IN;
         } else {
             syslog(LOG_ERR, "gpio%i: read_dir: unknown direction: %s", dev->pin, value);
             result = MRAA_ERROR_UNSPECIFIED;
@@ -1397,6 +1878,10 @@ mraa_gpio_read(mraa_gpio_context dev)
         return dev->advance_func->gpio_read_replace(dev);
     }
 
+    if (dev->mmap_read != NULL) {
+        return dev->mmap_read(dev);
+    }
+
     if (plat->chardev_capable) {
         int output_values[1] = { 0 };
 
@@ -1406,27 +1891,20 @@ mraa_gpio_read(mraa_gpio_context dev)
         return output_values[0];
     }
 
-    if (dev->mmap_read != NULL) {
-        return dev->mmap_read(dev);
-    }
-
     if (dev->value_fp == -1) {
         if (_mraa_gpio_get_valfp(dev) != MRAA_SUCCESS) {
             return -1;
         }
-    } else {
-        // if value_fp is new this is pointless
-        lseek(dev->value_fp, 0, SEEK_SET);
     }
+    // a single pread at offset 0 replaces the lseek/read/lseek sequence
     char bu[2];
-    if (read(dev->value_fp, bu, 2 * sizeof(char)) != 2) {
+    if (pread(dev->value_fp, bu, 2 * sizeof(char), 0) != 2) {
         syslog(LOG_ERR, "gpio%i: read: Failed to read a sensible value from sysfs: %s", dev->pin,
                strerror(errno));
         return -1;
     }
-    lseek(dev->value_fp, 0, SEEK_SET);
 
-    return (int) strtol(bu, NULL, 10);
+    return bu[0] != '0';
 }
 
 mraa_result_t
@@ -1437,6 +1915,10 @@ mraa_gpio_read_multi(mraa_gpio_context dev, int output_values[])
         return -1;
     }
 
+    if (dev->mmap_banks != NULL) {
+        return mraa_gpio_mmap_read_multi(dev, output_values);
+    }
+
     if (plat->chardev_capable) {
         memset(output_values, 0, dev->num_pins * sizeof(int));
 
@@ -1507,30 +1989,24 @@ mraa_gpio_write(mraa_gpio_context dev, int value)
         return dev->advance_func->gpio_write_replace(dev, value);
     }
 
+    if (dev->mmap_write != NULL) {
+        return dev->mmap_write(dev, value);
+    }
+
     if (plat->chardev_capable) {
         int input_values[1] = { value };
 
         return mraa_gpio_write_multi(dev, input_values);
     }
 
-    if (dev->mmap_write != NULL) {
-        return dev->mmap_write(dev, value);
-    }
-
     if (dev->value_fp == -1) {
         if (_mraa_gpio_get_valfp(dev) != MRAA_SUCCESS) {
             return MRAA_ERROR_INVALID_RESOURCE;
         }
     }
 
-    if (lseek(dev->value_fp, 0, SEEK_SET) == -1) {
-        syslog(LOG_ERR, "gpio%i: write: Failed to lseek 'value': %s", dev->pin, strerror(errno));
-        return MRAA_ERROR_UNSPECIFIED;
-    }
-
-    char bu[MAX_SIZE];
-    int length = snprintf(bu, sizeof(bu), "%d", value);
-    if (write(dev->value_fp, bu, length * sizeof(char)) == -1) {
+    // sysfs treats any non zero value as high
+    if (pwrite(dev->value_fp, value ? "1" : "0", sizeof(char), 0) == -1) {
         syslog(LOG_ERR, "gpio%i: write: Failed to write to 'value': %s", dev->pin, strerror(errno));
         return MRAA_ERROR_UNSPECIFIED;
     }
@@ -1542,6 +2018,29 @@ mraa_gpio_write(mraa_gpio_context dev, int value)
     return MRAA_SUCCESS;
 }
 
+static mraa_result_t
+mraa_gpio_chardev_write_group(mraa_gpiod_group_t gpio_iter)
+{
+    int status;
+
+    if (gpio_iter->gpiod_handle <= 0) {
+        gpio_iter->gpiod_handle = mraa_get_lines_handle(gpio_iter->dev_fd, gpio_iter->gpio_lines,
+                                                        gpio_iter->num_gpio_lines, GPIOHANDLE_REQUEST_OUTPUT, 0);
+        if (gpio_iter->gpiod_handle <= 0) {
+            syslog(LOG_ERR, "[GPIOD_INTERFACE]: error getting gpio line handle");
+            return MRAA_ERROR_INVALID_HANDLE;
+        }
+    }
+
+    status = mraa_set_line_values(gpio_iter->gpiod_handle, gpio_iter->num_gpio_lines, gpio_iter->rw_values);
+    if (status < 0) {
+        syslog(LOG_ERR, "[GPIOD_INTERFACE]: error writing gpio");
+        return MRAA_ERROR_INVALID_RESOURCE;
+    }
+
+    return MRAA_SUCCESS;
+}
+
 mraa_result_t
 mraa_gpio_write_multi(mraa_gpio_context dev, int input_values[])
 {
@@ -1550,56 +2049,91 @@ mraa_gpio_write_multi(mraa_gpio_context dev, int input_values[])
         return MRAA_ERROR_INVALID_HANDLE;
     }
 
+    if (dev->mmap_banks != NULL) {
+        return mraa_gpio_mmap_write_multi(dev, input_values);
+    }
+
     if (plat->chardev_capable) {
         mraa_gpiod_group_t gpio_iter;
 
-        int* counters = calloc(dev->num_chips, sizeof(int));
-        if (counters == NULL) {
-            syslog(LOG_ERR, "mraa_gpio_write_multi() malloc error");
-            return MRAA_ERROR_NO_RESOURCES;
+        for_each_gpio_group(gpio_iter, dev)
+        {
+            /* Gather the user values through the table built at init time. */
+            for (int j = 0; j < gpio_iter->num_gpio_lines; ++j) {
+                gpio_iter->rw_values[j] = input_values[gpio_iter->gpio_group_to_pins_table[j]];
+            }
+
+            mraa_result_t status = mraa_gpio_chardev_write_group(gpio_iter);
+            if (status != MRAA_SUCCESS) {
+                return status;
+            }
         }
+    } else {
+        mraa_gpio_context it = dev;
+        int i = 0;
+        mraa_result_t status;
 
-        for (int i = 0; i < dev->num_pins; ++i) {
-            int chip_id = dev->pin_to_gpio_table[i];
-            gpio_iter = &dev->gpio_group[chip_id];
-            gpio_iter->rw_values[counters[chip_id]] = input_values[i];
-            counters[chip_id]++;
+        while (it) {
+            status = mraa_gpio_write(it, input_values[i++]);
+            if (status != MRAA_SUCCESS) {
+                syslog(LOG_ERR, "gpio: read_multiple: failed to write to multiple gpio pins");
+                return status;
+            }
+            it = it->next;
         }
-        free(counters);
+    }
+
+    return MRAA_SUCCESS;
+}
+
+mraa_result_t
+mraa_gpio_write_mask(mraa_gpio_context dev, uint64_t values, uint64_t mask)
+{
+    if (dev == NULL) {
+        syslog(LOG_ERR, "gpio: write_mask: context is invalid");
+        return MRAA_ERROR_INVALID_HANDLE;
+    }
+
+    if (dev->mmap_banks != NULL) {
+        return mraa_gpio_mmap_write_mask(dev, values, mask);
+    }
+
+    if (plat->chardev_capable) {
+        mraa_gpiod_group_t gpio_iter;
 
         for_each_gpio_group(gpio_iter, dev)
         {
-            int status;
-            unsigned flags = GPIOHANDLE_REQUEST_OUTPUT;
+            if (!(gpio_iter->pin_mask & mask)) {
+                continue;
+            }
 
-            if (gpio_iter->gpiod_handle <= 0) {
-                gpio_iter->gpiod_handle = mraa_get_lines_handle(gpio_iter->dev_fd, gpio_iter->gpio_lines,
-                                                                gpio_iter->num_gpio_lines, flags, 0);
-                if (gpio_iter->gpiod_handle <= 0) {
-                    syslog(LOG_ERR, "[GPIOD_INTERFACE]: error getting gpio line handle");
-                    return MRAA_ERROR_INVALID_HANDLE;
+            /* Lines outside the mask keep the last value seen on the handle. */
+            for (int j = 0; j < gpio_iter->num_gpio_lines; ++j) {
+                unsigned int pin_idx = gpio_iter->gpio_group_to_pins_table[j];
+                if (pin_idx < 64 && (mask & ((uint64_t) 1 << pin_idx))) {
+                    gpio_iter->rw_values[j] = (values >> pin_idx) & 1;
                 }
             }
 
-            status =
-            mraa_set_line_values(gpio_iter->gpiod_handle, gpio_iter->num_gpio_lines, gpio_iter->rw_values);
-            if (status < 0) {
-                syslog(LOG_ERR, "[GPIOD_INTERFACE]: error writing gpio");
-                return MRAA_ERROR_INVALID_RESOURCE;
+            mraa_result_t status = mraa_gpio_chardev_write_group(gpio_iter);
+            if (status != MRAA_SUCCESS) {
+                return status;
             }
         }
     } else {
         mraa_gpio_context it = dev;
-        int i = 0;
         mraa_result_t status;
 
-        while (it) {
-            status = mraa_gpio_write(it, input_values[i++]);
+        for (int i = 0; it && i < 64; ++i, it = it->next) {
+            if (!(mask & ((uint64_t) 1 << i))) {
+                continue;
+            }
+
+            status = mraa_gpio_write(it, (values >> i) & 1);
             if (status != MRAA_SUCCESS) {
-                syslog(LOG_ERR, "gpio: read_multiple: failed to write to multiple gpio pins");
+                syslog(LOG_ERR, "gpio: write_mask: failed to write to gpio pin %d", i);
                 return status;
             }
-            it = it->next;
         }
     }
 
@@ -1683,12 +2217,23 @@ mraa_gpio_close(mraa_gpio_context dev)
         return MRAA_ERROR_INVALID_HANDLE;
     }
 
+    /* Free any ISRs */
+    mraa_gpio_isr_exit(dev);
+
     if (dev->events) {
         free(dev->events);
+        dev->events = NULL;
     }
+    _mraa_gpio_event_ring_free(dev);
 
-    /* Free any ISRs */
-    mraa_gpio_isr_exit(dev);
+    if (dev->mmap_banks != NULL) {
+        mraa_gpio_mmap_setup_multi(dev, 0);
+    }
+    for (mraa_gpio_context it = dev; it != NULL; it = it->next) {
+        if (it->mmap_region != NULL) {
+            mraa_gpio_mmap_setup(it, 0);
+        }
+    }
 
     if (plat && plat->chardev_capable) {
         _mraa_free_gpio_groups(dev);
@@ -1731,10 +2276,20 @@ mraa_gpio_use_mmaped(mraa_gpio_context dev, mraa_boolean_t mmap_en)
         return MRAA_ERROR_INVALID_HANDLE;
     }
 
+    /* Multi pin contexts are mapped bank by bank */
+    if (dev->mmap_banks != NULL ||
+        ((dev->next != NULL || dev->num_pins > 1) && !IS_FUNC_DEFINED(dev, gpio_mmap_setup))) {
+        return mraa_gpio_mmap_setup_multi(dev, mmap_en);
+    }
+
     if (IS_FUNC_DEFINED(dev, gpio_mmap_setup)) {
         return dev->advance_func->gpio_mmap_setup(dev, mmap_en);
     }
 
+    if (dev->mmap_region != NULL || mraa_gpio_mmap_pin(dev) != NULL) {
+        return mraa_gpio_mmap_setup(dev, mmap_en);
+    }
+
     syslog(LOG_ERR, "gpio%i: use_mmaped: mmap not implemented on this platform", dev->pin);
 
     return MRAA_ERROR_FEATURE_NOT_IMPLEMENTED;
@@ -0,0 +1,342 @@
+/*
+ * Copyright (c) 2026 Intel Corporation.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "gpio.h"
+#include "gpio/gpio_mmap.h"
+#include "mraa_internal.h"
+
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define CAPTURE_MAX_PINS 64
+#define CAPTURE_RAW_MAGIC "MRAACAP1"
+
+static inline uint64_t
+_mraa_gpio_capture_now()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t) ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+static unsigned int
+_mraa_gpio_capture_num_pins(mraa_gpio_context dev)
+{
+    unsigned int num_pins = 0;
+
+    if (dev->provided_pins != NULL) {
+        return dev->num_pins;
+    }
+    for (mraa_gpio_context it = dev; it != NULL; it = it->next) {
+        num_pins++;
+    }
+
+    return num_pins;
+}
+
+static mraa_result_t
+_mraa_gpio_capture_sample(mraa_gpio_context dev, int* values, unsigned int num_pins, uint64_t* sample)
+{
+    if (values == NULL) {
+        *sample = mraa_gpio_mmap_read_mask(dev);
+        return MRAA_SUCCESS;
+    }
+
+    if (mraa_gpio_read_multi(dev, values) != MRAA_SUCCESS) {
+        return MRAA_ERROR_INVALID_RESOURCE;
+    }
+
+    *sample = 0;
+    for (unsigned int i = 0; i < num_pins; ++i) {
+        if (values[i]) {
+            *sample |= (uint64_t) 1 << i;
+        }
+    }
+
+    return MRAA_SUCCESS;
+}
+
+static mraa_boolean_t
+_mraa_gpio_capture_triggered(const mraa_gpio_capture_config_t* config, uint64_t prev, uint64_t sample, mraa_boolean_t first)
+{
+    uint64_t bit;
+
+    switch (config->trigger) {
+        case MRAA_GPIO_TRIGGER_NONE:
+            return 1;
+        case MRAA_GPIO_TRIGGER_PATTERN:
+            return (sample & config->trigger_mask) == (config->trigger_value & config->trigger_mask);
+        case MRAA_GPIO_TRIGGER_EDGE:
+            if (first) {
+                return 0;
+            }
+            bit = (uint64_t) 1 << config->trigger_pin;
+            switch (config->trigger_edge) {
+                case MRAA_GPIO_EDGE_RISING:
+                    return !(prev & bit) && (sample & bit);
+                case MRAA_GPIO_EDGE_FALLING:
+                    return (prev & bit) && !(sample & bit);
+                default:
+                    return (prev ^ sample) & bit ? 1 : 0;
+            }
+    }
+
+    return 0;
+}
+
+mraa_gpio_capture_t*
+mraa_gpio_capture(mraa_gpio_context dev, const mraa_gpio_capture_config_t* config)
+{
+    mraa_gpio_capture_t* capture = NULL;
+    uint64_t* pre_ring = NULL;
+    int* values = NULL;
+    unsigned int num_pins, pre_count = 0, pre_head = 0, post_count = 0;
+    uint64_t period, start, deadline, timeout, sample, prev = 0;
+    mraa_boolean_t first = 1, triggered = 0, mapped = 0;
+
+    if (dev == NULL) {
+        syslog(LOG_ERR, "gpio: capture: context is invalid");
+        return NULL;
+    }
+
+    if (config == NULL || config->rate_hz == 0 || config->post_samples == 0) {
+        syslog(LOG_ERR, "gpio: capture: rate and post trigger samples must be set");
+        return NULL;
+    }
+
+    if (config->rate_hz > MRAA_GPIO_CAPTURE_MAX_RATE_HZ) {
+        syslog(LOG_ERR, "gpio: capture: rate %u Hz above the %u Hz maximum", config->rate_hz, MRAA_GPIO_CAPTURE_MAX_RATE_HZ);
+        return NULL;
+    }
+
+    num_pins = _mraa_gpio_capture_num_pins(dev);
+    if (num_pins == 0 || num_pins > CAPTURE_MAX_PINS) {
+        syslog(LOG_ERR, "gpio: capture: %u pins, 1 to %d are supported", num_pins, CAPTURE_MAX_PINS);
+        return NULL;
+    }
+
+    if (config->trigger == MRAA_GPIO_TRIGGER_EDGE && config->trigger_pin >= num_pins) {
+        syslog(LOG_ERR, "gpio: capture: trigger pin %u out of range", config->trigger_pin);
+        return NULL;
+    }
+
+    capture = calloc(1, sizeof(mraa_gpio_capture_t));
+    if (capture == NULL) {
+        syslog(LOG_CRIT, "gpio: capture: Failed to allocate memory for capture");
+        return NULL;
+    }
+    capture->samples = malloc(((size_t) config->pre_samples + config->post_samples) * sizeof(uint64_t));
+    if (config->pre_samples > 0) {
+        pre_ring = malloc(config->pre_samples * sizeof(uint64_t));
+    }
+    /* mmap banks pack the sample with one load per bank, no scratch needed */
+    if (mraa_gpio_mmap_num_banks(dev) == 0 && mraa_gpio_mmap_setup_multi(dev, 1) == MRAA_SUCCESS) {
+        mapped = 1;
+    }
+    if (mraa_gpio_mmap_num_banks(dev) == 0) {
+        values = malloc(num_pins * sizeof(int));
+    }
+    if (capture->samples == NULL || (config->pre_samples > 0 && pre_ring == NULL) ||
+        (mraa_gpio_mmap_num_banks(dev) == 0 && values == NULL)) {
+        syslog(LOG_CRIT, "gpio: capture: Failed to allocate memory for samples");
+        goto capture_fail;
+    }
+
+    capture->num_pins = num_pins;
+    capture->rate_hz = config->rate_hz;
+
+    period = 1000000000ULL / config->rate_hz;
+    timeout = (uint64_t) config->timeout_ms * 1000000ULL;
+    start = deadline = _mraa_gpio_capture_now();
+
+    while (post_count < config->post_samples) {
+        uint64_t now;
+
+        if (_mraa_gpio_capture_sample(dev, values, num_pins, &sample) != MRAA_SUCCESS) {
+            syslog(LOG_ERR, "gpio: capture: failed to read pins");
+            goto capture_fail;
+        }
+
+        if (!triggered && _mraa_gpio_capture_triggered(config, prev, sample, first)) {
+            triggered = 1;
+            /* Unroll the pre trigger ring, oldest first */
+            for (unsigned int i = 0; i < pre_count; ++i) {
+                unsigned int idx = (pre_head + config->pre_samples - pre_count + i) % config->pre_samples;
+                capture->samples[i] = pre_ring[idx];
+            }
+            capture->trigger_index = pre_count;
+        }
+
+        if (triggered) {
+            capture->samples[pre_count + post_count++] = sample;
+        } else if (config->pre_samples > 0) {
+            pre_ring[pre_head] = sample;
+            pre_head = (pre_head + 1) % config->pre_samples;
+            if (pre_count < config->pre_samples) {
+                pre_count++;
+            }
+        }
+        prev = sample;
+        first = 0;
+
+        deadline += period;
+        now = _mraa_gpio_capture_now();
+        if (!triggered && timeout > 0 && now - start > timeout) {
+            syslog(LOG_NOTICE, "gpio: capture: trigger timed out");
+            goto capture_fail;
+        }
+        /* Keep the sampling grid, drop the periods we overran */
+        if (now > deadline + period) {
+            uint64_t behind = (now - deadline) / period;
+            capture->missed += behind;
+            deadline += behind * period;
+        }
+        while (_mraa_gpio_capture_now() < deadline)
+            ;
+    }
+
+    capture->num_samples = pre_count + post_count;
+
+    if (mapped) {
+        mraa_gpio_mmap_setup_multi(dev, 0);
+    }
+    free(pre_ring);
+    free(values);
+
+    return capture;
+
+capture_fail:
+    if (mapped) {
+        mraa_gpio_mmap_setup_multi(dev, 0);
+    }
+    free(pre_ring);
+    free(values);
+    mraa_gpio_capture_free(capture);
+    return NULL;
+}
+
+mraa_result_t
+mraa_gpio_capture_write_vcd(const mraa_gpio_capture_t* capture, const char* path)
+{
+    FILE* fh;
+    uint64_t period_ns;
+
+    if (capture == NULL || path == NULL) {
+        return MRAA_ERROR_INVALID_PARAMETER;
+    }
+
+    if (capture->rate_hz == 0 || capture->rate_hz > MRAA_GPIO_CAPTURE_MAX_RATE_HZ) {
+        syslog(LOG_ERR, "gpio: capture: write_vcd: invalid rate %u Hz", capture->rate_hz);
+        return MRAA_ERROR_INVALID_PARAMETER;
+    }
+
+    fh = fopen(path, "w");
+    if (fh == NULL) {
+        syslog(LOG_ERR, "gpio: capture: failed to open %s: %s", path, strerror(errno));
+        return MRAA_ERROR_INVALID_RESOURCE;
+    }
+
+    period_ns = 1000000000ULL / capture->rate_hz;
+
+    fprintf(fh, "$version mraa %s $end\n", mraa_get_version());
+    fprintf(fh, "$timescale 1 ns $end\n");
+    fprintf(fh, "$scope module mraa $end\n");
+    /* Identifiers are single printable characters from '!' on */
+    for (unsigned int i = 0; i < capture->num_pins; ++i) {
+        fprintf(fh, "$var wire 1 %c pin%u $end\n", '!' + i, i);
+    }
+    fprintf(fh, "$upscope $end\n$enddefinitions $end\n");
+
+    for (unsigned int s = 0; s < capture->num_samples; ++s) {
+        uint64_t changed = s == 0 ? ~(uint64_t) 0 : capture->samples[s] ^ capture->samples[s - 1];
+        if (!changed) {
+            continue;
+        }
+        fprintf(fh, "#%llu\n", (unsigned long long) (s * period_ns));
+        for (unsigned int i = 0; i < capture->num_pins; ++i) {
+            if (changed & ((uint64_t) 1 << i)) {
+                fprintf(fh, "%d%c\n", (int) ((capture->samples[s] >> i) & 1), '!' + i);
+            }
+        }
+    }
+    if (capture->num_samples > 0) {
+        fprintf(fh, "#%llu\n", (unsigned long long) (capture->num_samples * period_ns));
+    }
+
+    if (fclose(fh) != 0) {
+        syslog(LOG_ERR, "gpio: capture: failed to write %s: %s", path, strerror(errno));
+        return MRAA_ERROR_UNSPECIFIED;
+    }
+
+    return MRAA_SUCCESS;
+}
+
+static void
+_mraa_gpio_capture_put_le(uint8_t* buf, uint64_t value, unsigned int bytes)
+{
+    for (unsigned int i = 0; i < bytes; ++i) {
+        buf[i] = (value >> (8 * i)) & 0xff;
+    }
+}
+
+mraa_result_t
+mraa_gpio_capture_write_raw(const mraa_gpio_capture_t* capture, const char* path)
+{
+    FILE* fh;
+    uint8_t header[24];
+    uint8_t sample[8];
+    unsigned int sample_bytes;
+    mraa_result_t ret = MRAA_SUCCESS;
+
+    if (capture == NULL || path == NULL) {
+        return MRAA_ERROR_INVALID_PARAMETER;
+    }
+
+    fh = fopen(path, "wb");
+    if (fh == NULL) {
+        syslog(LOG_ERR, "gpio: capture: failed to open %s: %s", path, strerror(errno));
+        return MRAA_ERROR_INVALID_RESOURCE;
+    }
+
+    memcpy(header, CAPTURE_RAW_MAGIC, 8);
+    _mraa_gpio_capture_put_le(header + 8, capture->num_pins, 4);
+    _mraa_gpio_capture_put_le(header + 12, capture->rate_hz, 4);
+    _mraa_gpio_capture_put_le(header + 16, capture->num_samples, 4);
+    _mraa_gpio_capture_put_le(header + 20, capture->trigger_index, 4);
+    if (fwrite(header, sizeof(header), 1, fh) != 1) {
+        ret = MRAA_ERROR_UNSPECIFIED;
+    }
+
+    sample_bytes = (capture->num_pins + 7) / 8;
+    for (unsigned int s = 0; ret == MRAA_SUCCESS && s < capture->num_samples; ++s) {
+        _mraa_gpio_capture_put_le(sample, capture->samples[s], sample_bytes);
+        if (fwrite(sample, sample_bytes, 1, fh) != 1) {
+            ret = MRAA_ERROR_UNSPECIFIED;
+        }
+    }
+
+    if (fclose(fh) != 0) {
+        ret = MRAA_ERROR_UNSPECIFIED;
+    }
+    if (ret != MRAA_SUCCESS) {
+        syslog(LOG_ERR, "gpio: capture: failed to write %s: %s", path, strerror(errno));
+    }
+
+    return ret;
+}
+
+void
+mraa_gpio_capture_free(mraa_gpio_capture_t* capture)
+{
+    if (capture == NULL) {
+        return;
+    }
+    free(capture->samples);
+    free(capture);
+}
@@ -30,6 +30,18 @@
 #define CHIP_DEV_PREFIX "gpiochip"
 #define STR_SIZE 64
 
+static int
+dir_filter(const struct dirent* dir)
+{
+    return !strncmp(dir->d_name, CHIP_DEV_PREFIX, strlen(CHIP_DEV_PREFIX));
+}
+
+static mraa_boolean_t
+_mraa_gpiod_is_v2()
+{
+    return (plat != NULL) && plat->chardev_v2;
+}
+
 void
 _mraa_free_gpio_groups(mraa_gpio_context dev)
 {
@@ -101,6 +113,12 @@ _mraa_close_gpio_event_handles(mraa_gpio_context dev)
             /* In the end, _mraa_free_gpio_groups will be called. */
             gpio_iter->event_handles = NULL;
         }
+
+        /* With the v2 ABI the line request itself carries the events. */
+        if (_mraa_gpiod_is_v2() && gpio_iter->gpiod_handle != -1) {
+            close(gpio_iter->gpiod_handle);
+            gpio_iter->gpiod_handle = -1;
+        }
     }
 }
 
@@ -131,17 +149,143 @@ _mraa_gpiod_ioctl(int fd, unsigned long gpio_request, void* data)
     return status;
 }
 
+static uint64_t
+_mraa_gpiod_v2_lines_mask(unsigned int num_lines)
+{
+    return num_lines >= 64 ? ~0ULL : (1ULL << num_lines) - 1;
+}
+
+static uint64_t
+_mraa_gpiod_v2_request_flags(unsigned flags)
+{
+    uint64_t v2_flags = 0;
+
+    if (flags & GPIOHANDLE_REQUEST_INPUT)
+        v2_flags |= GPIO_V2_LINE_FLAG_INPUT;
+    if (flags & GPIOHANDLE_REQUEST_OUTPUT)
+        v2_flags |= GPIO_V2_LINE_FLAG_OUTPUT;
+    if (flags & GPIOHANDLE_REQUEST_ACTIVE_LOW)
+        v2_flags |= GPIO_V2_LINE_FLAG_ACTIVE_LOW;
+    if (flags & GPIOHANDLE_REQUEST_OPEN_DRAIN)
+        v2_flags |= GPIO_V2_LINE_FLAG_OPEN_DRAIN;
+    if (flags & GPIOHANDLE_REQUEST_OPEN_SOURCE)
+        v2_flags |= GPIO_V2_LINE_FLAG_OPEN_SOURCE;
+
+    return v2_flags;
+}
+
+mraa_boolean_t
+mraa_is_gpio_chip_v2_compatible(int chip_fd)
+{
+    struct gpiochip_info chip_info;
+    struct gpio_v2_line_info linfo;
+
+    if (ioctl(chip_fd, GPIO_GET_CHIPINFO_IOCTL, &chip_info) < 0) {
+        return 0;
+    }
+
+    /* Nothing to ask about, and nothing will ever be requested from it. */
+    if (chip_info.lines == 0) {
+        return 1;
+    }
+
+    /* Kernels without the v2 ABI reject the ioctl. */
+    memset(&linfo, 0, sizeof(linfo));
+    return ioctl(chip_fd, GPIO_V2_GET_LINEINFO_IOCTL, &linfo) == 0;
+}
+
+mraa_boolean_t
+mraa_is_gpio_chardev_v2_compatible()
+{
+    int num_chips;
+    struct dirent** dirs;
+    mraa_boolean_t compatible = 1;
+
+    num_chips = scandir("/dev", &dirs, dir_filter, alphasort);
+    if (num_chips <= 0) {
+        return 0;
+    }
+
+    /* Any chip may end up opened, so all of them have to speak v2. */
+    for (int i = 0; i < num_chips; ++i) {
+        mraa_gpiod_chip_info* cinfo = compatible ? mraa_get_chip_info_by_name(dirs[i]->d_name) : NULL;
+        if (cinfo) {
+            compatible = mraa_is_gpio_chip_v2_compatible(cinfo->chip_fd);
+            close(cinfo->chip_fd);
+            free(cinfo);
+        } else {
+            compatible = 0;
+        }
+        free(dirs[i]);
+    }
+    free(dirs);
+
+    return compatible;
+}
+
+int
+mraa_get_lines_handle_v2(int chip_fd,
+                         unsigned line_offsets[],
+                         unsigned num_lines,
+                         uint64_t flags,
+                         unsigned default_value,
+                         unsigned debounce_us)
+{
+    int status;
+    unsigned num_attrs = 0;
+    struct gpio_v2_line_request __gpio_req;
+
+    memset(&__gpio_req, 0, sizeof(__gpio_req));
+    __gpio_req.num_lines = num_lines;
+    memcpy(__gpio_req.offsets, line_offsets, num_lines * sizeof __gpio_req.offsets[0]);
+    strncpy(__gpio_req.consumer, "mraa", sizeof(__gpio_req.consumer) - 1);
+    __gpio_req.config.flags = flags;
+
+    /* Same as the v1 default_values, every output line starts at default_value. */
+    if (flags & GPIO_V2_LINE_FLAG_OUTPUT) {
+        __gpio_req.config.attrs[num_attrs].attr.id = GPIO_V2_LINE_ATTR_ID_OUTPUT_VALUES;
+        __gpio_req.config.attrs[num_attrs].attr.values = default_value ? _mraa_gpiod_v2_lines_mask(num_lines) : 0;
+        __gpio_req.config.attrs[num_attrs].mask = _mraa_gpiod_v2_lines_mask(num_lines);
+        num_attrs++;
+    }
+
+    if (debounce_us > 0) {
+        __gpio_req.config.attrs[num_attrs].attr.id = GPIO_V2_LINE_ATTR_ID_DEBOUNCE;
+        __gpio_req.config.attrs[num_attrs].attr.debounce_period_us = debounce_us;
+        __gpio_req.config.attrs[num_attrs].mask = _mraa_gpiod_v2_lines_mask(num_lines);
+        num_attrs++;
+    }
+    __gpio_req.config.num_attrs = num_attrs;
+
+    status = _mraa_gpiod_ioctl(chip_fd, GPIO_V2_GET_LINE_IOCTL, &__gpio_req);
+    if (status < 0) {
+        syslog(LOG_ERR, "gpiod: v2 line request ioctl() fail");
+        return status;
+    }
+
+    if (__gpio_req.fd <= 0) {
+        syslog(LOG_ERR, "[GPIOD_INTERFACE]: invalid file descriptor");
+    }
+
+    return __gpio_req.fd;
+}
+
 int
 mraa_get_lines_handle(int chip_fd, unsigned line_offsets[], unsigned num_lines, unsigned flags, unsigned default_value)
 {
     int status;
     struct gpiohandle_request __gpio_hreq;
 
+    if (_mraa_gpiod_is_v2()) {
+        return mraa_get_lines_handle_v2(chip_fd, line_offsets, num_lines, _mraa_gpiod_v2_request_flags(flags),
+                                        default_value, 0);
+    }
+
     __gpio_hreq.lines = num_lines;
     memcpy(__gpio_hreq.lineoffsets, line_offsets, num_lines * sizeof __gpio_hreq.lineoffsets[0]);
 
     if (flags & GPIOHANDLE_REQUEST_OUTPUT) {
-        memset(__gpio_hreq.default_values, 0, num_lines * sizeof __gpio_hreq.default_values[0]);
+        memset(__gpio_hreq.default_values, default_value ? 1 : 0, num_lines * sizeof __gpio_hreq.default_values[0]);
     }
     __gpio_hreq.flags = flags;
 
@@ -257,6 +401,36 @@ mraa_get_line_info_from_descriptor(int chip_fd, unsigned line_number)
         return NULL;
     }
 
+    if (_mraa_gpiod_is_v2()) {
+        struct gpio_v2_line_info v2_linfo;
+
+        memset(&v2_linfo, 0, sizeof(v2_linfo));
+        v2_linfo.offset = line_number;
+        status = _mraa_gpiod_ioctl(chip_fd, GPIO_V2_GET_LINEINFO_IOCTL, &v2_linfo);
+        if (status < 0) {
+            free(linfo);
+            return NULL;
+        }
+
+        /* Keep handing out the v1 layout, the rest of mraa is built on it. */
+        linfo->line_offset = v2_linfo.offset;
+        linfo->flags = 0;
+        if (v2_linfo.flags & GPIO_V2_LINE_FLAG_USED)
+            linfo->flags |= GPIOLINE_FLAG_KERNEL;
+        if (v2_linfo.flags & GPIO_V2_LINE_FLAG_OUTPUT)
+            linfo->flags |= GPIOLINE_FLAG_IS_OUT;
+        if (v2_linfo.flags & GPIO_V2_LINE_FLAG_ACTIVE_LOW)
+            linfo->flags |= GPIOLINE_FLAG_ACTIVE_LOW;
+        if (v2_linfo.flags & GPIO_V2_LINE_FLAG_OPEN_DRAIN)
+            linfo->flags |= GPIOLINE_FLAG_OPEN_DRAIN;
+        if (v2_linfo.flags & GPIO_V2_LINE_FLAG_OPEN_SOURCE)
+            linfo->flags |= GPIOLINE_FLAG_OPEN_SOURCE;
+        memcpy(linfo->name, v2_linfo.name, sizeof(linfo->name));
+        memcpy(linfo->consumer, v2_linfo.consumer, sizeof(linfo->consumer));
+
+        return linfo;
+    }
+
     linfo->line_offset = line_number;
     status = _mraa_gpiod_ioctl(chip_fd, GPIO_GET_LINEINFO_IOCTL, linfo);
     if (status < 0) {
@@ -333,6 +507,25 @@ mraa_set_line_values(int line_handle, unsigned int num_lines, unsigned char inpu
     int status;
     struct gpiohandle_data __hdata;
 
+    if (_mraa_gpiod_is_v2()) {
+        struct gpio_v2_line_values __vdata;
+
+        __vdata.bits = 0;
+        __vdata.mask = _mraa_gpiod_v2_lines_mask(num_lines);
+        for (unsigned int i = 0; i < num_lines; ++i) {
+            if (input_values[i]) {
+                __vdata.bits |= 1ULL << i;
+            }
+        }
+
+        status = _mraa_gpiod_ioctl(line_handle, GPIO_V2_LINE_SET_VALUES_IOCTL, &__vdata);
+        if (status < 0) {
+            syslog(LOG_ERR, "[GPIOD_INTERFACE]: ioctl() fail");
+        }
+
+        return status;
+    }
+
     memcpy(__hdata.values, input_values, num_lines * sizeof(unsigned char));
 
     status = _mraa_gpiod_ioctl(line_handle, GPIOHANDLE_SET_LINE_VALUES_IOCTL, &__hdata);
@@ -349,6 +542,24 @@ mraa_get_line_values(int line_handle, unsigned int num_lines, unsigned char outp
     int status;
     struct gpiohandle_data __hdata;
 
+    if (_mraa_gpiod_is_v2()) {
+        struct gpio_v2_line_values __vdata;
+
+        __vdata.bits = 0;
+        __vdata.mask = _mraa_gpiod_v2_lines_mask(num_lines);
+        status = _mraa_gpiod_ioctl(line_handle, GPIO_V2_LINE_GET_VALUES_IOCTL, &__vdata);
+        if (status < 0) {
+            syslog(LOG_ERR, "[GPIOD_INTERFACE]: ioctl() fail");
+            return status;
+        }
+
+        for (unsigned int i = 0; i < num_lines; ++i) {
+            output_values[i] = (__vdata.bits >> i) & 1;
+        }
+
+        return status;
+    }
+
     status = _mraa_gpiod_ioctl(line_handle, GPIOHANDLE_GET_LINE_VALUES_IOCTL, &__hdata);
     if (status < 0) {
         syslog(LOG_ERR, "[GPIOD_INTERFACE]: ioctl() fail");
@@ -391,12 +602,6 @@ mraa_is_gpio_line_open_source(mraa_gpiod_line_info* linfo)
     return (linfo->flags & GPIOLINE_FLAG_OPEN_SOURCE);
 }
 
-static int
-dir_filter(const struct dirent* dir)
-{
-    return !strncmp(dir->d_name, CHIP_DEV_PREFIX, strlen(CHIP_DEV_PREFIX));
-}
-
 int
 mraa_get_number_of_gpio_chips()
 {
@@ -0,0 +1,518 @@
+/*
+ * Copyright (c) 2026 Intel Corporation.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "gpio/gpio_mmap.h"
+#include "mraa_internal.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+typedef struct {
+    mraa_mmap_region_t region; /**< one reference held per bank */
+    volatile uint32_t* set;
+    volatile uint32_t* clr;
+    volatile uint32_t* lev;
+    uint32_t set_mask; /**< bits to drive high, gathered by the current write */
+    uint32_t clr_mask; /**< bits to drive low, gathered by the current write */
+    uint32_t level; /**< level register loaded by the current read */
+} mraa_gpio_mmap_bank_t;
+
+struct _mraa_gpio_mmap_banks {
+    unsigned int num_banks;
+    mraa_gpio_mmap_bank_t* banks;
+    unsigned int num_pins;
+    unsigned int* pin_bank; /**< bank of each pin, in init order */
+    uint32_t* pin_bit; /**< bit of each pin in its bank */
+};
+
+struct _mraa_mmap_region {
+    char mem_dev[32];
+    uint64_t offset;
+    unsigned int size;
+    int fd;
+    uint8_t* base;
+    unsigned int refcount;
+    pthread_mutex_t rmw_lock; /**< serialises read-modify-write of data registers */
+    struct _mraa_mmap_region* next;
+};
+
+static pthread_mutex_t regions_lock = PTHREAD_MUTEX_INITIALIZER;
+static struct _mraa_mmap_region* regions = NULL;
+
+static mraa_mmap_region_t
+_mraa_mmap_region_get(mraa_mmap_pin_t* desc)
+{
+    mraa_mmap_region_t region;
+    long page_size = sysconf(_SC_PAGESIZE);
+
+    if (page_size > 0 && desc->mem_offset % page_size != 0) {
+        syslog(LOG_ERR, "gpio mmap: %s offset 0x%llx is not page aligned", desc->mem_dev,
+               (unsigned long long) desc->mem_offset);
+        return NULL;
+    }
+
+    pthread_mutex_lock(&regions_lock);
+
+    for (region = regions; region != NULL; region = region->next) {
+        if (region->offset == desc->mem_offset && region->size == desc->mem_sz &&
+            strncmp(region->mem_dev, desc->mem_dev, sizeof(region->mem_dev)) == 0) {
+            region->refcount++;
+            pthread_mutex_unlock(&regions_lock);
+            return region;
+        }
+    }
+
+    region = calloc(1, sizeof(struct _mraa_mmap_region));
+    if (region == NULL) {
+        syslog(LOG_CRIT, "gpio mmap: Failed to allocate memory for region");
+        pthread_mutex_unlock(&regions_lock);
+        return NULL;
+    }
+
+    region->fd = open(desc->mem_dev, O_RDWR | O_SYNC | O_CLOEXEC);
+    if (region->fd < 0) {
+        syslog(LOG_ERR, "gpio mmap: unable to open %s: %s", desc->mem_dev, strerror(errno));
+        goto region_get_fail;
+    }
+
+    region->base = (uint8_t*) mmap(NULL, desc->mem_sz, PROT_READ | PROT_WRITE, MAP_SHARED,
+                                   region->fd, (off_t) desc->mem_offset);
+    if (region->base == MAP_FAILED) {
+        syslog(LOG_ERR, "gpio mmap: failed to mmap %s: %s", desc->mem_dev, strerror(errno));
+        close(region->fd);
+        goto region_get_fail;
+    }
+
+    memcpy(region->mem_dev, desc->mem_dev, sizeof(region->mem_dev));
+    region->offset = desc->mem_offset;
+    region->size = desc->mem_sz;
+    region->refcount = 1;
+    pthread_mutex_init(&region->rmw_lock, NULL);
+    region->next = regions;
+    regions = region;
+
+    pthread_mutex_unlock(&regions_lock);
+
+    return region;
+
+region_get_fail:
+    pthread_mutex_unlock(&regions_lock);
+    free(region);
+    return NULL;
+}
+
+static void
+_mraa_mmap_region_put(mraa_mmap_region_t region)
+{
+    mraa_mmap_region_t* it;
+
+    pthread_mutex_lock(&regions_lock);
+
+    if (--region->refcount > 0) {
+        pthread_mutex_unlock(&regions_lock);
+        return;
+    }
+
+    for (it = &regions; *it != NULL; it = &(*it)->next) {
+        if (*it == region) {
+            *it = region->next;
+            break;
+        }
+    }
+
+    pthread_mutex_unlock(&regions_lock);
+
+    munmap(region->base, region->size);
+    close(region->fd);
+    pthread_mutex_destroy(&region->rmw_lock);
+    free(region);
+}
+
+/* Description of the index-th pin of a context, in init order. */
+static mraa_mmap_pin_t*
+_mraa_gpio_mmap_pin_at(mraa_gpio_context dev, unsigned int index)
+{
+    int phy_pin;
+
+    if (plat == NULL) {
+        return NULL;
+    }
+
+    if (dev->provided_pins != NULL) {
+        /* init_by_name keeps a chip line offset there, not a board pin */
+        if (index >= dev->num_pins || dev->phy_pin < 0) {
+            return NULL;
+        }
+        phy_pin = dev->provided_pins[index];
+    } else {
+        for (; dev != NULL && index > 0; --index) {
+            dev = dev->next;
+        }
+        /* phy_pin of a sub platform context doesn't index plat->pins */
+        if (dev == NULL || dev->advance_func != plat->adv_func) {
+            return NULL;
+        }
+        phy_pin = dev->phy_pin;
+    }
+
+    if (phy_pin < 0 || phy_pin >= plat->phy_pin_count || !plat->pins[phy_pin].mmap.regs) {
+        return NULL;
+    }
+
+    return &plat->pins[phy_pin].mmap;
+}
+
+static mraa_boolean_t
+_mraa_gpio_mmap_desc_valid(mraa_mmap_pin_t* desc)
+{
+    return desc->bit_pos <= 31 && (desc->set_reg | desc->clr_reg | desc->lev_reg) % 4 == 0 &&
+           desc->set_reg + 4 <= desc->mem_sz && desc->clr_reg + 4 <= desc->mem_sz &&
+           desc->lev_reg + 4 <= desc->mem_sz;
+}
+
+mraa_mmap_pin_t*
+mraa_gpio_mmap_pin(mraa_gpio_context dev)
+{
+    if (dev->next != NULL || dev->num_pins > 1) {
+        return NULL;
+    }
+
+    return _mraa_gpio_mmap_pin_at(dev, 0);
+}
+
+void
+mraa_gpio_mmap_write_bank(mraa_mmap_region_t region,
+                          volatile uint32_t* set,
+                          volatile uint32_t* clr,
+                          uint32_t set_mask,
+                          uint32_t clr_mask)
+{
+    if (set != clr) {
+        if (set_mask) {
+            *set = set_mask;
+        }
+        if (clr_mask) {
+            *clr = clr_mask;
+        }
+        return;
+    }
+
+    pthread_mutex_lock(&region->rmw_lock);
+    *set = (*set | set_mask) & ~clr_mask;
+    pthread_mutex_unlock(&region->rmw_lock);
+}
+
+mraa_result_t
+mraa_gpio_mmap_write(mraa_gpio_context dev, int value)
+{
+    if (value) {
+        mraa_gpio_mmap_write_bank(dev->mmap_region, dev->mmap_set, dev->mmap_clr, dev->mmap_mask, 0);
+    } else {
+        mraa_gpio_mmap_write_bank(dev->mmap_region, dev->mmap_set, dev->mmap_clr, 0, dev->mmap_mask);
+    }
+    return MRAA_SUCCESS;
+}
+
+int
+mraa_gpio_mmap_read(mraa_gpio_context dev)
+{
+    return (*dev->mmap_lev & dev->mmap_mask) ? 1 : 0;
+}
+
+mraa_result_t
+mraa_gpio_mmap_setup(mraa_gpio_context dev, mraa_boolean_t en)
+{
+    mraa_mmap_pin_t* desc;
+
+    if (dev == NULL) {
+        syslog(LOG_ERR, "gpio mmap: context not valid");
+        return MRAA_ERROR_INVALID_HANDLE;
+    }
+
+    if (en == 0) {
+        if (dev->mmap_region == NULL) {
+            syslog(LOG_ERR, "gpio mmap: can't disable disabled mmap gpio");
+            return MRAA_ERROR_INVALID_PARAMETER;
+        }
+        dev->mmap_write = NULL;
+        dev->mmap_read = NULL;
+        _mraa_mmap_region_put(dev->mmap_region);
+        dev->mmap_region = NULL;
+        dev->mmap_set = dev->mmap_clr = dev->mmap_lev = NULL;
+        return MRAA_SUCCESS;
+    }
+
+    if (dev->mmap_region != NULL) {
+        syslog(LOG_ERR, "gpio mmap: can't enable enabled mmap gpio");
+        return MRAA_ERROR_INVALID_PARAMETER;
+    }
+
+    desc = mraa_gpio_mmap_pin(dev);
+    if (desc == NULL) {
+        syslog(LOG_ERR, "gpio%i: mmap: no register description for this pin", dev->pin);
+        return MRAA_ERROR_FEATURE_NOT_IMPLEMENTED;
+    }
+
+    if (!_mraa_gpio_mmap_desc_valid(desc)) {
+        syslog(LOG_ERR, "gpio%i: mmap: register description out of range", dev->pin);
+        return MRAA_ERROR_INVALID_RESOURCE;
+    }
+
+    dev->mmap_region = _mraa_mmap_region_get(desc);
+    if (dev->mmap_region == NULL) {
+        return MRAA_ERROR_NO_RESOURCES;
+    }
+
+    dev->mmap_set = (volatile uint32_t*) (dev->mmap_region->base + desc->set_reg);
+    dev->mmap_clr = (volatile uint32_t*) (dev->mmap_region->base + desc->clr_reg);
+    dev->mmap_lev = (volatile uint32_t*) (dev->mmap_region->base + desc->lev_reg);
+    dev->mmap_mask = (uint32_t) 1 << desc->bit_pos;
+    dev->mmap_write = &mraa_gpio_mmap_write;
+    dev->mmap_read = &mraa_gpio_mmap_read;
+
+    return MRAA_SUCCESS;
+}
+
+static void
+_mraa_gpio_mmap_banks_free(struct _mraa_gpio_mmap_banks* banks)
+{
+    for (unsigned int i = 0; i < banks->num_banks; ++i) {
+        _mraa_mmap_region_put(banks->banks[i].region);
+    }
+    free(banks->banks);
+    free(banks->pin_bank);
+    free(banks->pin_bit);
+    free(banks);
+}
+
+mraa_result_t
+mraa_gpio_mmap_setup_multi(mraa_gpio_context dev, mraa_boolean_t en)
+{
+    struct _mraa_gpio_mmap_banks* banks;
+    unsigned int num_pins = 0;
+
+    if (dev == NULL) {
+        syslog(LOG_ERR, "gpio mmap: context not valid");
+        return MRAA_ERROR_INVALID_HANDLE;
+    }
+
+    if (en == 0) {
+        if (dev->mmap_banks == NULL) {
+            syslog(LOG_ERR, "gpio mmap: can't disable disabled mmap gpio");
+            return MRAA_ERROR_INVALID_PARAMETER;
+        }
+        _mraa_gpio_mmap_banks_free(dev->mmap_banks);
+        dev->mmap_banks = NULL;
+        return MRAA_SUCCESS;
+    }
+
+    if (dev->mmap_banks != NULL) {
+        syslog(LOG_ERR, "gpio mmap: can't enable enabled mmap gpio");
+        return MRAA_ERROR_INVALID_PARAMETER;
+    }
+
+    if (dev->provided_pins != NULL) {
+        num_pins = dev->num_pins;
+    } else {
+        for (mraa_gpio_context it = dev; it != NULL; it = it->next) {
+            num_pins++;
+        }
+    }
+
+    banks = calloc(1, sizeof(struct _mraa_gpio_mmap_banks));
+    if (banks == NULL) {
+        syslog(LOG_CRIT, "gpio mmap: Failed to allocate memory for banks");
+        return MRAA_ERROR_NO_RESOURCES;
+    }
+    banks->num_pins = num_pins;
+    /* At worst every pin sits in a bank of its own */
+    banks->banks = calloc(num_pins, sizeof(mraa_gpio_mmap_bank_t));
+    banks->pin_bank = calloc(num_pins, sizeof(unsigned int));
+    banks->pin_bit = calloc(num_pins, sizeof(uint32_t));
+    if (banks->banks == NULL || banks->pin_bank == NULL || banks->pin_bit == NULL) {
+        syslog(LOG_CRIT, "gpio mmap: Failed to allocate memory for banks");
+        _mraa_gpio_mmap_banks_free(banks);
+        return MRAA_ERROR_NO_RESOURCES;
+    }
+
+    for (unsigned int i = 0; i < num_pins; ++i) {
+        mraa_mmap_pin_t* desc = _mraa_gpio_mmap_pin_at(dev, i);
+        mraa_mmap_region_t region;
+        unsigned int b;
+
+        if (desc == NULL || !_mraa_gpio_mmap_desc_valid(desc)) {
+            syslog(LOG_ERR, "gpio mmap: no usable register description for pin %u", i);
+            _mraa_gpio_mmap_banks_free(banks);
+            return MRAA_ERROR_FEATURE_NOT_IMPLEMENTED;
+        }
+
+        region = _mraa_mmap_region_get(desc);
+        if (region == NULL) {
+            _mraa_gpio_mmap_banks_free(banks);
+            return MRAA_ERROR_NO_RESOURCES;
+        }
+
+        for (b = 0; b < banks->num_banks; ++b) {
+            mraa_gpio_mmap_bank_t* bank = &banks->banks[b];
+            if (bank->region == region && bank->set == (volatile uint32_t*) (region->base + desc->set_reg) &&
+                bank->clr == (volatile uint32_t*) (region->base + desc->clr_reg) &&
+                bank->lev == (volatile uint32_t*) (region->base + desc->lev_reg)) {
+                break;
+            }
+        }
+
+        if (b == banks->num_banks) {
+            mraa_gpio_mmap_bank_t* bank = &banks->banks[b];
+            bank->region = region;
+            bank->set = (volatile uint32_t*) (region->base + desc->set_reg);
+            bank->clr = (volatile uint32_t*) (region->base + desc->clr_reg);
+            bank->lev = (volatile uint32_t*) (region->base + desc->lev_reg);
+            banks->num_banks++;
+        } else {
+            _mraa_mmap_region_put(region);
+        }
+
+        banks->pin_bank[i] = b;
+        banks->pin_bit[i] = (uint32_t) 1 << desc->bit_pos;
+    }
+
+    syslog(LOG_DEBUG, "gpio mmap: %u pins in %u banks", num_pins, banks->num_banks);
+    dev->mmap_banks = banks;
+
+    return MRAA_SUCCESS;
+}
+
+static void
+_mraa_gpio_mmap_banks_store(struct _mraa_gpio_mmap_banks* banks)
+{
+    for (unsigned int b = 0; b < banks->num_banks; ++b) {
+        mraa_gpio_mmap_bank_t* bank = &banks->banks[b];
+        if (bank->set_mask | bank->clr_mask) {
+            mraa_gpio_mmap_write_bank(bank->region, bank->set, bank->clr, bank->set_mask, bank->clr_mask);
+        }
+        bank->set_mask = bank->clr_mask = 0;
+    }
+}
+
+mraa_result_t
+mraa_gpio_mmap_write_multi(mraa_gpio_context dev, int input_values[])
+{
+    struct _mraa_gpio_mmap_banks* banks = dev->mmap_banks;
+
+    for (unsigned int i = 0; i < banks->num_pins; ++i) {
+        mraa_gpio_mmap_bank_t* bank = &banks->banks[banks->pin_bank[i]];
+        if (input_values[i]) {
+            bank->set_mask |= banks->pin_bit[i];
+        } else {
+            bank->clr_mask |= banks->pin_bit[i];
+        }
+    }
+    _mraa_gpio_mmap_banks_store(banks);
+
+    return MRAA_SUCCESS;
+}
+
+mraa_result_t
+mraa_gpio_mmap_write_mask(mraa_gpio_context dev, uint64_t values, uint64_t mask)
+{
+    struct _mraa_gpio_mmap_banks* banks = dev->mmap_banks;
+
+    for (unsigned int i = 0; i < banks->num_pins && i < 64; ++i) {
+        mraa_gpio_mmap_bank_t* bank = &banks->banks[banks->pin_bank[i]];
+        if (!(mask & ((uint64_t) 1 << i))) {
+            continue;
+        }
+        if (values & ((uint64_t) 1 << i)) {
+            bank->set_mask |= banks->pin_bit[i];
+        } else {
+            bank->clr_mask |= banks->pin_bit[i];
+        }
+    }
+    _mraa_gpio_mmap_banks_store(banks);
+
+    return MRAA_SUCCESS;
+}
+
+mraa_result_t
+mraa_gpio_mmap_read_multi(mraa_gpio_context dev, int output_values[])
+{
+    struct _mraa_gpio_mmap_banks* banks = dev->mmap_banks;
+
+    for (unsigned int b = 0; b < banks->num_banks; ++b) {
+        banks->banks[b].level = *banks->banks[b].lev;
+    }
+    for (unsigned int i = 0; i < banks->num_pins; ++i) {
+        output_values[i] = (banks->banks[banks->pin_bank[i]].level & banks->pin_bit[i]) ? 1 : 0;
+    }
+
+    return MRAA_SUCCESS;
+}
+
+unsigned int
+mraa_gpio_mmap_num_banks(mraa_gpio_context dev)
+{
+    return dev->mmap_banks != NULL ? dev->mmap_banks->num_banks : 0;
+}
+
+void
+mraa_gpio_mmap_compile_mask(mraa_gpio_context dev,
+                            uint64_t values,
+                            uint64_t mask,
+                            uint32_t set_masks[],
+                            uint32_t clr_masks[])
+{
+    struct _mraa_gpio_mmap_banks* banks = dev->mmap_banks;
+
+    memset(set_masks, 0, banks->num_banks * sizeof(uint32_t));
+    memset(clr_masks, 0, banks->num_banks * sizeof(uint32_t));
+
+    for (unsigned int i = 0; i < banks->num_pins && i < 64; ++i) {
+        if (!(mask & ((uint64_t) 1 << i))) {
+            continue;
+        }
+        if (values & ((uint64_t) 1 << i)) {
+            set_masks[banks->pin_bank[i]] |= banks->pin_bit[i];
+        } else {
+            clr_masks[banks->pin_bank[i]] |= banks->pin_bit[i];
+        }
+    }
+}
+
+void
+mraa_gpio_mmap_store_masks(mraa_gpio_context dev, const uint32_t set_masks[], const uint32_t clr_masks[])
+{
+    struct _mraa_gpio_mmap_banks* banks = dev->mmap_banks;
+
+    for (unsigned int b = 0; b < banks->num_banks; ++b) {
+        mraa_gpio_mmap_bank_t* bank = &banks->banks[b];
+        if (set_masks[b] | clr_masks[b]) {
+            mraa_gpio_mmap_write_bank(bank->region, bank->set, bank->clr, set_masks[b], clr_masks[b]);
+        }
+    }
+}
+
+uint64_t
+mraa_gpio_mmap_read_mask(mraa_gpio_context dev)
+{
+    struct _mraa_gpio_mmap_banks* banks = dev->mmap_banks;
+    uint64_t values = 0;
+
+    for (unsigned int b = 0; b < banks->num_banks; ++b) {
+        banks->banks[b].level = *banks->banks[b].lev;
+    }
+    for (unsigned int i = 0; i < banks->num_pins && i < 64; ++i) {
+        if (banks->banks[banks->pin_bank[i]].level & banks->pin_bit[i]) {
+            values |= (uint64_t) 1 << i;
+        }
+    }
+
+    return values;
+}
@@ -0,0 +1,264 @@
+/*
+ * Copyright (c) 2026 Intel Corporation.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#define _GNU_SOURCE
+#include "gpio.h"
+#include "gpio/gpio_mmap.h"
+#include "mraa_internal.h"
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/* Delays longer than this sleep first and only busy wait the tail. */
+#define WAVEFORM_SPIN_NS 100000
+
+struct _gpio_waveform {
+    mraa_gpio_context dev;
+    unsigned int num_steps;
+    mraa_gpio_waveform_step_t* steps;
+    unsigned int num_banks; /**< non zero when compiled for the mmap banks */
+    uint32_t* set_masks; /**< num_banks per step */
+    uint32_t* clr_masks; /**< num_banks per step */
+    unsigned int repeat;
+    int cpu;
+    int priority;
+    pthread_t thread;
+    mraa_boolean_t running; /**< started and not yet waited for */
+    int stop;
+    mraa_result_t result;
+    mraa_gpio_waveform_stats_t stats;
+};
+
+static inline uint64_t
+_mraa_gpio_waveform_now()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t) ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+static void
+_mraa_gpio_waveform_wait_until(uint64_t deadline)
+{
+    uint64_t now = _mraa_gpio_waveform_now();
+
+    if (now + WAVEFORM_SPIN_NS < deadline) {
+        uint64_t wake = deadline - WAVEFORM_SPIN_NS;
+        struct timespec ts = { .tv_sec = wake / 1000000000ULL, .tv_nsec = wake % 1000000000ULL };
+        clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL);
+    }
+
+    while (_mraa_gpio_waveform_now() < deadline)
+        ;
+}
+
+static void*
+_mraa_gpio_waveform_thread(void* arg)
+{
+    mraa_gpio_waveform_t wf = (mraa_gpio_waveform_t) arg;
+    mraa_gpio_waveform_stats_t* stats = &wf->stats;
+    uint64_t start, deadline, late_sum = 0;
+
+    if (wf->cpu >= 0) {
+        cpu_set_t cpus;
+        CPU_ZERO(&cpus);
+        CPU_SET(wf->cpu, &cpus);
+        if (pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus) != 0) {
+            syslog(LOG_WARNING, "gpio waveform: failed to pin thread to cpu %d", wf->cpu);
+        }
+    }
+
+    if (wf->priority > 0 && mraa_set_priority(wf->priority) != 0) {
+        syslog(LOG_WARNING, "gpio waveform: failed to set thread priority %d", wf->priority);
+    }
+
+    memset(stats, 0, sizeof(mraa_gpio_waveform_stats_t));
+    start = deadline = _mraa_gpio_waveform_now();
+
+    for (unsigned int r = 0; r < wf->repeat; ++r) {
+        for (unsigned int i = 0; i < wf->num_steps; ++i) {
+            const mraa_gpio_waveform_step_t* step = &wf->steps[i];
+            uint64_t now;
+
+            if (__atomic_load_n(&wf->stop, __ATOMIC_RELAXED)) {
+                goto waveform_done;
+            }
+
+            now = _mraa_gpio_waveform_now();
+            if (now > deadline) {
+                late_sum += now - deadline;
+                if (now - deadline > stats->max_late_ns) {
+                    stats->max_late_ns = now - deadline;
+                }
+            }
+
+            if (wf->num_banks > 0) {
+                mraa_gpio_mmap_store_masks(wf->dev, &wf->set_masks[i * wf->num_banks],
+                                           &wf->clr_masks[i * wf->num_banks]);
+            } else if (step->mask != 0) {
+                mraa_result_t ret = mraa_gpio_write_mask(wf->dev, step->value, step->mask);
+                if (ret != MRAA_SUCCESS) {
+                    syslog(LOG_ERR, "gpio waveform: write failed at step %u", i);
+                    wf->result = ret;
+                    goto waveform_done;
+                }
+            }
+
+            stats->steps++;
+            stats->requested_ns += step->delay_ns;
+            deadline += step->delay_ns;
+            _mraa_gpio_waveform_wait_until(deadline);
+        }
+    }
+
+waveform_done:
+    stats->achieved_ns = _mraa_gpio_waveform_now() - start;
+    if (stats->steps > 0) {
+        stats->mean_late_ns = late_sum / stats->steps;
+    }
+
+    return NULL;
+}
+
+mraa_gpio_waveform_t
+mraa_gpio_waveform_init(mraa_gpio_context dev, const mraa_gpio_waveform_step_t* steps, unsigned int num_steps)
+{
+    mraa_gpio_waveform_t wf;
+
+    if (dev == NULL) {
+        syslog(LOG_ERR, "gpio waveform: context is invalid");
+        return NULL;
+    }
+
+    if (steps == NULL || num_steps == 0) {
+        syslog(LOG_ERR, "gpio waveform: no steps given");
+        return NULL;
+    }
+
+    wf = calloc(1, sizeof(struct _gpio_waveform));
+    if (wf == NULL) {
+        syslog(LOG_CRIT, "gpio waveform: Failed to allocate memory for waveform");
+        return NULL;
+    }
+
+    wf->dev = dev;
+    wf->num_steps = num_steps;
+    wf->steps = malloc(num_steps * sizeof(mraa_gpio_waveform_step_t));
+    if (wf->steps == NULL) {
+        syslog(LOG_CRIT, "gpio waveform: Failed to allocate memory for steps");
+        goto waveform_init_fail;
+    }
+    memcpy(wf->steps, steps, num_steps * sizeof(mraa_gpio_waveform_step_t));
+
+    /* With mmap banks every step is a handful of precomputed stores. */
+    wf->num_banks = mraa_gpio_mmap_num_banks(dev);
+    if (wf->num_banks > 0) {
+        wf->set_masks = malloc(num_steps * wf->num_banks * sizeof(uint32_t));
+        wf->clr_masks = malloc(num_steps * wf->num_banks * sizeof(uint32_t));
+        if (wf->set_masks == NULL || wf->clr_masks == NULL) {
+            syslog(LOG_CRIT, "gpio waveform: Failed to allocate memory for bank masks");
+            goto waveform_init_fail;
+        }
+        for (unsigned int i = 0; i < num_steps; ++i) {
+            mraa_gpio_mmap_compile_mask(dev, steps[i].value, steps[i].mask,
+                                        &wf->set_masks[i * wf->num_banks],
+                                        &wf->clr_masks[i * wf->num_banks]);
+        }
+    }
+
+    syslog(LOG_DEBUG, "gpio waveform: %u steps compiled for %s", num_steps,
+           wf->num_banks > 0 ? "mmap" : "masked writes");
+
+    return wf;
+
+waveform_init_fail:
+    free(wf->steps);
+    free(wf->set_masks);
+    free(wf->clr_masks);
+    free(wf);
+    return NULL;
+}
+
+mraa_result_t
+mraa_gpio_waveform_start(mraa_gpio_waveform_t wf, unsigned int repeat, int cpu, int priority)
+{
+    if (wf == NULL) {
+        syslog(LOG_ERR, "gpio waveform: waveform is invalid");
+        return MRAA_ERROR_INVALID_HANDLE;
+    }
+
+    if (wf->running) {
+        syslog(LOG_ERR, "gpio waveform: already running");
+        return MRAA_ERROR_INVALID_RESOURCE;
+    }
+
+    /* The masks point at the banks the waveform was compiled for. */
+    if (wf->num_banks != mraa_gpio_mmap_num_banks(wf->dev)) {
+        syslog(LOG_ERR, "gpio waveform: mmap was toggled since the waveform was compiled");
+        return MRAA_ERROR_INVALID_RESOURCE;
+    }
+
+    wf->repeat = repeat > 0 ? repeat : 1;
+    wf->cpu = cpu;
+    wf->priority = priority;
+    wf->stop = 0;
+    wf->result = MRAA_SUCCESS;
+
+    if (pthread_create(&wf->thread, NULL, _mraa_gpio_waveform_thread, wf) != 0) {
+        syslog(LOG_ERR, "gpio waveform: failed to start thread");
+        return MRAA_ERROR_NO_RESOURCES;
+    }
+    wf->running = 1;
+
+    return MRAA_SUCCESS;
+}
+
+mraa_result_t
+mraa_gpio_waveform_wait(mraa_gpio_waveform_t wf, mraa_gpio_waveform_stats_t* stats)
+{
+    if (wf == NULL) {
+        syslog(LOG_ERR, "gpio waveform: waveform is invalid");
+        return MRAA_ERROR_INVALID_HANDLE;
+    }
+
+    if (!wf->running) {
+        syslog(LOG_ERR, "gpio waveform: not started");
+        return MRAA_ERROR_INVALID_RESOURCE;
+    }
+
+    pthread_join(wf->thread, NULL);
+    wf->running = 0;
+
+    if (stats != NULL) {
+        *stats = wf->stats;
+    }
+
+    return wf->result;
+}
+
+mraa_result_t
+mraa_gpio_waveform_close(mraa_gpio_waveform_t wf)
+{
+    if (wf == NULL) {
+        syslog(LOG_ERR, "gpio waveform: waveform is invalid");
+        return MRAA_ERROR_INVALID_HANDLE;
+    }
+
+    if (wf->running) {
+        __atomic_store_n(&wf->stop, 1, __ATOMIC_RELAXED);
+        pthread_join(wf->thread, NULL);
+    }
+
+    free(wf->steps);
+    free(wf->set_masks);
+    free(wf->clr_masks);
+    free(wf);
+
+    return MRAA_SUCCESS;
+}
@@ -9,6 +9,7 @@
  */
 
 #include "i2c.h"
+#include "bus/bus_arbiter.h"
 #include "mraa_internal.h"
 
 #include <stdlib.h>
@@ -39,6 +40,8 @@ typedef struct i2c_smbus_ioctl_data_struct {
     i2c_smbus_data_t* data; ///< data
 } i2c_smbus_ioctl_data_t;
 
+/* The kernel refuses I2C_RDWR messages longer than this */
+#define I2C_MSG_MAX_LEN 8192
 
 // static mraa_adv_func_t* func_table;
 
@@ -55,6 +58,135 @@ mraa_i2c_smbus_access(int fh, uint8_t read_write, uint8_t command, int size, i2c
     return ioctl(fh, I2C_SMBUS, &args);
 }
 
+static void mraa_i2c_dispatch(mraa_bus_request_t* batch);
+
+/*
+ * Append one transfer to the caller's buffer as I2C_RDWR messages. Anything
+ * over the kernel's limit carries on in further messages without a new start
+ * where the adapter allows it, so it's still a single transfer on the bus.
+ *
+ * @return number of messages in m or -1 if the transfer doesn't fit
+ */
+static int
+mraa_i2c_rdwr_add(mraa_i2c_context dev, uint8_t addr, struct i2c_msg* m, int nmsgs, unsigned short flags, uint8_t* buf, int length)
+{
+    int offset = 0;
+
+    do {
+        int len = (length - offset > I2C_MSG_MAX_LEN) ? I2C_MSG_MAX_LEN : length - offset;
+        if (nmsgs == I2C_RDRW_IOCTL_MAX_MSGS || (offset > 0 && !(dev->funcs & I2C_FUNC_NOSTART))) {
+            return -1;
+        }
+        m[nmsgs].addr = addr;
+        m[nmsgs].flags = flags | (offset > 0 ? I2C_M_NOSTART : 0);
+        m[nmsgs].len = len;
+        m[nmsgs].buf = (char*) buf + offset;
+        nmsgs++;
+        offset += len;
+    } while (offset < length);
+
+    return nmsgs;
+}
+
+/*
+ * A write and/or a read, joined by a repeated start, to addr without going
+ * through the file descriptor's slave address.
+ */
+static mraa_result_t
+mraa_i2c_rdwr_at(mraa_i2c_context dev, uint8_t addr, const char* op, const uint8_t* wbuf, int wlength, uint8_t* rbuf, int rlength)
+{
+    struct i2c_rdwr_ioctl_data d;
+    struct i2c_msg m[I2C_RDRW_IOCTL_MAX_MSGS];
+
+    d.msgs = m;
+    d.nmsgs = 0;
+    if (wlength > 0) {
+        d.nmsgs = mraa_i2c_rdwr_add(dev, addr, m, d.nmsgs, 0, (uint8_t*) wbuf, wlength);
+    }
+    if (rlength > 0 && d.nmsgs >= 0) {
+        d.nmsgs = mraa_i2c_rdwr_add(dev, addr, m, d.nmsgs, I2C_M_RD, rbuf, rlength);
+    }
+    if (d.nmsgs < 0) {
+        syslog(LOG_ERR, "i2c%i: %s: transfer is more than the adapter can do at once", dev->busnum, op);
+        return MRAA_ERROR_INVALID_PARAMETER;
+    }
+
+    if (ioctl(dev->fh, I2C_RDWR, &d) < 0) {
+        syslog(LOG_ERR, "i2c%i: %s: Access error on 0x%02x: %s", dev->busnum, op, addr, strerror(errno));
+        return MRAA_ERROR_UNSPECIFIED;
+    }
+    return MRAA_SUCCESS;
+}
+
+#define I2C_CACHE_BIT(map, reg) ((map)[(reg) >> 5] & (1u << ((reg) & 31)))
+
+static mraa_i2c_cache_page_t*
+mraa_i2c_cache_page(mraa_i2c_context dev, int addr, mraa_boolean_t create)
+{
+    if (dev->cache == NULL || addr < 0 || addr > 0x7F) {
+        return NULL;
+    }
+    if (dev->cache->pages[addr] == NULL && create) {
+        dev->cache->pages[addr] = (mraa_i2c_cache_page_t*) calloc(1, sizeof(mraa_i2c_cache_page_t));
+        if (dev->cache->pages[addr] == NULL) {
+            syslog(LOG_CRIT, "i2c%i: cache: Failed to allocate memory for address 0x%02x", dev->busnum, addr);
+        }
+    }
+    return dev->cache->pages[addr];
+}
+
+/*
+ * Shadowed value of a register or -1 when it has to come from the bus
+ */
+static int
+mraa_i2c_cache_lookup(mraa_i2c_context dev, int addr, uint8_t reg)
+{
+    if (dev->cache == NULL) {
+        return -1;
+    }
+
+    mraa_i2c_cache_page_t* page = mraa_i2c_cache_page(dev, addr, 0);
+    if (page != NULL && I2C_CACHE_BIT(page->valid, reg) && !I2C_CACHE_BIT(page->uncached, reg)) {
+        dev->cache->hits++;
+        return page->value[reg];
+    }
+    dev->cache->misses++;
+    return -1;
+}
+
+static void
+mraa_i2c_cache_fill(mraa_i2c_context dev, int addr, uint8_t reg, int value)
+{
+    mraa_i2c_cache_page_t* page = mraa_i2c_cache_page(dev, addr, 1);
+    if (page == NULL || value < 0 || I2C_CACHE_BIT(page->uncached, reg)) {
+        return;
+    }
+    page->value[reg] = (uint8_t) value;
+    page->valid[reg >> 5] |= 1u << (reg & 31);
+}
+
+static void
+mraa_i2c_cache_drop(mraa_i2c_context dev, int addr, uint8_t reg)
+{
+    mraa_i2c_cache_page_t* page = mraa_i2c_cache_page(dev, addr, 0);
+    if (page != NULL) {
+        page->valid[reg >> 5] &= ~(1u << (reg & 31));
+    }
+}
+
+/*
+ * Raw writes don't say which registers they touch, the first byte isn't a
+ * register address on every device, so forget the whole slave.
+ */
+static void
+mraa_i2c_cache_drop_all(mraa_i2c_context dev, int addr)
+{
+    mraa_i2c_cache_page_t* page = mraa_i2c_cache_page(dev, addr, 0);
+    if (page != NULL) {
+        memset(page->valid, 0, sizeof(page->valid));
+    }
+}
+
 static mraa_i2c_context
 mraa_i2c_init_internal(mraa_adv_func_t* advance_func, unsigned int bus)
 {
@@ -106,6 +238,8 @@ mraa_i2c_init_internal(mraa_adv_func_t* advance_func, unsigned int bus)
 
 init_internal_cleanup:
     if (status == MRAA_SUCCESS) {
+        // Without an arbiter the context still works, just unserialised
+        dev->bus = mraa_bus_get(MRAA_BUS_I2C, advance_func, bus, mraa_i2c_dispatch);
         return dev;
     } else {
         if (dev != NULL)
@@ -185,6 +319,8 @@ mraa_i2c_frequency(mraa_i2c_context dev, mraa_i2c_mode_t mode)
         return MRAA_ERROR_INVALID_HANDLE;
     }
 
+    MRAA_BUS_LOCK_SCOPE(dev->bus);
+
     if (IS_FUNC_DEFINED(dev, i2c_set_frequency_replace)) {
         return dev->advance_func->i2c_set_frequency_replace(dev, mode);
     }
@@ -199,6 +335,8 @@ mraa_i2c_read(mraa_i2c_context dev, uint8_t* data, int length)
         return -1;
     }
 
+    MRAA_BUS_LOCK_SCOPE(dev->bus);
+
     int bytes_read = 0;
     if (IS_FUNC_DEFINED(dev, i2c_read_replace)) {
         bytes_read = dev->advance_func->i2c_read_replace(dev, data, length);
@@ -221,6 +359,8 @@ mraa_i2c_read_byte(mraa_i2c_context dev)
         return -1;
     }
 
+    MRAA_BUS_LOCK_SCOPE(dev->bus);
+
     if (IS_FUNC_DEFINED(dev, i2c_read_byte_replace))
         return dev->advance_func->i2c_read_byte_replace(dev);
     i2c_smbus_data_t d;
@@ -239,14 +379,24 @@ mraa_i2c_read_byte_data(mraa_i2c_context dev, uint8_t command)
         return -1;
     }
 
-    if (IS_FUNC_DEFINED(dev, i2c_read_byte_data_replace))
-        return dev->advance_func->i2c_read_byte_data_replace(dev, command);
-    i2c_smbus_data_t d;
-    if (mraa_i2c_smbus_access(dev->fh, I2C_SMBUS_READ, command, I2C_SMBUS_BYTE_DATA, &d) < 0) {
-       syslog(LOG_ERR, "i2c%i: read_byte_data: Access error: %s", dev->busnum, strerror(errno));
-       return -1;
+    MRAA_BUS_LOCK_SCOPE(dev->bus);
+
+    int value = mraa_i2c_cache_lookup(dev, dev->addr, command);
+    if (value >= 0)
+        return value;
+
+    if (IS_FUNC_DEFINED(dev, i2c_read_byte_data_replace)) {
+        value = dev->advance_func->i2c_read_byte_data_replace(dev, command);
+    } else {
+        i2c_smbus_data_t d;
+        if (mraa_i2c_smbus_access(dev->fh, I2C_SMBUS_READ, command, I2C_SMBUS_BYTE_DATA, &d) < 0) {
+           syslog(LOG_ERR, "i2c%i: read_byte_data: Access error: %s", dev->busnum, strerror(errno));
+           return -1;
+        }
+        value = 0x0FF & d.byte;
     }
-    return 0x0FF & d.byte;
+    mraa_i2c_cache_fill(dev, dev->addr, command, value);
+    return value;
 }
 
 int
@@ -257,6 +407,8 @@ mraa_i2c_read_word_data(mraa_i2c_context dev, uint8_t command)
         return -1;
     }
 
+    MRAA_BUS_LOCK_SCOPE(dev->bus);
+
     if (IS_FUNC_DEFINED(dev, i2c_read_word_data_replace))
         return dev->advance_func->i2c_read_word_data_replace(dev, command);
     i2c_smbus_data_t d;
@@ -275,22 +427,21 @@ mraa_i2c_read_bytes_data(mraa_i2c_context dev, uint8_t command, uint8_t* data, i
         return -1;
     }
 
+    MRAA_BUS_LOCK_SCOPE(dev->bus);
+
     if (IS_FUNC_DEFINED(dev, i2c_read_bytes_data_replace))
         return dev->advance_func->i2c_read_bytes_data_replace(dev, command, data, length);
     struct i2c_rdwr_ioctl_data d;
-    struct i2c_msg m[2];
-
-    m[0].addr = dev->addr;
-    m[0].flags = 0x00;
-    m[0].len = 1;
-    m[0].buf = (char*) &command;
-    m[1].addr = dev->addr;
-    m[1].flags = I2C_M_RD;
-    m[1].len = length;
-    m[1].buf = (char*) data;
+    struct i2c_msg m[I2C_RDRW_IOCTL_MAX_MSGS];
 
+    // Read straight into the caller's buffer, however long
     d.msgs = m;
-    d.nmsgs = 2;
+    d.nmsgs = mraa_i2c_rdwr_add(dev, dev->addr, m, 0, 0, &command, 1);
+    d.nmsgs = mraa_i2c_rdwr_add(dev, dev->addr, m, d.nmsgs, I2C_M_RD, data, length);
+    if (d.nmsgs < 0) {
+        syslog(LOG_ERR, "i2c%i: read_bytes_data: %d bytes is more than the adapter can read at once", dev->busnum, length);
+        return -1;
+    }
 
     int ret = ioctl(dev->fh, I2C_RDWR, &d);
 
@@ -310,27 +461,44 @@ mraa_i2c_write(mraa_i2c_context dev, const uint8_t* data, int length)
         return MRAA_ERROR_INVALID_HANDLE;
     }
 
+    MRAA_BUS_LOCK_SCOPE(dev->bus);
+
+    mraa_i2c_cache_drop_all(dev, dev->addr);
+
     if (IS_FUNC_DEFINED(dev, i2c_write_replace))
         return dev->advance_func->i2c_write_replace(dev, data, length);
+
+    if (length < 1) {
+        syslog(LOG_ERR, "i2c%i: write: Invalid length %d", dev->busnum, length);
+        return MRAA_ERROR_INVALID_PARAMETER;
+    }
+
+    // Plain i2c adapters send the caller's buffer as is, in one transfer
+    if (dev->funcs & I2C_FUNC_I2C) {
+        return mraa_i2c_rdwr_at(dev, dev->addr, "write", data, length, NULL, 0);
+    }
+
+    // SMBus only, the first byte goes out as the command of one block write.
+    // Splitting a longer write would need the slave to auto-increment its
+    // register, which not every device does
     i2c_smbus_data_t d;
-    int i;
     uint8_t command = data[0];
 
     data = &data[1];
     length = length - 1;
     if (length > I2C_SMBUS_I2C_BLOCK_MAX) {
-        length = I2C_SMBUS_I2C_BLOCK_MAX;
+        syslog(LOG_ERR, "i2c%i: write: adapter is SMBus only, %d bytes don't fit one %d byte block",
+               dev->busnum, length, I2C_SMBUS_I2C_BLOCK_MAX);
+        return MRAA_ERROR_FEATURE_NOT_SUPPORTED;
     }
 
-    for (i = 1; i <= length; i++) {
-        d.block[i] = data[i - 1];
-    }
+    memcpy(&d.block[1], data, length);
     d.block[0] = length;
-
     if (mraa_i2c_smbus_access(dev->fh, I2C_SMBUS_WRITE, command, I2C_SMBUS_I2C_BLOCK_DATA, &d) < 0) {
         syslog(LOG_ERR, "i2c%i: write: Access error: %s", dev->busnum, strerror(errno));
         return MRAA_ERROR_UNSPECIFIED;
     }
+
     return MRAA_SUCCESS;
 }
 
@@ -342,6 +510,11 @@ mraa_i2c_write_byte(mraa_i2c_context dev, const uint8_t data)
         return MRAA_ERROR_INVALID_HANDLE;
     }
 
+    MRAA_BUS_LOCK_SCOPE(dev->bus);
+
+    // A lone byte is a command or a register pointer, either may change any register
+    mraa_i2c_cache_drop_all(dev, dev->addr);
+
     if (IS_FUNC_DEFINED(dev, i2c_write_byte_replace)) {
         return dev->advance_func->i2c_write_byte_replace(dev, data);
     } else {
@@ -361,15 +534,27 @@ mraa_i2c_write_byte_data(mraa_i2c_context dev, const uint8_t data, const uint8_t
         return MRAA_ERROR_INVALID_HANDLE;
     }
 
-    if (IS_FUNC_DEFINED(dev, i2c_write_byte_data_replace))
-        return dev->advance_func->i2c_write_byte_data_replace(dev, data, command);
-    i2c_smbus_data_t d;
-    d.byte = data;
-    if (mraa_i2c_smbus_access(dev->fh, I2C_SMBUS_WRITE, command, I2C_SMBUS_BYTE_DATA, &d) < 0) {
-        syslog(LOG_ERR, "i2c%i: write_byte_data: Access error: %s", dev->busnum, strerror(errno));
-        return MRAA_ERROR_UNSPECIFIED;
+    MRAA_BUS_LOCK_SCOPE(dev->bus);
+
+    mraa_result_t status = MRAA_SUCCESS;
+    if (IS_FUNC_DEFINED(dev, i2c_write_byte_data_replace)) {
+        status = dev->advance_func->i2c_write_byte_data_replace(dev, data, command);
+    } else {
+        i2c_smbus_data_t d;
+        d.byte = data;
+        if (mraa_i2c_smbus_access(dev->fh, I2C_SMBUS_WRITE, command, I2C_SMBUS_BYTE_DATA, &d) < 0) {
+            syslog(LOG_ERR, "i2c%i: write_byte_data: Access error: %s", dev->busnum, strerror(errno));
+            status = MRAA_ERROR_UNSPECIFIED;
+        }
     }
-    return MRAA_SUCCESS;
+
+    // Write through, on failure the register is in an unknown state
+    if (status == MRAA_SUCCESS) {
+        mraa_i2c_cache_fill(dev, dev->addr, command, data);
+    } else {
+        mraa_i2c_cache_drop(dev, dev->addr, command);
+    }
+    return status;
 }
 
 mraa_result_t
@@ -380,6 +565,13 @@ mraa_i2c_write_word_data(mraa_i2c_context dev, const uint16_t data, const uint8_
         return MRAA_ERROR_INVALID_HANDLE;
     }
 
+    MRAA_BUS_LOCK_SCOPE(dev->bus);
+
+    mraa_i2c_cache_drop(dev, dev->addr, command);
+    if (command < 0xff) {
+        mraa_i2c_cache_drop(dev, dev->addr, command + 1);
+    }
+
     if (IS_FUNC_DEFINED(dev, i2c_write_word_data_replace))
         return dev->advance_func->i2c_write_word_data_replace(dev, data, command);
     i2c_smbus_data_t d;
@@ -399,6 +591,8 @@ mraa_i2c_address(mraa_i2c_context dev, uint8_t addr)
         return MRAA_ERROR_INVALID_HANDLE;
     }
 
+    MRAA_BUS_LOCK_SCOPE(dev->bus);
+
     dev->addr = (int) addr;
     if (IS_FUNC_DEFINED(dev, i2c_address_replace)) {
         return dev->advance_func->i2c_address_replace(dev, addr);
@@ -411,6 +605,292 @@ mraa_i2c_address(mraa_i2c_context dev, uint8_t addr)
     }
 }
 
+/*
+ * The addressed calls go straight to I2C_RDWR. Boards replacing the bus and
+ * SMBus only adapters have no way around the slave address, so there the
+ * plain call runs with the address switched for its duration.
+ */
+static mraa_boolean_t
+mraa_i2c_at_direct(mraa_i2c_context dev)
+{
+    return !IS_FUNC_DEFINED(dev, i2c_init_bus_replace) && (dev->funcs & I2C_FUNC_I2C);
+}
+
+static mraa_boolean_t
+mraa_i2c_at_valid(mraa_i2c_context dev, uint8_t addr, const char* op)
+{
+    if (dev == NULL) {
+        syslog(LOG_ERR, "i2c: %s: context is invalid", op);
+        return 0;
+    }
+    if (addr > 0x7F) {
+        syslog(LOG_ERR, "i2c%i: %s: Invalid 7-bit address 0x%X", dev->busnum, op, addr);
+        return 0;
+    }
+    return 1;
+}
+
+typedef struct {
+    mraa_i2c_context dev;
+    int prev; /**< slave address to put back */
+    mraa_result_t status; /**< result of switching to the new one */
+} mraa_i2c_at_scope_t;
+
+static mraa_i2c_at_scope_t
+mraa_i2c_at_enter(mraa_i2c_context dev, uint8_t addr)
+{
+    mraa_i2c_at_scope_t scope = { dev, dev->addr, MRAA_SUCCESS };
+
+    scope.status = mraa_i2c_address(dev, addr);
+    return scope;
+}
+
+static void
+mraa_i2c_at_leave(mraa_i2c_at_scope_t* scope)
+{
+    // Put it back even if the switch failed, dev->addr was changed anyway
+    mraa_i2c_address(scope->dev, (uint8_t) scope->prev);
+}
+
+/**
+ * Talk to addr through the plain calls until the end of the enclosing block,
+ * mraa_i2c_at_scope_.status says whether the address could be switched
+ */
+#define MRAA_I2C_AT_SCOPE(dev, addr)                                                              \
+    mraa_i2c_at_scope_t mraa_i2c_at_scope_ __attribute__((cleanup(mraa_i2c_at_leave))) =          \
+    mraa_i2c_at_enter(dev, addr)
+
+int
+mraa_i2c_read_at(mraa_i2c_context dev, uint8_t addr, uint8_t* data, int length)
+{
+    if (!mraa_i2c_at_valid(dev, addr, "read_at")) {
+        return -1;
+    }
+
+    MRAA_BUS_LOCK_SCOPE(dev->bus);
+
+    if (!mraa_i2c_at_direct(dev)) {
+        MRAA_I2C_AT_SCOPE(dev, addr);
+        if (mraa_i2c_at_scope_.status != MRAA_SUCCESS) {
+            return -1;
+        }
+        return mraa_i2c_read(dev, data, length);
+    }
+
+    if (length < 1) {
+        syslog(LOG_ERR, "i2c%i: read_at: Invalid length %d", dev->busnum, length);
+        return -1;
+    }
+    if (mraa_i2c_rdwr_at(dev, addr, "read_at", NULL, 0, data, length) != MRAA_SUCCESS) {
+        return -1;
+    }
+    return length;
+}
+
+int
+mraa_i2c_read_byte_at(mraa_i2c_context dev, uint8_t addr)
+{
+    if (!mraa_i2c_at_valid(dev, addr, "read_byte_at")) {
+        return -1;
+    }
+
+    MRAA_BUS_LOCK_SCOPE(dev->bus);
+
+    if (!mraa_i2c_at_direct(dev)) {
+        MRAA_I2C_AT_SCOPE(dev, addr);
+        if (mraa_i2c_at_scope_.status != MRAA_SUCCESS) {
+            return -1;
+        }
+        return mraa_i2c_read_byte(dev);
+    }
+
+    uint8_t value;
+    if (mraa_i2c_rdwr_at(dev, addr, "read_byte_at", NULL, 0, &value, 1) != MRAA_SUCCESS) {
+        return -1;
+    }
+    return value;
+}
+
+int
+mraa_i2c_read_byte_data_at(mraa_i2c_context dev, uint8_t addr, const uint8_t command)
+{
+    if (!mraa_i2c_at_valid(dev, addr, "read_byte_data_at")) {
+        return -1;
+    }
+
+    MRAA_BUS_LOCK_SCOPE(dev->bus);
+
+    if (!mraa_i2c_at_direct(dev)) {
+        MRAA_I2C_AT_SCOPE(dev, addr);
+        if (mraa_i2c_at_scope_.status != MRAA_SUCCESS) {
+            return -1;
+        }
+        return mraa_i2c_read_byte_data(dev, command);
+    }
+
+    int cached = mraa_i2c_cache_lookup(dev, addr, command);
+    if (cached >= 0) {
+        return cached;
+    }
+
+    uint8_t value;
+    if (mraa_i2c_rdwr_at(dev, addr, "read_byte_data_at", &command, 1, &value, 1) != MRAA_SUCCESS) {
+        return -1;
+    }
+    mraa_i2c_cache_fill(dev, addr, command, value);
+    return value;
+}
+
+int
+mraa_i2c_read_word_data_at(mraa_i2c_context dev, uint8_t addr, const uint8_t command)
+{
+    if (!mraa_i2c_at_valid(dev, addr, "read_word_data_at")) {
+        return -1;
+    }
+
+    MRAA_BUS_LOCK_SCOPE(dev->bus);
+
+    if (!mraa_i2c_at_direct(dev)) {
+        MRAA_I2C_AT_SCOPE(dev, addr);
+        if (mraa_i2c_at_scope_.status != MRAA_SUCCESS) {
+            return -1;
+        }
+        return mraa_i2c_read_word_data(dev, command);
+    }
+
+    // SMBus words are little endian on the wire
+    uint8_t value[2];
+    if (mraa_i2c_rdwr_at(dev, addr, "read_word_data_at", &command, 1, value, 2) != MRAA_SUCCESS) {
+        return -1;
+    }
+    return value[0] | (value[1] << 8);
+}
+
+int
+mraa_i2c_read_bytes_data_at(mraa_i2c_context dev, uint8_t addr, uint8_t command, uint8_t* data, int length)
+{
+    if (!mraa_i2c_at_valid(dev, addr, "read_bytes_data_at")) {
+        return -1;
+    }
+
+    MRAA_BUS_LOCK_SCOPE(dev->bus);
+
+    if (!mraa_i2c_at_direct(dev)) {
+        MRAA_I2C_AT_SCOPE(dev, addr);
+        if (mraa_i2c_at_scope_.status != MRAA_SUCCESS) {
+            return -1;
+        }
+        return mraa_i2c_read_bytes_data(dev, command, data, length);
+    }
+
+    if (length < 1) {
+        syslog(LOG_ERR, "i2c%i: read_bytes_data_at: Invalid length %d", dev->busnum, length);
+        return -1;
+    }
+    if (mraa_i2c_rdwr_at(dev, addr, "read_bytes_data_at", &command, 1, data, length) != MRAA_SUCCESS) {
+        return -1;
+    }
+    return length;
+}
+
+mraa_result_t
+mraa_i2c_write_at(mraa_i2c_context dev, uint8_t addr, const uint8_t* data, int length)
+{
+    if (!mraa_i2c_at_valid(dev, addr, "write_at")) {
+        return MRAA_ERROR_INVALID_PARAMETER;
+    }
+
+    MRAA_BUS_LOCK_SCOPE(dev->bus);
+
+    if (!mraa_i2c_at_direct(dev)) {
+        MRAA_I2C_AT_SCOPE(dev, addr);
+        if (mraa_i2c_at_scope_.status != MRAA_SUCCESS) {
+            return MRAA_ERROR_UNSPECIFIED;
+        }
+        return mraa_i2c_write(dev, data, length);
+    }
+
+    if (length < 1) {
+        syslog(LOG_ERR, "i2c%i: write_at: Invalid length %d", dev->busnum, length);
+        return MRAA_ERROR_INVALID_PARAMETER;
+    }
+    mraa_i2c_cache_drop_all(dev, addr);
+    return mraa_i2c_rdwr_at(dev, addr, "write_at", data, length, NULL, 0);
+}
+
+mraa_result_t
+mraa_i2c_write_byte_at(mraa_i2c_context dev, uint8_t addr, const uint8_t data)
+{
+    if (!mraa_i2c_at_valid(dev, addr, "write_byte_at")) {
+        return MRAA_ERROR_INVALID_PARAMETER;
+    }
+
+    MRAA_BUS_LOCK_SCOPE(dev->bus);
+
+    if (!mraa_i2c_at_direct(dev)) {
+        MRAA_I2C_AT_SCOPE(dev, addr);
+        if (mraa_i2c_at_scope_.status != MRAA_SUCCESS) {
+            return MRAA_ERROR_UNSPECIFIED;
+        }
+        return mraa_i2c_write_byte(dev, data);
+    }
+
+    mraa_i2c_cache_drop_all(dev, addr);
+    return mraa_i2c_rdwr_at(dev, addr, "write_byte_at", &data, 1, NULL, 0);
+}
+
+mraa_result_t
+mraa_i2c_write_byte_data_at(mraa_i2c_context dev, uint8_t addr, const uint8_t data, const uint8_t command)
+{
+    if (!mraa_i2c_at_valid(dev, addr, "write_byte_data_at")) {
+        return MRAA_ERROR_INVALID_PARAMETER;
+    }
+
+    MRAA_BUS_LOCK_SCOPE(dev->bus);
+
+    if (!mraa_i2c_at_direct(dev)) {
+        MRAA_I2C_AT_SCOPE(dev, addr);
+        if (mraa_i2c_at_scope_.status != MRAA_SUCCESS) {
+            return MRAA_ERROR_UNSPECIFIED;
+        }
+        return mraa_i2c_write_byte_data(dev, data, command);
+    }
+
+    uint8_t buf[2] = { command, data };
+    mraa_result_t status = mraa_i2c_rdwr_at(dev, addr, "write_byte_data_at", buf, 2, NULL, 0);
+    if (status == MRAA_SUCCESS) {
+        mraa_i2c_cache_fill(dev, addr, command, data);
+    } else {
+        mraa_i2c_cache_drop(dev, addr, command);
+    }
+    return status;
+}
+
+mraa_result_t
+mraa_i2c_write_word_data_at(mraa_i2c_context dev, uint8_t addr, const uint16_t data, const uint8_t command)
+{
+    if (!mraa_i2c_at_valid(dev, addr, "write_word_data_at")) {
+        return MRAA_ERROR_INVALID_PARAMETER;
+    }
+
+    MRAA_BUS_LOCK_SCOPE(dev->bus);
+
+    if (!mraa_i2c_at_direct(dev)) {
+        MRAA_I2C_AT_SCOPE(dev, addr);
+        if (mraa_i2c_at_scope_.status != MRAA_SUCCESS) {
+            return MRAA_ERROR_UNSPECIFIED;
+        }
+        return mraa_i2c_write_word_data(dev, data, command);
+    }
+
+    mraa_i2c_cache_drop(dev, addr, command);
+    if (command < 0xff) {
+        mraa_i2c_cache_drop(dev, addr, command + 1);
+    }
+
+    uint8_t buf[3] = { command, data & 0xFF, data >> 8 };
+    return mraa_i2c_rdwr_at(dev, addr, "write_word_data_at", buf, 3, NULL, 0);
+}
 
 mraa_result_t
 mraa_i2c_stop(mraa_i2c_context dev)
@@ -420,6 +900,14 @@ mraa_i2c_stop(mraa_i2c_context dev)
         return MRAA_ERROR_INVALID_HANDLE;
     }
 
+    if (mraa_bus_flush(dev->bus, dev) != MRAA_SUCCESS) {
+        syslog(LOG_ERR, "i2c%i: stop: bus is locked by this thread, unlock it first", dev->busnum);
+        return MRAA_ERROR_INVALID_RESOURCE;
+    }
+    mraa_i2c_cache_enable(dev, 0);
+    mraa_bus_put(dev->bus);
+    dev->bus = NULL;
+
     if (IS_FUNC_DEFINED(dev, i2c_stop_replace)) {
         return dev->advance_func->i2c_stop_replace(dev);
     }
@@ -429,3 +917,534 @@ mraa_i2c_stop(mraa_i2c_context dev)
     return MRAA_SUCCESS;
 }
 
+
+mraa_i2c_txn_t
+mraa_i2c_txn_init(mraa_i2c_context dev)
+{
+    if (dev == NULL) {
+        syslog(LOG_ERR, "i2c: txn_init: context is invalid");
+        return NULL;
+    }
+
+    mraa_i2c_txn_t txn = (mraa_i2c_txn_t) calloc(1, sizeof(struct _i2c_txn));
+    if (txn == NULL) {
+        syslog(LOG_CRIT, "i2c%i: txn_init: Failed to allocate memory for transaction", dev->busnum);
+        return NULL;
+    }
+    txn->dev = dev;
+
+    return txn;
+}
+
+static mraa_i2c_txn_msg_t*
+mraa_i2c_txn_add_msg(mraa_i2c_txn_t txn, uint8_t address, int length)
+{
+    if (length <= 0 || length > I2C_MSG_MAX_LEN) {
+        syslog(LOG_ERR, "i2c%i: txn: Invalid message length %d", txn->dev->busnum, length);
+        return NULL;
+    }
+
+    if (txn->num_msgs == txn->max_msgs) {
+        unsigned int max_msgs = txn->max_msgs == 0 ? 8 : txn->max_msgs * 2;
+        mraa_i2c_txn_msg_t* msgs = (mraa_i2c_txn_msg_t*) realloc(txn->msgs, max_msgs * sizeof(mraa_i2c_txn_msg_t));
+        if (msgs == NULL) {
+            syslog(LOG_CRIT, "i2c%i: txn: Failed to allocate memory for messages", txn->dev->busnum);
+            return NULL;
+        }
+        txn->msgs = msgs;
+        txn->max_msgs = max_msgs;
+    }
+
+    mraa_i2c_txn_msg_t* msg = &txn->msgs[txn->num_msgs];
+    memset(msg, 0, sizeof(mraa_i2c_txn_msg_t));
+    msg->addr = address;
+    msg->len = length;
+
+    return msg;
+}
+
+static mraa_result_t
+mraa_i2c_txn_copy_write(mraa_i2c_txn_t txn, mraa_i2c_txn_msg_t* msg, const uint8_t* data)
+{
+    if (txn->pool_len + msg->len > txn->pool_size) {
+        size_t pool_size = txn->pool_size == 0 ? 64 : txn->pool_size;
+        while (pool_size < txn->pool_len + msg->len) {
+            pool_size *= 2;
+        }
+        uint8_t* pool = (uint8_t*) realloc(txn->pool, pool_size);
+        if (pool == NULL) {
+            syslog(LOG_CRIT, "i2c%i: txn: Failed to allocate memory for write data", txn->dev->busnum);
+            return MRAA_ERROR_NO_RESOURCES;
+        }
+        txn->pool = pool;
+        txn->pool_size = pool_size;
+    }
+
+    // Only the offset is stable, the pool may move as it grows
+    msg->offset = txn->pool_len;
+    memcpy(txn->pool + msg->offset, data, msg->len);
+    txn->pool_len += msg->len;
+
+    return MRAA_SUCCESS;
+}
+
+mraa_result_t
+mraa_i2c_txn_add_write(mraa_i2c_txn_t txn, uint8_t address, const uint8_t* data, int length)
+{
+    if (txn == NULL || data == NULL) {
+        syslog(LOG_ERR, "i2c: txn_add_write: transaction or data is invalid");
+        return MRAA_ERROR_INVALID_PARAMETER;
+    }
+
+    mraa_i2c_txn_msg_t* msg = mraa_i2c_txn_add_msg(txn, address, length);
+    if (msg == NULL) {
+        return MRAA_ERROR_INVALID_PARAMETER;
+    }
+    mraa_result_t status = mraa_i2c_txn_copy_write(txn, msg, data);
+    if (status != MRAA_SUCCESS) {
+        return status;
+    }
+    txn->num_msgs++;
+
+    return MRAA_SUCCESS;
+}
+
+mraa_result_t
+mraa_i2c_txn_add_read(mraa_i2c_txn_t txn, uint8_t address, uint8_t* data, int length)
+{
+    if (txn == NULL || data == NULL) {
+        syslog(LOG_ERR, "i2c: txn_add_read: transaction or data is invalid");
+        return MRAA_ERROR_INVALID_PARAMETER;
+    }
+
+    mraa_i2c_txn_msg_t* msg = mraa_i2c_txn_add_msg(txn, address, length);
+    if (msg == NULL) {
+        return MRAA_ERROR_INVALID_PARAMETER;
+    }
+    msg->read = 1;
+    msg->data = data;
+    txn->num_msgs++;
+
+    return MRAA_SUCCESS;
+}
+
+mraa_result_t
+mraa_i2c_txn_add_write_read(mraa_i2c_txn_t txn, uint8_t address, const uint8_t* wdata, int wlength, uint8_t* rdata, int rlength)
+{
+    if (txn == NULL) {
+        syslog(LOG_ERR, "i2c: txn_add_write_read: transaction is invalid");
+        return MRAA_ERROR_INVALID_PARAMETER;
+    }
+
+    mraa_result_t status = mraa_i2c_txn_add_write(txn, address, wdata, wlength);
+    if (status != MRAA_SUCCESS) {
+        return status;
+    }
+    status = mraa_i2c_txn_add_read(txn, address, rdata, rlength);
+    if (status != MRAA_SUCCESS) {
+        // Don't leave half a pair queued
+        txn->num_msgs--;
+        txn->pool_len -= wlength;
+        return status;
+    }
+    txn->msgs[txn->num_msgs - 2].joined = 1;
+
+    return MRAA_SUCCESS;
+}
+
+/*
+ * For platforms replacing the bus without a transaction hook, one message at
+ * a time through the replaced calls, a joined single byte write and read
+ * becoming a register read. The replaced calls have no repeated start after
+ * a longer write, such a pair fails the transaction before anything is sent.
+ */
+static mraa_result_t
+mraa_i2c_txn_submit_each(mraa_i2c_context dev, mraa_i2c_txn_t txn)
+{
+    mraa_result_t status = MRAA_SUCCESS;
+    uint8_t addr = (uint8_t) dev->addr;
+    unsigned int i;
+
+    for (i = 0; i < txn->num_msgs; ++i) {
+        if (txn->msgs[i].joined && txn->msgs[i].len != 1) {
+            syslog(LOG_ERR, "i2c%i: txn_submit: No repeated start after a %d byte write on this platform",
+                   dev->busnum, txn->msgs[i].len);
+            return MRAA_ERROR_FEATURE_NOT_SUPPORTED;
+        }
+    }
+
+    for (i = 0; i < txn->num_msgs && status == MRAA_SUCCESS; ++i) {
+        mraa_i2c_txn_msg_t* msg = &txn->msgs[i];
+
+        status = mraa_i2c_address(dev, msg->addr);
+        if (status != MRAA_SUCCESS) {
+            break;
+        }
+        if (msg->joined && msg->len == 1) {
+            mraa_i2c_txn_msg_t* next = &txn->msgs[++i];
+            if (mraa_i2c_read_bytes_data(dev, msg->data[0], next->data, next->len) != next->len) {
+                status = MRAA_ERROR_UNSPECIFIED;
+            }
+        } else if (msg->read) {
+            if (mraa_i2c_read(dev, msg->data, msg->len) != msg->len) {
+                status = MRAA_ERROR_UNSPECIFIED;
+            }
+        } else {
+            status = mraa_i2c_write(dev, msg->data, msg->len);
+        }
+    }
+
+    mraa_i2c_address(dev, addr);
+    return status;
+}
+
+/*
+ * Point the write messages at their data, which may have moved while the
+ * pool grew, and forget the shadow of every slave written to.
+ */
+static void
+mraa_i2c_txn_prepare(mraa_i2c_txn_t txn)
+{
+    unsigned int i;
+
+    for (i = 0; i < txn->num_msgs; ++i) {
+        if (!txn->msgs[i].read) {
+            txn->msgs[i].data = txn->pool + txn->msgs[i].offset;
+            mraa_i2c_cache_drop_all(txn->dev, txn->msgs[i].addr);
+        }
+    }
+}
+
+static int
+mraa_i2c_txn_pack(mraa_i2c_txn_t txn, unsigned int first, struct i2c_msg* m, int nmsgs, int max_msgs)
+{
+    unsigned int i;
+
+    for (i = first; i < txn->num_msgs && nmsgs < max_msgs; ++i) {
+        mraa_i2c_txn_msg_t* msg = &txn->msgs[i];
+        // A joined pair goes into the next ioctl rather than being split
+        if (msg->joined && nmsgs == max_msgs - 1) {
+            break;
+        }
+        m[nmsgs].addr = msg->addr;
+        m[nmsgs].flags = msg->read ? I2C_M_RD : 0;
+        m[nmsgs].len = msg->len;
+        m[nmsgs].buf = (char*) msg->data;
+        nmsgs++;
+    }
+
+    return nmsgs;
+}
+
+static mraa_result_t
+mraa_i2c_txn_rdwr(mraa_i2c_context dev, mraa_i2c_txn_t txn)
+{
+    struct i2c_msg m[I2C_RDRW_IOCTL_MAX_MSGS];
+    struct i2c_rdwr_ioctl_data d;
+    unsigned int i;
+
+    d.msgs = m;
+    for (i = 0; i < txn->num_msgs; i += d.nmsgs) {
+        d.nmsgs = mraa_i2c_txn_pack(txn, i, m, 0, I2C_RDRW_IOCTL_MAX_MSGS);
+        if (ioctl(dev->fh, I2C_RDWR, &d) < 0) {
+            syslog(LOG_ERR, "i2c%i: txn_submit: Access error: %s", dev->busnum, strerror(errno));
+            return MRAA_ERROR_UNSPECIFIED;
+        }
+    }
+
+    return MRAA_SUCCESS;
+}
+
+static mraa_result_t
+mraa_i2c_txn_submit_locked(mraa_i2c_txn_t txn)
+{
+    mraa_i2c_context dev = txn->dev;
+
+    mraa_i2c_txn_prepare(txn);
+
+    if (IS_FUNC_DEFINED(dev, i2c_txn_submit_replace)) {
+        return dev->advance_func->i2c_txn_submit_replace(dev, txn);
+    }
+    if (IS_FUNC_DEFINED(dev, i2c_init_bus_replace)) {
+        return mraa_i2c_txn_submit_each(dev, txn);
+    }
+
+    if (dev->funcs != 0 && !(dev->funcs & I2C_FUNC_I2C)) {
+        syslog(LOG_ERR, "i2c%i: txn_submit: Adapter does not support plain i2c transfers", dev->busnum);
+        return MRAA_ERROR_FEATURE_NOT_SUPPORTED;
+    }
+
+    return mraa_i2c_txn_rdwr(dev, txn);
+}
+
+mraa_result_t
+mraa_i2c_txn_submit(mraa_i2c_txn_t txn)
+{
+    if (txn == NULL) {
+        syslog(LOG_ERR, "i2c: txn_submit: transaction is invalid");
+        return MRAA_ERROR_INVALID_HANDLE;
+    }
+
+    MRAA_BUS_LOCK_SCOPE(txn->dev->bus);
+
+    return mraa_i2c_txn_submit_locked(txn);
+}
+
+static mraa_boolean_t
+mraa_i2c_txn_direct(mraa_i2c_txn_t txn)
+{
+    mraa_i2c_context dev = txn->dev;
+
+    return !IS_FUNC_DEFINED(dev, i2c_txn_submit_replace) && mraa_i2c_at_direct(dev) &&
+           txn->num_msgs <= I2C_RDRW_IOCTL_MAX_MSGS;
+}
+
+/*
+ * Send the transactions of [first, end) in as few I2C_RDWR calls as possible.
+ * Transactions aren't split, a failed call fails every transaction in it.
+ */
+static void
+mraa_i2c_dispatch_rdwr(mraa_bus_request_t* first, mraa_bus_request_t* end)
+{
+    struct i2c_msg m[I2C_RDRW_IOCTL_MAX_MSGS];
+    struct i2c_rdwr_ioctl_data d;
+    mraa_bus_request_t* req = first;
+    mraa_i2c_context dev = ((mraa_i2c_txn_t) first->payload)->dev;
+
+    d.msgs = m;
+    while (req != end) {
+        mraa_bus_request_t* pending = req;
+        mraa_result_t status = MRAA_SUCCESS;
+
+        d.nmsgs = 0;
+        while (req != end && d.nmsgs + ((mraa_i2c_txn_t) req->payload)->num_msgs <= I2C_RDRW_IOCTL_MAX_MSGS) {
+            mraa_i2c_txn_t txn = (mraa_i2c_txn_t) req->payload;
+            mraa_i2c_txn_prepare(txn);
+            d.nmsgs = mraa_i2c_txn_pack(txn, 0, m, d.nmsgs, I2C_RDRW_IOCTL_MAX_MSGS);
+            req = req->next;
+        }
+
+        if (d.nmsgs > 0 && ioctl(dev->fh, I2C_RDWR, &d) < 0) {
+            syslog(LOG_ERR, "i2c%i: submit: Access error: %s", dev->busnum, strerror(errno));
+            status = MRAA_ERROR_UNSPECIFIED;
+        }
+        for (; pending != req; pending = pending->next) {
+            pending->result = status;
+        }
+    }
+}
+
+/*
+ * Bus worker dispatch. Runs of direct transactions are merged into shared
+ * I2C_RDWR calls, everything else is submitted one at a time.
+ */
+static void
+mraa_i2c_dispatch(mraa_bus_request_t* batch)
+{
+    mraa_bus_request_t* req = batch;
+
+    while (req != NULL) {
+        mraa_i2c_txn_t txn = (mraa_i2c_txn_t) req->payload;
+
+        if (!mraa_i2c_txn_direct(txn)) {
+            req->result = mraa_i2c_txn_submit_locked(txn);
+            req = req->next;
+            continue;
+        }
+
+        mraa_bus_request_t* end = req->next;
+        while (end != NULL && mraa_i2c_txn_direct((mraa_i2c_txn_t) end->payload)) {
+            end = end->next;
+        }
+        mraa_i2c_dispatch_rdwr(req, end);
+        req = end;
+    }
+}
+
+mraa_result_t
+mraa_i2c_submit(mraa_i2c_txn_t txn, mraa_i2c_callback_t callback, void* data)
+{
+    mraa_bus_request_t req = { 0 };
+
+    if (txn == NULL) {
+        syslog(LOG_ERR, "i2c: submit: transaction is invalid");
+        return MRAA_ERROR_INVALID_HANDLE;
+    }
+
+    req.dev = txn->dev;
+    req.payload = txn;
+    req.callback = callback;
+    req.data = data;
+
+    return mraa_bus_submit(txn->dev->bus, &req);
+}
+
+mraa_result_t
+mraa_i2c_lock(mraa_i2c_context dev)
+{
+    if (dev == NULL) {
+        syslog(LOG_ERR, "i2c: lock: context is invalid");
+        return MRAA_ERROR_INVALID_HANDLE;
+    }
+
+    mraa_bus_lock(dev->bus);
+    return MRAA_SUCCESS;
+}
+
+mraa_result_t
+mraa_i2c_unlock(mraa_i2c_context dev)
+{
+    if (dev == NULL) {
+        syslog(LOG_ERR, "i2c: unlock: context is invalid");
+        return MRAA_ERROR_INVALID_HANDLE;
+    }
+
+    mraa_bus_unlock(dev->bus);
+    return MRAA_SUCCESS;
+}
+
+mraa_result_t
+mraa_i2c_txn_clear(mraa_i2c_txn_t txn)
+{
+    if (txn == NULL) {
+        syslog(LOG_ERR, "i2c: txn_clear: transaction is invalid");
+        return MRAA_ERROR_INVALID_HANDLE;
+    }
+
+    txn->num_msgs = 0;
+    txn->pool_len = 0;
+
+    return MRAA_SUCCESS;
+}
+
+mraa_result_t
+mraa_i2c_txn_free(mraa_i2c_txn_t txn)
+{
+    if (txn == NULL) {
+        syslog(LOG_ERR, "i2c: txn_free: transaction is invalid");
+        return MRAA_ERROR_INVALID_HANDLE;
+    }
+
+    free(txn->msgs);
+    free(txn->pool);
+    free(txn);
+
+    return MRAA_SUCCESS;
+}
+
+mraa_result_t
+mraa_i2c_cache_enable(mraa_i2c_context dev, mraa_boolean_t enable)
+{
+    if (dev == NULL) {
+        syslog(LOG_ERR, "i2c: cache_enable: context is invalid");
+        return MRAA_ERROR_INVALID_HANDLE;
+    }
+
+    MRAA_BUS_LOCK_SCOPE(dev->bus);
+
+    if (!enable) {
+        if (dev->cache != NULL) {
+            unsigned int i;
+            for (i = 0; i < 128; ++i) {
+                free(dev->cache->pages[i]);
+            }
+            free(dev->cache);
+            dev->cache = NULL;
+        }
+        return MRAA_SUCCESS;
+    }
+
+    if (dev->cache == NULL) {
+        dev->cache = (struct _i2c_cache*) calloc(1, sizeof(struct _i2c_cache));
+        if (dev->cache == NULL) {
+            syslog(LOG_CRIT, "i2c%i: cache_enable: Failed to allocate memory for cache", dev->busnum);
+            return MRAA_ERROR_NO_RESOURCES;
+        }
+    }
+    return MRAA_SUCCESS;
+}
+
+mraa_result_t
+mraa_i2c_cache_volatile(mraa_i2c_context dev, uint8_t command, mraa_boolean_t is_volatile)
+{
+    if (dev == NULL) {
+        syslog(LOG_ERR, "i2c: cache_volatile: context is invalid");
+        return MRAA_ERROR_INVALID_HANDLE;
+    }
+
+    MRAA_BUS_LOCK_SCOPE(dev->bus);
+
+    mraa_i2c_cache_page_t* page = mraa_i2c_cache_page(dev, dev->addr, 1);
+    if (page == NULL) {
+        syslog(LOG_ERR, "i2c%i: cache_volatile: cache is not enabled", dev->busnum);
+        return MRAA_ERROR_INVALID_RESOURCE;
+    }
+
+    if (is_volatile) {
+        page->uncached[command >> 5] |= 1u << (command & 31);
+        page->valid[command >> 5] &= ~(1u << (command & 31));
+    } else {
+        page->uncached[command >> 5] &= ~(1u << (command & 31));
+    }
+    return MRAA_SUCCESS;
+}
+
+mraa_result_t
+mraa_i2c_cache_invalidate(mraa_i2c_context dev)
+{
+    if (dev == NULL) {
+        syslog(LOG_ERR, "i2c: cache_invalidate: context is invalid");
+        return MRAA_ERROR_INVALID_HANDLE;
+    }
+
+    MRAA_BUS_LOCK_SCOPE(dev->bus);
+
+    if (dev->cache != NULL) {
+        unsigned int i;
+        for (i = 0; i < 128; ++i) {
+            mraa_i2c_cache_drop_all(dev, i);
+        }
+    }
+    return MRAA_SUCCESS;
+}
+
+mraa_result_t
+mraa_i2c_cache_stats(mraa_i2c_context dev, uint64_t* hits, uint64_t* misses)
+{
+    if (dev == NULL) {
+        syslog(LOG_ERR, "i2c: cache_stats: context is invalid");
+        return MRAA_ERROR_INVALID_HANDLE;
+    }
+
+    MRAA_BUS_LOCK_SCOPE(dev->bus);
+
+    if (hits != NULL) {
+        *hits = dev->cache != NULL ? dev->cache->hits : 0;
+    }
+    if (misses != NULL) {
+        *misses = dev->cache != NULL ? dev->cache->misses : 0;
+    }
+    return MRAA_SUCCESS;
+}
+
+mraa_result_t
+mraa_i2c_update_bits(mraa_i2c_context dev, uint8_t command, uint8_t mask, uint8_t value)
+{
+    if (dev == NULL) {
+        syslog(LOG_ERR, "i2c: update_bits: context is invalid");
+        return MRAA_ERROR_INVALID_HANDLE;
+    }
+
+    MRAA_BUS_LOCK_SCOPE(dev->bus);
+
+    int old = mraa_i2c_read_byte_data(dev, command);
+    if (old < 0) {
+        return MRAA_ERROR_UNSPECIFIED;
+    }
+
+    uint8_t updated = (old & ~mask) | (value & mask);
+    if (updated == old) {
+        return MRAA_SUCCESS;
+    }
+    return mraa_i2c_write_byte_data(dev, updated, command);
+}
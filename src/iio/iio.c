@@ -6,6 +6,7 @@
  */
 
 #include "iio.h"
+#include "event/event_loop.h"
 #include "mraa_internal.h"
 #include "dirent.h"
 #include <string.h>
@@ -13,6 +14,7 @@
 #if defined(MSYS)
 #define __USE_LINUX_IOCTL_DEFS
 #endif
+#include <sys/epoll.h>
 #include <sys/ioctl.h>
 #include <sys/stat.h>
 
@@ -307,11 +309,31 @@ mraa_iio_wait_event(int fd, char* data, int* read_size)
     return MRAA_SUCCESS;
 }
 
+static void
+mraa_iio_trigger_dispatch(mraa_iio_context dev, char* data, int read_size)
+{
+    // only can process if readsize >= enabled channel's datasize
+    for (int i = 0; i < (read_size / dev->datasize); i++) {
+        dev->isr(data, (void*) dev->isr_args);
+    }
+}
+
+static void
+mraa_iio_trigger_loop_handler(int fd, uint32_t events, void* arg)
+{
+    mraa_iio_context dev = (mraa_iio_context) arg;
+    char data[MAX_SIZE * 100];
+
+    (void) events;
+
+    memset(data, 0, 100);
+    mraa_iio_trigger_dispatch(dev, data, read(fd, data, 100));
+}
+
 static void*
 mraa_iio_trigger_handler(void* arg)
 {
     mraa_iio_context dev = (mraa_iio_context) arg;
-    int i;
     char data[MAX_SIZE * 100];
     int read_size;
 
@@ -320,10 +342,7 @@ mraa_iio_trigger_handler(void* arg)
 #ifdef HAVE_PTHREAD_CANCEL
             pthread_setcancelstate(PTHREAD_CANCEL_DISABLE, NULL);
 #endif
-            // only can process if readsize >= enabled channel's datasize
-            for (i = 0; i < (read_size / dev->datasize); i++) {
-                dev->isr((char*)&data, (void*)dev->isr_args);
-            }
+            mraa_iio_trigger_dispatch(dev, data, read_size);
 #ifdef HAVE_PTHREAD_CANCEL
             pthread_setcancelstate(PTHREAD_CANCEL_ENABLE, NULL);
 #endif
@@ -341,7 +360,7 @@ mraa_result_t
 mraa_iio_trigger_buffer(mraa_iio_context dev, void (*fptr)(char*, void*), void* args)
 {
     char bu[MAX_SIZE];
-    if (dev->thread_id != 0) {
+    if (dev->thread_id != 0 || dev->event_source != NULL) {
         return MRAA_ERROR_NO_RESOURCES;
     }
 
@@ -353,6 +372,12 @@ mraa_iio_trigger_buffer(mraa_iio_context dev, void (*fptr)(char*, void*), void*
 
     dev->isr = fptr;
     dev->isr_args = args;
+
+    if (mraa_event_loop_is_active()) {
+        dev->event_source = mraa_event_loop_add(dev->fp, EPOLLIN, mraa_iio_trigger_loop_handler, dev);
+        return dev->event_source != NULL ? MRAA_SUCCESS : MRAA_ERROR_NO_RESOURCES;
+    }
+
     pthread_create(&dev->thread_id, NULL, mraa_iio_trigger_handler, (void*) dev);
 
     return MRAA_SUCCESS;
@@ -462,6 +487,19 @@ mraa_iio_event_poll(mraa_iio_context dev, struct iio_event_data* data)
     return MRAA_SUCCESS;
 }
 
+static void
+mraa_iio_event_loop_handler(int fd, uint32_t events, void* arg)
+{
+    struct iio_event_data data;
+    mraa_iio_context dev = (mraa_iio_context) arg;
+
+    (void) events;
+
+    if (read(fd, &data, sizeof(struct iio_event_data)) == sizeof(struct iio_event_data)) {
+        dev->isr_event(&data, dev->isr_args);
+    }
+}
+
 static void*
 mraa_iio_event_handler(void* arg)
 {
@@ -492,7 +530,7 @@ mraa_iio_event_setup_callback(mraa_iio_context dev, void (*fptr)(struct iio_even
 {
     int ret;
     char bu[MAX_SIZE];
-    if (dev->thread_id != 0) {
+    if (dev->thread_id != 0 || dev->event_source != NULL) {
         return MRAA_ERROR_NO_RESOURCES;
     }
 
@@ -510,6 +548,12 @@ mraa_iio_event_setup_callback(mraa_iio_context dev, void (*fptr)(struct iio_even
 
     dev->isr_event = fptr;
     dev->isr_args = args;
+
+    if (mraa_event_loop_is_active()) {
+        dev->event_source = mraa_event_loop_add(dev->fp_event, EPOLLIN, mraa_iio_event_loop_handler, dev);
+        return dev->event_source != NULL ? MRAA_SUCCESS : MRAA_ERROR_NO_RESOURCES;
+    }
+
     pthread_create(&dev->thread_id, NULL, mraa_iio_event_handler, (void*) dev);
 
     return MRAA_SUCCESS;
@@ -644,6 +688,10 @@ mraa_iio_update_channels(mraa_iio_context dev)
 mraa_result_t
 mraa_iio_close(mraa_iio_context dev)
 {
+    if (dev->event_source != NULL) {
+        mraa_event_loop_remove(dev->event_source);
+        dev->event_source = NULL;
+    }
     free(dev->channels);
     return MRAA_SUCCESS;
 }
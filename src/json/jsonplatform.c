@@ -217,11 +217,91 @@ mraa_init_json_platform_io(json_object* jobj_io, mraa_board_t* board, int index)
     return MRAA_SUCCESS;
 }
 
+mraa_result_t
+mraa_init_json_platform_gpio_mmap(json_object* jobj_mmap, mraa_mmap_pin_t* pin_mmap, int index)
+{
+    json_object* jobj_temp = NULL;
+    int value = 0;
+    mraa_result_t ret = MRAA_SUCCESS;
+
+    if (!json_object_is_type(jobj_mmap, json_type_object)) {
+        syslog(LOG_ERR, "init_json_platform: %s %s at position: %d is not an object", GPIO_KEY,
+               MMAP_KEY, index);
+        return MRAA_ERROR_INVALID_RESOURCE;
+    }
+
+    // The memory device, /dev/gpiomem, /dev/uio0 or /dev/mem
+    if (!json_object_object_get_ex(jobj_mmap, MMAP_DEV_KEY, &jobj_temp) ||
+        !json_object_is_type(jobj_temp, json_type_string)) {
+        syslog(LOG_ERR, "init_json_platform: No %s string for %s at position: %d", MMAP_DEV_KEY,
+               MMAP_KEY, index);
+        return MRAA_ERROR_NO_DATA_AVAILABLE;
+    }
+    memset(pin_mmap->mem_dev, 0, sizeof(pin_mmap->mem_dev));
+    strncpy(pin_mmap->mem_dev, json_object_get_string(jobj_temp), sizeof(pin_mmap->mem_dev) - 1);
+
+    // Physical addresses don't fit an int, the offset is optional
+    pin_mmap->mem_offset = 0;
+    if (json_object_object_get_ex(jobj_mmap, MMAP_OFFSET_KEY, &jobj_temp)) {
+        if (!json_object_is_type(jobj_temp, json_type_int) || json_object_get_int64(jobj_temp) < 0) {
+            syslog(LOG_ERR, "init_json_platform: %s %s at position: %d is not a valid offset",
+                   MMAP_KEY, MMAP_OFFSET_KEY, index);
+            return MRAA_ERROR_INVALID_RESOURCE;
+        }
+        pin_mmap->mem_offset = (uint64_t) json_object_get_int64(jobj_temp);
+    }
+
+    ret = mraa_init_json_platform_get_pin(jobj_mmap, MMAP_KEY, MMAP_SIZE_KEY, index, &value);
+    if (ret != MRAA_SUCCESS) {
+        return ret;
+    }
+    pin_mmap->mem_sz = value;
+
+    ret = mraa_init_json_platform_get_pin(jobj_mmap, MMAP_KEY, MMAP_SET_KEY, index, &value);
+    if (ret != MRAA_SUCCESS) {
+        return ret;
+    }
+    pin_mmap->set_reg = value;
+
+    // Without a clear register set is a plain data register
+    ret = mraa_init_json_platform_get_pin(jobj_mmap, MMAP_KEY, MMAP_CLEAR_KEY, index, &value);
+    if (ret == MRAA_ERROR_NO_DATA_AVAILABLE) {
+        value = pin_mmap->set_reg;
+    } else if (ret != MRAA_SUCCESS) {
+        return ret;
+    }
+    pin_mmap->clr_reg = value;
+
+    // Without a level register the value is read back from set
+    ret = mraa_init_json_platform_get_pin(jobj_mmap, MMAP_KEY, MMAP_LEVEL_KEY, index, &value);
+    if (ret == MRAA_ERROR_NO_DATA_AVAILABLE) {
+        value = pin_mmap->set_reg;
+    } else if (ret != MRAA_SUCCESS) {
+        return ret;
+    }
+    pin_mmap->lev_reg = value;
+
+    ret = mraa_init_json_platform_get_pin(jobj_mmap, MMAP_KEY, MMAP_BIT_KEY, index, &value);
+    if (ret != MRAA_SUCCESS) {
+        return ret;
+    }
+    if (value < 0 || value > 31) {
+        syslog(LOG_ERR, "init_json_platform: %s %s at position: %d out of range", MMAP_KEY,
+               MMAP_BIT_KEY, index);
+        return MRAA_ERROR_INVALID_RESOURCE;
+    }
+    pin_mmap->bit_pos = value;
+
+    pin_mmap->regs = 1;
+    return MRAA_SUCCESS;
+}
+
 mraa_result_t
 mraa_init_json_platform_gpio(json_object* jobj_gpio, mraa_board_t* board, int index)
 {
     int pos = 0;
     mraa_result_t ret = MRAA_SUCCESS;
+    json_object* jobj_temp = NULL;
 
     // Get the gpio index
     ret = mraa_init_json_platform_get_index(jobj_gpio, GPIO_KEY, INDEX_KEY, index, &pos,
@@ -236,6 +316,15 @@ mraa_init_json_platform_gpio(json_object* jobj_gpio, mraa_board_t* board, int in
         return ret;
     }
     board->pins[pos].capabilities.gpio = 1;
+
+    // Optional register description for memory mapped access
+    if (json_object_object_get_ex(jobj_gpio, MMAP_KEY, &jobj_temp)) {
+        ret = mraa_init_json_platform_gpio_mmap(jobj_temp, &(board->pins[pos].mmap), index);
+        if (ret != MRAA_SUCCESS) {
+            return ret;
+        }
+        board->pins[pos].capabilities.fast_gpio = 1;
+    }
     return MRAA_SUCCESS;
 }
 
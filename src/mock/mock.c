@@ -24,3 +24,23 @@ mraa_mock_platform()
 
     return platform_type;
 }
+
+/*
+ * A second mock board as the subplatform, so that its buses share numbers
+ * with the main board's but are separate devices
+ */
+mraa_platform_t
+mraa_mock_subplatform(mraa_board_t* board)
+{
+    mraa_board_t* b = mraa_mock_board();
+
+    if (b == NULL) {
+        syslog(LOG_ERR, "Was not able to initialize mock subplatform");
+        return MRAA_NULL_PLATFORM;
+    }
+    b->platform_name = "MRAA mock subplatform";
+    b->platform_type = MRAA_MOCK_PLATFORM;
+    board->sub_platform = b;
+
+    return MRAA_MOCK_PLATFORM;
+}
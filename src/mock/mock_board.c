@@ -98,6 +98,7 @@ mraa_mock_board()
     b->adv_func->i2c_write_byte_replace = &mraa_mock_i2c_write_byte_replace;
     b->adv_func->i2c_write_byte_data_replace = &mraa_mock_i2c_write_byte_data_replace;
     b->adv_func->i2c_write_word_data_replace = &mraa_mock_i2c_write_word_data_replace;
+    b->adv_func->i2c_txn_submit_replace = &mraa_mock_i2c_txn_submit_replace;
     b->adv_func->spi_init_raw_replace = &mraa_mock_spi_init_raw_replace;
     b->adv_func->spi_stop_replace = &mraa_mock_spi_stop_replace;
     b->adv_func->spi_bit_per_word_replace = &mraa_mock_spi_bit_per_word_replace;
@@ -108,6 +109,7 @@ mraa_mock_board()
     b->adv_func->spi_write_word_replace = &mraa_mock_spi_write_word_replace;
     b->adv_func->spi_transfer_buf_replace = &mraa_mock_spi_transfer_buf_replace;
     b->adv_func->spi_transfer_buf_word_replace = &mraa_mock_spi_transfer_buf_word_replace;
+    b->adv_func->spi_transfer_segments_replace = &mraa_mock_spi_transfer_segments_replace;
     b->adv_func->uart_init_raw_replace = &mraa_mock_uart_init_raw_replace;
     b->adv_func->uart_set_baudrate_replace = &mraa_mock_uart_set_baudrate_replace;
     b->adv_func->uart_flush_replace = &mraa_mock_uart_flush_replace;
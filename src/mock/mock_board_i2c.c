@@ -224,3 +224,43 @@ mraa_mock_i2c_write_word_data_replace(mraa_i2c_context dev, const uint16_t data,
         return MRAA_ERROR_UNSPECIFIED;
     }
 }
+
+mraa_result_t
+mraa_mock_i2c_txn_submit_replace(mraa_i2c_context dev, mraa_i2c_txn_t txn)
+{
+    mraa_result_t status = MRAA_SUCCESS;
+    int addr = dev->addr;
+    unsigned int i;
+
+    // Same device model as the single calls, a joined single byte write and
+    // read is a register read. Registers are single byte, like the replaced
+    // platforms the mock has no repeated start after a longer write.
+    for (i = 0; i < txn->num_msgs; ++i) {
+        if (txn->msgs[i].joined && txn->msgs[i].len != 1) {
+            syslog(LOG_ERR, "i2c%i: txn_submit: No repeated start after a %d byte write",
+                   dev->busnum, txn->msgs[i].len);
+            return MRAA_ERROR_FEATURE_NOT_SUPPORTED;
+        }
+    }
+
+    for (i = 0; i < txn->num_msgs && status == MRAA_SUCCESS; ++i) {
+        mraa_i2c_txn_msg_t* msg = &txn->msgs[i];
+
+        dev->addr = msg->addr;
+        if (msg->joined && msg->len == 1) {
+            mraa_i2c_txn_msg_t* next = &txn->msgs[++i];
+            if (mraa_mock_i2c_read_bytes_data_replace(dev, msg->data[0], next->data, next->len) < 0) {
+                status = MRAA_ERROR_UNSPECIFIED;
+            }
+        } else if (msg->read) {
+            if (mraa_mock_i2c_read_replace(dev, msg->data, msg->len) < 0) {
+                status = MRAA_ERROR_UNSPECIFIED;
+            }
+        } else {
+            status = mraa_mock_i2c_write_replace(dev, msg->data, msg->len);
+        }
+    }
+
+    dev->addr = addr;
+    return status;
+}
@@ -160,3 +160,23 @@ mraa_mock_spi_transfer_buf_word_replace(mraa_spi_context dev, uint16_t* data, ui
 
     return MRAA_SUCCESS;
 }
+
+mraa_result_t
+mraa_mock_spi_transfer_segments_replace(mraa_spi_context dev, const mraa_spi_segment_t* segments, unsigned int num_segments)
+{
+    unsigned int i;
+    int j;
+
+    for (i = 0; i < num_segments; ++i) {
+        const mraa_spi_segment_t* seg = &segments[i];
+        if (seg->rx == NULL) {
+            continue;
+        }
+        // Missing tx data clocks out zeros
+        for (j = 0; j < seg->length; ++j) {
+            seg->rx[j] = (seg->tx != NULL ? seg->tx[j] : 0) ^ MOCK_SPI_REPLY_DATA_MODIFIER_BYTE;
+        }
+    }
+
+    return MRAA_SUCCESS;
+}
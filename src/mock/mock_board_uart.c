@@ -10,6 +10,7 @@
 
 #include "common.h"
 #include "mock/mock_board_uart.h"
+#include "mock/mock_board_uart_ow.h"
 
 mraa_result_t
 mraa_mock_uart_set_baudrate_replace(mraa_uart_context dev, unsigned int baud)
@@ -20,12 +21,15 @@ mraa_mock_uart_set_baudrate_replace(mraa_uart_context dev, unsigned int baud)
         return MRAA_ERROR_INVALID_PARAMETER;
     }
 
+    mraa_mock_uart_ow_set_baudrate(baud);
     return MRAA_SUCCESS;
 }
 
 mraa_result_t
 mraa_mock_uart_init_raw_replace(mraa_uart_context dev, const char* path)
 {
+    mraa_mock_uart_ow_init();
+
     // The only thing we have to do from the original uart_init_raw()
     return mraa_uart_set_baudrate(dev, 9600);
 }
@@ -69,6 +73,10 @@ mraa_mock_uart_set_timeout_replace(mraa_uart_context dev, int read, int write, i
 mraa_boolean_t
 mraa_mock_uart_data_available_replace(mraa_uart_context dev, unsigned int millis)
 {
+    if (mraa_mock_uart_ow_active()) {
+        return mraa_mock_uart_ow_available();
+    }
+
     // Our mock implementation will always have "incoming" data
     return 1;
 }
@@ -76,6 +84,9 @@ mraa_mock_uart_data_available_replace(mraa_uart_context dev, unsigned int millis
 int
 mraa_mock_uart_write_replace(mraa_uart_context dev, const char* buf, size_t len)
 {
+    // Echoed back once a 1-Wire reset pulse has gone out, see mock_board_uart_ow.h
+    mraa_mock_uart_ow_write((const uint8_t*) buf, len);
+
     // Our mock implementation always succeeds when sending data
     return len;
 }
@@ -83,6 +94,10 @@ mraa_mock_uart_write_replace(mraa_uart_context dev, const char* buf, size_t len)
 int
 mraa_mock_uart_read_replace(mraa_uart_context dev, char* buf, size_t len)
 {
+    if (mraa_mock_uart_ow_active()) {
+        return mraa_mock_uart_ow_read((uint8_t*) buf, len);
+    }
+
     // We'll return MOCK_UART_DATA_BYTE, len times
     memset(buf, MOCK_UART_DATA_BYTE, len);
     return len;
@@ -0,0 +1,318 @@
+/*
+ * Copyright (c) 2026 Intel Corporation.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <pthread.h>
+#include <string.h>
+
+#include "mock/mock_board_uart_ow.h"
+
+#define MOCK_OW_ECHO_SIZE 4096
+// Echo of a read slot a device pulled low, anything but 0xff reads as 0
+#define MOCK_OW_SLOT_LOW 0xfc
+// Echo of the reset pulse with a presence pulse on the bus
+#define MOCK_OW_PRESENCE 0xe0
+
+typedef enum {
+    MOCK_OW_IDLE, /**< deselected until the next reset */
+    MOCK_OW_ROM_CMD,
+    MOCK_OW_SEARCH,
+    MOCK_OW_MATCH,
+    MOCK_OW_FUNC_CMD,
+    MOCK_OW_SEND,
+    MOCK_OW_CONVERT /**< read slots return 1, conversion done */
+} mock_ow_state_t;
+
+typedef struct {
+    uint8_t rom[8];
+    uint8_t scratchpad[9];
+    mraa_boolean_t alarm;
+    mock_ow_state_t state;
+    mock_ow_state_t after_send;
+    int bit;
+    uint8_t cmd;
+    const uint8_t* out;
+    int out_bits;
+} mock_ow_device_t;
+
+static pthread_mutex_t mock_ow_lock = PTHREAD_MUTEX_INITIALIZER;
+static mock_ow_device_t mock_ow_devices[MOCK_UART_OW_DEVICES];
+static mraa_boolean_t mock_ow_active;
+static unsigned int mock_ow_baud = 9600;
+static uint8_t mock_ow_echo[MOCK_OW_ECHO_SIZE];
+static size_t mock_ow_echo_head;
+static size_t mock_ow_echo_count;
+
+static uint8_t
+mock_ow_crc8(const uint8_t* buf, int len)
+{
+    uint8_t crc = 0;
+
+    for (int i = 0; i < len; i++) {
+        uint8_t data = buf[i];
+        for (int b = 0; b < 8; b++) {
+            uint8_t mix = (crc ^ data) & 0x01;
+            crc >>= 1;
+            if (mix) {
+                crc ^= 0x8c;
+            }
+            data >>= 1;
+        }
+    }
+
+    return crc;
+}
+
+static void
+mock_ow_device_setup(mock_ow_device_t* d, uint8_t family, uint8_t serial, int16_t temp16, mraa_boolean_t alarm)
+{
+    memset(d, 0, sizeof(*d));
+    d->rom[0] = family;
+    d->rom[1] = serial;
+    d->rom[7] = mock_ow_crc8(d->rom, 7);
+    d->alarm = alarm;
+
+    d->scratchpad[0] = temp16 & 0xff;
+    d->scratchpad[1] = (temp16 >> 8) & 0xff;
+    d->scratchpad[2] = 0x4b; // TH
+    d->scratchpad[3] = 0x46; // TL
+    d->scratchpad[4] = 0x7f; // 12 bit resolution
+    d->scratchpad[5] = 0xff;
+    d->scratchpad[6] = 0x0c;
+    d->scratchpad[7] = 0x10;
+    d->scratchpad[8] = mock_ow_crc8(d->scratchpad, 8);
+}
+
+static int
+mock_ow_rom_bit(mock_ow_device_t* d, int bit)
+{
+    return (d->rom[bit / 8] >> (bit % 8)) & 1;
+}
+
+static void
+mock_ow_send(mock_ow_device_t* d, const uint8_t* out, int bits, mock_ow_state_t after)
+{
+    d->state = MOCK_OW_SEND;
+    d->after_send = after;
+    d->out = out;
+    d->out_bits = bits;
+    d->bit = 0;
+}
+
+// What the device puts on the bus in the current slot, 0 when it pulls low
+static int
+mock_ow_drive(mock_ow_device_t* d)
+{
+    switch (d->state) {
+        case MOCK_OW_SEARCH:
+            switch (d->bit % 3) {
+                case 0:
+                    return mock_ow_rom_bit(d, d->bit / 3);
+                case 1:
+                    return !mock_ow_rom_bit(d, d->bit / 3);
+                default:
+                    return 1;
+            }
+        case MOCK_OW_SEND:
+            return (d->out[d->bit / 8] >> (d->bit % 8)) & 1;
+        default:
+            return 1;
+    }
+}
+
+// Follow the level the bus settled at in the current slot
+static void
+mock_ow_sample(mock_ow_device_t* d, int level)
+{
+    switch (d->state) {
+        case MOCK_OW_ROM_CMD:
+            d->cmd |= level << d->bit;
+            if (++d->bit < 8) {
+                return;
+            }
+            d->bit = 0;
+            switch (d->cmd) {
+                case 0xf0:
+                    d->state = MOCK_OW_SEARCH;
+                    break;
+                case 0xec:
+                    d->state = d->alarm ? MOCK_OW_SEARCH : MOCK_OW_IDLE;
+                    break;
+                case 0x55:
+                    d->state = MOCK_OW_MATCH;
+                    break;
+                case 0xcc:
+                    d->state = MOCK_OW_FUNC_CMD;
+                    break;
+                case 0x33:
+                    mock_ow_send(d, d->rom, 64, MOCK_OW_FUNC_CMD);
+                    break;
+                default:
+                    d->state = MOCK_OW_IDLE;
+                    break;
+            }
+            d->cmd = 0;
+            break;
+        case MOCK_OW_SEARCH:
+            if (d->bit % 3 == 2 && level != mock_ow_rom_bit(d, d->bit / 3)) {
+                d->state = MOCK_OW_IDLE;
+            } else if (++d->bit == 64 * 3) {
+                d->state = MOCK_OW_FUNC_CMD;
+                d->bit = 0;
+            }
+            break;
+        case MOCK_OW_MATCH:
+            if (level != mock_ow_rom_bit(d, d->bit)) {
+                d->state = MOCK_OW_IDLE;
+            } else if (++d->bit == 64) {
+                d->state = MOCK_OW_FUNC_CMD;
+                d->bit = 0;
+            }
+            break;
+        case MOCK_OW_FUNC_CMD:
+            d->cmd |= level << d->bit;
+            if (++d->bit < 8) {
+                return;
+            }
+            d->bit = 0;
+            if (d->rom[0] != 0x28) {
+                d->state = MOCK_OW_IDLE;
+            } else if (d->cmd == 0x44) {
+                d->state = MOCK_OW_CONVERT;
+            } else if (d->cmd == 0xbe) {
+                mock_ow_send(d, d->scratchpad, 72, MOCK_OW_IDLE);
+            } else {
+                d->state = MOCK_OW_IDLE;
+            }
+            d->cmd = 0;
+            break;
+        case MOCK_OW_SEND:
+            if (++d->bit == d->out_bits) {
+                d->state = d->after_send;
+                d->bit = 0;
+            }
+            break;
+        default:
+            break;
+    }
+}
+
+static void
+mock_ow_echo_push(uint8_t ch)
+{
+    if (mock_ow_echo_count == MOCK_OW_ECHO_SIZE) {
+        // Overrun, as a real receiver would
+        return;
+    }
+    mock_ow_echo[(mock_ow_echo_head + mock_ow_echo_count) % MOCK_OW_ECHO_SIZE] = ch;
+    mock_ow_echo_count++;
+}
+
+static uint8_t
+mock_ow_reset()
+{
+    for (int i = 0; i < MOCK_UART_OW_DEVICES; i++) {
+        mock_ow_devices[i].state = MOCK_OW_ROM_CMD;
+        mock_ow_devices[i].bit = 0;
+        mock_ow_devices[i].cmd = 0;
+    }
+    return MOCK_UART_OW_DEVICES > 0 ? MOCK_OW_PRESENCE : 0xf0;
+}
+
+static uint8_t
+mock_ow_slot(uint8_t ch)
+{
+    int level = (ch == 0xff);
+
+    for (int i = 0; i < MOCK_UART_OW_DEVICES; i++) {
+        level &= mock_ow_drive(&mock_ow_devices[i]);
+    }
+    for (int i = 0; i < MOCK_UART_OW_DEVICES; i++) {
+        mock_ow_sample(&mock_ow_devices[i], level);
+    }
+
+    if (ch != 0xff) {
+        return ch;
+    }
+    return level ? 0xff : MOCK_OW_SLOT_LOW;
+}
+
+void
+mraa_mock_uart_ow_init()
+{
+    pthread_mutex_lock(&mock_ow_lock);
+    mock_ow_device_setup(&mock_ow_devices[0], 0x28, 0x01, 0x0191, 0);
+    mock_ow_device_setup(&mock_ow_devices[1], 0x28, 0x02, 0x0158, 1);
+    mock_ow_device_setup(&mock_ow_devices[2], 0x28, 0x03, (int16_t) 0xff5e, 0);
+    mock_ow_device_setup(&mock_ow_devices[3], 0x01, 0x04, 0, 0);
+    mock_ow_active = 0;
+    mock_ow_baud = 9600;
+    mock_ow_echo_head = mock_ow_echo_count = 0;
+    pthread_mutex_unlock(&mock_ow_lock);
+}
+
+void
+mraa_mock_uart_ow_set_baudrate(unsigned int baud)
+{
+    pthread_mutex_lock(&mock_ow_lock);
+    mock_ow_baud = baud;
+    mock_ow_echo_head = mock_ow_echo_count = 0;
+    pthread_mutex_unlock(&mock_ow_lock);
+}
+
+mraa_boolean_t
+mraa_mock_uart_ow_active()
+{
+    pthread_mutex_lock(&mock_ow_lock);
+    mraa_boolean_t active = mock_ow_active;
+    pthread_mutex_unlock(&mock_ow_lock);
+    return active;
+}
+
+void
+mraa_mock_uart_ow_write(const uint8_t* buf, size_t len)
+{
+    pthread_mutex_lock(&mock_ow_lock);
+    for (size_t i = 0; i < len; i++) {
+        if (mock_ow_baud == 9600) {
+            // Too slow for time slots, only the reset pulse means anything
+            if (buf[i] == 0xf0) {
+                mock_ow_active = 1;
+                mock_ow_echo_push(mock_ow_reset());
+            } else if (mock_ow_active) {
+                mock_ow_echo_push(buf[i]);
+            }
+        } else if (mock_ow_active) {
+            mock_ow_echo_push(mock_ow_slot(buf[i]));
+        }
+    }
+    pthread_mutex_unlock(&mock_ow_lock);
+}
+
+int
+mraa_mock_uart_ow_read(uint8_t* buf, size_t len)
+{
+    size_t n;
+
+    pthread_mutex_lock(&mock_ow_lock);
+    n = len < mock_ow_echo_count ? len : mock_ow_echo_count;
+    for (size_t i = 0; i < n; i++) {
+        buf[i] = mock_ow_echo[(mock_ow_echo_head + i) % MOCK_OW_ECHO_SIZE];
+    }
+    mock_ow_echo_head = (mock_ow_echo_head + n) % MOCK_OW_ECHO_SIZE;
+    mock_ow_echo_count -= n;
+    pthread_mutex_unlock(&mock_ow_lock);
+
+    return (int) n;
+}
+
+mraa_boolean_t
+mraa_mock_uart_ow_available()
+{
+    pthread_mutex_lock(&mock_ow_lock);
+    mraa_boolean_t available = mock_ow_echo_count > 0;
+    pthread_mutex_unlock(&mock_ow_lock);
+    return available;
+}
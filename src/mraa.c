@@ -38,6 +38,7 @@
 #endif
 
 #include "aio.h"
+#include "event/event_loop.h"
 #include "firmata/firmata_mraa.h"
 #include "gpio.h"
 #include "gpio/gpio_chardev.h"
@@ -92,6 +93,10 @@ mraa_is_kernel_chardev_interface_compatible()
         return 0;
     }
 
+    if (plat != NULL) {
+        plat->chardev_v2 = mraa_is_gpio_chardev_v2_compatible();
+    }
+
     return 1;
 }
 
@@ -231,7 +236,8 @@ imraa_init()
 
     plat->chardev_capable = mraa_is_platform_chardev_interface_capable();
     if (plat->chardev_capable) {
-        syslog(LOG_NOTICE, "gpio: support for chardev interface is activated");
+        syslog(LOG_NOTICE, "gpio: support for chardev interface is activated (%s ABI)",
+               plat->chardev_v2 ? "v2" : "v1");
     }
 
     syslog(LOG_NOTICE, "libmraa initialised for platform '%s' of type %d", mraa_get_platform_name(),
@@ -316,6 +322,7 @@ mraa_deinit()
 #else
     pman_mraa_deinit();
 #endif
+    mraa_event_loop_stop();
     closelog();
 }
 
@@ -1361,6 +1368,23 @@ mraa_add_subplatform(mraa_platform_t subplatformtype, const char* dev)
     }
 #endif
 
+#if defined(MOCKPLAT)
+    if (subplatformtype == MRAA_MOCK_PLATFORM) {
+        if (plat->sub_platform != NULL) {
+            if (plat->sub_platform->platform_type == subplatformtype) {
+                syslog(LOG_NOTICE, "mraa: Mock subplatform already present");
+                return MRAA_SUCCESS;
+            }
+            syslog(LOG_NOTICE, "mraa: A subplatform was already added!");
+            return MRAA_ERROR_FEATURE_NOT_SUPPORTED;
+        }
+        if (mraa_mock_subplatform(plat) == MRAA_MOCK_PLATFORM) {
+            syslog(LOG_NOTICE, "mraa: Added mock subplatform");
+            return MRAA_SUCCESS;
+        }
+    }
+#endif
+
     if (subplatformtype == MRAA_GROVEPI) {
         if (plat == NULL || plat->platform_type == MRAA_UNKNOWN_PLATFORM || plat->i2c_bus_count == 0) {
             syslog(LOG_NOTICE, "mraa: The GrovePi shield is not supported on this platform!");
@@ -1397,6 +1421,7 @@ mraa_remove_subplatform(mraa_platform_t subplatformtype)
         free(plat->sub_platform->adv_func);
         free(plat->sub_platform->pins);
         free(plat->sub_platform);
+        plat->sub_platform = NULL;
         return MRAA_SUCCESS;
     }
     return MRAA_ERROR_INVALID_PARAMETER;
@@ -45,6 +45,9 @@
 %ignore Gpio(void* gpio_context);
 %ignore Led(void* led_context);
 
+// Read buffers are filled in after the call returns
+%ignore mraa::I2cTransaction;
+
 %ignore Gpio::nop(uv_work_t* req);
 %ignore Gpio::v8isr(uv_work_t* req);
 %ignore Gpio::v8isr(uv_work_t* req, int status);
@@ -0,0 +1,615 @@
+/*
+ * Copyright (c) 2026 Intel Corporation.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#define _GNU_SOURCE
+#include "poller.h"
+#include "mraa_internal.h"
+
+#include <errno.h>
+#include <poll.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/eventfd.h>
+#include <sys/timerfd.h>
+#include <time.h>
+#include <unistd.h>
+
+typedef enum {
+    POLLER_JOB_I2C,
+    POLLER_JOB_SPI,
+    POLLER_JOB_AIO
+} mraa_poller_job_type_t;
+
+typedef struct {
+    mraa_poller_job_type_t type;
+    void* dev;
+    uint8_t address;
+    uint8_t reg;
+    int length;
+    uint8_t tx[MRAA_POLLER_MAX_DATA];
+    uint8_t rx[MRAA_POLLER_MAX_DATA];
+    uint64_t period_ns;
+    uint64_t deadline;
+    int group; /**< index of the bus batch the job belongs to, -1 for none */
+    mraa_boolean_t due;
+    uint64_t jitter_sum;
+    mraa_poller_stats_t stats; /**< guarded by stats_lock */
+} mraa_poller_job_t;
+
+/**
+ * Jobs on one bus, run together when several fall due at once
+ */
+typedef struct {
+    mraa_poller_job_type_t type;
+    intptr_t key; /**< bus arbiter, or the context of a bus without one */
+    mraa_i2c_txn_t txn; /**< reused for every i2c batch */
+} mraa_poller_group_t;
+
+struct _poller {
+    mraa_poller_job_t* jobs;
+    unsigned int num_jobs;
+    mraa_poller_group_t* groups;
+    unsigned int num_groups;
+    mraa_poller_sample_t* ring;
+    unsigned int ring_mask;
+    unsigned int head; /**< written by the poller thread only */
+    unsigned int tail; /**< written by mraa_poller_read() only */
+    pthread_mutex_t stats_lock;
+    int timerfd;
+    int stopfd;
+    int cpu;
+    int priority;
+    pthread_t thread;
+    mraa_boolean_t running;
+};
+
+static inline uint64_t
+_mraa_poller_now()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t) ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+static mraa_boolean_t
+_mraa_poller_push(mraa_poller_t poller, const mraa_poller_sample_t* sample)
+{
+    unsigned int head = __atomic_load_n(&poller->head, __ATOMIC_RELAXED);
+    unsigned int tail = __atomic_load_n(&poller->tail, __ATOMIC_ACQUIRE);
+
+    if (head - tail > poller->ring_mask) {
+        return 0;
+    }
+    poller->ring[head & poller->ring_mask] = *sample;
+    __atomic_store_n(&poller->head, head + 1, __ATOMIC_RELEASE);
+
+    return 1;
+}
+
+static void
+_mraa_poller_record(mraa_poller_t poller, unsigned int idx, uint64_t t, mraa_result_t result, int value)
+{
+    mraa_poller_job_t* job = &poller->jobs[idx];
+    uint64_t late = t > job->deadline ? t - job->deadline : 0;
+    mraa_poller_sample_t sample;
+    mraa_boolean_t pushed;
+
+    sample.job = idx;
+    sample.result = result;
+    sample.timestamp_ns = t;
+    sample.value = value;
+    sample.length = job->type == POLLER_JOB_AIO ? 0 : job->length;
+    memcpy(sample.data, job->rx, sample.length);
+    pushed = _mraa_poller_push(poller, &sample);
+
+    pthread_mutex_lock(&poller->stats_lock);
+    job->stats.samples++;
+    if (result != MRAA_SUCCESS) {
+        job->stats.errors++;
+    }
+    if (!pushed) {
+        job->stats.dropped++;
+    }
+    if (late > job->stats.max_jitter_ns) {
+        job->stats.max_jitter_ns = late;
+    }
+    job->jitter_sum += late;
+    pthread_mutex_unlock(&poller->stats_lock);
+}
+
+static void
+_mraa_poller_run_i2c(mraa_poller_t poller, mraa_poller_group_t* group, int g)
+{
+    uint64_t t = _mraa_poller_now();
+    mraa_result_t status;
+    unsigned int i, queued = 0;
+
+    // Every due register read on the bus goes out as one transaction
+    mraa_i2c_txn_clear(group->txn);
+    for (i = 0; i < poller->num_jobs; ++i) {
+        mraa_poller_job_t* job = &poller->jobs[i];
+        if (!job->due || job->group != g) {
+            continue;
+        }
+        if (mraa_i2c_txn_add_write_read(group->txn, job->address, &job->reg, 1, job->rx, job->length) != MRAA_SUCCESS) {
+            job->due = 0;
+            _mraa_poller_record(poller, i, t, MRAA_ERROR_NO_RESOURCES, 0);
+            continue;
+        }
+        queued++;
+    }
+    if (queued == 0) {
+        return;
+    }
+
+    status = mraa_i2c_txn_submit(group->txn);
+
+    for (i = 0; i < poller->num_jobs; ++i) {
+        mraa_poller_job_t* job = &poller->jobs[i];
+        if (!job->due || job->group != g) {
+            continue;
+        }
+        // A slave that doesn't answer fails the batch, so find out which one
+        if (status != MRAA_SUCCESS && queued > 1) {
+            mraa_i2c_txn_clear(group->txn);
+            mraa_i2c_txn_add_write_read(group->txn, job->address, &job->reg, 1, job->rx, job->length);
+            _mraa_poller_record(poller, i, t, mraa_i2c_txn_submit(group->txn), 0);
+            continue;
+        }
+        _mraa_poller_record(poller, i, t, status, 0);
+    }
+}
+
+static void
+_mraa_poller_run_spi(mraa_poller_t poller, int g)
+{
+    mraa_spi_context locked = NULL;
+    unsigned int i;
+
+    // One hold of the bus lock keeps other contexts out between the transfers
+    for (i = 0; i < poller->num_jobs; ++i) {
+        mraa_poller_job_t* job = &poller->jobs[i];
+        if (!job->due || job->group != g) {
+            continue;
+        }
+        if (locked == NULL) {
+            locked = (mraa_spi_context) job->dev;
+            mraa_spi_lock(locked);
+        }
+        uint64_t t = _mraa_poller_now();
+        mraa_result_t status = mraa_spi_transfer_buf((mraa_spi_context) job->dev, job->tx, job->rx, job->length);
+        _mraa_poller_record(poller, i, t, status, 0);
+    }
+
+    if (locked != NULL) {
+        mraa_spi_unlock(locked);
+    }
+}
+
+static void
+_mraa_poller_run_aio(mraa_poller_t poller, unsigned int idx)
+{
+    uint64_t t = _mraa_poller_now();
+    int value = mraa_aio_read((mraa_aio_context) poller->jobs[idx].dev);
+
+    _mraa_poller_record(poller, idx, t, value < 0 ? MRAA_ERROR_UNSPECIFIED : MRAA_SUCCESS, value);
+}
+
+static void*
+_mraa_poller_thread(void* arg)
+{
+    mraa_poller_t poller = (mraa_poller_t) arg;
+    struct pollfd fds[2] = { { .fd = poller->timerfd, .events = POLLIN }, { .fd = poller->stopfd, .events = POLLIN } };
+    uint64_t start, expirations;
+    unsigned int i;
+
+    if (poller->cpu >= 0) {
+        cpu_set_t cpus;
+        CPU_ZERO(&cpus);
+        CPU_SET(poller->cpu, &cpus);
+        if (pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus) != 0) {
+            syslog(LOG_WARNING, "poller: failed to pin thread to cpu %d", poller->cpu);
+        }
+    }
+
+    if (poller->priority > 0 && mraa_set_priority(poller->priority) != 0) {
+        syslog(LOG_WARNING, "poller: failed to set thread priority %d", poller->priority);
+    }
+
+    start = _mraa_poller_now();
+    for (i = 0; i < poller->num_jobs; ++i) {
+        poller->jobs[i].deadline = start;
+    }
+
+    for (;;) {
+        uint64_t next = poller->jobs[0].deadline, now;
+        struct itimerspec its = { { 0, 0 }, { 0, 0 } };
+
+        for (i = 1; i < poller->num_jobs; ++i) {
+            if (poller->jobs[i].deadline < next) {
+                next = poller->jobs[i].deadline;
+            }
+        }
+        its.it_value.tv_sec = next / 1000000000ULL;
+        its.it_value.tv_nsec = next % 1000000000ULL;
+        if (timerfd_settime(poller->timerfd, TFD_TIMER_ABSTIME, &its, NULL) != 0) {
+            syslog(LOG_ERR, "poller: failed to arm timer: %s", strerror(errno));
+            break;
+        }
+
+        if (poll(fds, 2, -1) < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            syslog(LOG_ERR, "poller: poll failed: %s", strerror(errno));
+            break;
+        }
+        if (fds[1].revents & POLLIN) {
+            break;
+        }
+        if (read(poller->timerfd, &expirations, sizeof(expirations)) != sizeof(expirations)) {
+            continue;
+        }
+
+        now = _mraa_poller_now();
+        for (i = 0; i < poller->num_jobs; ++i) {
+            poller->jobs[i].due = poller->jobs[i].deadline <= now;
+        }
+
+        for (i = 0; i < poller->num_groups; ++i) {
+            if (poller->groups[i].type == POLLER_JOB_I2C) {
+                _mraa_poller_run_i2c(poller, &poller->groups[i], i);
+            } else {
+                _mraa_poller_run_spi(poller, i);
+            }
+        }
+        for (i = 0; i < poller->num_jobs; ++i) {
+            if (poller->jobs[i].due && poller->jobs[i].type == POLLER_JOB_AIO) {
+                _mraa_poller_run_aio(poller, i);
+            }
+        }
+
+        // Keep each job on its grid, dropping the periods it overran
+        now = _mraa_poller_now();
+        for (i = 0; i < poller->num_jobs; ++i) {
+            mraa_poller_job_t* job = &poller->jobs[i];
+            if (!job->due) {
+                continue;
+            }
+            job->deadline += job->period_ns;
+            if (now > job->deadline + job->period_ns) {
+                uint64_t behind = (now - job->deadline) / job->period_ns;
+                pthread_mutex_lock(&poller->stats_lock);
+                job->stats.missed += behind;
+                pthread_mutex_unlock(&poller->stats_lock);
+                job->deadline += behind * job->period_ns;
+            }
+        }
+    }
+
+    return NULL;
+}
+
+mraa_poller_t
+mraa_poller_init(unsigned int ring_size)
+{
+    mraa_poller_t poller;
+    unsigned int size = 1;
+
+    if (ring_size == 0 || ring_size > (1U << 24)) {
+        syslog(LOG_ERR, "poller: ring size %u out of range", ring_size);
+        return NULL;
+    }
+    while (size < ring_size) {
+        size <<= 1;
+    }
+
+    poller = calloc(1, sizeof(struct _poller));
+    if (poller == NULL) {
+        syslog(LOG_CRIT, "poller: Failed to allocate memory for poller");
+        return NULL;
+    }
+    poller->timerfd = poller->stopfd = -1;
+
+    poller->ring = malloc(size * sizeof(mraa_poller_sample_t));
+    if (poller->ring == NULL) {
+        syslog(LOG_CRIT, "poller: Failed to allocate memory for %u samples", size);
+        goto init_fail;
+    }
+    poller->ring_mask = size - 1;
+
+    poller->timerfd = timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC);
+    poller->stopfd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    if (poller->timerfd < 0 || poller->stopfd < 0) {
+        syslog(LOG_ERR, "poller: failed to create timer: %s", strerror(errno));
+        goto init_fail;
+    }
+    pthread_mutex_init(&poller->stats_lock, NULL);
+
+    return poller;
+
+init_fail:
+    if (poller->timerfd >= 0) {
+        close(poller->timerfd);
+    }
+    if (poller->stopfd >= 0) {
+        close(poller->stopfd);
+    }
+    free(poller->ring);
+    free(poller);
+    return NULL;
+}
+
+static int
+_mraa_poller_group(mraa_poller_t poller, mraa_poller_job_type_t type, intptr_t key, mraa_i2c_context i2c)
+{
+    mraa_poller_group_t* groups;
+    unsigned int i;
+
+    for (i = 0; i < poller->num_groups; ++i) {
+        if (poller->groups[i].type == type && poller->groups[i].key == key) {
+            return i;
+        }
+    }
+
+    groups = realloc(poller->groups, (poller->num_groups + 1) * sizeof(mraa_poller_group_t));
+    if (groups == NULL) {
+        syslog(LOG_CRIT, "poller: Failed to allocate memory for bus batch");
+        return -1;
+    }
+    poller->groups = groups;
+    groups[i].type = type;
+    groups[i].key = key;
+    groups[i].txn = NULL;
+    if (type == POLLER_JOB_I2C) {
+        groups[i].txn = mraa_i2c_txn_init(i2c);
+        if (groups[i].txn == NULL) {
+            return -1;
+        }
+    }
+    poller->num_groups++;
+
+    return i;
+}
+
+static mraa_poller_job_t*
+_mraa_poller_add(mraa_poller_t poller, mraa_poller_job_type_t type, void* dev, int length, unsigned int period_us)
+{
+    mraa_poller_job_t* jobs;
+
+    if (poller == NULL) {
+        syslog(LOG_ERR, "poller: add: poller is invalid");
+        return NULL;
+    }
+    if (dev == NULL) {
+        syslog(LOG_ERR, "poller: add: context is invalid");
+        return NULL;
+    }
+    if (poller->running) {
+        syslog(LOG_ERR, "poller: add: jobs can only be added while stopped");
+        return NULL;
+    }
+    if (period_us == 0 || length < 0 || length > MRAA_POLLER_MAX_DATA) {
+        syslog(LOG_ERR, "poller: add: invalid period %u or length %d", period_us, length);
+        return NULL;
+    }
+
+    jobs = realloc(poller->jobs, (poller->num_jobs + 1) * sizeof(mraa_poller_job_t));
+    if (jobs == NULL) {
+        syslog(LOG_CRIT, "poller: Failed to allocate memory for job");
+        return NULL;
+    }
+    poller->jobs = jobs;
+
+    mraa_poller_job_t* job = &jobs[poller->num_jobs];
+    memset(job, 0, sizeof(mraa_poller_job_t));
+    job->type = type;
+    job->dev = dev;
+    job->length = length;
+    job->period_ns = (uint64_t) period_us * 1000ULL;
+    job->group = -1;
+
+    return job;
+}
+
+int
+mraa_poller_add_i2c(mraa_poller_t poller, mraa_i2c_context dev, uint8_t address, uint8_t reg, int length, unsigned int period_us)
+{
+    mraa_poller_job_t* job;
+
+    if (length < 1 || address > 0x7F) {
+        syslog(LOG_ERR, "poller: add_i2c: invalid address 0x%x or length %d", address, length);
+        return -1;
+    }
+
+    job = _mraa_poller_add(poller, POLLER_JOB_I2C, dev, length, period_us);
+    if (job == NULL) {
+        return -1;
+    }
+    job->address = address;
+    job->reg = reg;
+    // Bus numbers repeat across platforms, the arbiter doesn't
+    job->group = _mraa_poller_group(poller, POLLER_JOB_I2C, dev->bus != NULL ? (intptr_t) dev->bus : (intptr_t) dev, dev);
+    if (job->group < 0) {
+        return -1;
+    }
+
+    return poller->num_jobs++;
+}
+
+int
+mraa_poller_add_spi(mraa_poller_t poller, mraa_spi_context dev, const uint8_t* tx, int length, unsigned int period_us)
+{
+    mraa_poller_job_t* job;
+
+    if (tx == NULL || length < 1) {
+        syslog(LOG_ERR, "poller: add_spi: nothing to transfer");
+        return -1;
+    }
+
+    job = _mraa_poller_add(poller, POLLER_JOB_SPI, dev, length, period_us);
+    if (job == NULL) {
+        return -1;
+    }
+    memcpy(job->tx, tx, length);
+    // Chip selects of one bus share its arbiter
+    job->group = _mraa_poller_group(poller, POLLER_JOB_SPI, dev->bus != NULL ? (intptr_t) dev->bus : (intptr_t) dev, NULL);
+    if (job->group < 0) {
+        return -1;
+    }
+
+    return poller->num_jobs++;
+}
+
+int
+mraa_poller_add_aio(mraa_poller_t poller, mraa_aio_context dev, unsigned int period_us)
+{
+    if (_mraa_poller_add(poller, POLLER_JOB_AIO, dev, 0, period_us) == NULL) {
+        return -1;
+    }
+
+    return poller->num_jobs++;
+}
+
+mraa_result_t
+mraa_poller_start(mraa_poller_t poller, int cpu, int priority)
+{
+    unsigned int i;
+
+    if (poller == NULL) {
+        syslog(LOG_ERR, "poller: start: poller is invalid");
+        return MRAA_ERROR_INVALID_HANDLE;
+    }
+
+    if (poller->running) {
+        syslog(LOG_ERR, "poller: start: already running");
+        return MRAA_ERROR_INVALID_RESOURCE;
+    }
+
+    if (poller->num_jobs == 0) {
+        syslog(LOG_ERR, "poller: start: no jobs");
+        return MRAA_ERROR_INVALID_PARAMETER;
+    }
+
+    for (i = 0; i < poller->num_jobs; ++i) {
+        memset(&poller->jobs[i].stats, 0, sizeof(mraa_poller_stats_t));
+        poller->jobs[i].jitter_sum = 0;
+    }
+    poller->cpu = cpu;
+    poller->priority = priority;
+
+    if (pthread_create(&poller->thread, NULL, _mraa_poller_thread, poller) != 0) {
+        syslog(LOG_ERR, "poller: failed to start thread");
+        return MRAA_ERROR_NO_RESOURCES;
+    }
+    poller->running = 1;
+
+    return MRAA_SUCCESS;
+}
+
+mraa_result_t
+mraa_poller_stop(mraa_poller_t poller)
+{
+    uint64_t value = 1;
+
+    if (poller == NULL) {
+        syslog(LOG_ERR, "poller: stop: poller is invalid");
+        return MRAA_ERROR_INVALID_HANDLE;
+    }
+
+    if (!poller->running) {
+        return MRAA_SUCCESS;
+    }
+
+    if (write(poller->stopfd, &value, sizeof(value)) != sizeof(value)) {
+        syslog(LOG_ERR, "poller: stop: failed to wake thread: %s", strerror(errno));
+        return MRAA_ERROR_UNSPECIFIED;
+    }
+    pthread_join(poller->thread, NULL);
+    poller->running = 0;
+
+    // Rearm for the next start
+    if (read(poller->stopfd, &value, sizeof(value)) != sizeof(value)) {
+        syslog(LOG_WARNING, "poller: stop: failed to reset wakeup");
+    }
+
+    return MRAA_SUCCESS;
+}
+
+int
+mraa_poller_read(mraa_poller_t poller, mraa_poller_sample_t* samples, int max_samples)
+{
+    unsigned int head, tail;
+    int count = 0;
+
+    if (poller == NULL || samples == NULL || max_samples < 0) {
+        syslog(LOG_ERR, "poller: read: invalid parameters");
+        return -1;
+    }
+
+    tail = __atomic_load_n(&poller->tail, __ATOMIC_RELAXED);
+    head = __atomic_load_n(&poller->head, __ATOMIC_ACQUIRE);
+    while (tail != head && count < max_samples) {
+        samples[count++] = poller->ring[tail & poller->ring_mask];
+        tail++;
+    }
+    __atomic_store_n(&poller->tail, tail, __ATOMIC_RELEASE);
+
+    return count;
+}
+
+mraa_result_t
+mraa_poller_stats(mraa_poller_t poller, unsigned int job, mraa_poller_stats_t* stats)
+{
+    if (poller == NULL || stats == NULL) {
+        syslog(LOG_ERR, "poller: stats: invalid parameters");
+        return MRAA_ERROR_INVALID_HANDLE;
+    }
+
+    if (job >= poller->num_jobs) {
+        syslog(LOG_ERR, "poller: stats: no job %u", job);
+        return MRAA_ERROR_INVALID_PARAMETER;
+    }
+
+    pthread_mutex_lock(&poller->stats_lock);
+    *stats = poller->jobs[job].stats;
+    if (stats->samples > 0) {
+        stats->mean_jitter_ns = poller->jobs[job].jitter_sum / stats->samples;
+    }
+    pthread_mutex_unlock(&poller->stats_lock);
+
+    return MRAA_SUCCESS;
+}
+
+mraa_result_t
+mraa_poller_close(mraa_poller_t poller)
+{
+    unsigned int i;
+
+    if (poller == NULL) {
+        syslog(LOG_ERR, "poller: close: poller is invalid");
+        return MRAA_ERROR_INVALID_HANDLE;
+    }
+
+    mraa_poller_stop(poller);
+
+    for (i = 0; i < poller->num_groups; ++i) {
+        if (poller->groups[i].txn != NULL) {
+            mraa_i2c_txn_free(poller->groups[i].txn);
+        }
+    }
+    close(poller->timerfd);
+    close(poller->stopfd);
+    pthread_mutex_destroy(&poller->stats_lock);
+    free(poller->groups);
+    free(poller->jobs);
+    free(poller->ring);
+    free(poller);
+
+    return MRAA_SUCCESS;
+}
@@ -27,10 +27,21 @@
 #include <errno.h>
 
 #include "spi.h"
+#include "bus/bus_arbiter.h"
+#include "spi/spi_bitops.h"
 #include "mraa_internal.h"
 
 #define MAX_SIZE 64
 #define SPI_MAX_LENGTH 4096
+#define SPI_BUFSIZ_PATH "/sys/module/spidev/parameters/bufsiz"
+
+static void mraa_spi_dispatch(mraa_bus_request_t* batch);
+static mraa_result_t
+mraa_spi_ioc_segments(mraa_spi_context dev, const mraa_spi_segment_t* segments, unsigned int num_segments);
+static void
+mraa_spi_soft_code(mraa_spi_context dev, uint8_t* dst, const uint8_t* src, int length, unsigned int bpw);
+static mraa_result_t
+mraa_spi_soft_segments(mraa_spi_context dev, const mraa_spi_segment_t* segments, unsigned int num_segments);
 
 static mraa_spi_context
 mraa_spi_init_internal(mraa_adv_func_t* func_table)
@@ -107,9 +118,14 @@ mraa_spi_init(int bus)
     }
     mraa_spi_context dev = mraa_spi_init_raw(plat->spi_bus[bus].bus_id, plat->spi_bus[bus].slave_s);
 
+    if (dev == NULL) {
+        return NULL;
+    }
+
     if (plat->adv_func != NULL && plat->adv_func->spi_init_post != NULL) {
         mraa_result_t ret = plat->adv_func->spi_init_post(dev);
         if (ret != MRAA_SUCCESS) {
+            mraa_bus_put(dev->bus);
             free(dev);
             return NULL;
         }
@@ -118,6 +134,26 @@ mraa_spi_init(int bus)
     return dev;
 }
 
+static int
+mraa_spi_read_bufsiz()
+{
+    int bufsiz = 0;
+    FILE* fh = fopen(SPI_BUFSIZ_PATH, "r");
+
+    if (fh != NULL) {
+        if (fscanf(fh, "%d", &bufsiz) != 1) {
+            bufsiz = 0;
+        }
+        fclose(fh);
+    }
+    if (bufsiz <= 0) {
+        syslog(LOG_NOTICE, "spi: Failed to read %s, assuming %d", SPI_BUFSIZ_PATH, SPI_MAX_LENGTH);
+        bufsiz = SPI_MAX_LENGTH;
+    }
+
+    return bufsiz;
+}
+
 mraa_spi_context
 mraa_spi_init_raw(unsigned int bus, unsigned int cs)
 {
@@ -132,11 +168,7 @@ mraa_spi_init_raw(unsigned int bus, unsigned int cs)
 
     if (IS_FUNC_DEFINED(dev, spi_init_raw_replace)) {
         status = dev->advance_func->spi_init_raw_replace(dev, bus, cs);
-        if (status == MRAA_SUCCESS) {
-            return dev;
-        } else {
-            goto init_raw_cleanup;
-        }
+        goto init_raw_cleanup;
     }
 
     char path[MAX_SIZE];
@@ -149,6 +181,10 @@ mraa_spi_init_raw(unsigned int bus, unsigned int cs)
         goto init_raw_cleanup;
     }
 
+    // spidev refuses ioctls moving more than bufsiz bytes either way
+    dev->bufsiz = mraa_spi_read_bufsiz();
+    dev->chunk = dev->bufsiz;
+
     int speed = 0;
     if (ioctl(dev->devfd, SPI_IOC_RD_MAX_SPEED_HZ, &speed) != -1) {
         dev->clock = speed;
@@ -181,6 +217,8 @@ init_raw_cleanup:
         return NULL;
     }
 
+    // Chip selects share the wires, so the arbiter is per bus
+    dev->bus = mraa_bus_get(MRAA_BUS_SPI, dev->advance_func, bus, mraa_spi_dispatch);
     return dev;
 }
 
@@ -192,6 +230,8 @@ mraa_spi_mode(mraa_spi_context dev, mraa_spi_mode_t mode)
         return MRAA_ERROR_INVALID_HANDLE;
     }
 
+    MRAA_BUS_LOCK_SCOPE(dev->bus);
+
     if (IS_FUNC_DEFINED(dev, spi_mode_replace)) {
         return dev->advance_func->spi_mode_replace(dev, mode);
     }
@@ -232,6 +272,8 @@ mraa_spi_frequency(mraa_spi_context dev, int hz)
         return MRAA_ERROR_INVALID_HANDLE;
     }
 
+    MRAA_BUS_LOCK_SCOPE(dev->bus);
+
     if (IS_FUNC_DEFINED(dev, spi_frequency_replace)) {
         return dev->advance_func->spi_frequency_replace(dev, hz);
     }
@@ -258,19 +300,31 @@ mraa_spi_lsbmode(mraa_spi_context dev, mraa_boolean_t lsb)
         return MRAA_ERROR_INVALID_HANDLE;
     }
 
+    MRAA_BUS_LOCK_SCOPE(dev->bus);
+
     if (IS_FUNC_DEFINED(dev, spi_lsbmode_replace)) {
         return dev->advance_func->spi_lsbmode_replace(dev, lsb);
     }
 
     uint8_t lsb_mode = (uint8_t) lsb;
     if (ioctl(dev->devfd, SPI_IOC_WR_LSB_FIRST, &lsb_mode) < 0) {
-        syslog(LOG_ERR, "spi: Failed to set bit order");
-        return MRAA_ERROR_INVALID_RESOURCE;
+        // Plenty of controllers only shift MSB first, reverse the bits of
+        // every transfer for them instead
+        lsb_mode = 0;
+        if (!lsb || ioctl(dev->devfd, SPI_IOC_WR_LSB_FIRST, &lsb_mode) < 0) {
+            syslog(LOG_ERR, "spi: Failed to set bit order");
+            return MRAA_ERROR_INVALID_RESOURCE;
+        }
+        syslog(LOG_NOTICE, "spi: lsbmode: controller can't send LSB first, using software bit reversal");
+        dev->soft_lsb = 1;
+        dev->lsb = lsb;
+        return MRAA_SUCCESS;
     }
     if (ioctl(dev->devfd, SPI_IOC_RD_LSB_FIRST, &lsb_mode) < 0) {
         syslog(LOG_ERR, "spi: Failed to set bit order");
         return MRAA_ERROR_INVALID_RESOURCE;
     }
+    dev->soft_lsb = 0;
     dev->lsb = lsb;
     return MRAA_SUCCESS;
 }
@@ -283,18 +337,54 @@ mraa_spi_bit_per_word(mraa_spi_context dev, unsigned int bits)
         return MRAA_ERROR_INVALID_HANDLE;
     }
 
+    MRAA_BUS_LOCK_SCOPE(dev->bus);
+
     if (IS_FUNC_DEFINED(dev, spi_bit_per_word_replace)) {
         return dev->advance_func->spi_bit_per_word_replace(dev, bits);
     }
 
     if (ioctl(dev->devfd, SPI_IOC_WR_BITS_PER_WORD, &bits) < 0) {
-        syslog(LOG_ERR, "spi: Failed to set bit per word");
-        return MRAA_ERROR_INVALID_RESOURCE;
+        // 16 bit words are two bytes on the wire, send them as such with
+        // the bytes in the order the controller would have shifted them
+        unsigned int byte_bits = 8;
+        if (bits != 16 || ioctl(dev->devfd, SPI_IOC_WR_BITS_PER_WORD, &byte_bits) < 0) {
+            syslog(LOG_ERR, "spi: Failed to set bit per word");
+            return MRAA_ERROR_INVALID_RESOURCE;
+        }
+        syslog(LOG_NOTICE, "spi: bit_per_word: controller can't send 16 bit words, using software byte order");
+        dev->soft_word = 1;
+        dev->bpw = byte_bits;
+        return MRAA_SUCCESS;
     }
+    dev->soft_word = 0;
     dev->bpw = bits;
     return MRAA_SUCCESS;
 }
 
+mraa_result_t
+mraa_spi_chunk_size(mraa_spi_context dev, int size)
+{
+    if (dev == NULL) {
+        syslog(LOG_ERR, "spi: chunk_size: context is invalid");
+        return MRAA_ERROR_INVALID_HANDLE;
+    }
+
+    if (size < 0) {
+        syslog(LOG_ERR, "spi: chunk_size: invalid size %d", size);
+        return MRAA_ERROR_INVALID_PARAMETER;
+    }
+
+    MRAA_BUS_LOCK_SCOPE(dev->bus);
+
+    // Only spidev transfers are split, the bufsiz is its ioctl limit
+    if (dev->bufsiz == 0) {
+        return MRAA_SUCCESS;
+    }
+    dev->chunk = (size == 0 || size > dev->bufsiz) ? dev->bufsiz : size;
+
+    return MRAA_SUCCESS;
+}
+
 int
 mraa_spi_write(mraa_spi_context dev, uint8_t data)
 {
@@ -303,6 +393,8 @@ mraa_spi_write(mraa_spi_context dev, uint8_t data)
         return -1;
     }
 
+    MRAA_BUS_LOCK_SCOPE(dev->bus);
+
     if (IS_FUNC_DEFINED(dev, spi_write_replace)) {
         return dev->advance_func->spi_write_replace(dev, data);
     }
@@ -313,6 +405,9 @@ mraa_spi_write(mraa_spi_context dev, uint8_t data)
     uint16_t length = 1;
 
     unsigned long recv = 0;
+    if (dev->soft_lsb) {
+        mraa_spi_bitrev(&data, &data, length);
+    }
     msg.tx_buf = (unsigned long) &data;
     msg.rx_buf = (unsigned long) &recv;
     msg.speed_hz = dev->clock;
@@ -323,6 +418,11 @@ mraa_spi_write(mraa_spi_context dev, uint8_t data)
         syslog(LOG_ERR, "spi: Failed to perform dev transfer");
         return -1;
     }
+    if (dev->soft_lsb) {
+        uint8_t byte = (uint8_t) recv;
+        mraa_spi_bitrev(&byte, &byte, length);
+        recv = byte;
+    }
     return (int) recv;
 }
 
@@ -334,6 +434,8 @@ mraa_spi_write_word(mraa_spi_context dev, uint16_t data)
         return -1;
     }
 
+    MRAA_BUS_LOCK_SCOPE(dev->bus);
+
     if (IS_FUNC_DEFINED(dev, spi_write_word_replace)) {
         return dev->advance_func->spi_write_word_replace(dev, data);
     }
@@ -344,6 +446,9 @@ mraa_spi_write_word(mraa_spi_context dev, uint16_t data)
     uint16_t length = 2;
 
     uint16_t recv = 0;
+    if (dev->soft_lsb || dev->soft_word) {
+        mraa_spi_soft_code(dev, (uint8_t*) &data, (const uint8_t*) &data, length, 0);
+    }
     msg.tx_buf = (unsigned long) &data;
     msg.rx_buf = (unsigned long) &recv;
     msg.speed_hz = dev->clock;
@@ -354,6 +459,9 @@ mraa_spi_write_word(mraa_spi_context dev, uint16_t data)
         syslog(LOG_ERR, "spi: Failed to perform dev transfer");
         return -1;
     }
+    if (dev->soft_lsb || dev->soft_word) {
+        mraa_spi_soft_code(dev, (uint8_t*) &recv, (const uint8_t*) &recv, length, 0);
+    }
     return (int) recv;
 }
 
@@ -365,10 +473,21 @@ mraa_spi_transfer_buf(mraa_spi_context dev, uint8_t* data, uint8_t* rxbuf, int l
         return MRAA_ERROR_INVALID_HANDLE;
     }
 
+    MRAA_BUS_LOCK_SCOPE(dev->bus);
+
     if (IS_FUNC_DEFINED(dev, spi_transfer_buf_replace)) {
         return dev->advance_func->spi_transfer_buf_replace(dev, data, rxbuf, length);
     }
 
+    if (dev->soft_lsb || dev->soft_word) {
+        mraa_spi_segment_t seg = { .tx = data, .rx = rxbuf, .length = length };
+        return mraa_spi_soft_segments(dev, &seg, 1);
+    }
+    if (length > dev->chunk) {
+        mraa_spi_segment_t seg = { .tx = data, .rx = rxbuf, .length = length };
+        return mraa_spi_ioc_segments(dev, &seg, 1);
+    }
+
     struct spi_ioc_transfer msg;
     memset(&msg, 0, sizeof(msg));
 
@@ -393,10 +512,21 @@ mraa_spi_transfer_buf_word(mraa_spi_context dev, uint16_t* data, uint16_t* rxbuf
         return MRAA_ERROR_INVALID_HANDLE;
     }
 
+    MRAA_BUS_LOCK_SCOPE(dev->bus);
+
     if (IS_FUNC_DEFINED(dev, spi_transfer_buf_word_replace)) {
         return dev->advance_func->spi_transfer_buf_word_replace(dev, data, rxbuf, length);
     }
 
+    if (dev->soft_lsb || dev->soft_word) {
+        mraa_spi_segment_t seg = { .tx = (const uint8_t*) data, .rx = (uint8_t*) rxbuf, .length = length };
+        return mraa_spi_soft_segments(dev, &seg, 1);
+    }
+    if (length > dev->chunk) {
+        mraa_spi_segment_t seg = { .tx = (const uint8_t*) data, .rx = (uint8_t*) rxbuf, .length = length };
+        return mraa_spi_ioc_segments(dev, &seg, 1);
+    }
+
     struct spi_ioc_transfer msg;
     memset(&msg, 0, sizeof(msg));
 
@@ -413,6 +543,294 @@ mraa_spi_transfer_buf_word(mraa_spi_context dev, uint16_t* data, uint16_t* rxbuf
     return MRAA_SUCCESS;
 }
 
+/*
+ * Issue segments through spidev, which limits the bytes sent and received
+ * by one ioctl to its bufsiz each. Segments are cut into chunks and packed
+ * as many per ioctl as the limit allows. Between ioctls the chip is kept
+ * selected by cs_change on the last transfer of the message, where it means
+ * the opposite of what it means between transfers.
+ */
+static mraa_result_t
+mraa_spi_ioc_segments(mraa_spi_context dev, const mraa_spi_segment_t* segments, unsigned int num_segments)
+{
+    struct spi_ioc_transfer msgs[MRAA_SPI_MAX_SEGMENTS];
+    int tx_left = dev->bufsiz, rx_left = dev->bufsiz;
+    unsigned int i, n = 0;
+
+    for (i = 0; i < num_segments; ++i) {
+        const mraa_spi_segment_t* seg = &segments[i];
+        unsigned int bpw = seg->bits_per_word > 0 ? seg->bits_per_word : dev->bpw;
+        int align = bpw > 16 ? 4 : (bpw > 8 ? 2 : 1);
+        int done = 0;
+
+        while (done < seg->length) {
+            int len = seg->length - done;
+            if (len > dev->chunk) {
+                len = dev->chunk;
+            }
+            if (seg->tx != NULL && len > tx_left) {
+                len = tx_left;
+            }
+            if (seg->rx != NULL && len > rx_left) {
+                len = rx_left;
+            }
+            // Chunks end on word boundaries
+            if (len < seg->length - done) {
+                len -= len % align;
+            }
+
+            if (len <= 0 || n == MRAA_SPI_MAX_SEGMENTS) {
+                if (n == 0) {
+                    syslog(LOG_ERR, "spi: bufsiz %d is below the word size", dev->bufsiz);
+                    return MRAA_ERROR_INVALID_PARAMETER;
+                }
+                msgs[n - 1].cs_change = !msgs[n - 1].cs_change;
+                if (ioctl(dev->devfd, SPI_IOC_MESSAGE(n), msgs) < 0) {
+                    syslog(LOG_ERR, "spi: Failed to perform dev transfer: %s", strerror(errno));
+                    return MRAA_ERROR_INVALID_RESOURCE;
+                }
+                n = 0;
+                tx_left = rx_left = dev->bufsiz;
+                continue;
+            }
+
+            memset(&msgs[n], 0, sizeof(struct spi_ioc_transfer));
+            msgs[n].tx_buf = seg->tx != NULL ? (unsigned long) (seg->tx + done) : 0;
+            msgs[n].rx_buf = seg->rx != NULL ? (unsigned long) (seg->rx + done) : 0;
+            msgs[n].len = len;
+            msgs[n].speed_hz = seg->speed_hz > 0 ? seg->speed_hz : dev->clock;
+            msgs[n].bits_per_word = bpw;
+            done += len;
+            if (done == seg->length) {
+                msgs[n].delay_usecs = seg->delay_usecs;
+                msgs[n].cs_change = seg->cs_change ? 1 : 0;
+            }
+            if (seg->tx != NULL) {
+                tx_left -= len;
+            }
+            if (seg->rx != NULL) {
+                rx_left -= len;
+            }
+            n++;
+        }
+    }
+
+    if (n > 0 && ioctl(dev->devfd, SPI_IOC_MESSAGE(n), msgs) < 0) {
+        syslog(LOG_ERR, "spi: Failed to perform dev transfer: %s", strerror(errno));
+        return MRAA_ERROR_INVALID_RESOURCE;
+    }
+    return MRAA_SUCCESS;
+}
+
+/*
+ * Move words that were reversed across their whole 16 or 32 bit container
+ * down into the bpw bits the controller shifts
+ */
+static void
+mraa_spi_soft_align(uint8_t* buf, int length, unsigned int bpw)
+{
+    int i;
+
+    if (bpw > 16) {
+        for (i = 0; i + 4 <= length; i += 4) {
+            uint32_t word;
+            memcpy(&word, buf + i, 4);
+            word >>= 32 - bpw;
+            memcpy(buf + i, &word, 4);
+        }
+    } else {
+        for (i = 0; i + 2 <= length; i += 2) {
+            uint16_t word;
+            memcpy(&word, buf + i, 2);
+            word >>= 16 - bpw;
+            memcpy(buf + i, &word, 2);
+        }
+    }
+}
+
+/*
+ * Turn data into the bytes a controller set to MSB first words has to shift
+ * for the software modes to look like the hardware ones, or shifted bytes
+ * back into data. Reversing the bits of a byte sends it LSB first, swapping
+ * the bytes of a 16 bit word sent as two bytes sends its first bit first.
+ * A hardware word is reversed whole, bytes and all, within its bpw bits.
+ * All of it is its own inverse. bpw is the word size of the transfer, 0 for
+ * the context's.
+ */
+static void
+mraa_spi_soft_code(mraa_spi_context dev, uint8_t* dst, const uint8_t* src, int length, unsigned int bpw)
+{
+    unsigned int word_bits = bpw > 0 ? bpw : dev->bpw;
+    mraa_boolean_t swap, hw_word = 0;
+
+    if (bpw == 0 && dev->soft_word) {
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+        swap = !dev->lsb;
+#else
+        swap = dev->lsb;
+#endif
+    } else {
+        // Hardware words go out whole, only reversing them needs the swap
+        swap = hw_word = dev->soft_lsb && word_bits > 8;
+    }
+
+    if (dev->soft_lsb) {
+        mraa_spi_bitrev(dst, src, length);
+    } else if (dst != src) {
+        memcpy(dst, src, length);
+    }
+    if (!swap) {
+        return;
+    }
+    if (hw_word && word_bits > 16) {
+        mraa_spi_swap32(dst, length);
+    } else {
+        mraa_spi_swap16(dst, length);
+    }
+    if (hw_word && word_bits != 16 && word_bits != 32) {
+        mraa_spi_soft_align(dst, length, word_bits);
+    }
+}
+
+/*
+ * Segments in the software modes: the transmit data is coded into scratch
+ * space kept on the context and what was received is decoded in place.
+ */
+static mraa_result_t
+mraa_spi_soft_segments(mraa_spi_context dev, const mraa_spi_segment_t* segments, unsigned int num_segments)
+{
+    mraa_spi_segment_t coded[MRAA_SPI_MAX_SEGMENTS];
+    mraa_result_t status;
+    int total = 0, offset = 0;
+    unsigned int i;
+
+    for (i = 0; i < num_segments; ++i) {
+        if (segments[i].tx != NULL) {
+            total += segments[i].length;
+        }
+    }
+    if (total > dev->soft_size) {
+        uint8_t* buf = (uint8_t*) realloc(dev->soft_buf, total);
+        if (buf == NULL) {
+            syslog(LOG_CRIT, "spi: transfer: Failed to allocate memory for software bit order");
+            return MRAA_ERROR_NO_RESOURCES;
+        }
+        dev->soft_buf = buf;
+        dev->soft_size = total;
+    }
+
+    for (i = 0; i < num_segments; ++i) {
+        coded[i] = segments[i];
+        if (segments[i].tx != NULL) {
+            mraa_spi_soft_code(dev, dev->soft_buf + offset, segments[i].tx, segments[i].length,
+                               segments[i].bits_per_word);
+            coded[i].tx = dev->soft_buf + offset;
+            offset += segments[i].length;
+        }
+    }
+
+    status = mraa_spi_ioc_segments(dev, coded, num_segments);
+    if (status != MRAA_SUCCESS) {
+        return status;
+    }
+
+    for (i = 0; i < num_segments; ++i) {
+        if (segments[i].rx != NULL) {
+            mraa_spi_soft_code(dev, segments[i].rx, segments[i].rx, segments[i].length, segments[i].bits_per_word);
+        }
+    }
+    return MRAA_SUCCESS;
+}
+
+/*
+ * Segments for platforms that replace single transfers only: one transfer
+ * each, with the clock and word size switched around segments that differ.
+ */
+static mraa_result_t
+mraa_spi_transfer_segments_each(mraa_spi_context dev, const mraa_spi_segment_t* segments, unsigned int num_segments)
+{
+    mraa_result_t status = MRAA_SUCCESS;
+    int clock = dev->clock;
+    unsigned int bpw = dev->bpw;
+    unsigned int i;
+
+    for (i = 0; i < num_segments && status == MRAA_SUCCESS; ++i) {
+        const mraa_spi_segment_t* seg = &segments[i];
+        uint8_t* tx = (uint8_t*) seg->tx;
+
+        if (seg->speed_hz > 0 && seg->speed_hz != dev->clock) {
+            status = mraa_spi_frequency(dev, seg->speed_hz);
+        }
+        if (status == MRAA_SUCCESS && seg->bits_per_word > 0 && seg->bits_per_word != dev->bpw) {
+            status = mraa_spi_bit_per_word(dev, seg->bits_per_word);
+        }
+        if (status != MRAA_SUCCESS) {
+            break;
+        }
+
+        if (tx == NULL) {
+            tx = (uint8_t*) calloc(seg->length, sizeof(uint8_t));
+            if (tx == NULL) {
+                syslog(LOG_CRIT, "spi: transfer_segments: Failed to allocate memory for segment");
+                status = MRAA_ERROR_NO_RESOURCES;
+                break;
+            }
+        }
+        status = dev->advance_func->spi_transfer_buf_replace(dev, tx, seg->rx, seg->length);
+        if (tx != seg->tx) {
+            free(tx);
+        }
+        if (seg->delay_usecs > 0) {
+            usleep(seg->delay_usecs);
+        }
+    }
+
+    if (dev->clock != clock) {
+        mraa_spi_frequency(dev, clock);
+    }
+    if (dev->bpw != bpw) {
+        mraa_spi_bit_per_word(dev, bpw);
+    }
+
+    return status;
+}
+
+mraa_result_t
+mraa_spi_transfer_segments(mraa_spi_context dev, const mraa_spi_segment_t* segments, unsigned int num_segments)
+{
+    if (dev == NULL) {
+        syslog(LOG_ERR, "spi: transfer_segments: context is invalid");
+        return MRAA_ERROR_INVALID_HANDLE;
+    }
+
+    if (segments == NULL || num_segments == 0 || num_segments > MRAA_SPI_MAX_SEGMENTS) {
+        syslog(LOG_ERR, "spi: transfer_segments: 1 to %d segments are supported", MRAA_SPI_MAX_SEGMENTS);
+        return MRAA_ERROR_INVALID_PARAMETER;
+    }
+
+    unsigned int i;
+    for (i = 0; i < num_segments; ++i) {
+        if (segments[i].length <= 0) {
+            syslog(LOG_ERR, "spi: transfer_segments: segment %u is empty", i);
+            return MRAA_ERROR_INVALID_PARAMETER;
+        }
+    }
+
+    MRAA_BUS_LOCK_SCOPE(dev->bus);
+
+    if (IS_FUNC_DEFINED(dev, spi_transfer_segments_replace)) {
+        return dev->advance_func->spi_transfer_segments_replace(dev, segments, num_segments);
+    }
+    if (IS_FUNC_DEFINED(dev, spi_transfer_buf_replace)) {
+        return mraa_spi_transfer_segments_each(dev, segments, num_segments);
+    }
+
+    if (dev->soft_lsb || dev->soft_word) {
+        return mraa_spi_soft_segments(dev, segments, num_segments);
+    }
+    return mraa_spi_ioc_segments(dev, segments, num_segments);
+}
+
 uint8_t*
 mraa_spi_write_buf(mraa_spi_context dev, uint8_t* data, int length)
 {
@@ -422,6 +840,10 @@ mraa_spi_write_buf(mraa_spi_context dev, uint8_t* data, int length)
     }
 
     uint8_t* recv = malloc(sizeof(uint8_t) * length);
+    if (recv == NULL) {
+        syslog(LOG_CRIT, "spi: write_buf: Failed to allocate memory for receive buffer");
+        return NULL;
+    }
 
     if (mraa_spi_transfer_buf(dev, data, recv, length) != MRAA_SUCCESS) {
         free(recv);
@@ -439,6 +861,10 @@ mraa_spi_write_buf_word(mraa_spi_context dev, uint16_t* data, int length)
     }
 
     uint16_t* recv = malloc(sizeof(uint16_t) * length);
+    if (recv == NULL) {
+        syslog(LOG_CRIT, "spi: write_buf_word: Failed to allocate memory for receive buffer");
+        return NULL;
+    }
 
     if (mraa_spi_transfer_buf_word(dev, data, recv, length) != MRAA_SUCCESS) {
         free(recv);
@@ -447,6 +873,179 @@ mraa_spi_write_buf_word(mraa_spi_context dev, uint16_t* data, int length)
     return recv;
 }
 
+mraa_result_t
+mraa_spi_rx_pool(mraa_spi_context dev, unsigned int num_buffers, int buffer_size)
+{
+    if (dev == NULL) {
+        syslog(LOG_ERR, "spi: rx_pool: context is invalid");
+        return MRAA_ERROR_INVALID_HANDLE;
+    }
+
+    if (num_buffers > 0 && buffer_size <= 0) {
+        syslog(LOG_ERR, "spi: rx_pool: invalid buffer size %d", buffer_size);
+        return MRAA_ERROR_INVALID_PARAMETER;
+    }
+
+    MRAA_BUS_LOCK_SCOPE(dev->bus);
+
+    free(dev->rx_pool);
+    dev->rx_pool = NULL;
+    dev->rx_pool_count = 0;
+    dev->rx_pool_size = 0;
+    dev->rx_pool_next = 0;
+    if (num_buffers == 0) {
+        return MRAA_SUCCESS;
+    }
+
+    // Even sizes keep every buffer aligned for the word variant
+    buffer_size = (buffer_size + 1) & ~1;
+    dev->rx_pool = (uint8_t*) malloc((size_t) num_buffers * buffer_size);
+    if (dev->rx_pool == NULL) {
+        syslog(LOG_CRIT, "spi: rx_pool: Failed to allocate memory for %u buffers", num_buffers);
+        return MRAA_ERROR_NO_RESOURCES;
+    }
+    dev->rx_pool_count = num_buffers;
+    dev->rx_pool_size = buffer_size;
+
+    return MRAA_SUCCESS;
+}
+
+static uint8_t*
+mraa_spi_rx_pool_next(mraa_spi_context dev, int length, const char* op)
+{
+    uint8_t* buf;
+
+    if (dev->rx_pool == NULL || length > dev->rx_pool_size) {
+        syslog(LOG_ERR, "spi: %s: no pool buffer of %d bytes", op, length);
+        return NULL;
+    }
+    buf = dev->rx_pool + (size_t) dev->rx_pool_next * dev->rx_pool_size;
+    dev->rx_pool_next = (dev->rx_pool_next + 1) % dev->rx_pool_count;
+
+    return buf;
+}
+
+const uint8_t*
+mraa_spi_write_buf_pooled(mraa_spi_context dev, const uint8_t* data, int length)
+{
+    if (dev == NULL) {
+        syslog(LOG_ERR, "spi: write_buf_pooled: context is invalid");
+        return NULL;
+    }
+
+    MRAA_BUS_LOCK_SCOPE(dev->bus);
+
+    uint8_t* recv = mraa_spi_rx_pool_next(dev, length, "write_buf_pooled");
+    if (recv == NULL || mraa_spi_transfer_buf(dev, (uint8_t*) data, recv, length) != MRAA_SUCCESS) {
+        return NULL;
+    }
+    return recv;
+}
+
+const uint16_t*
+mraa_spi_write_buf_word_pooled(mraa_spi_context dev, const uint16_t* data, int length)
+{
+    if (dev == NULL) {
+        syslog(LOG_ERR, "spi: write_buf_word_pooled: context is invalid");
+        return NULL;
+    }
+
+    MRAA_BUS_LOCK_SCOPE(dev->bus);
+
+    uint16_t* recv = (uint16_t*) mraa_spi_rx_pool_next(dev, length, "write_buf_word_pooled");
+    if (recv == NULL || mraa_spi_transfer_buf_word(dev, (uint16_t*) data, recv, length) != MRAA_SUCCESS) {
+        return NULL;
+    }
+    return recv;
+}
+
+/*
+ * Bus worker dispatch. The batch goes out under a single hold of the bus
+ * lock, so nothing from other contexts lands between queued transfers, and
+ * runs queued on the same context share one transaction, deselecting the
+ * chip between transfers as separate calls would.
+ */
+static void
+mraa_spi_dispatch(mraa_bus_request_t* batch)
+{
+    mraa_spi_segment_t segments[MRAA_SPI_MAX_SEGMENTS];
+    mraa_bus_request_t* req = batch;
+
+    while (req != NULL) {
+        mraa_bus_request_t* first = req;
+        unsigned int num = 0;
+        int total = 0;
+
+        memset(segments, 0, sizeof(segments));
+        while (req != NULL && req->dev == first->dev && req->length > 0 && num < MRAA_SPI_MAX_SEGMENTS &&
+               total + req->length <= SPI_MAX_LENGTH) {
+            segments[num].tx = req->tx;
+            segments[num].rx = req->rx;
+            segments[num].length = req->length;
+            segments[num].cs_change = 1;
+            total += req->length;
+            num++;
+            req = req->next;
+        }
+
+        if (num == 0) {
+            req->result = mraa_spi_transfer_buf((mraa_spi_context) req->dev, req->tx, req->rx, req->length);
+            req = req->next;
+            continue;
+        }
+
+        segments[num - 1].cs_change = 0;
+        mraa_result_t status = mraa_spi_transfer_segments((mraa_spi_context) first->dev, segments, num);
+        for (; first != req; first = first->next) {
+            first->result = status;
+        }
+    }
+}
+
+mraa_result_t
+mraa_spi_submit(mraa_spi_context dev, uint8_t* data, uint8_t* rxbuf, int length, mraa_spi_callback_t callback, void* cb_data)
+{
+    mraa_bus_request_t req = { 0 };
+
+    if (dev == NULL) {
+        syslog(LOG_ERR, "spi: submit: context is invalid");
+        return MRAA_ERROR_INVALID_HANDLE;
+    }
+
+    req.dev = dev;
+    req.tx = data;
+    req.rx = rxbuf;
+    req.length = length;
+    req.callback = callback;
+    req.data = cb_data;
+
+    return mraa_bus_submit(dev->bus, &req);
+}
+
+mraa_result_t
+mraa_spi_lock(mraa_spi_context dev)
+{
+    if (dev == NULL) {
+        syslog(LOG_ERR, "spi: lock: context is invalid");
+        return MRAA_ERROR_INVALID_HANDLE;
+    }
+
+    mraa_bus_lock(dev->bus);
+    return MRAA_SUCCESS;
+}
+
+mraa_result_t
+mraa_spi_unlock(mraa_spi_context dev)
+{
+    if (dev == NULL) {
+        syslog(LOG_ERR, "spi: unlock: context is invalid");
+        return MRAA_ERROR_INVALID_HANDLE;
+    }
+
+    mraa_bus_unlock(dev->bus);
+    return MRAA_SUCCESS;
+}
+
 mraa_result_t
 mraa_spi_stop(mraa_spi_context dev)
 {
@@ -455,6 +1054,17 @@ mraa_spi_stop(mraa_spi_context dev)
         return MRAA_ERROR_INVALID_HANDLE;
     }
 
+    if (mraa_bus_flush(dev->bus, dev) != MRAA_SUCCESS) {
+        syslog(LOG_ERR, "spi: stop: bus is locked by this thread, unlock it first");
+        return MRAA_ERROR_INVALID_RESOURCE;
+    }
+    mraa_bus_put(dev->bus);
+    dev->bus = NULL;
+    free(dev->rx_pool);
+    dev->rx_pool = NULL;
+    free(dev->soft_buf);
+    dev->soft_buf = NULL;
+
     if (IS_FUNC_DEFINED(dev, spi_stop_replace)) {
         return dev->advance_func->spi_stop_replace(dev);
     }
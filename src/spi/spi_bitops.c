@@ -0,0 +1,105 @@
+/*
+ * Copyright (c) 2026 Intel Corporation.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "spi/spi_bitops.h"
+
+#include <string.h>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+static inline uint8_t
+mraa_spi_bitrev8(uint8_t b)
+{
+    b = (uint8_t) (((b >> 1) & 0x55) | ((b & 0x55) << 1));
+    b = (uint8_t) (((b >> 2) & 0x33) | ((b & 0x33) << 2));
+    return (uint8_t) ((b >> 4) | (b << 4));
+}
+
+void
+mraa_spi_bitrev(uint8_t* dst, const uint8_t* src, size_t length)
+{
+    size_t i = 0;
+
+#if defined(__SSE2__)
+    // The same swaps as the scalar version, 16 bytes at a time. The masks
+    // drop whatever the 16 bit shifts carry over from the neighbouring byte.
+    const __m128i m1 = _mm_set1_epi8(0x55);
+    const __m128i m2 = _mm_set1_epi8(0x33);
+    const __m128i m4 = _mm_set1_epi8(0x0f);
+
+    for (; i + 16 <= length; i += 16) {
+        __m128i v = _mm_loadu_si128((const __m128i*) (src + i));
+        v = _mm_or_si128(_mm_and_si128(_mm_srli_epi16(v, 1), m1), _mm_slli_epi16(_mm_and_si128(v, m1), 1));
+        v = _mm_or_si128(_mm_and_si128(_mm_srli_epi16(v, 2), m2), _mm_slli_epi16(_mm_and_si128(v, m2), 2));
+        v = _mm_or_si128(_mm_and_si128(_mm_srli_epi16(v, 4), m4), _mm_slli_epi16(_mm_and_si128(v, m4), 4));
+        _mm_storeu_si128((__m128i*) (dst + i), v);
+    }
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+    for (; i + 16 <= length; i += 16) {
+        vst1q_u8(dst + i, vrbitq_u8(vld1q_u8(src + i)));
+    }
+#endif
+
+    for (; i < length; ++i) {
+        dst[i] = mraa_spi_bitrev8(src[i]);
+    }
+}
+
+void
+mraa_spi_swap16(uint8_t* buf, size_t length)
+{
+    size_t i = 0;
+
+#if defined(__SSE2__)
+    for (; i + 16 <= length; i += 16) {
+        __m128i v = _mm_loadu_si128((const __m128i*) (buf + i));
+        _mm_storeu_si128((__m128i*) (buf + i), _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8)));
+    }
+#elif defined(__ARM_NEON)
+    for (; i + 16 <= length; i += 16) {
+        vst1q_u8(buf + i, vrev16q_u8(vld1q_u8(buf + i)));
+    }
+#endif
+
+    for (; i + 2 <= length; i += 2) {
+        uint8_t b = buf[i];
+        buf[i] = buf[i + 1];
+        buf[i + 1] = b;
+    }
+}
+
+void
+mraa_spi_swap32(uint8_t* buf, size_t length)
+{
+    size_t i = 0;
+
+#if defined(__SSE2__)
+    // No byte shuffle before SSSE3: swap the bytes of each half, then the halves
+    for (; i + 16 <= length; i += 16) {
+        __m128i v = _mm_loadu_si128((const __m128i*) (buf + i));
+        v = _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8));
+        v = _mm_shufflelo_epi16(v, _MM_SHUFFLE(2, 3, 0, 1));
+        v = _mm_shufflehi_epi16(v, _MM_SHUFFLE(2, 3, 0, 1));
+        _mm_storeu_si128((__m128i*) (buf + i), v);
+    }
+#elif defined(__ARM_NEON)
+    for (; i + 16 <= length; i += 16) {
+        vst1q_u8(buf + i, vrev32q_u8(vld1q_u8(buf + i)));
+    }
+#endif
+
+    for (; i + 4 <= length; i += 4) {
+        uint8_t b0 = buf[i], b1 = buf[i + 1];
+        buf[i] = buf[i + 3];
+        buf[i + 1] = buf[i + 2];
+        buf[i + 2] = b1;
+        buf[i + 3] = b0;
+    }
+}
@@ -13,11 +13,19 @@
 #include <unistd.h>
 #include <string.h>
 #include <termios.h>
-#include <sys/select.h>
+#include <poll.h>
+#include <sys/ioctl.h>
+#if !defined(MSYS)
+#include <linux/serial.h>
+#endif
 #include <errno.h>
+#include <limits.h>
 #include <string.h>
 
 #include "uart.h"
+#include "uart/uart_rx.h"
+#include "uart/uart_termios2.h"
+#include "uart/uart_tx.h"
 #include "mraa_internal.h"
 
 #ifndef CMSPAR
@@ -323,6 +331,15 @@ mraa_uart_stop(mraa_uart_context dev)
         return MRAA_ERROR_INVALID_HANDLE;
     }
 
+    // The group would go on using the fd and the context
+    if (dev->group != NULL) {
+        syslog(LOG_ERR, "uart%i: stop: port is still in a group", dev->index);
+        return MRAA_ERROR_INVALID_RESOURCE;
+    }
+
+    mraa_uart_rx_stop(dev);
+    mraa_uart_tx_stop(dev);
+
     // just close the device and reset our fd.
     if (dev->fd >= 0) {
         close(dev->fd);
@@ -412,6 +429,10 @@ mraa_uart_settings(int index, const char **devpath, const char **name, int* baud
 
        if (baudrate != NULL) {
            *baudrate = speed_to_uint(cfgetospeed(&term));
+           if (*baudrate == 0) {
+               /* set with BOTHER, only termios2 has the rate */
+               *baudrate = mraa_uart_termios2_get_baud(fd);
+           }
        }
 
        if (ctsrts != NULL) {
@@ -435,6 +456,13 @@ mraa_uart_flush(mraa_uart_context dev)
         return MRAA_ERROR_INVALID_HANDLE;
     }
 
+    if (dev->tx != NULL) {
+        mraa_result_t status = mraa_uart_tx_wait_idle(dev);
+        if (status != MRAA_SUCCESS) {
+            return status;
+        }
+    }
+
     if (IS_FUNC_DEFINED(dev, uart_flush_replace)) {
         return dev->advance_func->uart_flush_replace(dev);
     }
@@ -491,6 +519,10 @@ mraa_uart_set_baudrate(mraa_uart_context dev, unsigned int baud)
     speed_t speed = uint2speed(baud);
     if (speed == B0)
     {
+        if (baud > 0) {
+            // not one of the Bxxxx rates, let the driver make what it can
+            return mraa_uart_termios2_set_baud(dev->fd, baud);
+        }
         syslog(LOG_ERR, "uart%i: set_baudrate: invalid baudrate: %i", dev->index, baud);
         return MRAA_ERROR_INVALID_PARAMETER;
     }
@@ -712,6 +744,59 @@ mraa_uart_set_non_blocking(mraa_uart_context dev, mraa_boolean_t nonblock)
     return MRAA_SUCCESS;
 }
 
+mraa_result_t
+mraa_uart_set_low_latency(mraa_uart_context dev, mraa_boolean_t enable, unsigned int frame_size)
+{
+    if (!dev) {
+        syslog(LOG_ERR, "uart: set_low_latency: context is NULL");
+        return MRAA_ERROR_INVALID_HANDLE;
+    }
+
+    if (dev->fd < 0) {
+        syslog(LOG_ERR, "uart%i: set_low_latency: port is not open", dev->index);
+        return MRAA_ERROR_FEATURE_NOT_SUPPORTED;
+    }
+
+#if !defined(MSYS)
+    // Drivers without serial settings (ptys, some usb adapters) still get
+    // the read tuning below
+    struct serial_struct serial;
+    if (ioctl(dev->fd, TIOCGSERIAL, &serial) == 0) {
+        if (enable) {
+            serial.flags |= ASYNC_LOW_LATENCY;
+        } else {
+            serial.flags &= ~ASYNC_LOW_LATENCY;
+        }
+        if (ioctl(dev->fd, TIOCSSERIAL, &serial) < 0) {
+            syslog(LOG_NOTICE, "uart%i: set_low_latency: TIOCSSERIAL failed: %s", dev->index, strerror(errno));
+        }
+    } else {
+        syslog(LOG_NOTICE, "uart%i: set_low_latency: driver has no serial settings", dev->index);
+    }
+#endif
+
+    struct termios termio;
+    if (tcgetattr(dev->fd, &termio)) {
+        syslog(LOG_ERR, "uart%i: set_low_latency: tcgetattr() failed: %s", dev->index, strerror(errno));
+        return MRAA_ERROR_INVALID_RESOURCE;
+    }
+    // A read returns once a whole frame is in, or a tenth of a second after
+    // the line went quiet mid frame. Off is the cfmakeraw() default.
+    if (enable && frame_size > 1) {
+        termio.c_cc[VMIN] = frame_size > 255 ? 255 : frame_size;
+        termio.c_cc[VTIME] = 1;
+    } else {
+        termio.c_cc[VMIN] = 1;
+        termio.c_cc[VTIME] = 0;
+    }
+    if (tcsetattr(dev->fd, TCSANOW, &termio) < 0) {
+        syslog(LOG_ERR, "uart%i: set_low_latency: tcsetattr() failed: %s", dev->index, strerror(errno));
+        return MRAA_ERROR_FEATURE_NOT_SUPPORTED;
+    }
+
+    return MRAA_SUCCESS;
+}
+
 const char*
 mraa_uart_get_dev_path(mraa_uart_context dev)
 {
@@ -733,6 +818,10 @@ mraa_uart_read(mraa_uart_context dev, char* buf, size_t len)
         return MRAA_ERROR_INVALID_HANDLE;
     }
 
+    if (dev->rx != NULL) {
+        return mraa_uart_rx_read(dev, buf, len);
+    }
+
     if (IS_FUNC_DEFINED(dev, uart_read_replace)) {
         return dev->advance_func->uart_read_replace(dev, buf, len);
     }
@@ -753,6 +842,11 @@ mraa_uart_write(mraa_uart_context dev, const char* buf, size_t len)
         return MRAA_ERROR_INVALID_HANDLE;
     }
 
+    if (dev->tx != NULL && len > 0) {
+        // behind whatever is queued, not ahead of it
+        return mraa_uart_tx_write(dev, buf, len);
+    }
+
     if (IS_FUNC_DEFINED(dev, uart_write_replace)) {
         return dev->advance_func->uart_write_replace(dev, buf, len);
     }
@@ -773,6 +867,10 @@ mraa_uart_data_available(mraa_uart_context dev, unsigned int millis)
         return 0;
     }
 
+    if (dev->rx != NULL) {
+        return mraa_uart_rx_available(dev, millis);
+    }
+
     if (IS_FUNC_DEFINED(dev, uart_data_available_replace)) {
         return dev->advance_func->uart_data_available_replace(dev, millis);
     }
@@ -782,25 +880,12 @@ mraa_uart_data_available(mraa_uart_context dev, unsigned int millis)
         return 0;
     }
 
-    struct timeval timeout;
-
-    if (millis == 0) {
-        // no waiting
-        timeout.tv_sec = 0;
-        timeout.tv_usec = 0;
-    } else {
-        timeout.tv_sec = millis / 1000;
-        timeout.tv_usec = (millis % 1000) * 1000;
-    }
-
-    fd_set readfds;
-
-#if !defined(PERIPHERALMAN)
-    FD_ZERO(&readfds);
-    FD_SET(dev->fd, &readfds);
-#endif
+    // poll() rather than select(), which can't take fds past FD_SETSIZE
+    struct pollfd pfd;
+    pfd.fd = dev->fd;
+    pfd.events = POLLIN;
 
-    if (select(dev->fd + 1, &readfds, NULL, NULL, &timeout) > 0) {
+    if (poll(&pfd, 1, millis > INT_MAX ? -1 : (int) millis) > 0) {
         return 1; // data is ready
     } else {
         return 0;
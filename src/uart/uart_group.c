@@ -0,0 +1,297 @@
+/*
+ * Copyright (c) 2026 Intel Corporation.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "uart_group.h"
+#include "mraa_internal.h"
+
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/epoll.h>
+#include <time.h>
+#include <unistd.h>
+
+#define GROUP_DEFAULT_BUFFER_SIZE 4096
+#define GROUP_MAX_EVENTS 64
+/* How often ports without a fd are checked while the group waits */
+#define GROUP_POLL_MS 10
+
+typedef struct {
+    mraa_uart_context dev; /**< NULL once removed */
+    int fd; /**< fd in the epoll set, as it was when the port was added */
+    uint8_t* buf;
+    mraa_boolean_t polled; /**< no fd in the epoll set, checked through data_available */
+} mraa_uart_group_port_t;
+
+struct _uart_group {
+    int epfd;
+    size_t buffer_size;
+    mraa_uart_group_port_t* ports;
+    int num_ports; /**< ids handed out, removed ports included */
+    int max_ports;
+    int watched; /**< ports in the epoll set */
+    int polled; /**< ports checked through data_available */
+    int next_polled; /**< where the next scan of polled ports starts */
+};
+
+static int64_t
+_mraa_uart_group_now_ms()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t) ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
+}
+
+static void
+_mraa_uart_group_drop(mraa_uart_group_t group, mraa_uart_group_port_t* port)
+{
+    if (port->polled) {
+        group->polled--;
+    } else {
+        epoll_ctl(group->epfd, EPOLL_CTL_DEL, port->fd, NULL);
+        group->watched--;
+    }
+    free(port->buf);
+    port->buf = NULL;
+    port->dev->group = NULL;
+    port->dev = NULL;
+}
+
+static void
+_mraa_uart_group_event(mraa_uart_group_event_t* event, int id, mraa_uart_group_port_t* port, int length)
+{
+    event->port = id;
+    event->dev = port->dev;
+    event->data = length > 0 ? port->buf : NULL;
+    event->length = length;
+}
+
+/**
+ * One pass over the ports that can't be waited on, starting where the last
+ * pass stopped so that a small events array doesn't starve the later ones
+ */
+static int
+_mraa_uart_group_scan(mraa_uart_group_t group, mraa_uart_group_event_t* events, int max_events)
+{
+    int n = 0;
+    int start = group->next_polled;
+
+    for (int i = 0; i < group->num_ports && n < max_events; ++i) {
+        int id = (start + i) % group->num_ports;
+        mraa_uart_group_port_t* port = &group->ports[id];
+        int r;
+
+        if (port->dev == NULL || !port->polled) {
+            continue;
+        }
+        group->next_polled = (id + 1) % group->num_ports;
+        if (!mraa_uart_data_available(port->dev, 0)) {
+            continue;
+        }
+
+        r = mraa_uart_read(port->dev, (char*) port->buf, group->buffer_size);
+        if (r > 0) {
+            _mraa_uart_group_event(&events[n++], id, port, r);
+        } else if (r < 0) {
+            syslog(LOG_ERR, "uart%i: group: read failed, port dropped", port->dev->index);
+            _mraa_uart_group_event(&events[n++], id, port, -1);
+            _mraa_uart_group_drop(group, port);
+        }
+    }
+
+    return n;
+}
+
+mraa_uart_group_t
+mraa_uart_group_init(size_t buffer_size)
+{
+    mraa_uart_group_t group = (mraa_uart_group_t) calloc(1, sizeof(struct _uart_group));
+    if (group == NULL) {
+        syslog(LOG_CRIT, "uart: group_init: Failed to allocate memory for group");
+        return NULL;
+    }
+    group->buffer_size = buffer_size > 0 ? buffer_size : GROUP_DEFAULT_BUFFER_SIZE;
+
+    group->epfd = epoll_create1(EPOLL_CLOEXEC);
+    if (group->epfd < 0) {
+        syslog(LOG_ERR, "uart: group_init: epoll_create1 failed: %s", strerror(errno));
+        free(group);
+        return NULL;
+    }
+
+    return group;
+}
+
+int
+mraa_uart_group_add(mraa_uart_group_t group, mraa_uart_context dev)
+{
+    mraa_uart_group_port_t* port;
+    int id;
+
+    if (group == NULL || dev == NULL) {
+        syslog(LOG_ERR, "uart: group_add: context is NULL");
+        return -1;
+    }
+
+    if (dev->group != NULL) {
+        syslog(LOG_ERR, "uart%i: group_add: port already in a group", dev->index);
+        return -1;
+    }
+
+    if (group->num_ports == group->max_ports) {
+        int max_ports = group->max_ports > 0 ? group->max_ports * 2 : 8;
+        mraa_uart_group_port_t* ports =
+        (mraa_uart_group_port_t*) realloc(group->ports, max_ports * sizeof(mraa_uart_group_port_t));
+        if (ports == NULL) {
+            syslog(LOG_CRIT, "uart%i: group_add: Failed to allocate memory for ports", dev->index);
+            return -1;
+        }
+        group->ports = ports;
+        group->max_ports = max_ports;
+    }
+
+    id = group->num_ports;
+    port = &group->ports[id];
+    port->dev = dev;
+    port->fd = dev->fd;
+    port->buf = (uint8_t*) malloc(group->buffer_size);
+    if (port->buf == NULL) {
+        syslog(LOG_CRIT, "uart%i: group_add: Failed to allocate memory for buffer", dev->index);
+        return -1;
+    }
+
+    // The receiver thread owns the fd of a port it runs on, and replaced
+    // reads can come from somewhere other than the fd altogether
+    port->polled = dev->rx != NULL || IS_FUNC_DEFINED(dev, uart_read_replace) || dev->fd < 0;
+    if (port->polled) {
+        group->polled++;
+    } else {
+        struct epoll_event ev;
+        memset(&ev, 0, sizeof(ev));
+        ev.events = EPOLLIN;
+        ev.data.u32 = (uint32_t) id;
+        if (epoll_ctl(group->epfd, EPOLL_CTL_ADD, dev->fd, &ev) < 0) {
+            syslog(LOG_ERR, "uart%i: group_add: epoll_ctl failed: %s", dev->index, strerror(errno));
+            free(port->buf);
+            return -1;
+        }
+        group->watched++;
+    }
+    group->num_ports++;
+    dev->group = group;
+
+    return id;
+}
+
+mraa_result_t
+mraa_uart_group_remove(mraa_uart_group_t group, int port)
+{
+    if (group == NULL) {
+        syslog(LOG_ERR, "uart: group_remove: context is NULL");
+        return MRAA_ERROR_INVALID_HANDLE;
+    }
+
+    if (port < 0 || port >= group->num_ports || group->ports[port].dev == NULL) {
+        syslog(LOG_ERR, "uart: group_remove: no port %i in the group", port);
+        return MRAA_ERROR_INVALID_PARAMETER;
+    }
+
+    _mraa_uart_group_drop(group, &group->ports[port]);
+    return MRAA_SUCCESS;
+}
+
+int
+mraa_uart_group_wait(mraa_uart_group_t group, mraa_uart_group_event_t* events, int max_events, int millis)
+{
+    struct epoll_event evs[GROUP_MAX_EVENTS];
+    int64_t deadline = _mraa_uart_group_now_ms() + (millis > 0 ? millis : 0);
+
+    if (group == NULL || events == NULL) {
+        syslog(LOG_ERR, "uart: group_wait: context is NULL");
+        return -1;
+    }
+
+    if (max_events <= 0) {
+        syslog(LOG_ERR, "uart: group_wait: no room for events");
+        return -1;
+    }
+
+    if (group->watched == 0 && group->polled == 0) {
+        return 0;
+    }
+
+    for (;;) {
+        int n = group->polled > 0 ? _mraa_uart_group_scan(group, events, max_events) : 0;
+        int timeout = 0;
+        int ready;
+
+        if (n == 0 && millis != 0) {
+            if (millis > 0) {
+                int64_t left = deadline - _mraa_uart_group_now_ms();
+                timeout = left > 0 ? (int) left : 0;
+            } else {
+                timeout = -1;
+            }
+            if (group->polled > 0 && (timeout < 0 || timeout > GROUP_POLL_MS)) {
+                timeout = GROUP_POLL_MS;
+            }
+        }
+
+        if (n < max_events) {
+            int room = max_events - n < GROUP_MAX_EVENTS ? max_events - n : GROUP_MAX_EVENTS;
+            ready = epoll_wait(group->epfd, evs, room, timeout);
+            if (ready < 0) {
+                if (errno != EINTR) {
+                    syslog(LOG_ERR, "uart: group_wait: epoll_wait failed: %s", strerror(errno));
+                    return n > 0 ? n : -1;
+                }
+                ready = 0;
+            }
+
+            for (int i = 0; i < ready; ++i) {
+                int id = (int) evs[i].data.u32;
+                mraa_uart_group_port_t* port = &group->ports[id];
+                ssize_t r = read(port->fd, port->buf, group->buffer_size);
+
+                if (r > 0) {
+                    _mraa_uart_group_event(&events[n++], id, port, (int) r);
+                } else if (r == 0 || (errno != EAGAIN && errno != EINTR)) {
+                    syslog(LOG_ERR, "uart%i: group: port hung up or failed, dropped", port->dev->index);
+                    _mraa_uart_group_event(&events[n++], id, port, -1);
+                    _mraa_uart_group_drop(group, port);
+                }
+            }
+        }
+
+        if (n > 0 || millis == 0 || (group->watched == 0 && group->polled == 0)) {
+            return n;
+        }
+        if (millis > 0 && _mraa_uart_group_now_ms() >= deadline) {
+            return 0;
+        }
+    }
+}
+
+mraa_result_t
+mraa_uart_group_close(mraa_uart_group_t group)
+{
+    if (group == NULL) {
+        syslog(LOG_ERR, "uart: group_close: context is NULL");
+        return MRAA_ERROR_INVALID_HANDLE;
+    }
+
+    for (int id = 0; id < group->num_ports; ++id) {
+        if (group->ports[id].dev != NULL) {
+            group->ports[id].dev->group = NULL;
+        }
+        free(group->ports[id].buf);
+    }
+    free(group->ports);
+    close(group->epfd);
+    free(group);
+
+    return MRAA_SUCCESS;
+}
@@ -0,0 +1,648 @@
+/*
+ * Copyright (c) 2026 Intel Corporation.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "uart.h"
+#include "uart/uart_rx.h"
+#include "mraa_internal.h"
+
+#include <errno.h>
+#include <poll.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/eventfd.h>
+#include <time.h>
+#include <unistd.h>
+
+#define RX_DEFAULT_RING_SIZE 65536
+#define RX_DEFAULT_MAX_FRAME 1024
+#define RX_READ_SIZE 4096
+/* Wait of the receiver on ports whose reads are replaced by the platform */
+#define RX_REPLACE_POLL_MS 10
+
+#define SLIP_END 0xC0
+#define SLIP_ESC 0xDB
+#define SLIP_ESC_END 0xDC
+#define SLIP_ESC_ESC 0xDD
+
+typedef enum {
+    RX_STATE_DATA,
+    RX_STATE_ESCAPE, /**< SLIP escape seen */
+    RX_STATE_PREFIX, /**< reading a length prefix */
+    RX_STATE_DISCARD /**< dropping a bad frame up to the next delimiter */
+} mraa_uart_rx_state_t;
+
+struct _mraa_uart_rx {
+    mraa_uart_context dev;
+    mraa_uart_rx_config_t config;
+    mraa_uart_frame_callback_t callback;
+    void* user_data;
+    uint8_t* ring;
+    unsigned int ring_mask;
+    unsigned int head; /**< written by the receiver thread only */
+    unsigned int tail; /**< written by the consumer only */
+    uint8_t* scratch; /**< read buffer of the callback mode and of overflows */
+    /* decoder, run by whichever side consumes the bytes */
+    uint8_t* frame;
+    unsigned int frame_size;
+    unsigned int frame_len;
+    mraa_uart_rx_state_t state;
+    unsigned int prefix_len;
+    unsigned int expect;
+    mraa_uart_rx_stats_t stats; /**< updated atomically */
+    int datafd; /**< signalled when bytes are pushed to the ring */
+    int stopfd;
+    pthread_t thread;
+};
+
+static inline uint64_t
+_mraa_uart_rx_now_ms()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t) ts.tv_sec * 1000ULL + ts.tv_nsec / 1000000;
+}
+
+static void
+_mraa_uart_rx_error(struct _mraa_uart_rx* rx)
+{
+    __atomic_add_fetch(&rx->stats.framing_errors, 1, __ATOMIC_RELAXED);
+    rx->frame_len = 0;
+    rx->state = RX_STATE_DISCARD;
+}
+
+static mraa_boolean_t
+_mraa_uart_rx_append(struct _mraa_uart_rx* rx, uint8_t byte, unsigned int max)
+{
+    if (rx->frame_len == max) {
+        _mraa_uart_rx_error(rx);
+        return 0;
+    }
+    rx->frame[rx->frame_len++] = byte;
+    return 1;
+}
+
+/*
+ * Decode a COBS frame in place, the delimiter already stripped. The output
+ * never gets ahead of the input, so no second buffer is needed.
+ */
+static int
+_mraa_uart_rx_cobs_decode(uint8_t* buf, unsigned int length)
+{
+    unsigned int in = 0, out = 0;
+
+    while (in < length) {
+        unsigned int code = buf[in++];
+        if (code == 0 || in + code - 1 > length) {
+            return -1;
+        }
+        memmove(buf + out, buf + in, code - 1);
+        out += code - 1;
+        in += code - 1;
+        if (code < 0xFF && in < length) {
+            buf[out++] = 0;
+        }
+    }
+
+    return out;
+}
+
+/*
+ * Feed one byte to the decoder. Returns the length of the frame it
+ * completes, which is left in rx->frame until the next call, or -1. Empty
+ * frames are skipped.
+ */
+static int
+_mraa_uart_rx_decode(struct _mraa_uart_rx* rx, uint8_t byte)
+{
+    unsigned int max = rx->config.max_frame;
+    int len;
+
+    switch (rx->config.framing) {
+        case MRAA_UART_FRAMING_NEWLINE:
+            if (byte != '\n') {
+                if (rx->state != RX_STATE_DISCARD) {
+                    _mraa_uart_rx_append(rx, byte, max);
+                }
+                return -1;
+            }
+            if (rx->state == RX_STATE_DISCARD) {
+                rx->state = RX_STATE_DATA;
+                return -1;
+            }
+            len = rx->frame_len;
+            if (len > 0 && rx->frame[len - 1] == '\r') {
+                len--;
+            }
+            rx->frame_len = 0;
+            return len > 0 ? len : -1;
+
+        case MRAA_UART_FRAMING_SLIP:
+            if (byte == SLIP_END) {
+                mraa_uart_rx_state_t state = rx->state;
+                len = rx->frame_len;
+                rx->frame_len = 0;
+                rx->state = RX_STATE_DATA;
+                if (state == RX_STATE_ESCAPE) {
+                    __atomic_add_fetch(&rx->stats.framing_errors, 1, __ATOMIC_RELAXED);
+                    return -1;
+                }
+                return (state == RX_STATE_DATA && len > 0) ? len : -1;
+            }
+            switch (rx->state) {
+                case RX_STATE_DISCARD:
+                    return -1;
+                case RX_STATE_ESCAPE:
+                    if (byte != SLIP_ESC_END && byte != SLIP_ESC_ESC) {
+                        _mraa_uart_rx_error(rx);
+                        return -1;
+                    }
+                    rx->state = RX_STATE_DATA;
+                    _mraa_uart_rx_append(rx, byte == SLIP_ESC_END ? SLIP_END : SLIP_ESC, max);
+                    return -1;
+                default:
+                    if (byte == SLIP_ESC) {
+                        rx->state = RX_STATE_ESCAPE;
+                    } else {
+                        _mraa_uart_rx_append(rx, byte, max);
+                    }
+                    return -1;
+            }
+
+        case MRAA_UART_FRAMING_COBS:
+            if (byte != 0) {
+                if (rx->state != RX_STATE_DISCARD) {
+                    _mraa_uart_rx_append(rx, byte, rx->frame_size);
+                }
+                return -1;
+            }
+            if (rx->state == RX_STATE_DISCARD) {
+                rx->state = RX_STATE_DATA;
+                return -1;
+            }
+            len = _mraa_uart_rx_cobs_decode(rx->frame, rx->frame_len);
+            rx->frame_len = 0;
+            if (len < 0) {
+                __atomic_add_fetch(&rx->stats.framing_errors, 1, __ATOMIC_RELAXED);
+                return -1;
+            }
+            return len > 0 ? len : -1;
+
+        case MRAA_UART_FRAMING_LENGTH:
+            if (rx->state != RX_STATE_DATA && rx->state != RX_STATE_DISCARD) {
+                // Prefix bytes, the frame buffer is empty while they come in
+                rx->expect = rx->config.length_big_endian ? (rx->expect << 8) | byte
+                                                          : rx->expect | (unsigned int) byte << (8 * rx->prefix_len);
+                if (++rx->prefix_len < rx->config.length_bytes) {
+                    return -1;
+                }
+                rx->prefix_len = 0;
+                rx->frame_len = 0;
+                if (rx->expect == 0) {
+                    return -1;
+                }
+                if (rx->expect > max) {
+                    // No delimiter to resync on, skip the payload instead
+                    __atomic_add_fetch(&rx->stats.framing_errors, 1, __ATOMIC_RELAXED);
+                    rx->state = RX_STATE_DISCARD;
+                } else {
+                    rx->state = RX_STATE_DATA;
+                }
+                return -1;
+            }
+            if (rx->state == RX_STATE_DATA) {
+                rx->frame[rx->frame_len] = byte;
+            }
+            if (++rx->frame_len < rx->expect) {
+                return -1;
+            }
+            len = rx->state == RX_STATE_DATA ? (int) rx->frame_len : -1;
+            rx->frame_len = 0;
+            rx->expect = 0;
+            rx->state = RX_STATE_PREFIX;
+            return len;
+
+        default:
+            return -1;
+    }
+}
+
+static void
+_mraa_uart_rx_deliver(struct _mraa_uart_rx* rx, const uint8_t* bytes, int length)
+{
+    if (rx->config.framing == MRAA_UART_FRAMING_NONE) {
+        __atomic_add_fetch(&rx->stats.frames, 1, __ATOMIC_RELAXED);
+        rx->callback(rx->dev, bytes, length, rx->user_data);
+        return;
+    }
+
+    for (int i = 0; i < length; ++i) {
+        int len = _mraa_uart_rx_decode(rx, bytes[i]);
+        if (len >= 0) {
+            __atomic_add_fetch(&rx->stats.frames, 1, __ATOMIC_RELAXED);
+            rx->callback(rx->dev, rx->frame, len, rx->user_data);
+        }
+    }
+}
+
+static int
+_mraa_uart_rx_fill(struct _mraa_uart_rx* rx, uint8_t* buf, size_t length)
+{
+    mraa_uart_context dev = rx->dev;
+
+    if (IS_FUNC_DEFINED(dev, uart_read_replace)) {
+        return dev->advance_func->uart_read_replace(dev, (char*) buf, length);
+    }
+    return read(dev->fd, buf, length);
+}
+
+static void*
+_mraa_uart_rx_thread(void* arg)
+{
+    struct _mraa_uart_rx* rx = (struct _mraa_uart_rx*) arg;
+    mraa_uart_context dev = rx->dev;
+    mraa_boolean_t replaced = IS_FUNC_DEFINED(dev, uart_read_replace);
+    mraa_boolean_t idle = 0;
+    struct pollfd fds[2];
+    uint64_t one = 1;
+
+    fds[0].fd = rx->stopfd;
+    fds[0].events = POLLIN;
+    fds[1].fd = dev->fd;
+    fds[1].events = POLLIN;
+
+    for (;;) {
+        uint8_t* buf = rx->scratch;
+        size_t space = RX_READ_SIZE;
+        mraa_boolean_t to_ring = 0;
+        int n;
+
+        if (replaced) {
+            // No fd to wait on, ask the platform instead. Without a way to
+            // ask, back off on the stop eventfd after a read came back empty
+            // rather than spinning on the platform read. Either way a read in
+            // progress is only left once the platform returns from it.
+            if (IS_FUNC_DEFINED(dev, uart_data_available_replace)) {
+                if (poll(fds, 1, 0) > 0) {
+                    break;
+                }
+                if (!dev->advance_func->uart_data_available_replace(dev, RX_REPLACE_POLL_MS)) {
+                    continue;
+                }
+            } else if (poll(fds, 1, idle ? RX_REPLACE_POLL_MS : 0) > 0) {
+                break;
+            }
+        } else {
+            if (poll(fds, 2, -1) < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                syslog(LOG_ERR, "uart%i: rx: poll failed: %s", dev->index, strerror(errno));
+                break;
+            }
+            if (fds[0].revents) {
+                break;
+            }
+            if (fds[1].revents == 0) {
+                continue;
+            }
+        }
+
+        if (rx->callback == NULL) {
+            unsigned int head = rx->head;
+            unsigned int tail = __atomic_load_n(&rx->tail, __ATOMIC_ACQUIRE);
+            unsigned int free_bytes = rx->ring_mask + 1 - (head - tail);
+            unsigned int offset = head & rx->ring_mask;
+
+            // Straight into the ring, up to where it wraps
+            if (free_bytes > 0) {
+                buf = rx->ring + offset;
+                space = free_bytes < rx->ring_mask + 1 - offset ? free_bytes : rx->ring_mask + 1 - offset;
+                to_ring = 1;
+            }
+        }
+
+        n = _mraa_uart_rx_fill(rx, buf, space);
+        idle = n <= 0;
+        if (n < 0) {
+            if (errno == EINTR || errno == EAGAIN) {
+                continue;
+            }
+            syslog(LOG_ERR, "uart%i: rx: read failed: %s", dev->index, strerror(errno));
+            break;
+        }
+        if (n == 0) {
+            if (!replaced && (fds[1].revents & POLLHUP)) {
+                syslog(LOG_ERR, "uart%i: rx: port hung up", dev->index);
+                break;
+            }
+            continue;
+        }
+        __atomic_add_fetch(&rx->stats.bytes, n, __ATOMIC_RELAXED);
+
+        if (to_ring) {
+            __atomic_store_n(&rx->head, rx->head + n, __ATOMIC_RELEASE);
+            if (write(rx->datafd, &one, sizeof(one)) < 0) {
+                // The counter only saturates if nobody reads, nothing to do
+            }
+        } else if (rx->callback != NULL) {
+            _mraa_uart_rx_deliver(rx, buf, n);
+        } else {
+            __atomic_add_fetch(&rx->stats.overflows, n, __ATOMIC_RELAXED);
+        }
+    }
+
+    return NULL;
+}
+
+static void
+_mraa_uart_rx_free(struct _mraa_uart_rx* rx)
+{
+    if (rx->datafd >= 0) {
+        close(rx->datafd);
+    }
+    if (rx->stopfd >= 0) {
+        close(rx->stopfd);
+    }
+    free(rx->ring);
+    free(rx->scratch);
+    free(rx->frame);
+    free(rx);
+}
+
+mraa_result_t
+mraa_uart_rx_start(mraa_uart_context dev, const mraa_uart_rx_config_t* config, mraa_uart_frame_callback_t callback, void* data)
+{
+    struct _mraa_uart_rx* rx;
+    unsigned int size = 1;
+
+    if (!dev) {
+        syslog(LOG_ERR, "uart: rx_start: context is NULL");
+        return MRAA_ERROR_INVALID_HANDLE;
+    }
+
+    if (dev->rx != NULL) {
+        syslog(LOG_ERR, "uart%i: rx_start: receiver already running", dev->index);
+        return MRAA_ERROR_INVALID_RESOURCE;
+    }
+
+    // The group reads the fd it was given, the receiver would race it
+    if (dev->group != NULL) {
+        syslog(LOG_ERR, "uart%i: rx_start: port is in a uart group", dev->index);
+        return MRAA_ERROR_INVALID_RESOURCE;
+    }
+
+    if (!IS_FUNC_DEFINED(dev, uart_read_replace) && dev->fd < 0) {
+        syslog(LOG_ERR, "uart%i: rx_start: port is not open", dev->index);
+        return MRAA_ERROR_INVALID_RESOURCE;
+    }
+
+    rx = (struct _mraa_uart_rx*) calloc(1, sizeof(struct _mraa_uart_rx));
+    if (rx == NULL) {
+        syslog(LOG_CRIT, "uart%i: rx_start: Failed to allocate memory for receiver", dev->index);
+        return MRAA_ERROR_NO_RESOURCES;
+    }
+    rx->datafd = rx->stopfd = -1;
+    rx->dev = dev;
+    rx->callback = callback;
+    rx->user_data = data;
+    if (config != NULL) {
+        rx->config = *config;
+    } else {
+        rx->config.framing = MRAA_UART_FRAMING_NEWLINE;
+    }
+    if (rx->config.ring_size == 0) {
+        rx->config.ring_size = RX_DEFAULT_RING_SIZE;
+    }
+    if (rx->config.max_frame == 0) {
+        rx->config.max_frame = RX_DEFAULT_MAX_FRAME;
+    }
+    if (rx->config.length_bytes == 0) {
+        rx->config.length_bytes = 1;
+    }
+
+    if (rx->config.framing > MRAA_UART_FRAMING_LENGTH || rx->config.length_bytes > 2 ||
+        rx->config.ring_size > (1U << 30)) {
+        syslog(LOG_ERR, "uart%i: rx_start: invalid receiver settings", dev->index);
+        _mraa_uart_rx_free(rx);
+        return MRAA_ERROR_INVALID_PARAMETER;
+    }
+    if (rx->config.framing == MRAA_UART_FRAMING_LENGTH) {
+        unsigned int longest = (1U << (8 * rx->config.length_bytes)) - 1;
+        if (rx->config.max_frame > longest) {
+            rx->config.max_frame = longest;
+        }
+        rx->state = RX_STATE_PREFIX;
+    }
+
+    while (size < rx->config.ring_size) {
+        size <<= 1;
+    }
+    rx->ring_mask = size - 1;
+    // COBS frames are buffered encoded, one overhead byte per 254
+    rx->frame_size = rx->config.max_frame + rx->config.max_frame / 254 + 1;
+
+    rx->ring = (uint8_t*) malloc(size);
+    rx->scratch = (uint8_t*) malloc(RX_READ_SIZE);
+    rx->frame = (uint8_t*) malloc(rx->frame_size);
+    if (rx->ring == NULL || rx->scratch == NULL || rx->frame == NULL) {
+        syslog(LOG_CRIT, "uart%i: rx_start: Failed to allocate memory for receiver", dev->index);
+        _mraa_uart_rx_free(rx);
+        return MRAA_ERROR_NO_RESOURCES;
+    }
+
+    rx->datafd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    rx->stopfd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (rx->datafd < 0 || rx->stopfd < 0) {
+        syslog(LOG_ERR, "uart%i: rx_start: eventfd failed: %s", dev->index, strerror(errno));
+        _mraa_uart_rx_free(rx);
+        return MRAA_ERROR_INVALID_RESOURCE;
+    }
+
+    if (pthread_create(&rx->thread, NULL, _mraa_uart_rx_thread, rx) != 0) {
+        syslog(LOG_ERR, "uart%i: rx_start: failed to start receiver thread", dev->index);
+        _mraa_uart_rx_free(rx);
+        return MRAA_ERROR_NO_RESOURCES;
+    }
+    dev->rx = rx;
+
+    return MRAA_SUCCESS;
+}
+
+mraa_result_t
+mraa_uart_rx_stop(mraa_uart_context dev)
+{
+    uint64_t one = 1;
+
+    if (!dev) {
+        syslog(LOG_ERR, "uart: rx_stop: context is NULL");
+        return MRAA_ERROR_INVALID_HANDLE;
+    }
+
+    if (dev->rx == NULL) {
+        return MRAA_SUCCESS;
+    }
+
+    if (write(dev->rx->stopfd, &one, sizeof(one)) < 0) {
+        syslog(LOG_ERR, "uart%i: rx_stop: failed to signal receiver: %s", dev->index, strerror(errno));
+        return MRAA_ERROR_UNSPECIFIED;
+    }
+    pthread_join(dev->rx->thread, NULL);
+    _mraa_uart_rx_free(dev->rx);
+    dev->rx = NULL;
+
+    return MRAA_SUCCESS;
+}
+
+/*
+ * Wait for the receiver to push more bytes, up to the deadline. Returns 0
+ * once the deadline has passed.
+ */
+static mraa_boolean_t
+_mraa_uart_rx_wait(struct _mraa_uart_rx* rx, uint64_t deadline)
+{
+    struct pollfd pfd = { .fd = rx->datafd, .events = POLLIN };
+    uint64_t now = _mraa_uart_rx_now_ms();
+    uint64_t count;
+
+    if (now >= deadline) {
+        return 0;
+    }
+    if (poll(&pfd, 1, (int) (deadline - now)) > 0) {
+        if (read(rx->datafd, &count, sizeof(count)) < 0) {
+            // Raced with another wait, the ring is checked again anyway
+        }
+    }
+
+    return 1;
+}
+
+int
+mraa_uart_read_frame(mraa_uart_context dev, uint8_t* buf, int length, unsigned int millis)
+{
+    struct _mraa_uart_rx* rx;
+    uint64_t deadline;
+
+    if (!dev) {
+        syslog(LOG_ERR, "uart: read_frame: context is NULL");
+        return -1;
+    }
+
+    rx = dev->rx;
+    if (rx == NULL || rx->callback != NULL) {
+        syslog(LOG_ERR, "uart%i: read_frame: no receiver buffering frames", dev->index);
+        return -1;
+    }
+
+    if (buf == NULL || length <= 0) {
+        syslog(LOG_ERR, "uart%i: read_frame: invalid buffer", dev->index);
+        return -1;
+    }
+
+    if (rx->config.framing == MRAA_UART_FRAMING_NONE) {
+        int n = mraa_uart_rx_read(dev, (char*) buf, length);
+        if (n == 0 && mraa_uart_rx_available(dev, millis)) {
+            n = mraa_uart_rx_read(dev, (char*) buf, length);
+        }
+        if (n > 0) {
+            __atomic_add_fetch(&rx->stats.frames, 1, __ATOMIC_RELAXED);
+        }
+        return n;
+    }
+
+    deadline = _mraa_uart_rx_now_ms() + millis;
+    do {
+        unsigned int tail = rx->tail;
+        unsigned int head = __atomic_load_n(&rx->head, __ATOMIC_ACQUIRE);
+
+        while (tail != head) {
+            int len = _mraa_uart_rx_decode(rx, rx->ring[tail++ & rx->ring_mask]);
+            if (len >= 0) {
+                __atomic_store_n(&rx->tail, tail, __ATOMIC_RELEASE);
+                __atomic_add_fetch(&rx->stats.frames, 1, __ATOMIC_RELAXED);
+                // Like recv() with MSG_TRUNC, the caller learns the real length
+                if (len > length) {
+                    __atomic_add_fetch(&rx->stats.truncated, 1, __ATOMIC_RELAXED);
+                }
+                memcpy(buf, rx->frame, len > length ? length : len);
+                return len;
+            }
+        }
+        __atomic_store_n(&rx->tail, tail, __ATOMIC_RELEASE);
+    } while (_mraa_uart_rx_wait(rx, deadline));
+
+    return 0;
+}
+
+int
+mraa_uart_rx_read(mraa_uart_context dev, char* buf, size_t length)
+{
+    struct _mraa_uart_rx* rx = dev->rx;
+    unsigned int tail = rx->tail;
+    unsigned int head = __atomic_load_n(&rx->head, __ATOMIC_ACQUIRE);
+    unsigned int avail = head - tail;
+    unsigned int offset = tail & rx->ring_mask;
+    unsigned int first;
+
+    if (rx->callback != NULL) {
+        syslog(LOG_ERR, "uart%i: read: frames are handed to the receiver callback", dev->index);
+        return -1;
+    }
+
+    if (length < avail) {
+        avail = (unsigned int) length;
+    }
+    first = rx->ring_mask + 1 - offset;
+    if (first > avail) {
+        first = avail;
+    }
+    memcpy(buf, rx->ring + offset, first);
+    memcpy(buf + first, rx->ring, avail - first);
+    __atomic_store_n(&rx->tail, tail + avail, __ATOMIC_RELEASE);
+
+    return (int) avail;
+}
+
+mraa_boolean_t
+mraa_uart_rx_available(mraa_uart_context dev, unsigned int millis)
+{
+    struct _mraa_uart_rx* rx = dev->rx;
+    uint64_t deadline = _mraa_uart_rx_now_ms() + millis;
+
+    if (rx->callback != NULL) {
+        return 0;
+    }
+
+    do {
+        if (__atomic_load_n(&rx->head, __ATOMIC_ACQUIRE) != rx->tail) {
+            return 1;
+        }
+    } while (_mraa_uart_rx_wait(rx, deadline));
+
+    return 0;
+}
+
+mraa_result_t
+mraa_uart_rx_stats(mraa_uart_context dev, mraa_uart_rx_stats_t* stats)
+{
+    if (!dev) {
+        syslog(LOG_ERR, "uart: rx_stats: context is NULL");
+        return MRAA_ERROR_INVALID_HANDLE;
+    }
+
+    if (dev->rx == NULL || stats == NULL) {
+        syslog(LOG_ERR, "uart%i: rx_stats: no receiver running", dev->index);
+        return MRAA_ERROR_INVALID_PARAMETER;
+    }
+
+    stats->bytes = __atomic_load_n(&dev->rx->stats.bytes, __ATOMIC_RELAXED);
+    stats->frames = __atomic_load_n(&dev->rx->stats.frames, __ATOMIC_RELAXED);
+    stats->overflows = __atomic_load_n(&dev->rx->stats.overflows, __ATOMIC_RELAXED);
+    stats->framing_errors = __atomic_load_n(&dev->rx->stats.framing_errors, __ATOMIC_RELAXED);
+    stats->truncated = __atomic_load_n(&dev->rx->stats.truncated, __ATOMIC_RELAXED);
+
+    return MRAA_SUCCESS;
+}
@@ -0,0 +1,62 @@
+/*
+ * Copyright (c) 2026 Intel Corporation.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "uart/uart_termios2.h"
+
+#include <errno.h>
+#include <string.h>
+#include <sys/ioctl.h>
+#if !defined(MSYS)
+#include <asm/termbits.h>
+#endif
+
+mraa_result_t
+mraa_uart_termios2_set_baud(int fd, unsigned int baud)
+{
+#if defined(TCSETSF2) && defined(BOTHER)
+    struct termios2 tio;
+
+    if (ioctl(fd, TCGETS2, &tio) < 0) {
+        syslog(LOG_ERR, "uart: set_baudrate: TCGETS2 failed: %s", strerror(errno));
+        return MRAA_ERROR_INVALID_RESOURCE;
+    }
+
+    tio.c_cflag &= ~(CBAUD | (CBAUD << IBSHIFT));
+    tio.c_cflag |= BOTHER | (BOTHER << IBSHIFT);
+    tio.c_ispeed = baud;
+    tio.c_ospeed = baud;
+    // TCSETSF2 flushes like the TCSAFLUSH used for the standard rates
+    if (ioctl(fd, TCSETSF2, &tio) < 0) {
+        syslog(LOG_ERR, "uart: set_baudrate: TCSETSF2 failed for %u baud: %s", baud, strerror(errno));
+        return MRAA_ERROR_FEATURE_NOT_SUPPORTED;
+    }
+
+    // Drivers round to what their divisors can make, complain if it's far off
+    if (ioctl(fd, TCGETS2, &tio) == 0 && (tio.c_ospeed < baud - baud / 50 || tio.c_ospeed > baud + baud / 50)) {
+        syslog(LOG_NOTICE, "uart: set_baudrate: asked for %u baud, got %u", baud, tio.c_ospeed);
+    }
+
+    return MRAA_SUCCESS;
+#else
+    syslog(LOG_ERR, "uart: set_baudrate: %u baud needs TCSETSF2, not available", baud);
+    return MRAA_ERROR_FEATURE_NOT_SUPPORTED;
+#endif
+}
+
+unsigned int
+mraa_uart_termios2_get_baud(int fd)
+{
+#if defined(TCGETS2)
+    struct termios2 tio;
+
+    if (ioctl(fd, TCGETS2, &tio) < 0) {
+        return 0;
+    }
+    return tio.c_ospeed;
+#else
+    return 0;
+#endif
+}
@@ -0,0 +1,513 @@
+/*
+ * Copyright (c) 2026 Intel Corporation.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "uart.h"
+#include "uart/uart_termios2.h"
+#include "uart/uart_tx.h"
+#include "mraa_internal.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/ioctl.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#define TX_DEFAULT_QUEUE_LIMIT (1024 * 1024)
+#define TX_DEFAULT_OUTQ_LIMIT 4096
+#define TX_MAX_IOV 64
+/* Bounds of the wait for the driver's output queue to go below the limit */
+#define TX_MIN_WAIT_US 100
+#define TX_MAX_WAIT_US 10000
+
+typedef struct _mraa_uart_tx_seg {
+    struct _mraa_uart_tx_seg* next;
+    const uint8_t* bytes; /**< what gets written, buf or the copy */
+    const void* buf;
+    size_t length;
+    mraa_uart_tx_mode_t mode;
+    mraa_uart_tx_done_t done;
+    void* data;
+    uint8_t copy[]; /**< MRAA_UART_TX_COPY bytes */
+} mraa_uart_tx_seg_t;
+
+struct _mraa_uart_tx {
+    mraa_uart_context dev;
+    size_t queue_limit;
+    size_t outq_limit;
+    unsigned int baud; /**< to tell how long the driver takes to drain, 0 if unknown */
+    pthread_mutex_t lock;
+    pthread_cond_t cond; /**< signalled on enqueue and stop */
+    pthread_cond_t room; /**< broadcast when bytes leave the queue and on stop */
+    pthread_cond_t idle; /**< broadcast when the queue runs empty and on stop */
+    pthread_cond_t gone; /**< signalled when the last waiter leaves a stopping queue */
+    unsigned int waiters; /**< callers blocked on room or idle, stop waits them out */
+    mraa_uart_tx_seg_t* head;
+    mraa_uart_tx_seg_t* tail;
+    size_t offset; /**< bytes of head already written */
+    mraa_boolean_t stopping;
+    uint64_t queued;
+    uint64_t written;
+    uint64_t segments;
+    uint64_t writes;
+    pthread_t thread;
+};
+
+static void
+_mraa_uart_tx_release(mraa_uart_tx_seg_t* seg, mraa_result_t result)
+{
+    if (seg->done != NULL) {
+        seg->done(result, seg->buf, seg->length, seg->data);
+    }
+    if (seg->mode == MRAA_UART_TX_TAKE) {
+        free((void*) seg->buf);
+    }
+    free(seg);
+}
+
+/*
+ * Bytes the driver may still take before its output queue is over the
+ * limit. Without an fd there's no queue to look at.
+ */
+static size_t
+_mraa_uart_tx_room(struct _mraa_uart_tx* tx)
+{
+    int outq = 0;
+
+    if (tx->dev->fd < 0 || ioctl(tx->dev->fd, TIOCOUTQ, &outq) < 0 || outq < 0) {
+        return tx->outq_limit;
+    }
+    return (size_t) outq < tx->outq_limit ? tx->outq_limit - outq : 0;
+}
+
+static void
+_mraa_uart_tx_wait_room(struct _mraa_uart_tx* tx)
+{
+    // Roughly the time the line takes to send a quarter of the limit
+    long wait_us = tx->baud > 0 ? (long) (tx->outq_limit / 4 * 10 * 1000000ULL / tx->baud) : TX_MAX_WAIT_US;
+
+    if (wait_us < TX_MIN_WAIT_US) {
+        wait_us = TX_MIN_WAIT_US;
+    } else if (wait_us > TX_MAX_WAIT_US) {
+        wait_us = TX_MAX_WAIT_US;
+    }
+    usleep(wait_us);
+}
+
+static ssize_t
+_mraa_uart_tx_write(struct _mraa_uart_tx* tx, const struct iovec* iov, int iovcnt)
+{
+    mraa_uart_context dev = tx->dev;
+    ssize_t total = 0;
+
+    if (!IS_FUNC_DEFINED(dev, uart_write_replace)) {
+        return writev(dev->fd, iov, iovcnt);
+    }
+
+    // Platforms replacing writes get them one buffer at a time
+    for (int i = 0; i < iovcnt; ++i) {
+        int n = dev->advance_func->uart_write_replace(dev, (const char*) iov[i].iov_base, iov[i].iov_len);
+        if (n < 0) {
+            if (total > 0) {
+                return total;
+            }
+            // The hooks don't set errno, and there's no fd to poll for EAGAIN
+            errno = EIO;
+            return -1;
+        }
+        total += n;
+        if ((size_t) n < iov[i].iov_len) {
+            break;
+        }
+    }
+    return total;
+}
+
+static void*
+_mraa_uart_tx_thread(void* arg)
+{
+    struct _mraa_uart_tx* tx = (struct _mraa_uart_tx*) arg;
+    struct iovec iov[TX_MAX_IOV];
+
+    for (;;) {
+        mraa_uart_tx_seg_t* seg;
+        mraa_uart_tx_seg_t* done = NULL;
+        mraa_uart_tx_seg_t** done_tail = &done;
+        mraa_result_t result = MRAA_SUCCESS;
+        size_t room, offset, bytes = 0;
+        ssize_t n;
+        int iovcnt = 0;
+
+        pthread_mutex_lock(&tx->lock);
+        while (tx->head == NULL && !tx->stopping) {
+            pthread_cond_wait(&tx->cond, &tx->lock);
+        }
+        if (tx->stopping) {
+            pthread_mutex_unlock(&tx->lock);
+            break;
+        }
+        // Only this thread takes segments off the queue, so the ones
+        // gathered here stay put once the lock is dropped
+        seg = tx->head;
+        offset = tx->offset;
+        pthread_mutex_unlock(&tx->lock);
+
+        room = _mraa_uart_tx_room(tx);
+        if (room == 0) {
+            _mraa_uart_tx_wait_room(tx);
+            continue;
+        }
+
+        for (; seg != NULL && iovcnt < TX_MAX_IOV && bytes < room; seg = seg->next) {
+            iov[iovcnt].iov_base = (void*) (seg->bytes + offset);
+            iov[iovcnt].iov_len = seg->length - offset;
+            if (bytes + iov[iovcnt].iov_len > room) {
+                iov[iovcnt].iov_len = room - bytes;
+            }
+            bytes += iov[iovcnt++].iov_len;
+            offset = 0;
+        }
+
+        n = _mraa_uart_tx_write(tx, iov, iovcnt);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            if (errno == EAGAIN) {
+                struct pollfd pfd = { .fd = tx->dev->fd, .events = POLLOUT };
+                poll(&pfd, 1, TX_MAX_WAIT_US / 1000);
+                continue;
+            }
+            // Drop the buffer the write choked on, the rest may yet go
+            syslog(LOG_ERR, "uart%i: tx: write failed: %s", tx->dev->index, strerror(errno));
+            result = MRAA_ERROR_INVALID_RESOURCE;
+        }
+
+        pthread_mutex_lock(&tx->lock);
+        tx->writes++;
+        if (n < 0) {
+            n = tx->head->length - tx->offset;
+        } else {
+            tx->written += n;
+        }
+        tx->queued -= n;
+        pthread_cond_broadcast(&tx->room);
+        while (n > 0) {
+            size_t left = tx->head->length - tx->offset;
+            if ((size_t) n < left) {
+                tx->offset += n;
+                break;
+            }
+            n -= left;
+            *done_tail = tx->head;
+            done_tail = &tx->head->next;
+            tx->head = tx->head->next;
+            tx->offset = 0;
+            if (result == MRAA_SUCCESS) {
+                tx->segments++;
+            }
+        }
+        *done_tail = NULL;
+        if (tx->head == NULL) {
+            tx->tail = NULL;
+            pthread_cond_broadcast(&tx->idle);
+        }
+        pthread_mutex_unlock(&tx->lock);
+
+        while (done != NULL) {
+            seg = done;
+            done = done->next;
+            _mraa_uart_tx_release(seg, result);
+        }
+    }
+
+    return NULL;
+}
+
+mraa_result_t
+mraa_uart_tx_start(mraa_uart_context dev, size_t queue_limit, size_t outq_limit)
+{
+    struct _mraa_uart_tx* tx;
+
+    if (!dev) {
+        syslog(LOG_ERR, "uart: tx_start: context is NULL");
+        return MRAA_ERROR_INVALID_HANDLE;
+    }
+
+    if (dev->tx != NULL) {
+        syslog(LOG_ERR, "uart%i: tx_start: transmit queue already running", dev->index);
+        return MRAA_ERROR_INVALID_RESOURCE;
+    }
+
+    if (!IS_FUNC_DEFINED(dev, uart_write_replace) && dev->fd < 0) {
+        syslog(LOG_ERR, "uart%i: tx_start: port is not open", dev->index);
+        return MRAA_ERROR_INVALID_RESOURCE;
+    }
+
+    tx = (struct _mraa_uart_tx*) calloc(1, sizeof(struct _mraa_uart_tx));
+    if (tx == NULL) {
+        syslog(LOG_CRIT, "uart%i: tx_start: Failed to allocate memory for transmit queue", dev->index);
+        return MRAA_ERROR_NO_RESOURCES;
+    }
+    tx->dev = dev;
+    tx->queue_limit = queue_limit > 0 ? queue_limit : TX_DEFAULT_QUEUE_LIMIT;
+    tx->outq_limit = outq_limit > 0 ? outq_limit : TX_DEFAULT_OUTQ_LIMIT;
+    tx->baud = dev->fd >= 0 ? mraa_uart_termios2_get_baud(dev->fd) : 0;
+    pthread_mutex_init(&tx->lock, NULL);
+    pthread_cond_init(&tx->cond, NULL);
+    pthread_cond_init(&tx->room, NULL);
+    pthread_cond_init(&tx->idle, NULL);
+    pthread_cond_init(&tx->gone, NULL);
+
+    if (pthread_create(&tx->thread, NULL, _mraa_uart_tx_thread, tx) != 0) {
+        syslog(LOG_ERR, "uart%i: tx_start: failed to start transmit thread", dev->index);
+        pthread_cond_destroy(&tx->gone);
+        pthread_cond_destroy(&tx->idle);
+        pthread_cond_destroy(&tx->room);
+        pthread_cond_destroy(&tx->cond);
+        pthread_mutex_destroy(&tx->lock);
+        free(tx);
+        return MRAA_ERROR_NO_RESOURCES;
+    }
+    dev->tx = tx;
+
+    return MRAA_SUCCESS;
+}
+
+/*
+ * Whether length more bytes fit. A buffer larger than the whole limit is
+ * let in on its own once the queue is empty, it could never fit otherwise.
+ */
+static mraa_boolean_t
+_mraa_uart_tx_fits(struct _mraa_uart_tx* tx, size_t length)
+{
+    return tx->queued == 0 || tx->queued + length <= tx->queue_limit;
+}
+
+/*
+ * Leave a wait on the queue, with the lock held. Once the last waiter is
+ * out a stopping queue may be freed, so tx can't be used after unlocking.
+ */
+static void
+_mraa_uart_tx_leave(struct _mraa_uart_tx* tx)
+{
+    if (--tx->waiters == 0 && tx->stopping) {
+        pthread_cond_signal(&tx->gone);
+    }
+}
+
+/*
+ * Queue a buffer, waiting for room if wait is set. On failure buf stays
+ * with the caller.
+ */
+static mraa_result_t
+_mraa_uart_tx_queue(struct _mraa_uart_tx* tx,
+                    const void* buf,
+                    size_t length,
+                    mraa_uart_tx_mode_t mode,
+                    mraa_uart_tx_done_t done,
+                    void* data,
+                    mraa_boolean_t wait)
+{
+    mraa_uart_tx_seg_t* seg;
+
+    seg = (mraa_uart_tx_seg_t*) malloc(sizeof(mraa_uart_tx_seg_t) + (mode == MRAA_UART_TX_COPY ? length : 0));
+    if (seg == NULL) {
+        syslog(LOG_CRIT, "uart%i: tx: Failed to allocate memory for buffer", tx->dev->index);
+        return MRAA_ERROR_NO_RESOURCES;
+    }
+    seg->next = NULL;
+    seg->buf = buf;
+    seg->length = length;
+    seg->mode = mode;
+    seg->done = done;
+    seg->data = data;
+    if (mode == MRAA_UART_TX_COPY) {
+        memcpy(seg->copy, buf, length);
+        seg->bytes = seg->copy;
+    } else {
+        seg->bytes = (const uint8_t*) buf;
+    }
+
+    pthread_mutex_lock(&tx->lock);
+    if (wait && !tx->stopping && !_mraa_uart_tx_fits(tx, length)) {
+        tx->waiters++;
+        while (!tx->stopping && !_mraa_uart_tx_fits(tx, length)) {
+            pthread_cond_wait(&tx->room, &tx->lock);
+        }
+        _mraa_uart_tx_leave(tx);
+    }
+    if (tx->stopping || !_mraa_uart_tx_fits(tx, length)) {
+        pthread_mutex_unlock(&tx->lock);
+        free(seg);
+        return MRAA_ERROR_NO_RESOURCES;
+    }
+    if (tx->tail != NULL) {
+        tx->tail->next = seg;
+    } else {
+        tx->head = seg;
+    }
+    tx->tail = seg;
+    tx->queued += length;
+    pthread_cond_signal(&tx->cond);
+    pthread_mutex_unlock(&tx->lock);
+
+    return MRAA_SUCCESS;
+}
+
+mraa_result_t
+mraa_uart_tx_enqueue(mraa_uart_context dev,
+                     const void* buf,
+                     size_t length,
+                     mraa_uart_tx_mode_t mode,
+                     mraa_uart_tx_done_t done,
+                     void* data)
+{
+    if (!dev) {
+        syslog(LOG_ERR, "uart: tx_enqueue: context is NULL");
+        return MRAA_ERROR_INVALID_HANDLE;
+    }
+
+    if (dev->tx == NULL) {
+        syslog(LOG_ERR, "uart%i: tx_enqueue: no transmit queue running", dev->index);
+        return MRAA_ERROR_INVALID_RESOURCE;
+    }
+
+    if (buf == NULL || length == 0 || mode > MRAA_UART_TX_COPY) {
+        syslog(LOG_ERR, "uart%i: tx_enqueue: invalid buffer", dev->index);
+        return MRAA_ERROR_INVALID_PARAMETER;
+    }
+
+    return _mraa_uart_tx_queue(dev->tx, buf, length, mode, done, data, 0);
+}
+
+int
+mraa_uart_tx_write(mraa_uart_context dev, const char* buf, size_t length)
+{
+    // Blocks for room like write() blocks on the driver, unless the port
+    // was made non-blocking
+    mraa_boolean_t wait = dev->fd < 0 || !(fcntl(dev->fd, F_GETFL) & O_NONBLOCK);
+
+    if (_mraa_uart_tx_queue(dev->tx, buf, length, MRAA_UART_TX_COPY, NULL, NULL, wait) != MRAA_SUCCESS) {
+        errno = EAGAIN;
+        return -1;
+    }
+
+    return (int) length;
+}
+
+mraa_result_t
+mraa_uart_tx_wait_idle(mraa_uart_context dev)
+{
+    struct _mraa_uart_tx* tx;
+    mraa_result_t result;
+
+    if (!dev) {
+        syslog(LOG_ERR, "uart: tx_wait_idle: context is NULL");
+        return MRAA_ERROR_INVALID_HANDLE;
+    }
+
+    tx = dev->tx;
+    if (tx == NULL) {
+        return MRAA_SUCCESS;
+    }
+
+    pthread_mutex_lock(&tx->lock);
+    tx->waiters++;
+    while (tx->head != NULL && !tx->stopping) {
+        pthread_cond_wait(&tx->idle, &tx->lock);
+    }
+    result = tx->stopping ? MRAA_ERROR_INVALID_RESOURCE : MRAA_SUCCESS;
+    _mraa_uart_tx_leave(tx);
+    pthread_mutex_unlock(&tx->lock);
+
+    return result;
+}
+
+mraa_result_t
+mraa_uart_tx_stop(mraa_uart_context dev)
+{
+    struct _mraa_uart_tx* tx;
+    mraa_uart_tx_seg_t* head;
+
+    if (!dev) {
+        syslog(LOG_ERR, "uart: tx_stop: context is NULL");
+        return MRAA_ERROR_INVALID_HANDLE;
+    }
+
+    tx = dev->tx;
+    if (tx == NULL) {
+        return MRAA_SUCCESS;
+    }
+
+    pthread_mutex_lock(&tx->lock);
+    tx->stopping = 1;
+    pthread_cond_signal(&tx->cond);
+    pthread_cond_broadcast(&tx->room);
+    pthread_cond_broadcast(&tx->idle);
+    pthread_mutex_unlock(&tx->lock);
+    pthread_join(tx->thread, NULL);
+
+    // Woken waiters still have to get the lock back before tx can go
+    pthread_mutex_lock(&tx->lock);
+    head = tx->head;
+    tx->head = tx->tail = NULL;
+    while (tx->waiters > 0) {
+        pthread_cond_wait(&tx->gone, &tx->lock);
+    }
+    pthread_mutex_unlock(&tx->lock);
+
+    while (head != NULL) {
+        mraa_uart_tx_seg_t* seg = head;
+        head = seg->next;
+        _mraa_uart_tx_release(seg, MRAA_ERROR_UNSPECIFIED);
+    }
+    pthread_cond_destroy(&tx->gone);
+    pthread_cond_destroy(&tx->idle);
+    pthread_cond_destroy(&tx->room);
+    pthread_cond_destroy(&tx->cond);
+    pthread_mutex_destroy(&tx->lock);
+    free(tx);
+    dev->tx = NULL;
+
+    return MRAA_SUCCESS;
+}
+
+mraa_result_t
+mraa_uart_drain_stats(mraa_uart_context dev, mraa_uart_drain_stats_t* stats)
+{
+    struct _mraa_uart_tx* tx;
+    int outq = 0;
+
+    if (!dev) {
+        syslog(LOG_ERR, "uart: drain_stats: context is NULL");
+        return MRAA_ERROR_INVALID_HANDLE;
+    }
+
+    tx = dev->tx;
+    if (tx == NULL || stats == NULL) {
+        syslog(LOG_ERR, "uart%i: drain_stats: no transmit queue running", dev->index);
+        return MRAA_ERROR_INVALID_PARAMETER;
+    }
+
+    if (dev->fd < 0 || ioctl(dev->fd, TIOCOUTQ, &outq) < 0 || outq < 0) {
+        outq = 0;
+    }
+
+    pthread_mutex_lock(&tx->lock);
+    stats->queued = tx->queued;
+    // The driver's queue also holds whatever was written around the queue
+    stats->in_flight = (uint64_t) outq < tx->written ? (uint64_t) outq : tx->written;
+    stats->completed = tx->written - stats->in_flight;
+    stats->segments = tx->segments;
+    stats->writes = tx->writes;
+    pthread_mutex_unlock(&tx->lock);
+
+    return MRAA_SUCCESS;
+}
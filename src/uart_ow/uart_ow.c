@@ -19,36 +19,133 @@
 #include <fcntl.h>
 #include <errno.h>
 #include <time.h>
+#include <poll.h>
 #include "uart.h"
 #include "uart_ow.h"
 #include "mraa_internal.h"
+#include "uart_ow/uart_ow_engine.h"
 
-// low-level read byte
+// longest wait for the echoes of one batch of time slots
+#define OW_TIMEOUT_MS 5000
+
+// bytes sent per batch by the block functions, 8 time slots each
+#define OW_BLOCK_CHUNK 32
+
+static int64_t
+_ow_now_ms()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t) ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
+}
+
+// low-level write, all of buf in as few writes as the driver takes
 static mraa_result_t
-_ow_read_byte(mraa_uart_ow_context dev, uint8_t *ch)
+_ow_write_bytes(mraa_uart_ow_context dev, const uint8_t* buf, size_t len)
 {
-    time_t thetime = time(NULL);
-    // add 5 seconds -- our crude timeout
-    thetime += 5;
+    size_t done = 0;
 
-    int rv;
-    do {
-        rv = mraa_uart_read(dev->uart, (char*) ch, 1);
-    } while (rv == 0 && (time(NULL) < thetime));
+    while (done < len) {
+        int rv = mraa_uart_write(dev->uart, (const char*) buf + done, len - done);
+        if (rv > 0) {
+            done += rv;
+            continue;
+        }
 
-    if (rv == 0) {
-        return MRAA_ERROR_NO_DATA_AVAILABLE; // we timed out
+        // the fd is non-blocking, wait for the driver to make room
+        if (rv < 0 && errno == EAGAIN && dev->uart->fd >= 0) {
+            struct pollfd pfd = { .fd = dev->uart->fd, .events = POLLOUT };
+            if (poll(&pfd, 1, OW_TIMEOUT_MS) > 0) {
+                continue;
+            }
+        }
+        syslog(LOG_ERR, "uart_ow: write failed");
+        return MRAA_ERROR_INVALID_RESOURCE;
     }
-    else {
-        return MRAA_SUCCESS;
+
+    return MRAA_SUCCESS;
+}
+
+// low-level read of exactly len bytes, sleeping in poll() until they
+// arrive rather than spinning on read()
+static mraa_result_t
+_ow_read_bytes(mraa_uart_ow_context dev, uint8_t* buf, size_t len)
+{
+    int64_t deadline = _ow_now_ms() + OW_TIMEOUT_MS;
+    size_t got = 0;
+
+    while (got < len) {
+        int rv = mraa_uart_read(dev->uart, (char*) buf + got, len - got);
+        if (rv > 0) {
+            got += rv;
+            continue;
+        }
+        if (rv < 0 && errno != EAGAIN && errno != EINTR) {
+            return MRAA_ERROR_INVALID_RESOURCE;
+        }
+
+        int64_t left = deadline - _ow_now_ms();
+        if (left <= 0 || !mraa_uart_data_available(dev->uart, (unsigned int) left)) {
+            return MRAA_ERROR_NO_DATA_AVAILABLE; // we timed out
+        }
+    }
+
+    return MRAA_SUCCESS;
+}
+
+// Run one time slot per byte of slots, 0xff to write a 1 (or read) and
+// 0x00 to write a 0.  All of them go out in one write, and the echoes
+// (0xff for a 1, anything else for a 0) replace them in slots.
+static mraa_result_t
+_ow_slots(mraa_uart_ow_context dev, uint8_t* slots, size_t n)
+{
+    mraa_result_t rv = _ow_write_bytes(dev, slots, n);
+    if (rv != MRAA_SUCCESS) {
+        return rv;
     }
+    return _ow_read_bytes(dev, slots, n);
 }
 
-// low-level write byte
-static int
-_ow_write_byte(mraa_uart_ow_context dev, const char ch)
+// Send tx and receive into rx (can be NULL) LSB first, a chunk of bytes
+// per batch of time slots
+mraa_result_t
+mraa_uart_ow_touch_bytes(mraa_uart_ow_context dev, const uint8_t* tx, uint8_t* rx, size_t len)
 {
-    return mraa_uart_write(dev->uart, &ch, 1);
+    uint8_t slots[OW_BLOCK_CHUNK * 8];
+
+    while (len > 0) {
+        size_t n = len < OW_BLOCK_CHUNK ? len : OW_BLOCK_CHUNK;
+        size_t i;
+        int b;
+
+        for (i = 0; i < n; i++) {
+            for (b = 0; b < 8; b++) {
+                slots[i * 8 + b] = ((tx[i] >> b) & 0x01) ? 0xff : 0x00;
+            }
+        }
+
+        mraa_result_t rv = _ow_slots(dev, slots, n * 8);
+        if (rv != MRAA_SUCCESS) {
+            return rv;
+        }
+
+        if (rx) {
+            for (i = 0; i < n; i++) {
+                uint8_t byte = 0;
+                for (b = 0; b < 8; b++) {
+                    if (slots[i * 8 + b] == 0xff) {
+                        byte |= 1 << b;
+                    }
+                }
+                rx[i] = byte;
+            }
+            rx += n;
+        }
+        tx += n;
+        len -= n;
+    }
+
+    return MRAA_SUCCESS;
 }
 
 // Here we setup a very simple termios with the minimum required
@@ -65,7 +162,12 @@ _ow_set_speed(mraa_uart_ow_context dev, mraa_boolean_t speed)
         return MRAA_ERROR_INVALID_HANDLE;
     }
 
-    static speed_t baud;
+    // platforms replacing the uart have no termios to set up
+    if (dev->uart->fd < 0) {
+        return mraa_uart_set_baudrate(dev->uart, speed ? 115200 : 9600);
+    }
+
+    speed_t baud;
     if (speed) {
         baud = B115200;
     }
@@ -89,12 +191,12 @@ _ow_set_speed(mraa_uart_ow_context dev, mraa_boolean_t speed)
 }
 
 // Perform the 1-Wire Search Algorithm on the 1-Wire bus using the existing
-// search state.
+// search state.  command selects all devices or only those in alarm.
 // Return 1 : device found, ROM number in ROM_NO buffer
 // 0 : device not found, end of search
 //
-static mraa_boolean_t
-_ow_search(mraa_uart_ow_context dev)
+mraa_boolean_t
+mraa_uart_ow_search(mraa_uart_ow_context dev, uint8_t command)
 {
     int id_bit_number;
     int last_zero, rom_byte_number, search_result;
@@ -119,14 +221,29 @@ _ow_search(mraa_uart_ow_context dev)
             return 0;
         }
 
-        // issue the search command
-        mraa_uart_ow_write_byte(dev, MRAA_UART_OW_CMD_SEARCH_ROM);
+        // issue the search command, followed by the time slots reading
+        // the first bit and its complement
+        uint8_t slots[10];
+        int i;
+        for (i = 0; i < 8; i++) {
+            slots[i] = ((command >> i) & 0x01) ? 0xff : 0x00;
+        }
+        slots[8] = slots[9] = 0xff;
+        if (_ow_slots(dev, slots, 10) != MRAA_SUCCESS) {
+            dev->LastDiscrepancy = 0;
+            dev->LastDeviceFlag = 0;
+            dev->LastFamilyDiscrepancy = 0;
+            return 0;
+        }
+
+        slots[1] = slots[8];
+        slots[2] = slots[9];
 
         // loop to do the search
         do {
-            // read a bit and its complement
-            id_bit = mraa_uart_ow_bit(dev, 1);
-            cmp_id_bit = mraa_uart_ow_bit(dev, 1);
+            // a bit and its complement
+            id_bit = (slots[1] == 0xff);
+            cmp_id_bit = (slots[2] == 0xff);
 
             // check for no devices on 1-wire
             if ((id_bit == 1) && (cmp_id_bit == 1))
@@ -159,8 +276,16 @@ _ow_search(mraa_uart_ow_context dev)
                 else
                     dev->ROM_NO[rom_byte_number] &= ~rom_byte_mask;
 
-                // serial number search direction write bit
-                mraa_uart_ow_bit(dev, search_direction);
+                // serial number search direction write bit, batched
+                // with reading the next bit and its complement
+                slots[0] = search_direction ? 0xff : 0x00;
+                slots[1] = slots[2] = 0xff;
+                if (_ow_slots(dev, slots, id_bit_number < 64 ? 3 : 1) != MRAA_SUCCESS) {
+                    dev->LastDiscrepancy = 0;
+                    dev->LastDeviceFlag = 0;
+                    dev->LastFamilyDiscrepancy = 0;
+                    return 0;
+                }
 
                 // increment the byte counter id_bit_number
                 // and shift the mask rom_byte_mask
@@ -177,7 +302,7 @@ _ow_search(mraa_uart_ow_context dev)
 
         // loop until through all ROM bytes 0-7
         // if the search was successful then
-        if (id_bit_number >= 65) {
+        if (id_bit_number >= 65 && mraa_uart_ow_crc8(dev->ROM_NO, MRAA_UART_OW_ROMCODE_SIZE) == 0) {
             // search successful so set
             // LastDiscrepancy,LastDeviceFlag,search_result
             dev->LastDiscrepancy = last_zero;
@@ -185,8 +310,9 @@ _ow_search(mraa_uart_ow_context dev)
             // check for last device
             if (dev->LastDiscrepancy == 0)
                 dev->LastDeviceFlag = 1;
+
+            search_result = 1;
         }
-        search_result = 1;
     }
 
     // if no device found then reset counters so next 'search' will be
@@ -214,7 +340,7 @@ _ow_first(mraa_uart_ow_context dev)
     dev->LastDeviceFlag = 0;
     dev->LastFamilyDiscrepancy = 0;
 
-    return _ow_search(dev);
+    return mraa_uart_ow_search(dev, MRAA_UART_OW_CMD_SEARCH_ROM);
 }
 
 //--------------------------------------------------------------------------
@@ -226,7 +352,7 @@ static mraa_boolean_t
 _ow_next(mraa_uart_ow_context dev)
 {
     // leave the search state alone
-    return _ow_search(dev);
+    return mraa_uart_ow_search(dev, MRAA_UART_OW_CMD_SEARCH_ROM);
 }
 
 // Start of exported mraa functionality
@@ -247,7 +373,7 @@ mraa_uart_ow_init(int index)
 
 
     // now get the fd, and set it up for non-blocking operation
-    if (fcntl(dev->uart->fd, F_SETFL, O_NONBLOCK) == -1) {
+    if (dev->uart->fd >= 0 && fcntl(dev->uart->fd, F_SETFL, O_NONBLOCK) == -1) {
         syslog(LOG_ERR, "uart_ow: failed to set non-blocking on fd");
         mraa_uart_ow_stop(dev);
         return NULL;
@@ -271,7 +397,7 @@ mraa_uart_ow_init_raw(const char* path)
         }
 
     // now get the fd, and set it up for non-blocking operation
-    if (fcntl(dev->uart->fd, F_SETFL, O_NONBLOCK) == -1) {
+    if (dev->uart->fd >= 0 && fcntl(dev->uart->fd, F_SETFL, O_NONBLOCK) == -1) {
         syslog(LOG_ERR, "uart_ow: failed to set non-blocking on fd");
         mraa_uart_ow_stop(dev);
         return NULL;
@@ -302,19 +428,13 @@ mraa_uart_ow_bit(mraa_uart_ow_context dev, uint8_t bit)
         return -1;
     }
 
-    int ret = 0;
-    uint8_t ch;
-    if (bit) {
-        ret = _ow_write_byte(dev, 0xff); /* write a 1 bit */
-    }
-    else {
-        ret = _ow_write_byte(dev, 0x00); /* write a 0 bit */
-    }
+    /* 0xff writes a 1 bit, 0x00 a 0 bit */
+    uint8_t ch = bit ? 0xff : 0x00;
 
     /* return the bit present on the bus (0xff is a '1', anything else
      * (typically 0xfc or 0x00) is a 0
      */
-    if (_ow_read_byte(dev, &ch) != MRAA_SUCCESS || ret == -1) {
+    if (_ow_slots(dev, &ch, 1) != MRAA_SUCCESS) {
          return -1;
     }
     return (ch == 0xff);
@@ -333,22 +453,17 @@ mraa_uart_ow_write_byte(mraa_uart_ow_context dev, uint8_t byte)
      * from the bus and build a byte to return.  This is possible due to
      * the way we wire the UART TX/RX pins together, similar to a
      * loopback connection, except the devices on the 1-wire bus have
-     * the ability to modify the returning bitstream.
+     * the ability to modify the returning bitstream.  All 8 time slots
+     * go out in one write.
      */
 
-    uint8_t bit;
-    int i;
-    for (i = 0; i < 8; i++) {
-        bit = mraa_uart_ow_bit(dev, byte & 0x01);
-        /* prep for next bit to send, and clear space for bit read */
-        byte >>= 1;
-        /* store read bit in the msb */
-        if (bit)
-            byte |= 0x80;
+    uint8_t read;
+    if (mraa_uart_ow_touch_bytes(dev, &byte, &read, 1) != MRAA_SUCCESS) {
+        return -1;
     }
 
     /* return the new byte read */
-    return byte;
+    return read;
 }
 
 int
@@ -366,6 +481,59 @@ mraa_uart_ow_read_byte(mraa_uart_ow_context dev)
     return mraa_uart_ow_write_byte(dev, 0xff);
 }
 
+mraa_result_t
+mraa_uart_ow_write_block(mraa_uart_ow_context dev, const uint8_t* data, size_t length)
+{
+    if (!dev || !data) {
+        syslog(LOG_ERR, "uart_ow: write_block: context is NULL");
+        return MRAA_ERROR_INVALID_HANDLE;
+    }
+
+    uint8_t echo[OW_BLOCK_CHUNK];
+
+    while (length > 0) {
+        size_t n = length < OW_BLOCK_CHUNK ? length : OW_BLOCK_CHUNK;
+        mraa_result_t rv = mraa_uart_ow_touch_bytes(dev, data, echo, n);
+        if (rv != MRAA_SUCCESS) {
+            return rv;
+        }
+
+        /* nothing on the bus should be answering while we write */
+        if (memcmp(echo, data, n) != 0) {
+            syslog(LOG_ERR, "uart_ow: write_block: bus echoed back different bits");
+            return MRAA_ERROR_UART_OW_DATA_ERROR;
+        }
+        data += n;
+        length -= n;
+    }
+
+    return MRAA_SUCCESS;
+}
+
+mraa_result_t
+mraa_uart_ow_read_block(mraa_uart_ow_context dev, uint8_t* data, size_t length)
+{
+    if (!dev || !data) {
+        syslog(LOG_ERR, "uart_ow: read_block: context is NULL");
+        return MRAA_ERROR_INVALID_HANDLE;
+    }
+
+    uint8_t ones[OW_BLOCK_CHUNK];
+    memset(ones, 0xff, sizeof(ones));
+
+    while (length > 0) {
+        size_t n = length < OW_BLOCK_CHUNK ? length : OW_BLOCK_CHUNK;
+        mraa_result_t rv = mraa_uart_ow_touch_bytes(dev, ones, data, n);
+        if (rv != MRAA_SUCCESS) {
+            return rv;
+        }
+        data += n;
+        length -= n;
+    }
+
+    return MRAA_SUCCESS;
+}
+
 mraa_result_t
 mraa_uart_ow_reset(mraa_uart_ow_context dev)
 {
@@ -374,7 +542,7 @@ mraa_uart_ow_reset(mraa_uart_ow_context dev)
         return MRAA_ERROR_INVALID_HANDLE;
     }
 
-    uint8_t rv;
+    uint8_t rv = 0xf0;
 
     /* To emit a proper reset pulse, we set low speed (9600 baud) for
      * the reset pulse and send 0xf0 to pull the line down for the
@@ -394,9 +562,11 @@ mraa_uart_ow_reset(mraa_uart_ow_context dev)
     }
 
     /* pull the data line low */
-    _ow_write_byte(dev, 0xf0);
+    if (_ow_write_bytes(dev, &rv, 1) != MRAA_SUCCESS) {
+        return MRAA_ERROR_INVALID_RESOURCE;
+    }
 
-    if (_ow_read_byte(dev, &rv) != MRAA_SUCCESS) {
+    if (_ow_read_bytes(dev, &rv, 1) != MRAA_SUCCESS) {
         return MRAA_ERROR_NO_DATA_AVAILABLE;
     }
 
@@ -464,51 +634,57 @@ mraa_uart_ow_command(mraa_uart_ow_context dev, uint8_t command, uint8_t* id)
     if (rv != MRAA_SUCCESS)
         return rv;
 
+    /* the rom command, rom code and command all go out in one batch */
+    uint8_t buf[MRAA_UART_OW_ROMCODE_SIZE + 2];
+    size_t len = 0;
+
     if (id) {
         /* send the match rom command */
-        mraa_uart_ow_write_byte(dev, MRAA_UART_OW_CMD_MATCH_ROM);
+        buf[len++] = MRAA_UART_OW_CMD_MATCH_ROM;
 
         /* sending to a specific device, so send out the full romcode */
-        int i;
-        for (i = 0; i < MRAA_UART_OW_ROMCODE_SIZE; i++)
-            mraa_uart_ow_write_byte(dev, id[i]);
+        memcpy(buf + len, id, MRAA_UART_OW_ROMCODE_SIZE);
+        len += MRAA_UART_OW_ROMCODE_SIZE;
     } else {
         /* send to all devices (or a single device if it's the only one
          * on the bus)
          */
-        mraa_uart_ow_write_byte(dev, MRAA_UART_OW_CMD_SKIP_ROM);
+        buf[len++] = MRAA_UART_OW_CMD_SKIP_ROM;
     }
 
-    mraa_uart_ow_write_byte(dev, command);
+    buf[len++] = command;
 
-    return MRAA_SUCCESS;
+    return mraa_uart_ow_touch_bytes(dev, buf, NULL, len);
 }
 
 uint8_t
 mraa_uart_ow_crc8(uint8_t* buffer, uint16_t length)
 {
-    // 0x18 = X ^ 8 + X ^ 5 + X ^ 4 + X ^ 0
-    static const uint8_t CRC8POLY = 0x18;
+    // X ^ 8 + X ^ 5 + X ^ 4 + X ^ 0, reflected (0x8c), a byte at a time
+    static const uint8_t crc8_table[256] = {
+        0x00, 0x5e, 0xbc, 0xe2, 0x61, 0x3f, 0xdd, 0x83, 0xc2, 0x9c, 0x7e, 0x20, 0xa3, 0xfd, 0x1f, 0x41,
+        0x9d, 0xc3, 0x21, 0x7f, 0xfc, 0xa2, 0x40, 0x1e, 0x5f, 0x01, 0xe3, 0xbd, 0x3e, 0x60, 0x82, 0xdc,
+        0x23, 0x7d, 0x9f, 0xc1, 0x42, 0x1c, 0xfe, 0xa0, 0xe1, 0xbf, 0x5d, 0x03, 0x80, 0xde, 0x3c, 0x62,
+        0xbe, 0xe0, 0x02, 0x5c, 0xdf, 0x81, 0x63, 0x3d, 0x7c, 0x22, 0xc0, 0x9e, 0x1d, 0x43, 0xa1, 0xff,
+        0x46, 0x18, 0xfa, 0xa4, 0x27, 0x79, 0x9b, 0xc5, 0x84, 0xda, 0x38, 0x66, 0xe5, 0xbb, 0x59, 0x07,
+        0xdb, 0x85, 0x67, 0x39, 0xba, 0xe4, 0x06, 0x58, 0x19, 0x47, 0xa5, 0xfb, 0x78, 0x26, 0xc4, 0x9a,
+        0x65, 0x3b, 0xd9, 0x87, 0x04, 0x5a, 0xb8, 0xe6, 0xa7, 0xf9, 0x1b, 0x45, 0xc6, 0x98, 0x7a, 0x24,
+        0xf8, 0xa6, 0x44, 0x1a, 0x99, 0xc7, 0x25, 0x7b, 0x3a, 0x64, 0x86, 0xd8, 0x5b, 0x05, 0xe7, 0xb9,
+        0x8c, 0xd2, 0x30, 0x6e, 0xed, 0xb3, 0x51, 0x0f, 0x4e, 0x10, 0xf2, 0xac, 0x2f, 0x71, 0x93, 0xcd,
+        0x11, 0x4f, 0xad, 0xf3, 0x70, 0x2e, 0xcc, 0x92, 0xd3, 0x8d, 0x6f, 0x31, 0xb2, 0xec, 0x0e, 0x50,
+        0xaf, 0xf1, 0x13, 0x4d, 0xce, 0x90, 0x72, 0x2c, 0x6d, 0x33, 0xd1, 0x8f, 0x0c, 0x52, 0xb0, 0xee,
+        0x32, 0x6c, 0x8e, 0xd0, 0x53, 0x0d, 0xef, 0xb1, 0xf0, 0xae, 0x4c, 0x12, 0x91, 0xcf, 0x2d, 0x73,
+        0xca, 0x94, 0x76, 0x28, 0xab, 0xf5, 0x17, 0x49, 0x08, 0x56, 0xb4, 0xea, 0x69, 0x37, 0xd5, 0x8b,
+        0x57, 0x09, 0xeb, 0xb5, 0x36, 0x68, 0x8a, 0xd4, 0x95, 0xcb, 0x29, 0x77, 0xf4, 0xaa, 0x48, 0x16,
+        0xe9, 0xb7, 0x55, 0x0b, 0x88, 0xd6, 0x34, 0x6a, 0x2b, 0x75, 0x97, 0xc9, 0x4a, 0x14, 0xf6, 0xa8,
+        0x74, 0x2a, 0xc8, 0x96, 0x15, 0x4b, 0xa9, 0xf7, 0xb6, 0xe8, 0x0a, 0x54, 0xd7, 0x89, 0x6b, 0x35,
+    };
 
     uint8_t crc = 0x00;
     uint16_t loop_count;
-    uint8_t bit_counter;
-    uint8_t data;
-    uint8_t feedback_bit;
 
     for (loop_count = 0; loop_count != length; loop_count++) {
-        data = buffer[loop_count];
-        bit_counter = 8;
-        do {
-            feedback_bit = (crc ^ data) & 0x01;
-            if (feedback_bit == 0x01)
-                crc = crc ^ CRC8POLY;
-            crc = (crc >> 1) & 0x7F;
-            if (feedback_bit == 0x01)
-                crc = crc | 0x80;
-            data = data >> 1;
-            bit_counter--;
-        } while (bit_counter > 0);
+        crc = crc8_table[crc ^ buffer[loop_count]];
     }
 
     return crc;
@@ -0,0 +1,353 @@
+/*
+ * Copyright (c) 2026 Intel Corporation.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "uart_ow.h"
+#include "mraa_internal.h"
+#include "uart_ow/uart_ow_engine.h"
+
+// worst case 12 bit DS18B20 conversion
+#define OW_CONVERT_TIMEOUT_MS 750
+// time between polls of a running conversion
+#define OW_CONVERT_POLL_US 5000
+// match rom command, rom code and function command ahead of the reads
+#define OW_MATCH_HEADER (MRAA_UART_OW_ROMCODE_SIZE + 2)
+
+struct _mraa_uart_ow_registry {
+    mraa_uart_ow_context dev;
+    uint8_t (*ids)[MRAA_UART_OW_ROMCODE_SIZE];
+    int count;
+    int size;
+    int next; /**< where the next revalidation starts */
+    uint8_t* xfer; /**< time slot batch of read_all */
+    size_t xfer_size;
+};
+
+static int64_t
+_ow_registry_now_ms()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t) ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
+}
+
+static void
+_ow_registry_search_reset(mraa_uart_ow_context dev)
+{
+    dev->LastDiscrepancy = 0;
+    dev->LastDeviceFlag = 0;
+    dev->LastFamilyDiscrepancy = 0;
+}
+
+// Point the search state at id, so that the next pass follows it at
+// every discrepancy and finds the lowest rom code at or above it
+static void
+_ow_registry_search_target(mraa_uart_ow_context dev, const uint8_t* id)
+{
+    memcpy(dev->ROM_NO, id, MRAA_UART_OW_ROMCODE_SIZE);
+    dev->LastDiscrepancy = 64;
+    dev->LastDeviceFlag = 0;
+    dev->LastFamilyDiscrepancy = 0;
+}
+
+// -1 on a bus error, 0 when nothing answers the reset, 1 otherwise
+static int
+_ow_registry_present(mraa_uart_ow_registry_t registry)
+{
+    mraa_result_t rv = mraa_uart_ow_reset(registry->dev);
+
+    if (rv == MRAA_ERROR_UART_OW_NO_DEVICES) {
+        return 0;
+    }
+    if (rv != MRAA_SUCCESS) {
+        syslog(LOG_ERR, "uart_ow: registry: bus reset failed");
+        return -1;
+    }
+    return 1;
+}
+
+static mraa_result_t
+_ow_registry_add(mraa_uart_ow_registry_t registry, const uint8_t* id)
+{
+    if (registry->count == registry->size) {
+        int size = registry->size > 0 ? registry->size * 2 : 8;
+        uint8_t(*ids)[MRAA_UART_OW_ROMCODE_SIZE] = realloc(registry->ids, size * MRAA_UART_OW_ROMCODE_SIZE);
+        if (ids == NULL) {
+            syslog(LOG_CRIT, "uart_ow: registry: Failed to allocate memory for %d devices", size);
+            return MRAA_ERROR_NO_RESOURCES;
+        }
+        registry->ids = ids;
+        registry->size = size;
+    }
+
+    memcpy(registry->ids[registry->count++], id, MRAA_UART_OW_ROMCODE_SIZE);
+    return MRAA_SUCCESS;
+}
+
+mraa_uart_ow_registry_t
+mraa_uart_ow_registry_init(mraa_uart_ow_context dev)
+{
+    if (!dev) {
+        syslog(LOG_ERR, "uart_ow: registry_init: context is NULL");
+        return NULL;
+    }
+
+    mraa_uart_ow_registry_t registry = calloc(1, sizeof(struct _mraa_uart_ow_registry));
+    if (registry == NULL) {
+        syslog(LOG_CRIT, "uart_ow: registry_init: Failed to allocate memory for registry");
+        return NULL;
+    }
+    registry->dev = dev;
+
+    return registry;
+}
+
+int
+mraa_uart_ow_registry_scan(mraa_uart_ow_registry_t registry, uint8_t family)
+{
+    if (!registry) {
+        syslog(LOG_ERR, "uart_ow: registry_scan: context is NULL");
+        return -1;
+    }
+
+    mraa_uart_ow_context dev = registry->dev;
+    int present = _ow_registry_present(registry);
+
+    registry->count = 0;
+    registry->next = 0;
+    if (present <= 0) {
+        return present;
+    }
+
+    if (family) {
+        // start straight at the family rather than walking the devices
+        // ahead of it
+        uint8_t id[MRAA_UART_OW_ROMCODE_SIZE] = { family };
+        _ow_registry_search_target(dev, id);
+    } else {
+        _ow_registry_search_reset(dev);
+    }
+
+    while (mraa_uart_ow_search(dev, MRAA_UART_OW_CMD_SEARCH_ROM)) {
+        if (family && dev->ROM_NO[0] != family) {
+            break;
+        }
+        if (_ow_registry_add(registry, dev->ROM_NO) != MRAA_SUCCESS) {
+            _ow_registry_search_reset(dev);
+            return -1;
+        }
+    }
+    _ow_registry_search_reset(dev);
+
+    return registry->count;
+}
+
+int
+mraa_uart_ow_registry_revalidate(mraa_uart_ow_registry_t registry, int max_devices)
+{
+    if (!registry) {
+        syslog(LOG_ERR, "uart_ow: registry_revalidate: context is NULL");
+        return -1;
+    }
+
+    mraa_uart_ow_context dev = registry->dev;
+    int checks = registry->count;
+    int dropped = 0;
+
+    if (max_devices > 0 && max_devices < checks) {
+        checks = max_devices;
+    }
+
+    while (checks-- > 0 && registry->count > 0) {
+        int i = registry->next % registry->count;
+        uint8_t* id = registry->ids[i];
+
+        _ow_registry_search_target(dev, id);
+        if (mraa_uart_ow_search(dev, MRAA_UART_OW_CMD_SEARCH_ROM) &&
+            memcmp(dev->ROM_NO, id, MRAA_UART_OW_ROMCODE_SIZE) == 0) {
+            registry->next = i + 1;
+            continue;
+        }
+
+        // gone, or the bus failed; tell them apart before dropping it
+        if (_ow_registry_present(registry) < 0) {
+            _ow_registry_search_reset(dev);
+            return -1;
+        }
+        memmove(registry->ids[i], registry->ids[i + 1], (registry->count - i - 1) * MRAA_UART_OW_ROMCODE_SIZE);
+        registry->count--;
+        registry->next = i;
+        dropped++;
+    }
+    if (registry->count > 0) {
+        registry->next %= registry->count;
+    }
+    _ow_registry_search_reset(dev);
+
+    return dropped;
+}
+
+int
+mraa_uart_ow_registry_count(mraa_uart_ow_registry_t registry)
+{
+    if (!registry) {
+        syslog(LOG_ERR, "uart_ow: registry_count: context is NULL");
+        return -1;
+    }
+
+    return registry->count;
+}
+
+mraa_result_t
+mraa_uart_ow_registry_get(mraa_uart_ow_registry_t registry, int index, uint8_t* id)
+{
+    if (!registry || !id) {
+        syslog(LOG_ERR, "uart_ow: registry_get: context is NULL");
+        return MRAA_ERROR_INVALID_HANDLE;
+    }
+
+    if (index < 0 || index >= registry->count) {
+        syslog(LOG_ERR, "uart_ow: registry_get: no device %d", index);
+        return MRAA_ERROR_INVALID_PARAMETER;
+    }
+
+    memcpy(id, registry->ids[index], MRAA_UART_OW_ROMCODE_SIZE);
+    return MRAA_SUCCESS;
+}
+
+int
+mraa_uart_ow_registry_alarm_search(mraa_uart_ow_registry_t registry, uint8_t* ids, int max_ids)
+{
+    if (!registry || !ids) {
+        syslog(LOG_ERR, "uart_ow: registry_alarm_search: context is NULL");
+        return -1;
+    }
+
+    mraa_uart_ow_context dev = registry->dev;
+    int present = _ow_registry_present(registry);
+    int n = 0;
+
+    if (present <= 0) {
+        return present;
+    }
+
+    _ow_registry_search_reset(dev);
+    while (n < max_ids && mraa_uart_ow_search(dev, MRAA_UART_OW_CMD_SEARCH_ROM_ALARM)) {
+        memcpy(ids + n * MRAA_UART_OW_ROMCODE_SIZE, dev->ROM_NO, MRAA_UART_OW_ROMCODE_SIZE);
+        n++;
+    }
+    _ow_registry_search_reset(dev);
+
+    return n;
+}
+
+mraa_result_t
+mraa_uart_ow_registry_convert_all(mraa_uart_ow_registry_t registry, uint8_t command, unsigned int timeout_ms)
+{
+    if (!registry) {
+        syslog(LOG_ERR, "uart_ow: registry_convert_all: context is NULL");
+        return MRAA_ERROR_INVALID_HANDLE;
+    }
+
+    int64_t deadline = _ow_registry_now_ms() + (timeout_ms > 0 ? timeout_ms : OW_CONVERT_TIMEOUT_MS);
+
+    mraa_result_t rv = mraa_uart_ow_command(registry->dev, command, NULL);
+    if (rv != MRAA_SUCCESS) {
+        return rv;
+    }
+
+    // every device holds read slots at 0 until its conversion is done
+    for (;;) {
+        int bit = mraa_uart_ow_bit(registry->dev, 1);
+        if (bit < 0) {
+            return MRAA_ERROR_NO_DATA_AVAILABLE;
+        }
+        if (bit == 1) {
+            return MRAA_SUCCESS;
+        }
+        if (_ow_registry_now_ms() >= deadline) {
+            syslog(LOG_ERR, "uart_ow: registry_convert_all: conversion timed out");
+            return MRAA_ERROR_UART_OW_DATA_ERROR;
+        }
+        usleep(OW_CONVERT_POLL_US);
+    }
+}
+
+int
+mraa_uart_ow_registry_read_all(mraa_uart_ow_registry_t registry,
+                               uint8_t command,
+                               uint8_t* data,
+                               size_t length,
+                               mraa_result_t* results)
+{
+    if (!registry || (!data && length > 0)) {
+        syslog(LOG_ERR, "uart_ow: registry_read_all: context is NULL");
+        return -1;
+    }
+
+    size_t need = OW_MATCH_HEADER + length;
+    int ok = 0;
+
+    if (need > registry->xfer_size) {
+        uint8_t* xfer = realloc(registry->xfer, need);
+        if (xfer == NULL) {
+            syslog(LOG_CRIT, "uart_ow: registry_read_all: Failed to allocate memory for %zu bytes", need);
+            return -1;
+        }
+        registry->xfer = xfer;
+        registry->xfer_size = need;
+    }
+
+    for (int i = 0; i < registry->count; i++) {
+        uint8_t* xfer = registry->xfer;
+        uint8_t* answer = data + i * length;
+        mraa_result_t rv = mraa_uart_ow_reset(registry->dev);
+
+        if (rv == MRAA_SUCCESS) {
+            // rom code, command and the reads all in one batch
+            xfer[0] = MRAA_UART_OW_CMD_MATCH_ROM;
+            memcpy(xfer + 1, registry->ids[i], MRAA_UART_OW_ROMCODE_SIZE);
+            xfer[OW_MATCH_HEADER - 1] = command;
+            memset(xfer + OW_MATCH_HEADER, 0xff, length);
+            rv = mraa_uart_ow_touch_bytes(registry->dev, xfer, xfer, need);
+        }
+
+        if (rv == MRAA_SUCCESS && length > 0) {
+            memcpy(answer, xfer + OW_MATCH_HEADER, length);
+            if (length > 1 && mraa_uart_ow_crc8(answer, length) != 0) {
+                rv = MRAA_ERROR_UART_OW_DATA_ERROR;
+            }
+        }
+
+        if (results) {
+            results[i] = rv;
+        }
+        if (rv == MRAA_SUCCESS) {
+            ok++;
+        }
+    }
+
+    return ok;
+}
+
+mraa_result_t
+mraa_uart_ow_registry_close(mraa_uart_ow_registry_t registry)
+{
+    if (!registry) {
+        syslog(LOG_ERR, "uart_ow: registry_close: context is NULL");
+        return MRAA_ERROR_INVALID_HANDLE;
+    }
+
+    free(registry->ids);
+    free(registry->xfer);
+    free(registry);
+
+    return MRAA_SUCCESS;
+}
@@ -821,6 +821,37 @@ i2c_write_word_data_replace(mraa_i2c_context dev, const uint16_t data, const uin
     return status;
 }
 
+/* One lock and bus select for the lot, so no other user gets in between.
+ * Every message ends with a stop, so joined pairs are refused. */
+mraa_result_t
+i2c_txn_submit_replace(mraa_i2c_context dev, mraa_i2c_txn_t txn)
+{
+    Ftdi_4222_Shim* shim = ShimFromI2cBus(dev->busnum);
+    if (!shim)
+        return MRAA_ERROR_NO_RESOURCES;
+
+    for (unsigned int i = 0; i < txn->num_msgs; ++i) {
+        if (txn->msgs[i].joined) {
+            syslog(LOG_ERR, "FT4222 I2C has no repeated start, can't submit a write and read pair");
+            return MRAA_ERROR_FEATURE_NOT_SUPPORTED;
+        }
+    }
+
+    lock_guard lock(shim->mtx_ft4222);
+
+    if (ft4222_i2c_select_bus(dev->busnum) != MRAA_SUCCESS)
+        return MRAA_ERROR_UNSPECIFIED;
+
+    for (unsigned int i = 0; i < txn->num_msgs; ++i) {
+        mraa_i2c_txn_msg_t* msg = &txn->msgs[i];
+        int bytes = msg->read ? ft4222_i2c_read_internal(*shim, msg->addr, msg->data, msg->len) :
+                                ft4222_i2c_write_internal(*shim, msg->addr, msg->data, msg->len);
+        if (bytes != msg->len)
+            return MRAA_ERROR_UNSPECIFIED;
+    }
+    return MRAA_SUCCESS;
+}
+
 mraa_result_t i2c_stop_replace(mraa_i2c_context /*dev*/)
 {
     return MRAA_SUCCESS;
@@ -1275,6 +1306,7 @@ ft4222_populate_i2c_func_table(mraa_adv_func_t* func_table)
     func_table->i2c_write_byte_replace = &i2c_write_byte_replace; // No mutex needed
     func_table->i2c_write_byte_data_replace = &i2c_write_byte_data_replace;
     func_table->i2c_write_word_data_replace = &i2c_write_word_data_replace;
+    func_table->i2c_txn_submit_replace = &i2c_txn_submit_replace;
     func_table->i2c_stop_replace = &i2c_stop_replace;
 }
 
@@ -0,0 +1,204 @@
+/*
+ * Copyright (c) 2026 Intel Corporation.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "mraa/i2c.h"
+#include "mraa/spi.h"
+#include "gtest/gtest.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <mutex>
+#include <thread>
+
+#define MOCK_I2C_BUS 0
+#define MOCK_I2C_ADDR 0x33
+#define MOCK_SPI_BUS 0
+
+/* Completion of one queued request */
+struct completion {
+    std::mutex lock;
+    std::condition_variable done;
+    int count = 0;
+    mraa_result_t result = MRAA_SUCCESS;
+};
+
+static void
+count_completion(mraa_result_t result, void* data)
+{
+    completion* c = static_cast<completion*>(data);
+    std::lock_guard<std::mutex> guard(c->lock);
+    c->count++;
+    if (result != MRAA_SUCCESS) {
+        c->result = result;
+    }
+    c->done.notify_all();
+}
+
+/* MRAA bus arbiter test fixture, on the mock i2c device */
+class mraa_bus_arbiter_h_unit : public ::testing::Test
+{
+  protected:
+    mraa_i2c_context dev = NULL;
+
+    virtual void
+    SetUp()
+    {
+        ASSERT_EQ(MRAA_SUCCESS, mraa_init());
+        dev = mraa_i2c_init(MOCK_I2C_BUS);
+        ASSERT_TRUE(dev != NULL);
+        ASSERT_EQ(MRAA_SUCCESS, mraa_i2c_address(dev, MOCK_I2C_ADDR));
+    }
+
+    virtual void
+    TearDown()
+    {
+        if (dev != NULL) {
+            mraa_i2c_stop(dev);
+        }
+    }
+};
+
+/* Queued requests run in order, after synchronous calls that held the bus */
+TEST_F(mraa_bus_arbiter_h_unit, test_queue_ordering)
+{
+    completion c;
+    uint8_t value = 0x22;
+    uint8_t readback = 0;
+    mraa_i2c_txn_t write = mraa_i2c_txn_init(dev);
+    mraa_i2c_txn_t read = mraa_i2c_txn_init(dev);
+    ASSERT_TRUE(write != NULL && read != NULL);
+    ASSERT_EQ(MRAA_SUCCESS, mraa_i2c_txn_add_write(write, MOCK_I2C_ADDR, &value, 1));
+    ASSERT_EQ(MRAA_SUCCESS, mraa_i2c_txn_add_read(read, MOCK_I2C_ADDR, &readback, 1));
+
+    /* The worker can't touch the bus while it's locked */
+    ASSERT_EQ(MRAA_SUCCESS, mraa_i2c_lock(dev));
+    ASSERT_EQ(MRAA_SUCCESS, mraa_i2c_write_byte(dev, 0x11));
+    ASSERT_EQ(MRAA_SUCCESS, mraa_i2c_submit(write, count_completion, &c));
+    ASSERT_EQ(MRAA_SUCCESS, mraa_i2c_submit(read, count_completion, &c));
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    ASSERT_EQ(0x11, mraa_i2c_read_byte(dev));
+    {
+        std::lock_guard<std::mutex> guard(c.lock);
+        ASSERT_EQ(0, c.count);
+    }
+    ASSERT_EQ(MRAA_SUCCESS, mraa_i2c_unlock(dev));
+
+    {
+        std::unique_lock<std::mutex> guard(c.lock);
+        ASSERT_TRUE(c.done.wait_for(guard, std::chrono::seconds(5), [&] { return c.count == 2; }));
+    }
+    ASSERT_EQ(MRAA_SUCCESS, c.result);
+    ASSERT_EQ(0x22, readback);
+    ASSERT_EQ(0x22, mraa_i2c_read_byte(dev));
+
+    mraa_i2c_txn_free(write);
+    mraa_i2c_txn_free(read);
+}
+
+/* Completion callbacks don't hold the bus, other threads get to use it */
+TEST_F(mraa_bus_arbiter_h_unit, test_callback_outside_lock)
+{
+    struct {
+        std::mutex lock;
+        std::condition_variable changed;
+        bool in_callback = false;
+        bool sync_done = false;
+        bool saw_sync = false;
+    } state;
+    uint8_t value = 0x33;
+    mraa_i2c_txn_t txn = mraa_i2c_txn_init(dev);
+    ASSERT_TRUE(txn != NULL);
+    ASSERT_EQ(MRAA_SUCCESS, mraa_i2c_txn_add_write(txn, MOCK_I2C_ADDR, &value, 1));
+
+    /* The callback waits for a synchronous call from this thread, which
+     * could never finish if the worker held the bus lock meanwhile */
+    auto callback = [](mraa_result_t result, void* data) {
+        auto* s = static_cast<decltype(state)*>(data);
+        std::unique_lock<std::mutex> guard(s->lock);
+        s->in_callback = true;
+        s->changed.notify_all();
+        s->saw_sync = s->changed.wait_for(guard, std::chrono::seconds(2), [&] { return s->sync_done; });
+    };
+    ASSERT_EQ(MRAA_SUCCESS, mraa_i2c_submit(txn, callback, &state));
+
+    {
+        std::unique_lock<std::mutex> guard(state.lock);
+        ASSERT_TRUE(state.changed.wait_for(guard, std::chrono::seconds(5), [&] { return state.in_callback; }));
+    }
+    ASSERT_EQ(0x33, mraa_i2c_read_byte(dev));
+    {
+        std::lock_guard<std::mutex> guard(state.lock);
+        state.sync_done = true;
+        state.changed.notify_all();
+    }
+
+    /* stop waits for the callback to return */
+    ASSERT_EQ(MRAA_SUCCESS, mraa_i2c_stop(dev));
+    dev = NULL;
+    ASSERT_TRUE(state.saw_sync);
+
+    mraa_i2c_txn_free(txn);
+}
+
+/* Stop returns only once everything the context queued has completed */
+TEST_F(mraa_bus_arbiter_h_unit, test_stop_flushes_queue)
+{
+    const int queued = 32;
+    completion c;
+    uint8_t values[queued];
+    mraa_i2c_txn_t txns[queued];
+
+    /* Hold the bus so that the whole lot is still pending at stop */
+    ASSERT_EQ(MRAA_SUCCESS, mraa_i2c_lock(dev));
+    for (int i = 0; i < queued; i++) {
+        values[i] = i;
+        txns[i] = mraa_i2c_txn_init(dev);
+        ASSERT_TRUE(txns[i] != NULL);
+        ASSERT_EQ(MRAA_SUCCESS, mraa_i2c_txn_add_write(txns[i], MOCK_I2C_ADDR, &values[i], 1));
+        ASSERT_EQ(MRAA_SUCCESS, mraa_i2c_submit(txns[i], count_completion, &c));
+    }
+
+    /* The worker would need the lock this thread holds, so stop refuses */
+    ASSERT_EQ(MRAA_ERROR_INVALID_RESOURCE, mraa_i2c_stop(dev));
+    ASSERT_EQ(MRAA_SUCCESS, mraa_i2c_unlock(dev));
+
+    ASSERT_EQ(MRAA_SUCCESS, mraa_i2c_stop(dev));
+    dev = NULL;
+    {
+        std::lock_guard<std::mutex> guard(c.lock);
+        ASSERT_EQ(queued, c.count);
+        ASSERT_EQ(MRAA_SUCCESS, c.result);
+    }
+
+    for (int i = 0; i < queued; i++) {
+        mraa_i2c_txn_free(txns[i]);
+    }
+}
+
+/* Spi contexts on one bus share the arbiter the same way */
+TEST_F(mraa_bus_arbiter_h_unit, test_spi_stop_flushes_queue)
+{
+    const int queued = 8;
+    completion c;
+    uint8_t tx[queued][4];
+    uint8_t rx[queued][4];
+    mraa_spi_context spi = mraa_spi_init(MOCK_SPI_BUS);
+    ASSERT_TRUE(spi != NULL);
+
+    ASSERT_EQ(MRAA_SUCCESS, mraa_spi_lock(spi));
+    for (int i = 0; i < queued; i++) {
+        memset(tx[i], i, sizeof(tx[i]));
+        ASSERT_EQ(MRAA_SUCCESS, mraa_spi_submit(spi, tx[i], rx[i], sizeof(tx[i]), count_completion, &c));
+    }
+    ASSERT_EQ(MRAA_ERROR_INVALID_RESOURCE, mraa_spi_stop(spi));
+    ASSERT_EQ(MRAA_SUCCESS, mraa_spi_unlock(spi));
+
+    ASSERT_EQ(MRAA_SUCCESS, mraa_spi_stop(spi));
+    std::lock_guard<std::mutex> guard(c.lock);
+    ASSERT_EQ(queued, c.count);
+    ASSERT_EQ(MRAA_SUCCESS, c.result);
+}
@@ -0,0 +1,106 @@
+/*
+ * Copyright (c) 2026 Intel Corporation.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "gpio/gpio_mmap.h"
+#include "mraa/gpio.h"
+#include "gtest/gtest.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#define MOCK_GPIO_PIN 0
+#define REG_BLOCK_SIZE 4096
+#define SET_REG 0
+#define CLR_REG 4
+#define LEV_REG 8
+#define BIT_POS 3
+
+/* MRAA gpio mmap test fixture. The mock board pin gets a register block
+ * backed by a plain file, so the generic engine maps real memory */
+class mraa_gpio_mmap_unit : public ::testing::Test
+{
+  protected:
+    char path[32] = "/tmp/mraa_mmap_XXXXXX";
+    int fd = -1;
+
+    virtual void
+    SetUp()
+    {
+        ASSERT_EQ(MRAA_SUCCESS, mraa_init());
+        fd = mkstemp(path);
+        ASSERT_GE(fd, 0);
+        ASSERT_EQ(0, ftruncate(fd, REG_BLOCK_SIZE));
+
+        mraa_mmap_pin_t* desc = &plat->pins[MOCK_GPIO_PIN].mmap;
+        memset(desc, 0, sizeof(*desc));
+        strncpy(desc->mem_dev, path, sizeof(desc->mem_dev) - 1);
+        desc->mem_sz = REG_BLOCK_SIZE;
+        desc->bit_pos = BIT_POS;
+        desc->regs = 1;
+        desc->set_reg = SET_REG;
+        desc->clr_reg = CLR_REG;
+        desc->lev_reg = LEV_REG;
+    }
+
+    virtual void
+    TearDown()
+    {
+        memset(&plat->pins[MOCK_GPIO_PIN].mmap, 0, sizeof(mraa_mmap_pin_t));
+        if (fd >= 0) {
+            close(fd);
+            unlink(path);
+        }
+    }
+
+    uint32_t
+    reg(unsigned int offset)
+    {
+        uint32_t value = 0;
+        pread(fd, &value, sizeof(value), offset);
+        return value;
+    }
+};
+
+/* A context made by pin number drives the pin's registers */
+TEST_F(mraa_gpio_mmap_unit, test_board_pin)
+{
+    mraa_gpio_context dev = mraa_gpio_init(MOCK_GPIO_PIN);
+    ASSERT_TRUE(dev != NULL);
+
+    ASSERT_EQ(MRAA_SUCCESS, mraa_gpio_mmap_setup(dev, 1));
+    ASSERT_EQ(MRAA_SUCCESS, mraa_gpio_mmap_write(dev, 1));
+    ASSERT_EQ(MRAA_SUCCESS, mraa_gpio_mmap_write(dev, 0));
+    ASSERT_EQ(MRAA_SUCCESS, mraa_gpio_mmap_setup(dev, 0));
+
+    ASSERT_EQ(1u << BIT_POS, reg(SET_REG));
+    ASSERT_EQ(1u << BIT_POS, reg(CLR_REG));
+    mraa_gpio_close(dev);
+}
+
+/* provided_pins holds board pins for init_multi but a chip line offset for
+ * init_by_name, the line must not be taken for the board pin of that number */
+TEST_F(mraa_gpio_mmap_unit, test_by_name_refused)
+{
+    struct _gpio* dev = (struct _gpio*) calloc(1, sizeof(struct _gpio));
+    ASSERT_TRUE(dev != NULL);
+    int line_offset = MOCK_GPIO_PIN;
+    dev->num_pins = 1;
+    dev->provided_pins = &line_offset;
+
+    /* Shaped as init_multi leaves it, the pin is found */
+    ASSERT_EQ(MRAA_SUCCESS, mraa_gpio_mmap_setup_multi(dev, 1));
+    ASSERT_EQ(MRAA_SUCCESS, mraa_gpio_mmap_setup_multi(dev, 0));
+
+    /* Shaped as init_by_name leaves it */
+    dev->phy_pin = -1;
+    ASSERT_TRUE(mraa_gpio_mmap_pin(dev) == NULL);
+    ASSERT_EQ(MRAA_ERROR_FEATURE_NOT_IMPLEMENTED, mraa_gpio_mmap_setup(dev, 1));
+    ASSERT_EQ(MRAA_ERROR_FEATURE_NOT_IMPLEMENTED, mraa_gpio_mmap_setup_multi(dev, 1));
+    ASSERT_TRUE(dev->mmap_banks == NULL);
+
+    free(dev);
+}
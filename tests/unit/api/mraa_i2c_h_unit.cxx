@@ -0,0 +1,200 @@
+/*
+ * Copyright (c) 2026 Intel Corporation.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "mraa/i2c.h"
+#include "gtest/gtest.h"
+
+#include <future>
+
+#define MOCK_I2C_BUS 0
+#define MOCK_I2C_ADDR 0x33
+#define MOCK_I2C_DATA_INIT_BYTE 0xAB
+#define ABSENT_I2C_ADDR 0x44
+
+/* MRAA i2c test fixture, on the mock i2c device */
+class mraa_i2c_h_unit : public ::testing::Test
+{
+  protected:
+    mraa_i2c_context dev = NULL;
+    mraa_i2c_txn_t txn = NULL;
+
+    virtual void
+    SetUp()
+    {
+        ASSERT_EQ(MRAA_SUCCESS, mraa_init());
+        dev = mraa_i2c_init(MOCK_I2C_BUS);
+        ASSERT_TRUE(dev != NULL);
+        ASSERT_EQ(MRAA_SUCCESS, mraa_i2c_address(dev, MOCK_I2C_ADDR));
+        txn = mraa_i2c_txn_init(dev);
+        ASSERT_TRUE(txn != NULL);
+    }
+
+    virtual void
+    TearDown()
+    {
+        if (txn != NULL) {
+            mraa_i2c_txn_free(txn);
+        }
+        if (dev != NULL) {
+            mraa_i2c_stop(dev);
+        }
+    }
+};
+
+/* Messages go out in order, and again on every submit */
+TEST_F(mraa_i2c_h_unit, test_txn_write_read)
+{
+    uint8_t wdata[] = { 0x01, 0x02, 0x03 };
+    uint8_t rdata[4] = { 0 };
+
+    ASSERT_EQ(MRAA_SUCCESS, mraa_i2c_txn_add_write(txn, MOCK_I2C_ADDR, wdata, sizeof(wdata)));
+    ASSERT_EQ(MRAA_SUCCESS, mraa_i2c_txn_add_read(txn, MOCK_I2C_ADDR, rdata, sizeof(rdata)));
+    /* The write data was copied */
+    wdata[0] = 0x10;
+
+    ASSERT_EQ(MRAA_SUCCESS, mraa_i2c_txn_submit(txn));
+    ASSERT_EQ(0x01, rdata[0]);
+    ASSERT_EQ(0x02, rdata[1]);
+    ASSERT_EQ(0x03, rdata[2]);
+    ASSERT_EQ(MOCK_I2C_DATA_INIT_BYTE, rdata[3]);
+
+    ASSERT_EQ(MRAA_SUCCESS, mraa_i2c_write_byte_data(dev, 0x20, 1));
+    ASSERT_EQ(MRAA_SUCCESS, mraa_i2c_txn_submit(txn));
+    ASSERT_EQ(0x02, rdata[1]);
+}
+
+/* A single byte register followed by the read is a register read */
+TEST_F(mraa_i2c_h_unit, test_txn_register_read)
+{
+    uint8_t reg = 4;
+    uint8_t rdata[2] = { 0 };
+
+    ASSERT_EQ(MRAA_SUCCESS, mraa_i2c_write_byte_data(dev, 0x5C, reg));
+    ASSERT_EQ(MRAA_SUCCESS, mraa_i2c_txn_add_write_read(txn, MOCK_I2C_ADDR, &reg, 1, rdata, sizeof(rdata)));
+    ASSERT_EQ(MRAA_SUCCESS, mraa_i2c_txn_submit(txn));
+    ASSERT_EQ(0x5C, rdata[0]);
+    ASSERT_EQ(MOCK_I2C_DATA_INIT_BYTE, rdata[1]);
+}
+
+/* Without a repeated start after a longer write the pair is refused, before
+ * the messages queued ahead of it went out */
+TEST_F(mraa_i2c_h_unit, test_txn_long_joined_write)
+{
+    uint8_t first = 0x77;
+    uint8_t reg[] = { 0x00, 0x04 };
+    uint8_t rdata[2];
+
+    ASSERT_EQ(MRAA_SUCCESS, mraa_i2c_txn_add_write(txn, MOCK_I2C_ADDR, &first, 1));
+    ASSERT_EQ(MRAA_SUCCESS, mraa_i2c_txn_add_write_read(txn, MOCK_I2C_ADDR, reg, sizeof(reg), rdata, sizeof(rdata)));
+    ASSERT_EQ(MRAA_ERROR_FEATURE_NOT_SUPPORTED, mraa_i2c_txn_submit(txn));
+    ASSERT_EQ(MOCK_I2C_DATA_INIT_BYTE, mraa_i2c_read_byte_data(dev, 0));
+}
+
+/* An absent slave fails the transaction, the context keeps its address */
+TEST_F(mraa_i2c_h_unit, test_txn_absent_slave)
+{
+    uint8_t rdata[1];
+
+    ASSERT_EQ(MRAA_SUCCESS, mraa_i2c_txn_add_read(txn, ABSENT_I2C_ADDR, rdata, sizeof(rdata)));
+    ASSERT_NE(MRAA_SUCCESS, mraa_i2c_txn_submit(txn));
+    ASSERT_EQ(MOCK_I2C_DATA_INIT_BYTE, mraa_i2c_read_byte(dev));
+}
+
+/* Bad lengths are refused, a cleared transaction is empty and reusable */
+TEST_F(mraa_i2c_h_unit, test_txn_clear)
+{
+    uint8_t data[1] = { 0x42 };
+    uint8_t rdata[1] = { 0 };
+
+    ASSERT_EQ(MRAA_ERROR_INVALID_PARAMETER, mraa_i2c_txn_add_write(txn, MOCK_I2C_ADDR, data, 0));
+    ASSERT_EQ(MRAA_ERROR_INVALID_PARAMETER, mraa_i2c_txn_add_read(txn, MOCK_I2C_ADDR, rdata, 8193));
+    ASSERT_EQ(MRAA_ERROR_INVALID_PARAMETER, mraa_i2c_txn_add_read(txn, MOCK_I2C_ADDR, NULL, 1));
+
+    ASSERT_EQ(MRAA_SUCCESS, mraa_i2c_txn_add_read(txn, ABSENT_I2C_ADDR, rdata, 1));
+    ASSERT_EQ(MRAA_SUCCESS, mraa_i2c_txn_clear(txn));
+    ASSERT_EQ(MRAA_SUCCESS, mraa_i2c_txn_submit(txn));
+
+    ASSERT_EQ(MRAA_SUCCESS, mraa_i2c_txn_add_write(txn, MOCK_I2C_ADDR, data, 1));
+    ASSERT_EQ(MRAA_SUCCESS, mraa_i2c_txn_add_read(txn, MOCK_I2C_ADDR, rdata, 1));
+    ASSERT_EQ(MRAA_SUCCESS, mraa_i2c_txn_submit(txn));
+    ASSERT_EQ(0x42, rdata[0]);
+}
+
+static void
+txn_done(mraa_result_t result, void* data)
+{
+    static_cast<std::promise<mraa_result_t>*>(data)->set_value(result);
+}
+
+/* The bus worker runs a submitted transaction and reports its result */
+TEST_F(mraa_i2c_h_unit, test_txn_async)
+{
+    uint8_t reg = 2;
+    uint8_t rdata[1] = { 0 };
+    std::promise<mraa_result_t> done;
+
+    ASSERT_EQ(MRAA_SUCCESS, mraa_i2c_write_byte_data(dev, 0x66, reg));
+    ASSERT_EQ(MRAA_SUCCESS, mraa_i2c_txn_add_write_read(txn, MOCK_I2C_ADDR, &reg, 1, rdata, 1));
+    ASSERT_EQ(MRAA_SUCCESS, mraa_i2c_submit(txn, txn_done, &done));
+
+    std::future<mraa_result_t> result = done.get_future();
+    ASSERT_EQ(std::future_status::ready, result.wait_for(std::chrono::seconds(1)));
+    ASSERT_EQ(MRAA_SUCCESS, result.get());
+    ASSERT_EQ(0x66, rdata[0]);
+}
+
+/* A lone byte write may change any register, the shadow forgets the slave.
+ * Word reads go to the bus without counting */
+TEST_F(mraa_i2c_h_unit, test_cache_write_byte)
+{
+    uint64_t hits, misses;
+
+    ASSERT_EQ(MRAA_SUCCESS, mraa_i2c_cache_enable(dev, 1));
+    ASSERT_EQ(MOCK_I2C_DATA_INIT_BYTE, mraa_i2c_read_byte_data(dev, 0));
+    ASSERT_EQ(MOCK_I2C_DATA_INIT_BYTE, mraa_i2c_read_byte_data(dev, 0));
+
+    /* The mock takes the byte into register 0 */
+    ASSERT_EQ(MRAA_SUCCESS, mraa_i2c_write_byte(dev, 0x12));
+    ASSERT_EQ(0x12, mraa_i2c_read_byte_data(dev, 0));
+
+    ASSERT_EQ(MOCK_I2C_DATA_INIT_BYTE | (MOCK_I2C_DATA_INIT_BYTE << 8), mraa_i2c_read_word_data(dev, 2));
+    ASSERT_EQ(MRAA_SUCCESS, mraa_i2c_cache_stats(dev, &hits, &misses));
+    ASSERT_EQ(1u, hits);
+    ASSERT_EQ(2u, misses);
+}
+
+/* The addressed calls reach their slave while the context stays on its own,
+ * whether they succeed or not */
+TEST_F(mraa_i2c_h_unit, test_at_keeps_address)
+{
+    uint8_t wdata[] = { 0x01, 0x02 };
+    uint8_t rdata[2] = { 0 };
+
+    ASSERT_EQ(MRAA_SUCCESS, mraa_i2c_address(dev, ABSENT_I2C_ADDR));
+
+    ASSERT_EQ(MRAA_SUCCESS, mraa_i2c_write_at(dev, MOCK_I2C_ADDR, wdata, sizeof(wdata)));
+    ASSERT_EQ(2, mraa_i2c_read_at(dev, MOCK_I2C_ADDR, rdata, sizeof(rdata)));
+    ASSERT_EQ(0x01, rdata[0]);
+    ASSERT_EQ(0x02, rdata[1]);
+    ASSERT_EQ(MRAA_SUCCESS, mraa_i2c_write_byte_data_at(dev, MOCK_I2C_ADDR, 0x33, 2));
+    ASSERT_EQ(0x33, mraa_i2c_read_byte_data_at(dev, MOCK_I2C_ADDR, 2));
+    ASSERT_EQ(MRAA_SUCCESS, mraa_i2c_write_word_data_at(dev, MOCK_I2C_ADDR, 0x4455, 4));
+    ASSERT_EQ(0x4455, mraa_i2c_read_word_data_at(dev, MOCK_I2C_ADDR, 4));
+    ASSERT_EQ(MRAA_SUCCESS, mraa_i2c_write_byte_at(dev, MOCK_I2C_ADDR, 0x66));
+    ASSERT_EQ(0x66, mraa_i2c_read_byte_at(dev, MOCK_I2C_ADDR));
+    ASSERT_EQ(2, mraa_i2c_read_bytes_data_at(dev, MOCK_I2C_ADDR, 2, rdata, sizeof(rdata)));
+    ASSERT_EQ(0x33, rdata[0]);
+
+    /* Still on the absent slave */
+    ASSERT_EQ(-1, mraa_i2c_read_byte(dev));
+
+    /* A failed or refused call doesn't move the context either */
+    ASSERT_EQ(MRAA_SUCCESS, mraa_i2c_address(dev, MOCK_I2C_ADDR));
+    ASSERT_EQ(-1, mraa_i2c_read_byte_data_at(dev, ABSENT_I2C_ADDR, 0));
+    ASSERT_NE(MRAA_SUCCESS, mraa_i2c_write_byte_data_at(dev, ABSENT_I2C_ADDR, 0x77, 0));
+    ASSERT_EQ(MRAA_ERROR_INVALID_PARAMETER, mraa_i2c_write_byte_data_at(dev, 0x80, 0x77, 0));
+    ASSERT_EQ(0x66, mraa_i2c_read_byte_data(dev, 0));
+}
@@ -112,14 +112,18 @@ TEST_F(mraa_initio_h_unit, test_uart_init)
 /* Test for a successful UART_OW init. */
 TEST_F(mraa_initio_h_unit, test_uart_ow_init)
 {
-    /*mraa_io_descriptor* desc;
-     mraa_result_t status;
+    mraa_io_descriptor* desc;
+    mraa_result_t status;
 
-     status = mraa_io_init("ow:0x1", &desc);
-     ASSERT_EQ(status, MRAA_SUCCESS);
+    status = mraa_io_init("ow:0x0", &desc);
+    ASSERT_EQ(status, MRAA_SUCCESS);
 
-     status = mraa_io_close(desc);
-     ASSERT_EQ(status, MRAA_SUCCESS);*/
+    /* The mock UART simulates a 1-wire bus with devices on it */
+    status = mraa_uart_ow_reset(desc->uart_ows[0]);
+    ASSERT_EQ(status, MRAA_SUCCESS);
+
+    status = mraa_io_close(desc);
+    ASSERT_EQ(status, MRAA_SUCCESS);
 }
 
 /* Test for multiple IO initialization and access the structs for
@@ -0,0 +1,210 @@
+/*
+ * Copyright (c) 2026 Intel Corporation.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "mraa/poller.h"
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#define MOCK_I2C_BUS 0
+#define MOCK_I2C_ADDR 0x33
+#define MOCK_I2C_DATA_INIT_BYTE 0xAB
+#define ABSENT_I2C_ADDR 0x44
+
+/* MRAA poller test fixture, with jobs on the mock i2c device */
+class mraa_poller_h_unit : public ::testing::Test
+{
+  protected:
+    mraa_i2c_context dev = NULL;
+    mraa_poller_t poller = NULL;
+
+    virtual void
+    SetUp()
+    {
+        ASSERT_EQ(MRAA_SUCCESS, mraa_init());
+        dev = mraa_i2c_init(MOCK_I2C_BUS);
+        ASSERT_TRUE(dev != NULL);
+        poller = mraa_poller_init(1024);
+        ASSERT_TRUE(poller != NULL);
+    }
+
+    virtual void
+    TearDown()
+    {
+        if (poller != NULL) {
+            mraa_poller_close(poller);
+        }
+        if (dev != NULL) {
+            mraa_i2c_stop(dev);
+        }
+    }
+
+    /* Everything in the ring */
+    std::vector<mraa_poller_sample_t>
+    drain()
+    {
+        std::vector<mraa_poller_sample_t> samples(1024);
+        int n = mraa_poller_read(poller, samples.data(), samples.size());
+        samples.resize(n < 0 ? 0 : n);
+        return samples;
+    }
+};
+
+/* Deadlines stay on each job's grid, so a job whose period is a multiple of
+ * another's always falls due in the same batch */
+TEST_F(mraa_poller_h_unit, test_timer_grid_deadlines)
+{
+    int fast = mraa_poller_add_i2c(poller, dev, MOCK_I2C_ADDR, 0, 2, 10000);
+    int slow = mraa_poller_add_i2c(poller, dev, MOCK_I2C_ADDR, 1, 2, 30000);
+    ASSERT_EQ(0, fast);
+    ASSERT_EQ(1, slow);
+
+    ASSERT_EQ(MRAA_SUCCESS, mraa_poller_start(poller, -1, 0));
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    ASSERT_EQ(MRAA_SUCCESS, mraa_poller_stop(poller));
+
+    std::vector<uint64_t> fast_ts, slow_ts;
+    for (const mraa_poller_sample_t& s : drain()) {
+        ASSERT_EQ(MRAA_SUCCESS, s.result);
+        ASSERT_EQ(2, s.length);
+        ASSERT_EQ(MOCK_I2C_DATA_INIT_BYTE, s.data[0]);
+        (s.job == (unsigned int) fast ? fast_ts : slow_ts).push_back(s.timestamp_ns);
+    }
+
+    /* Several periods went by, counting the read at start */
+    ASSERT_GE(fast_ts.size(), 10u);
+    ASSERT_GE(slow_ts.size(), 3u);
+
+    for (size_t i = 1; i < fast_ts.size(); i++) {
+        ASSERT_GT(fast_ts[i], fast_ts[i - 1]);
+    }
+    /* A batch is stamped once, every slow read has a fast twin */
+    for (uint64_t t : slow_ts) {
+        ASSERT_NE(fast_ts.end(), std::find(fast_ts.begin(), fast_ts.end(), t));
+    }
+
+    mraa_poller_stats_t stats;
+    ASSERT_EQ(MRAA_SUCCESS, mraa_poller_stats(poller, fast, &stats));
+    ASSERT_EQ(fast_ts.size(), stats.samples);
+    ASSERT_EQ(0u, stats.errors);
+    ASSERT_EQ(0u, stats.dropped);
+    ASSERT_LE(stats.mean_jitter_ns, stats.max_jitter_ns);
+}
+
+/* A slave that doesn't answer fails the batch, the retries one job at a
+ * time keep the others going */
+TEST_F(mraa_poller_h_unit, test_batch_fallback)
+{
+    /* The absent slave goes first so that it fails the whole batch */
+    int absent = mraa_poller_add_i2c(poller, dev, ABSENT_I2C_ADDR, 0, 1, 20000);
+    int present = mraa_poller_add_i2c(poller, dev, MOCK_I2C_ADDR, 0, 4, 20000);
+    ASSERT_EQ(0, absent);
+    ASSERT_EQ(1, present);
+
+    ASSERT_EQ(MRAA_SUCCESS, mraa_poller_start(poller, -1, 0));
+    std::this_thread::sleep_for(std::chrono::milliseconds(70));
+    ASSERT_EQ(MRAA_SUCCESS, mraa_poller_stop(poller));
+
+    int absent_count = 0, present_count = 0;
+    for (const mraa_poller_sample_t& s : drain()) {
+        if (s.job == (unsigned int) absent) {
+            ASSERT_NE(MRAA_SUCCESS, s.result);
+            absent_count++;
+        } else {
+            ASSERT_EQ(MRAA_SUCCESS, s.result);
+            ASSERT_EQ(4, s.length);
+            for (int i = 0; i < s.length; i++) {
+                ASSERT_EQ(MOCK_I2C_DATA_INIT_BYTE, s.data[i]);
+            }
+            present_count++;
+        }
+    }
+    ASSERT_GE(present_count, 2);
+    ASSERT_EQ(absent_count, present_count);
+
+    mraa_poller_stats_t stats;
+    ASSERT_EQ(MRAA_SUCCESS, mraa_poller_stats(poller, absent, &stats));
+    ASSERT_EQ((uint64_t) absent_count, stats.errors);
+    ASSERT_EQ(MRAA_SUCCESS, mraa_poller_stats(poller, present, &stats));
+    ASSERT_EQ(0u, stats.errors);
+}
+
+/* A subplatform bus with the same number is a different adapter, its jobs
+ * don't join the batch of the native bus */
+TEST_F(mraa_poller_h_unit, test_subplatform_bus)
+{
+    uint8_t native_data[] = { 0x11, 0x11 };
+    uint8_t sub_data[] = { 0x22, 0x22 };
+
+    ASSERT_EQ(MRAA_SUCCESS, mraa_add_subplatform(MRAA_MOCK_PLATFORM, NULL));
+    mraa_i2c_context sub = mraa_i2c_init(mraa_get_sub_platform_id(MOCK_I2C_BUS));
+    ASSERT_TRUE(sub != NULL);
+
+    /* Tell the two mock devices apart by their registers */
+    ASSERT_EQ(MRAA_SUCCESS, mraa_i2c_address(dev, MOCK_I2C_ADDR));
+    ASSERT_EQ(MRAA_SUCCESS, mraa_i2c_write(dev, native_data, sizeof(native_data)));
+    ASSERT_EQ(MRAA_SUCCESS, mraa_i2c_address(sub, MOCK_I2C_ADDR));
+    ASSERT_EQ(MRAA_SUCCESS, mraa_i2c_write(sub, sub_data, sizeof(sub_data)));
+
+    int native = mraa_poller_add_i2c(poller, dev, MOCK_I2C_ADDR, 0, 2, 10000);
+    int on_sub = mraa_poller_add_i2c(poller, sub, MOCK_I2C_ADDR, 0, 2, 10000);
+    ASSERT_EQ(0, native);
+    ASSERT_EQ(1, on_sub);
+
+    ASSERT_EQ(MRAA_SUCCESS, mraa_poller_start(poller, -1, 0));
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    ASSERT_EQ(MRAA_SUCCESS, mraa_poller_stop(poller));
+
+    int native_count = 0, sub_count = 0;
+    for (const mraa_poller_sample_t& s : drain()) {
+        ASSERT_EQ(MRAA_SUCCESS, s.result);
+        if (s.job == (unsigned int) native) {
+            ASSERT_EQ(0x11, s.data[0]);
+            native_count++;
+        } else {
+            ASSERT_EQ(0x22, s.data[0]);
+            sub_count++;
+        }
+    }
+    ASSERT_GT(native_count, 0);
+    ASSERT_GT(sub_count, 0);
+
+    /* The poller's transactions go before the context they were made for */
+    mraa_poller_close(poller);
+    poller = NULL;
+    mraa_i2c_stop(sub);
+    ASSERT_EQ(MRAA_SUCCESS, mraa_remove_subplatform(MRAA_MOCK_PLATFORM));
+}
+
+/* Stop wakes the thread out of a long sleep, and the poller can run again */
+TEST_F(mraa_poller_h_unit, test_stop_through_eventfd)
+{
+    ASSERT_EQ(0, mraa_poller_add_i2c(poller, dev, MOCK_I2C_ADDR, 0, 1, 10000000));
+
+    for (int run = 0; run < 2; run++) {
+        ASSERT_EQ(MRAA_SUCCESS, mraa_poller_start(poller, -1, 0));
+        ASSERT_EQ(MRAA_ERROR_INVALID_RESOURCE, mraa_poller_start(poller, -1, 0));
+        /* No jobs while running */
+        ASSERT_EQ(-1, mraa_poller_add_i2c(poller, dev, MOCK_I2C_ADDR, 0, 1, 10000));
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+        /* The next deadline is 10 s off, only the eventfd ends the wait */
+        auto begin = std::chrono::steady_clock::now();
+        ASSERT_EQ(MRAA_SUCCESS, mraa_poller_stop(poller));
+        ASSERT_LT(std::chrono::steady_clock::now() - begin, std::chrono::seconds(1));
+
+        /* Samples outlive the thread, one for the read at start */
+        std::vector<mraa_poller_sample_t> samples = drain();
+        ASSERT_EQ(1u, samples.size());
+        ASSERT_EQ(MRAA_SUCCESS, samples[0].result);
+    }
+
+    /* Stopping a stopped poller is harmless */
+    ASSERT_EQ(MRAA_SUCCESS, mraa_poller_stop(poller));
+}
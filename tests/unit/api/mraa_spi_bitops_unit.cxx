@@ -0,0 +1,132 @@
+/*
+ * Copyright (c) 2026 Intel Corporation.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "spi/spi_bitops.h"
+#include "gtest/gtest.h"
+
+#include <cstring>
+#include <vector>
+
+/* Longer than a few vectors, so every length gets some vector blocks and
+ * every tail length */
+#define MAX_LENGTH 70
+/* Every misalignment of a 16 byte vector */
+#define MAX_OFFSET 16
+
+/* MRAA spi bit operations test fixture. The kernels take 16 byte blocks with
+ * SSE2 or NEON and finish with scalar code, both are checked against plain
+ * loops here on unaligned buffers */
+class mraa_spi_bitops_unit : public ::testing::Test
+{
+  protected:
+    std::vector<uint8_t> pattern;
+
+    virtual void
+    SetUp()
+    {
+        pattern.resize(MAX_OFFSET + MAX_LENGTH);
+        for (size_t i = 0; i < pattern.size(); i++) {
+            pattern[i] = (uint8_t)(i * 37 + 11);
+        }
+    }
+
+    static uint8_t
+    bitrev8(uint8_t b)
+    {
+        uint8_t r = 0;
+        for (int i = 0; i < 8; i++) {
+            r |= ((b >> i) & 1) << (7 - i);
+        }
+        return r;
+    }
+
+    /* Reverse the bytes of each whole word of a given size */
+    static std::vector<uint8_t>
+    swap_words(const uint8_t* buf, size_t length, size_t word)
+    {
+        std::vector<uint8_t> out(buf, buf + length);
+        for (size_t i = 0; i + word <= length; i += word) {
+            for (size_t j = 0; j < word; j++) {
+                out[i + j] = buf[i + word - 1 - j];
+            }
+        }
+        return out;
+    }
+};
+
+TEST_F(mraa_spi_bitops_unit, test_bitrev)
+{
+    for (size_t offset = 0; offset < MAX_OFFSET; offset++) {
+        for (size_t length = 0; length <= MAX_LENGTH; length++) {
+            const uint8_t* src = pattern.data() + offset;
+            std::vector<uint8_t> expected(length);
+            for (size_t i = 0; i < length; i++) {
+                expected[i] = bitrev8(src[i]);
+            }
+
+            /* Out of place into a buffer misaligned the other way, with a
+             * guard byte past the end */
+            std::vector<uint8_t> dst(MAX_OFFSET + length + 1, 0xEE);
+            uint8_t* out = dst.data() + (MAX_OFFSET - 1 - offset);
+            mraa_spi_bitrev(out, src, length);
+            ASSERT_EQ(expected, std::vector<uint8_t>(out, out + length)) << offset << " " << length;
+            ASSERT_EQ(0xEE, out[length]);
+
+            /* In place */
+            std::vector<uint8_t> buf(pattern);
+            mraa_spi_bitrev(buf.data() + offset, buf.data() + offset, length);
+            ASSERT_EQ(expected, std::vector<uint8_t>(buf.data() + offset, buf.data() + offset + length));
+        }
+    }
+}
+
+TEST_F(mraa_spi_bitops_unit, test_swap16)
+{
+    for (size_t offset = 0; offset < MAX_OFFSET; offset++) {
+        for (size_t length = 0; length <= MAX_LENGTH; length++) {
+            std::vector<uint8_t> buf(pattern);
+            uint8_t* data = buf.data() + offset;
+            std::vector<uint8_t> expected = swap_words(data, length, 2);
+
+            mraa_spi_swap16(data, length);
+            ASSERT_EQ(expected, std::vector<uint8_t>(data, data + length)) << offset << " " << length;
+            ASSERT_EQ(pattern[offset + length], buf[offset + length]);
+        }
+    }
+}
+
+TEST_F(mraa_spi_bitops_unit, test_swap32)
+{
+    for (size_t offset = 0; offset < MAX_OFFSET; offset++) {
+        for (size_t length = 0; length <= MAX_LENGTH; length++) {
+            std::vector<uint8_t> buf(pattern);
+            uint8_t* data = buf.data() + offset;
+            std::vector<uint8_t> expected = swap_words(data, length, 4);
+
+            mraa_spi_swap32(data, length);
+            ASSERT_EQ(expected, std::vector<uint8_t>(data, data + length)) << offset << " " << length;
+            ASSERT_EQ(pattern[offset + length], buf[offset + length]);
+        }
+    }
+}
+
+/* Reversing the bits of each byte and then the bytes of a word reverses the
+ * whole word, what the soft LSB mode does to hardware words */
+TEST_F(mraa_spi_bitops_unit, test_word_reversal)
+{
+    uint32_t word = 0x12345678;
+    uint32_t expected = 0;
+    for (int i = 0; i < 32; i++) {
+        expected |= ((word >> i) & 1u) << (31 - i);
+    }
+
+    uint8_t buf[4];
+    memcpy(buf, &word, 4);
+    mraa_spi_bitrev(buf, buf, 4);
+    mraa_spi_swap32(buf, 4);
+    memcpy(&word, buf, 4);
+    ASSERT_EQ(expected, word);
+}
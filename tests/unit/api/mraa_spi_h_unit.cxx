@@ -0,0 +1,284 @@
+/*
+ * Copyright (c) 2026 Intel Corporation.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "mraa/spi.h"
+#include "mraa_internal.h"
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <errno.h>
+#include <fcntl.h>
+#include <linux/spi/spidev.h>
+#include <stdarg.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <vector>
+
+#define MOCK_SPI_BUS 0
+/* The mock answers every byte XORed with this */
+#define MOCK_SPI_REPLY_BYTE 0xAB
+#define MOCK_SPI_REPLY_WORD 0xABBA
+
+/* Stand-in for a spidev device: the transfers of every SPI_IOC_MESSAGE
+ * issued on fd, with the replies of the mock */
+static struct {
+    int fd = -1;
+    int bufsiz = 0;
+    std::vector<std::vector<struct spi_ioc_transfer>> messages;
+} spidev;
+
+/* Takes the place of the C library's ioctl for the library too */
+int
+ioctl(int fd, unsigned long int request, ...) __THROW
+{
+    va_list ap;
+    va_start(ap, request);
+    void* arg = va_arg(ap, void*);
+    va_end(ap);
+
+    if (fd != spidev.fd || _IOC_TYPE(request) != SPI_IOC_MAGIC || _IOC_NR(request) != 0) {
+        return syscall(SYS_ioctl, fd, request, arg);
+    }
+
+    struct spi_ioc_transfer* xfers = (struct spi_ioc_transfer*) arg;
+    std::vector<struct spi_ioc_transfer> msg(xfers, xfers + _IOC_SIZE(request) / sizeof(*xfers));
+    int tx = 0, rx = 0;
+    for (const struct spi_ioc_transfer& x : msg) {
+        tx += x.tx_buf ? x.len : 0;
+        rx += x.rx_buf ? x.len : 0;
+    }
+    /* As spidev does */
+    if (tx > spidev.bufsiz || rx > spidev.bufsiz) {
+        errno = EMSGSIZE;
+        return -1;
+    }
+
+    for (const struct spi_ioc_transfer& x : msg) {
+        const uint8_t* out = (const uint8_t*) (uintptr_t) x.tx_buf;
+        uint8_t* in = (uint8_t*) (uintptr_t) x.rx_buf;
+        for (unsigned int i = 0; in != NULL && i < x.len; i++) {
+            in[i] = (out != NULL ? out[i] : 0) ^ MOCK_SPI_REPLY_BYTE;
+        }
+    }
+    spidev.messages.push_back(msg);
+    return tx > rx ? tx : rx;
+}
+
+/* MRAA spi test fixture, on the mock spi device */
+class mraa_spi_h_unit : public ::testing::Test
+{
+  protected:
+    mraa_spi_context dev = NULL;
+    mraa_adv_func_t funcs;
+
+    virtual void
+    SetUp()
+    {
+        ASSERT_EQ(MRAA_SUCCESS, mraa_init());
+        dev = mraa_spi_init(MOCK_SPI_BUS);
+        ASSERT_TRUE(dev != NULL);
+    }
+
+    virtual void
+    TearDown()
+    {
+        if (dev != NULL) {
+            mraa_spi_stop(dev);
+        }
+        spidev.fd = -1;
+        spidev.messages.clear();
+    }
+
+    /* Turn the context into one on spidev with the given bufsiz, whose ioctls
+     * are answered above. Stopping it closes the fd */
+    void
+    as_spidev(int bufsiz)
+    {
+        spidev.fd = open("/dev/null", O_RDWR);
+        ASSERT_GE(spidev.fd, 0);
+        spidev.bufsiz = bufsiz;
+        dev->devfd = spidev.fd;
+        dev->bufsiz = dev->chunk = bufsiz;
+        dev->advance_func = NULL;
+    }
+
+    /* Lengths of the transfers of each ioctl */
+    static std::vector<std::vector<unsigned int>>
+    lengths()
+    {
+        std::vector<std::vector<unsigned int>> out;
+        for (const auto& msg : spidev.messages) {
+            out.emplace_back();
+            for (const struct spi_ioc_transfer& x : msg) {
+                out.back().push_back(x.len);
+            }
+        }
+        return out;
+    }
+
+    /* Drop the mock's segment hook from this context only, so segments go
+     * out one transfer at a time as on platforms replacing single transfers */
+    void
+    without_segment_hook()
+    {
+        funcs = *dev->advance_func;
+        funcs.spi_transfer_segments_replace = NULL;
+        dev->advance_func = &funcs;
+    }
+
+    static std::vector<uint8_t>
+    reply(const std::vector<uint8_t>& tx)
+    {
+        std::vector<uint8_t> rx(tx);
+        for (uint8_t& b : rx) {
+            b ^= MOCK_SPI_REPLY_BYTE;
+        }
+        return rx;
+    }
+};
+
+/* Each segment is answered into its own buffer, a segment without transmit
+ * data clocks out zeros */
+TEST_F(mraa_spi_h_unit, test_transfer_segments)
+{
+    std::vector<uint8_t> cmd = { 0x03, 0x10 };
+    std::vector<uint8_t> cmd_rx(2), data_rx(5, 0xEE);
+    mraa_spi_segment_t segs[3] = {};
+
+    segs[0].tx = cmd.data();
+    segs[0].length = cmd.size();
+    segs[1].tx = cmd.data();
+    segs[1].rx = cmd_rx.data();
+    segs[1].length = cmd.size();
+    segs[2].rx = data_rx.data();
+    segs[2].length = data_rx.size();
+
+    ASSERT_EQ(MRAA_SUCCESS, mraa_spi_transfer_segments(dev, segs, 3));
+    ASSERT_EQ(reply(cmd), cmd_rx);
+    ASSERT_EQ(reply(std::vector<uint8_t>(5, 0)), data_rx);
+
+    /* The same through single transfers */
+    without_segment_hook();
+    std::fill(cmd_rx.begin(), cmd_rx.end(), 0);
+    std::fill(data_rx.begin(), data_rx.end(), 0xEE);
+    ASSERT_EQ(MRAA_SUCCESS, mraa_spi_transfer_segments(dev, segs, 3));
+    ASSERT_EQ(reply(cmd), cmd_rx);
+    ASSERT_EQ(reply(std::vector<uint8_t>(5, 0)), data_rx);
+}
+
+/* Empty transactions and empty segments are refused */
+TEST_F(mraa_spi_h_unit, test_transfer_segments_invalid)
+{
+    uint8_t tx[1] = { 0 };
+    mraa_spi_segment_t segs[MRAA_SPI_MAX_SEGMENTS + 1] = {};
+    for (mraa_spi_segment_t& s : segs) {
+        s.tx = tx;
+        s.length = 1;
+    }
+
+    ASSERT_EQ(MRAA_ERROR_INVALID_PARAMETER, mraa_spi_transfer_segments(dev, NULL, 1));
+    ASSERT_EQ(MRAA_ERROR_INVALID_PARAMETER, mraa_spi_transfer_segments(dev, segs, 0));
+    ASSERT_EQ(MRAA_ERROR_INVALID_PARAMETER, mraa_spi_transfer_segments(dev, segs, MRAA_SPI_MAX_SEGMENTS + 1));
+    ASSERT_EQ(MRAA_SUCCESS, mraa_spi_transfer_segments(dev, segs, MRAA_SPI_MAX_SEGMENTS));
+    segs[1].length = 0;
+    ASSERT_EQ(MRAA_ERROR_INVALID_PARAMETER, mraa_spi_transfer_segments(dev, segs, 2));
+}
+
+/* Pooled writes receive into the pool's buffers in turn, a result stays
+ * valid for the writes the other buffers take */
+TEST_F(mraa_spi_h_unit, test_write_buf_pooled)
+{
+    std::vector<uint8_t> tx[3] = { { 0x01, 0x02, 0x03 }, { 0x11, 0x12 }, { 0x21, 0x22, 0x23, 0x24 } };
+    uint16_t words[2] = { 0x1234, 0x5678 };
+
+    /* No pool yet */
+    ASSERT_TRUE(mraa_spi_write_buf_pooled(dev, tx[0].data(), tx[0].size()) == NULL);
+    ASSERT_EQ(MRAA_ERROR_INVALID_PARAMETER, mraa_spi_rx_pool(dev, 2, 0));
+    ASSERT_EQ(MRAA_SUCCESS, mraa_spi_rx_pool(dev, 2, 4));
+
+    const uint8_t* first = mraa_spi_write_buf_pooled(dev, tx[0].data(), tx[0].size());
+    const uint8_t* second = mraa_spi_write_buf_pooled(dev, tx[1].data(), tx[1].size());
+    ASSERT_TRUE(first != NULL);
+    ASSERT_TRUE(second != NULL);
+    ASSERT_NE(first, second);
+    ASSERT_EQ(reply(tx[0]), std::vector<uint8_t>(first, first + tx[0].size()));
+    ASSERT_EQ(reply(tx[1]), std::vector<uint8_t>(second, second + tx[1].size()));
+
+    /* Round robin, the third write reuses the first buffer */
+    const uint8_t* third = mraa_spi_write_buf_pooled(dev, tx[2].data(), tx[2].size());
+    ASSERT_EQ(first, third);
+    ASSERT_EQ(reply(tx[2]), std::vector<uint8_t>(third, third + tx[2].size()));
+    ASSERT_EQ(reply(tx[1]), std::vector<uint8_t>(second, second + tx[1].size()));
+
+    /* The word variant shares the pool */
+    const uint16_t* rx = mraa_spi_write_buf_word_pooled(dev, words, sizeof(words));
+    ASSERT_EQ((const void*) second, (const void*) rx);
+    ASSERT_EQ(0x1234 ^ MOCK_SPI_REPLY_WORD, rx[0]);
+    ASSERT_EQ(0x5678 ^ MOCK_SPI_REPLY_WORD, rx[1]);
+
+    /* Longer than a buffer */
+    std::vector<uint8_t> big(5, 0x42);
+    ASSERT_TRUE(mraa_spi_write_buf_pooled(dev, big.data(), big.size()) == NULL);
+
+    ASSERT_EQ(MRAA_SUCCESS, mraa_spi_rx_pool(dev, 0, 0));
+    ASSERT_TRUE(mraa_spi_write_buf_pooled(dev, tx[0].data(), tx[0].size()) == NULL);
+}
+
+/* Transfers beyond the bufsiz take several ioctls, the chip stays selected
+ * between them */
+TEST_F(mraa_spi_h_unit, test_bufsiz_split)
+{
+    std::vector<uint8_t> tx(40), rx(40);
+    for (size_t i = 0; i < tx.size(); i++) {
+        tx[i] = (uint8_t) i;
+    }
+    as_spidev(16);
+
+    ASSERT_EQ(MRAA_SUCCESS, mraa_spi_transfer_buf(dev, tx.data(), rx.data(), tx.size()));
+    ASSERT_EQ(reply(tx), rx);
+    ASSERT_EQ(std::vector<std::vector<unsigned int>>({ { 16 }, { 16 }, { 8 } }), lengths());
+    /* cs_change on the last transfer of a message keeps the chip selected */
+    ASSERT_EQ(1, spidev.messages[0].back().cs_change);
+    ASSERT_EQ(1, spidev.messages[1].back().cs_change);
+    ASSERT_EQ(0, spidev.messages[2].back().cs_change);
+    ASSERT_EQ(tx.data() + 16, (uint8_t*) (uintptr_t) spidev.messages[1][0].tx_buf);
+
+    /* Smaller chunks are packed up to the bufsiz per ioctl */
+    spidev.messages.clear();
+    ASSERT_EQ(MRAA_SUCCESS, mraa_spi_chunk_size(dev, 4));
+    ASSERT_EQ(MRAA_SUCCESS, mraa_spi_transfer_buf(dev, tx.data(), rx.data(), tx.size()));
+    ASSERT_EQ(reply(tx), rx);
+    ASSERT_EQ(std::vector<std::vector<unsigned int>>({ { 4, 4, 4, 4 }, { 4, 4, 4, 4 }, { 4, 4 } }), lengths());
+    for (const auto& msg : spidev.messages) {
+        for (size_t i = 0; i + 1 < msg.size(); i++) {
+            ASSERT_EQ(0, msg[i].cs_change);
+        }
+    }
+}
+
+/* Segments share the bufsiz of an ioctl, each direction counted on its own,
+ * and are only cut on word boundaries */
+TEST_F(mraa_spi_h_unit, test_bufsiz_split_segments)
+{
+    std::vector<uint8_t> cmd = { 0x0B, 0x00, 0x00, 0x00 };
+    std::vector<uint8_t> data(20, 0xEE);
+    mraa_spi_segment_t segs[2] = {};
+    segs[0].tx = cmd.data();
+    segs[0].length = cmd.size();
+    segs[1].rx = data.data();
+    segs[1].length = data.size();
+    segs[1].bits_per_word = 16;
+    as_spidev(15);
+
+    ASSERT_EQ(MRAA_SUCCESS, mraa_spi_transfer_segments(dev, segs, 2));
+    ASSERT_EQ(reply(std::vector<uint8_t>(data.size(), 0)), data);
+    /* The command only transmits, the read only receives, so both fit the
+     * first ioctl up to the bufsiz less an odd byte */
+    ASSERT_EQ(std::vector<std::vector<unsigned int>>({ { 4, 14 }, { 6 } }), lengths());
+    ASSERT_EQ(0u, spidev.messages[0][1].tx_buf);
+    ASSERT_EQ(16, spidev.messages[1][0].bits_per_word);
+}
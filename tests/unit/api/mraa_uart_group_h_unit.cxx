@@ -0,0 +1,126 @@
+/*
+ * Copyright (c) 2026 Intel Corporation.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "mraa/uart_group.h"
+#include "gtest/gtest.h"
+
+#define MOCK_UART_DEV 0
+#define MOCK_UART_DATA_BYTE 0x5A
+#define GROUP_BUFFER_SIZE 16
+#define WAIT_MS 1000
+
+/* MRAA uart group test fixture, on two contexts of the mock uart, which
+ * always has data */
+class mraa_uart_group_h_unit : public ::testing::Test
+{
+  protected:
+    mraa_uart_context dev[2] = { NULL, NULL };
+    mraa_uart_group_t group = NULL;
+
+    virtual void
+    SetUp()
+    {
+        ASSERT_EQ(MRAA_SUCCESS, mraa_init());
+        for (mraa_uart_context& d : dev) {
+            d = mraa_uart_init(MOCK_UART_DEV);
+            ASSERT_TRUE(d != NULL);
+        }
+        group = mraa_uart_group_init(GROUP_BUFFER_SIZE);
+        ASSERT_TRUE(group != NULL);
+    }
+
+    virtual void
+    TearDown()
+    {
+        if (group != NULL) {
+            mraa_uart_group_close(group);
+        }
+        for (mraa_uart_context d : dev) {
+            if (d != NULL) {
+                mraa_uart_rx_stop(d);
+                mraa_uart_stop(d);
+            }
+        }
+    }
+};
+
+/* Each ready port is read once per wait, into its own buffer */
+TEST_F(mraa_uart_group_h_unit, test_wait)
+{
+    mraa_uart_group_event_t events[4];
+
+    ASSERT_EQ(0, mraa_uart_group_add(group, dev[0]));
+    ASSERT_EQ(1, mraa_uart_group_add(group, dev[1]));
+
+    ASSERT_EQ(2, mraa_uart_group_wait(group, events, 4, WAIT_MS));
+    ASSERT_NE(events[0].port, events[1].port);
+    for (int i = 0; i < 2; i++) {
+        ASSERT_EQ(dev[events[i].port], events[i].dev);
+        ASSERT_EQ(GROUP_BUFFER_SIZE, events[i].length);
+        ASSERT_EQ(MOCK_UART_DATA_BYTE, events[i].data[0]);
+    }
+    ASSERT_NE(events[0].data, events[1].data);
+
+    /* A single slot still gets to both ports over two waits */
+    ASSERT_EQ(1, mraa_uart_group_wait(group, events, 1, WAIT_MS));
+    int first = events[0].port;
+    ASSERT_EQ(1, mraa_uart_group_wait(group, events, 1, WAIT_MS));
+    ASSERT_NE(first, events[0].port);
+
+    /* Removed ports are gone, ids aren't reused */
+    ASSERT_EQ(MRAA_SUCCESS, mraa_uart_group_remove(group, 0));
+    ASSERT_EQ(MRAA_ERROR_INVALID_PARAMETER, mraa_uart_group_remove(group, 0));
+    ASSERT_EQ(1, mraa_uart_group_wait(group, events, 4, WAIT_MS));
+    ASSERT_EQ(1, events[0].port);
+    ASSERT_EQ(2, mraa_uart_group_add(group, dev[0]));
+}
+
+/* A port belongs to one group and stays open and without a receiver while
+ * it is in there */
+TEST_F(mraa_uart_group_h_unit, test_grouped_port)
+{
+    mraa_uart_group_t other = mraa_uart_group_init(0);
+    ASSERT_TRUE(other != NULL);
+
+    int port = mraa_uart_group_add(group, dev[0]);
+    ASSERT_EQ(0, port);
+    ASSERT_EQ(-1, mraa_uart_group_add(group, dev[0]));
+    ASSERT_EQ(-1, mraa_uart_group_add(other, dev[0]));
+
+    ASSERT_EQ(MRAA_ERROR_INVALID_RESOURCE, mraa_uart_rx_start(dev[0], NULL, NULL, NULL));
+    ASSERT_EQ(MRAA_ERROR_INVALID_RESOURCE, mraa_uart_stop(dev[0]));
+
+    /* Out of the group the port is free again */
+    ASSERT_EQ(MRAA_SUCCESS, mraa_uart_group_remove(group, port));
+    ASSERT_EQ(0, mraa_uart_group_add(other, dev[0]));
+    ASSERT_EQ(MRAA_SUCCESS, mraa_uart_group_close(other));
+    ASSERT_EQ(MRAA_SUCCESS, mraa_uart_rx_start(dev[0], NULL, NULL, NULL));
+    ASSERT_EQ(MRAA_SUCCESS, mraa_uart_rx_stop(dev[0]));
+    ASSERT_EQ(MRAA_SUCCESS, mraa_uart_stop(dev[0]));
+    dev[0] = NULL;
+}
+
+/* A receiver started before the port joins keeps its bytes coming */
+TEST_F(mraa_uart_group_h_unit, test_receiver_first)
+{
+    mraa_uart_group_event_t events[1];
+    mraa_uart_rx_config_t config = {};
+    config.framing = MRAA_UART_FRAMING_NONE;
+
+    ASSERT_EQ(MRAA_SUCCESS, mraa_uart_rx_start(dev[0], &config, NULL, NULL));
+    ASSERT_EQ(0, mraa_uart_group_add(group, dev[0]));
+    ASSERT_EQ(1, mraa_uart_group_wait(group, events, 1, WAIT_MS));
+    ASSERT_EQ(dev[0], events[0].dev);
+    ASSERT_GT(events[0].length, 0);
+    ASSERT_EQ(MOCK_UART_DATA_BYTE, events[0].data[0]);
+
+    /* Closing the group lets go of the port */
+    ASSERT_EQ(MRAA_SUCCESS, mraa_uart_group_close(group));
+    group = NULL;
+    ASSERT_EQ(MRAA_SUCCESS, mraa_uart_rx_stop(dev[0]));
+    ASSERT_EQ(MRAA_SUCCESS, mraa_uart_stop(dev[0]));
+    dev[0] = NULL;
+}
@@ -0,0 +1,174 @@
+/*
+ * Copyright (c) 2026 Intel Corporation.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "mraa/uart_ow.h"
+#include "gtest/gtest.h"
+
+#include <set>
+#include <vector>
+
+#define MOCK_UART_DEV 0
+#define MOCK_OW_DEVICES 4
+#define DS18B20_FAMILY 0x28
+#define DS2401_FAMILY 0x01
+#define CONVERT_T 0x44
+#define READ_SCRATCHPAD 0xbe
+#define SCRATCHPAD_SIZE 9
+
+typedef std::vector<uint8_t> rom_t;
+
+/* MRAA uart_ow registry test fixture, on the 1-Wire bus simulated by the
+ * mock uart: three DS18B20 with serials 1 to 3, the second one in alarm,
+ * and a DS2401 with serial 4 */
+class mraa_uart_ow_registry_h_unit : public ::testing::Test
+{
+  protected:
+    mraa_uart_ow_context dev = NULL;
+    mraa_uart_ow_registry_t registry = NULL;
+
+    virtual void
+    SetUp()
+    {
+        ASSERT_EQ(MRAA_SUCCESS, mraa_init());
+        dev = mraa_uart_ow_init(MOCK_UART_DEV);
+        ASSERT_TRUE(dev != NULL);
+        registry = mraa_uart_ow_registry_init(dev);
+        ASSERT_TRUE(registry != NULL);
+    }
+
+    virtual void
+    TearDown()
+    {
+        if (registry != NULL) {
+            mraa_uart_ow_registry_close(registry);
+        }
+        if (dev != NULL) {
+            mraa_uart_ow_stop(dev);
+        }
+    }
+
+    /* Rom code of a simulated device */
+    static rom_t
+    rom(uint8_t family, uint8_t serial)
+    {
+        rom_t id(MRAA_UART_OW_ROMCODE_SIZE, 0);
+        id[0] = family;
+        id[1] = serial;
+        id[7] = mraa_uart_ow_crc8(id.data(), 7);
+        return id;
+    }
+
+    /* The cached rom codes, in no particular order */
+    std::set<rom_t>
+    cached()
+    {
+        std::set<rom_t> ids;
+        for (int i = 0; i < mraa_uart_ow_registry_count(registry); i++) {
+            rom_t id(MRAA_UART_OW_ROMCODE_SIZE);
+            EXPECT_EQ(MRAA_SUCCESS, mraa_uart_ow_registry_get(registry, i, id.data()));
+            ids.insert(id);
+        }
+        return ids;
+    }
+};
+
+/* Dallas CRC8, the check byte of a rom code makes the whole code sum to 0 */
+TEST_F(mraa_uart_ow_registry_h_unit, test_crc8)
+{
+    uint8_t empty[1] = { 0 };
+    ASSERT_EQ(0, mraa_uart_ow_crc8(empty, 0));
+
+    /* Rom code of a DS2401 from the Maxim application note 27 */
+    uint8_t id[MRAA_UART_OW_ROMCODE_SIZE] = { 0x02, 0x1c, 0xb8, 0x01, 0x00, 0x00, 0x00, 0xa2 };
+    ASSERT_EQ(0xa2, mraa_uart_ow_crc8(id, 7));
+    ASSERT_EQ(0, mraa_uart_ow_crc8(id, sizeof(id)));
+    id[3] ^= 0x10;
+    ASSERT_NE(0, mraa_uart_ow_crc8(id, sizeof(id)));
+}
+
+/* A scan finds every device, or those of one family, and revalidation
+ * keeps all of them while they're on the bus */
+TEST_F(mraa_uart_ow_registry_h_unit, test_scan)
+{
+    ASSERT_EQ(0, mraa_uart_ow_registry_count(registry));
+
+    ASSERT_EQ(MOCK_OW_DEVICES, mraa_uart_ow_registry_scan(registry, 0));
+    ASSERT_EQ(MOCK_OW_DEVICES, mraa_uart_ow_registry_count(registry));
+    std::set<rom_t> all = { rom(DS18B20_FAMILY, 1), rom(DS18B20_FAMILY, 2), rom(DS18B20_FAMILY, 3),
+                            rom(DS2401_FAMILY, 4) };
+    ASSERT_EQ(all, cached());
+    ASSERT_EQ(0, mraa_uart_ow_registry_revalidate(registry, 0));
+    ASSERT_EQ(MOCK_OW_DEVICES, mraa_uart_ow_registry_count(registry));
+
+    /* A second scan replaces the cache */
+    ASSERT_EQ(3, mraa_uart_ow_registry_scan(registry, DS18B20_FAMILY));
+    std::set<rom_t> sensors = { rom(DS18B20_FAMILY, 1), rom(DS18B20_FAMILY, 2), rom(DS18B20_FAMILY, 3) };
+    ASSERT_EQ(sensors, cached());
+
+    /* Revalidation a few devices at a time wraps around */
+    ASSERT_EQ(0, mraa_uart_ow_registry_revalidate(registry, 2));
+    ASSERT_EQ(0, mraa_uart_ow_registry_revalidate(registry, 2));
+    ASSERT_EQ(3, mraa_uart_ow_registry_count(registry));
+
+    uint8_t id[MRAA_UART_OW_ROMCODE_SIZE];
+    ASSERT_NE(MRAA_SUCCESS, mraa_uart_ow_registry_get(registry, 3, id));
+    ASSERT_NE(MRAA_SUCCESS, mraa_uart_ow_registry_get(registry, -1, id));
+}
+
+/* Only the sensor in alarm answers the conditional search, the cache stays */
+TEST_F(mraa_uart_ow_registry_h_unit, test_alarm_search)
+{
+    uint8_t ids[MOCK_OW_DEVICES * MRAA_UART_OW_ROMCODE_SIZE];
+
+    ASSERT_EQ(MOCK_OW_DEVICES, mraa_uart_ow_registry_scan(registry, 0));
+    ASSERT_EQ(1, mraa_uart_ow_registry_alarm_search(registry, ids, MOCK_OW_DEVICES));
+    ASSERT_EQ(rom(DS18B20_FAMILY, 2), rom_t(ids, ids + MRAA_UART_OW_ROMCODE_SIZE));
+    ASSERT_EQ(MOCK_OW_DEVICES, mraa_uart_ow_registry_count(registry));
+}
+
+/* One conversion for all sensors, then each scratchpad read with its CRC
+ * checked */
+TEST_F(mraa_uart_ow_registry_h_unit, test_convert_read_all)
+{
+    ASSERT_EQ(3, mraa_uart_ow_registry_scan(registry, DS18B20_FAMILY));
+    ASSERT_EQ(MRAA_SUCCESS, mraa_uart_ow_registry_convert_all(registry, CONVERT_T, 0));
+
+    uint8_t data[3 * SCRATCHPAD_SIZE];
+    mraa_result_t results[3];
+    ASSERT_EQ(3, mraa_uart_ow_registry_read_all(registry, READ_SCRATCHPAD, data, SCRATCHPAD_SIZE, results));
+
+    /* Temperatures in 1/16 C by serial */
+    const int16_t temps[] = { 0x0191, 0x0158, (int16_t) 0xff5e };
+    for (int i = 0; i < 3; i++) {
+        uint8_t id[MRAA_UART_OW_ROMCODE_SIZE];
+        const uint8_t* pad = data + i * SCRATCHPAD_SIZE;
+
+        ASSERT_EQ(MRAA_SUCCESS, results[i]);
+        ASSERT_EQ(0, mraa_uart_ow_crc8((uint8_t*) pad, SCRATCHPAD_SIZE));
+        ASSERT_EQ(MRAA_SUCCESS, mraa_uart_ow_registry_get(registry, i, id));
+        ASSERT_EQ(temps[id[1] - 1], (int16_t)(pad[0] | (pad[1] << 8)));
+    }
+}
+
+/* The serial number chip has no scratchpad, its answer fails the CRC check
+ * without failing the sensors */
+TEST_F(mraa_uart_ow_registry_h_unit, test_read_all_bad_crc)
+{
+    ASSERT_EQ(MOCK_OW_DEVICES, mraa_uart_ow_registry_scan(registry, 0));
+
+    uint8_t data[MOCK_OW_DEVICES * SCRATCHPAD_SIZE];
+    mraa_result_t results[MOCK_OW_DEVICES];
+    ASSERT_EQ(3, mraa_uart_ow_registry_read_all(registry, READ_SCRATCHPAD, data, SCRATCHPAD_SIZE, results));
+    for (int i = 0; i < MOCK_OW_DEVICES; i++) {
+        uint8_t id[MRAA_UART_OW_ROMCODE_SIZE];
+        ASSERT_EQ(MRAA_SUCCESS, mraa_uart_ow_registry_get(registry, i, id));
+        if (id[0] == DS2401_FAMILY) {
+            ASSERT_NE(MRAA_SUCCESS, results[i]);
+        } else {
+            ASSERT_EQ(MRAA_SUCCESS, results[i]);
+        }
+    }
+}
@@ -0,0 +1,212 @@
+/*
+ * Copyright (c) 2026 Intel Corporation.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "mraa/uart.h"
+#include "gtest/gtest.h"
+
+#include <string>
+#include <vector>
+
+#define MOCK_UART_DEV 0
+/* Puts the mock 1-Wire bus on the uart, which then echoes every other byte */
+#define MOCK_UART_OW_RESET 0xf0
+#define FRAME_WAIT_MS 1000
+
+typedef std::vector<uint8_t> bytes;
+
+/* COBS encoding with the trailing delimiter */
+static bytes
+cobs_encode(const bytes& data)
+{
+    bytes out(1);
+    size_t code_at = 0;
+    uint8_t code = 1;
+
+    for (uint8_t b : data) {
+        if (b != 0) {
+            out.push_back(b);
+            code++;
+        }
+        if (b == 0 || code == 0xFF) {
+            out[code_at] = code;
+            code_at = out.size();
+            out.push_back(0);
+            code = 1;
+        }
+    }
+    out[code_at] = code;
+    out.push_back(0);
+
+    return out;
+}
+
+/* MRAA uart receiver test fixture, on the mock uart looped back through
+ * the echo of its 1-Wire bus */
+class mraa_uart_rx_h_unit : public ::testing::Test
+{
+  protected:
+    mraa_uart_context dev = NULL;
+
+    virtual void
+    SetUp()
+    {
+        uint8_t reset = MOCK_UART_OW_RESET;
+        char presence;
+
+        ASSERT_EQ(MRAA_SUCCESS, mraa_init());
+        dev = mraa_uart_init(MOCK_UART_DEV);
+        ASSERT_TRUE(dev != NULL);
+        ASSERT_EQ(1, mraa_uart_write(dev, (const char*) &reset, 1));
+        ASSERT_EQ(1, mraa_uart_read(dev, &presence, 1));
+    }
+
+    virtual void
+    TearDown()
+    {
+        if (dev != NULL) {
+            mraa_uart_rx_stop(dev);
+            mraa_uart_stop(dev);
+        }
+    }
+
+    void
+    start(mraa_uart_framing_t framing, unsigned int max_frame = 0, unsigned int length_bytes = 0, mraa_boolean_t big_endian = 0)
+    {
+        mraa_uart_rx_config_t config = {};
+        config.framing = framing;
+        config.max_frame = max_frame;
+        config.length_bytes = length_bytes;
+        config.length_big_endian = big_endian;
+        ASSERT_EQ(MRAA_SUCCESS, mraa_uart_rx_start(dev, &config, NULL, NULL));
+    }
+
+    void
+    send(const bytes& data)
+    {
+        ASSERT_EQ((int) data.size(), mraa_uart_write(dev, (const char*) data.data(), data.size()));
+    }
+
+    bytes
+    frame()
+    {
+        uint8_t buf[2048];
+        int n = mraa_uart_read_frame(dev, buf, sizeof(buf), FRAME_WAIT_MS);
+        return n > 0 ? bytes(buf, buf + n) : bytes();
+    }
+
+    uint64_t
+    framing_errors()
+    {
+        mraa_uart_rx_stats_t stats;
+        if (mraa_uart_rx_stats(dev, &stats) != MRAA_SUCCESS) {
+            return (uint64_t) -1;
+        }
+        return stats.framing_errors;
+    }
+};
+
+/* Lines lose their '\r', empty ones are skipped, too long ones are dropped */
+TEST_F(mraa_uart_rx_h_unit, test_newline)
+{
+    std::string line(20, 'x');
+    std::string input = "abc\r\n\r\n\ndef\n" + line + "\nghi\r\n";
+
+    start(MRAA_UART_FRAMING_NEWLINE, 16);
+    send(bytes(input.begin(), input.end()));
+
+    ASSERT_EQ(bytes({ 'a', 'b', 'c' }), frame());
+    ASSERT_EQ(bytes({ 'd', 'e', 'f' }), frame());
+    ASSERT_EQ(bytes({ 'g', 'h', 'i' }), frame());
+    ASSERT_EQ(1u, framing_errors());
+}
+
+/* Escapes decode to the bytes they stand for, a bad one loses its frame */
+TEST_F(mraa_uart_rx_h_unit, test_slip)
+{
+    start(MRAA_UART_FRAMING_SLIP);
+    send({ 0xC0, 0x01, 0xDB, 0xDC, 0x02, 0xDB, 0xDD, 0x03, 0xC0 });
+    send({ 0x04, 0xDB, 0x05, 0x06, 0xC0 });
+    send({ 0xC0, 0xC0, 0x07, 0xDB, 0xC0 });
+    send({ 0x08, 0xC0 });
+
+    ASSERT_EQ(bytes({ 0x01, 0xC0, 0x02, 0xDB, 0x03 }), frame());
+    ASSERT_EQ(bytes({ 0x08 }), frame());
+    ASSERT_EQ(2u, framing_errors());
+}
+
+/* Zero runs and full 254 byte blocks survive the round trip */
+TEST_F(mraa_uart_rx_h_unit, test_cobs)
+{
+    bytes zeros = { 0x11, 0x00, 0x00, 0x00, 0x22, 0x00 };
+    bytes block(300);
+    for (size_t i = 0; i < block.size(); i++) {
+        block[i] = i % 0xE0 + 1;
+    }
+
+    start(MRAA_UART_FRAMING_COBS);
+    send(cobs_encode(zeros));
+    send(cobs_encode(block));
+    /* Claims 5 bytes where the frame has 2 */
+    send({ 0x06, 0x33, 0x44, 0x00 });
+    send(cobs_encode({ 0x55 }));
+
+    ASSERT_EQ(zeros, frame());
+    ASSERT_EQ(block, frame());
+    ASSERT_EQ(bytes({ 0x55 }), frame());
+    ASSERT_EQ(1u, framing_errors());
+}
+
+/* Prefixes in either byte order, oversized payloads skipped whole */
+TEST_F(mraa_uart_rx_h_unit, test_length_prefix)
+{
+    bytes big(20, 0x77);
+
+    start(MRAA_UART_FRAMING_LENGTH, 16);
+    send({ 0x03, 0x01, 0x02, 0x03 });
+    send({ 0x00 });
+    send({ (uint8_t) big.size() });
+    send(big);
+    send({ 0x01, 0x04 });
+    ASSERT_EQ(bytes({ 0x01, 0x02, 0x03 }), frame());
+    ASSERT_EQ(bytes({ 0x04 }), frame());
+    ASSERT_EQ(1u, framing_errors());
+    ASSERT_EQ(MRAA_SUCCESS, mraa_uart_rx_stop(dev));
+
+    start(MRAA_UART_FRAMING_LENGTH, 0, 2, 0);
+    send({ 0x02, 0x00, 0x05, 0x06 });
+    ASSERT_EQ(bytes({ 0x05, 0x06 }), frame());
+    ASSERT_EQ(MRAA_SUCCESS, mraa_uart_rx_stop(dev));
+
+    start(MRAA_UART_FRAMING_LENGTH, 0, 2, 1);
+    bytes payload(0x102, 0x66);
+    bytes prefix = { 0x01, 0x02 };
+    send(prefix);
+    send(payload);
+    ASSERT_EQ(payload, frame());
+    ASSERT_EQ(0u, framing_errors());
+}
+
+/* A frame longer than the buffer fills it and reports its real length, as
+ * recv() with MSG_TRUNC does, and is counted */
+TEST_F(mraa_uart_rx_h_unit, test_truncated_frame)
+{
+    uint8_t buf[4];
+    mraa_uart_rx_stats_t stats;
+
+    start(MRAA_UART_FRAMING_LENGTH);
+    send({ 0x06, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06 });
+    send({ 0x02, 0x07, 0x08 });
+
+    ASSERT_EQ(6, mraa_uart_read_frame(dev, buf, sizeof(buf), FRAME_WAIT_MS));
+    ASSERT_EQ(bytes({ 0x01, 0x02, 0x03, 0x04 }), bytes(buf, buf + sizeof(buf)));
+    /* The rest of it is gone */
+    ASSERT_EQ(bytes({ 0x07, 0x08 }), frame());
+
+    ASSERT_EQ(MRAA_SUCCESS, mraa_uart_rx_stats(dev, &stats));
+    ASSERT_EQ(2u, stats.frames);
+    ASSERT_EQ(1u, stats.truncated);
+    ASSERT_EQ(0u, stats.framing_errors);
+}
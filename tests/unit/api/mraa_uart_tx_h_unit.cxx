@@ -0,0 +1,245 @@
+/*
+ * Copyright (c) 2026 Intel Corporation.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "mraa/uart.h"
+#include "gtest/gtest.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <pthread.h>
+#include <thread>
+#include <vector>
+
+#define MOCK_UART_DEV 0
+/* Puts the mock 1-Wire bus on the uart, which then echoes every other byte */
+#define MOCK_UART_OW_RESET 0xf0
+
+/* What the done callback saw, and a gate that holds the transmit thread in
+ * the callback until it is opened */
+struct tx_record {
+    pthread_mutex_t lock = PTHREAD_MUTEX_INITIALIZER;
+    pthread_cond_t cond = PTHREAD_COND_INITIALIZER;
+    bool hold = false;
+    bool held = false;
+    std::vector<mraa_result_t> results;
+    std::vector<const void*> bufs;
+};
+
+static void
+tx_done(mraa_result_t result, const void* buf, size_t length, void* data)
+{
+    tx_record* rec = static_cast<tx_record*>(data);
+    pthread_mutex_lock(&rec->lock);
+    rec->results.push_back(result);
+    rec->bufs.push_back(buf);
+    rec->held = rec->hold;
+    pthread_cond_broadcast(&rec->cond);
+    while (rec->hold) {
+        pthread_cond_wait(&rec->cond, &rec->lock);
+    }
+    rec->held = false;
+    pthread_mutex_unlock(&rec->lock);
+}
+
+/* MRAA uart transmit queue test fixture, on the mock uart looped back
+ * through the echo of its 1-Wire bus */
+class mraa_uart_tx_h_unit : public ::testing::Test
+{
+  protected:
+    mraa_uart_context dev = NULL;
+    tx_record rec;
+
+    virtual void
+    SetUp()
+    {
+        uint8_t reset = MOCK_UART_OW_RESET;
+        char presence;
+
+        ASSERT_EQ(MRAA_SUCCESS, mraa_init());
+        dev = mraa_uart_init(MOCK_UART_DEV);
+        ASSERT_TRUE(dev != NULL);
+        ASSERT_EQ(1, mraa_uart_write(dev, (const char*) &reset, 1));
+        ASSERT_EQ(1, mraa_uart_read(dev, &presence, 1));
+    }
+
+    virtual void
+    TearDown()
+    {
+        open_gate();
+        if (dev != NULL) {
+            mraa_uart_tx_stop(dev);
+            mraa_uart_stop(dev);
+        }
+    }
+
+    /* Hold the transmit thread in the callback of the next buffer */
+    void
+    close_gate()
+    {
+        pthread_mutex_lock(&rec.lock);
+        rec.hold = true;
+        pthread_mutex_unlock(&rec.lock);
+    }
+
+    void
+    wait_held()
+    {
+        pthread_mutex_lock(&rec.lock);
+        while (!rec.held) {
+            pthread_cond_wait(&rec.cond, &rec.lock);
+        }
+        pthread_mutex_unlock(&rec.lock);
+    }
+
+    void
+    open_gate()
+    {
+        pthread_mutex_lock(&rec.lock);
+        rec.hold = false;
+        pthread_cond_broadcast(&rec.cond);
+        pthread_mutex_unlock(&rec.lock);
+    }
+
+    std::vector<uint8_t>
+    echoed(size_t length)
+    {
+        std::vector<uint8_t> buf(length);
+        int n = mraa_uart_read(dev, (char*) buf.data(), length);
+        buf.resize(n < 0 ? 0 : n);
+        return buf;
+    }
+};
+
+/* Each mode hands the buffer back the way it was taken, the bytes go out
+ * in queue order */
+TEST_F(mraa_uart_tx_h_unit, test_ownership_modes)
+{
+    uint8_t reference[] = { 0x01, 0x02 };
+    uint8_t* take = (uint8_t*) malloc(2);
+    uint8_t copy[] = { 0x05, 0x06 };
+    ASSERT_TRUE(take != NULL);
+    take[0] = 0x03;
+    take[1] = 0x04;
+
+    ASSERT_EQ(MRAA_SUCCESS, mraa_uart_tx_start(dev, 0, 0));
+    ASSERT_EQ(MRAA_SUCCESS, mraa_uart_tx_enqueue(dev, reference, 2, MRAA_UART_TX_REFERENCE, tx_done, &rec));
+    ASSERT_EQ(MRAA_SUCCESS, mraa_uart_tx_enqueue(dev, take, 2, MRAA_UART_TX_TAKE, tx_done, &rec));
+    ASSERT_EQ(MRAA_SUCCESS, mraa_uart_tx_enqueue(dev, copy, 2, MRAA_UART_TX_COPY, tx_done, &rec));
+    /* The copy was made when queued */
+    copy[0] = 0xEE;
+    ASSERT_EQ(MRAA_SUCCESS, mraa_uart_flush(dev));
+
+    ASSERT_EQ(std::vector<uint8_t>({ 0x01, 0x02, 0x03, 0x04, 0x05, 0x06 }), echoed(6));
+    ASSERT_EQ(MRAA_ERROR_INVALID_PARAMETER, mraa_uart_tx_enqueue(dev, NULL, 2, MRAA_UART_TX_COPY, NULL, NULL));
+    ASSERT_EQ(MRAA_ERROR_INVALID_PARAMETER, mraa_uart_tx_enqueue(dev, copy, 0, MRAA_UART_TX_COPY, NULL, NULL));
+
+    /* Callbacks run after the bytes went out, the stop waits for them */
+    ASSERT_EQ(MRAA_SUCCESS, mraa_uart_tx_stop(dev));
+    ASSERT_EQ(3u, rec.results.size());
+    ASSERT_EQ(std::vector<mraa_result_t>(3, MRAA_SUCCESS), rec.results);
+    ASSERT_EQ((const void*) reference, rec.bufs[0]);
+    ASSERT_EQ((const void*) take, rec.bufs[1]);
+    ASSERT_EQ((const void*) copy, rec.bufs[2]);
+}
+
+/* A full queue refuses enqueues and holds up blocking writes until the
+ * transmit thread makes room */
+TEST_F(mraa_uart_tx_h_unit, test_queue_limit)
+{
+    uint8_t first = 0x11;
+    uint8_t big[8] = { 0x21, 0x22, 0x23, 0x24, 0x25, 0x26, 0x27, 0x28 };
+    uint8_t last = 0x31;
+    int written = 0;
+
+    ASSERT_EQ(MRAA_SUCCESS, mraa_uart_tx_start(dev, sizeof(big), 0));
+    close_gate();
+    ASSERT_EQ(MRAA_SUCCESS, mraa_uart_tx_enqueue(dev, &first, 1, MRAA_UART_TX_REFERENCE, tx_done, &rec));
+    wait_held();
+
+    /* Larger than the limit is still let into an empty queue */
+    uint8_t huge[16] = { 0 };
+    ASSERT_EQ(MRAA_SUCCESS, mraa_uart_tx_enqueue(dev, big, sizeof(big), MRAA_UART_TX_COPY, NULL, NULL));
+    ASSERT_EQ(MRAA_ERROR_NO_RESOURCES, mraa_uart_tx_enqueue(dev, huge, sizeof(huge), MRAA_UART_TX_COPY, NULL, NULL));
+    ASSERT_EQ(MRAA_ERROR_NO_RESOURCES, mraa_uart_tx_enqueue(dev, &last, 1, MRAA_UART_TX_COPY, NULL, NULL));
+
+    std::thread writer([&] { written = mraa_uart_write(dev, (const char*) &last, 1); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    ASSERT_EQ(0, written);
+    open_gate();
+    writer.join();
+    ASSERT_EQ(1, written);
+
+    ASSERT_EQ(MRAA_SUCCESS, mraa_uart_flush(dev));
+    std::vector<uint8_t> expected = { first };
+    expected.insert(expected.end(), big, big + sizeof(big));
+    expected.push_back(last);
+    ASSERT_EQ(expected, echoed(expected.size()));
+}
+
+/* Stop wakes a writer blocked on room and a flush blocked on the queue,
+ * drops what is left, and frees the queue only once they're out */
+TEST_F(mraa_uart_tx_h_unit, test_stop_wakes_waiters)
+{
+    uint8_t first = 0x11;
+    uint8_t fill[4] = { 0x21, 0x22, 0x23, 0x24 };
+    uint8_t last = 0x31;
+    int written = 0;
+    mraa_result_t flushed = MRAA_SUCCESS;
+
+    ASSERT_EQ(MRAA_SUCCESS, mraa_uart_tx_start(dev, sizeof(fill), 0));
+    close_gate();
+    ASSERT_EQ(MRAA_SUCCESS, mraa_uart_tx_enqueue(dev, &first, 1, MRAA_UART_TX_REFERENCE, tx_done, &rec));
+    wait_held();
+    ASSERT_EQ(MRAA_SUCCESS, mraa_uart_tx_enqueue(dev, fill, sizeof(fill), MRAA_UART_TX_REFERENCE, tx_done, &rec));
+
+    std::thread writer([&] { written = mraa_uart_write(dev, (const char*) &last, 1); });
+    std::thread flusher([&] { flushed = mraa_uart_flush(dev); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    /* The transmit thread is let go while stop is under way */
+    std::thread opener([this] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        open_gate();
+    });
+    ASSERT_EQ(MRAA_SUCCESS, mraa_uart_tx_stop(dev));
+    writer.join();
+    flusher.join();
+    opener.join();
+
+    ASSERT_EQ(-1, written);
+    ASSERT_EQ(MRAA_ERROR_INVALID_RESOURCE, flushed);
+    ASSERT_EQ(2u, rec.results.size());
+    ASSERT_EQ(MRAA_SUCCESS, rec.results[0]);
+    ASSERT_NE(MRAA_SUCCESS, rec.results[1]);
+    ASSERT_EQ((const void*) fill, rec.bufs[1]);
+}
+
+/* Counters add up once the queue is idle */
+TEST_F(mraa_uart_tx_h_unit, test_drain_stats)
+{
+    mraa_uart_drain_stats_t stats;
+    uint8_t data[3] = { 0x41, 0x42, 0x43 };
+
+    ASSERT_EQ(MRAA_ERROR_INVALID_PARAMETER, mraa_uart_drain_stats(dev, &stats));
+    ASSERT_EQ(MRAA_SUCCESS, mraa_uart_tx_start(dev, 0, 0));
+    ASSERT_EQ(MRAA_ERROR_INVALID_PARAMETER, mraa_uart_drain_stats(dev, NULL));
+
+    for (int i = 0; i < 5; i++) {
+        ASSERT_EQ(MRAA_SUCCESS, mraa_uart_tx_enqueue(dev, data, sizeof(data), MRAA_UART_TX_COPY, NULL, NULL));
+    }
+    ASSERT_EQ(4, mraa_uart_write(dev, "abcd", 4));
+    ASSERT_EQ(MRAA_SUCCESS, mraa_uart_flush(dev));
+
+    ASSERT_EQ(MRAA_SUCCESS, mraa_uart_drain_stats(dev, &stats));
+    ASSERT_EQ(0u, stats.queued);
+    /* The mock has no driver queue, written is sent */
+    ASSERT_EQ(0u, stats.in_flight);
+    ASSERT_EQ(5u * sizeof(data) + 4, stats.completed);
+    ASSERT_EQ(6u, stats.segments);
+    ASSERT_GE(stats.writes, 1u);
+    ASSERT_LE(stats.writes, stats.segments);
+    ASSERT_EQ(5u * sizeof(data) + 4, echoed(5 * sizeof(data) + 4).size());
+}
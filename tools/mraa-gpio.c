@@ -5,6 +5,8 @@
  * SPDX-License-Identifier: MIT
  */
 
+#include <ctype.h>
+#include <errno.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -12,6 +14,9 @@
 
 #include "mraa/gpio.h"
 
+/* 128MB of samples */
+#define CAPTURE_MAX_SAMPLES (1UL << 24)
+
 struct gpio_source {
     int pin;
     mraa_gpio_context context;
@@ -32,6 +37,11 @@ print_help()
     fprintf(stdout, "get pin           Get pin level\n");
     fprintf(stdout, "getraw pin        Get pin level via mmap (if available)\n");
     fprintf(stdout, "monitor pin       Monitor pin level changes\n");
+    fprintf(stdout, "capture file rate samples pre trigger pin...\n");
+    fprintf(stdout, "                  Sample pins at rate Hz (1-1000000000) into file (.vcd or\n");
+    fprintf(stdout, "                  binary), samples (1-16777216) from the trigger on and pre\n");
+    fprintf(stdout, "                  (0-16777216) from before it. Trigger: none, rise:i, fall:i,\n");
+    fprintf(stdout, "                  edge:i (i-th listed pin) or pattern:mask=value (hex)\n");
     fprintf(stdout, "version           Get mraa version and board name\n");
 }
 
@@ -159,6 +169,115 @@ gpio_isr_stop(struct gpio_source* gpio_info)
 }
 
 
+mraa_result_t
+gpio_parse_trigger(const char* arg, mraa_gpio_capture_config_t* config)
+{
+    unsigned long long mask, value;
+    unsigned int pin;
+
+    if (strcmp(arg, "none") == 0) {
+        config->trigger = MRAA_GPIO_TRIGGER_NONE;
+    } else if (sscanf(arg, "rise:%u", &pin) == 1) {
+        config->trigger = MRAA_GPIO_TRIGGER_EDGE;
+        config->trigger_edge = MRAA_GPIO_EDGE_RISING;
+        config->trigger_pin = pin;
+    } else if (sscanf(arg, "fall:%u", &pin) == 1) {
+        config->trigger = MRAA_GPIO_TRIGGER_EDGE;
+        config->trigger_edge = MRAA_GPIO_EDGE_FALLING;
+        config->trigger_pin = pin;
+    } else if (sscanf(arg, "edge:%u", &pin) == 1) {
+        config->trigger = MRAA_GPIO_TRIGGER_EDGE;
+        config->trigger_edge = MRAA_GPIO_EDGE_BOTH;
+        config->trigger_pin = pin;
+    } else if (sscanf(arg, "pattern:%llx=%llx", &mask, &value) == 2) {
+        config->trigger = MRAA_GPIO_TRIGGER_PATTERN;
+        config->trigger_mask = mask;
+        config->trigger_value = value;
+    } else {
+        return MRAA_ERROR_INVALID_PARAMETER;
+    }
+    return MRAA_SUCCESS;
+}
+
+mraa_result_t
+gpio_parse_count(const char* arg, unsigned long min, unsigned long max, unsigned int* count)
+{
+    unsigned long value;
+    char* end;
+
+    /* strtoul takes a sign and negates, a count never has one */
+    while (isspace((unsigned char) *arg)) {
+        arg++;
+    }
+    if (!isdigit((unsigned char) *arg)) {
+        return MRAA_ERROR_INVALID_PARAMETER;
+    }
+
+    errno = 0;
+    value = strtoul(arg, &end, 10);
+    if (errno != 0 || *end != '\0' || value < min || value > max) {
+        return MRAA_ERROR_INVALID_PARAMETER;
+    }
+
+    *count = (unsigned int) value;
+    return MRAA_SUCCESS;
+}
+
+mraa_result_t
+gpio_capture(int argc, char** argv)
+{
+    mraa_gpio_capture_config_t config = { 0 };
+    mraa_gpio_capture_t* capture;
+    mraa_gpio_context gpio;
+    mraa_result_t status;
+    const char* path = argv[0];
+    const char* ext = strrchr(path, '.');
+    int num_pins = argc - 5;
+    int pins[64];
+
+    if (gpio_parse_count(argv[1], 1, MRAA_GPIO_CAPTURE_MAX_RATE_HZ, &config.rate_hz) != MRAA_SUCCESS ||
+        gpio_parse_count(argv[2], 1, CAPTURE_MAX_SAMPLES, &config.post_samples) != MRAA_SUCCESS ||
+        gpio_parse_count(argv[3], 0, CAPTURE_MAX_SAMPLES, &config.pre_samples) != MRAA_SUCCESS ||
+        gpio_parse_trigger(argv[4], &config) != MRAA_SUCCESS || num_pins > 64) {
+        print_command_error();
+        return MRAA_ERROR_INVALID_PARAMETER;
+    }
+    for (int i = 0; i < num_pins; ++i) {
+        pins[i] = atoi(argv[5 + i]);
+    }
+
+    gpio = mraa_gpio_init_multi(pins, num_pins);
+    if (gpio == NULL) {
+        return MRAA_ERROR_INVALID_RESOURCE;
+    }
+    status = mraa_gpio_dir(gpio, MRAA_GPIO_IN);
+    if (status != MRAA_SUCCESS) {
+        fprintf(stderr, "Failed to set the pins as inputs\n");
+        mraa_gpio_close(gpio);
+        return status;
+    }
+
+    fprintf(stdout, "Waiting for trigger...\n");
+    capture = mraa_gpio_capture(gpio, &config);
+    mraa_gpio_close(gpio);
+    if (capture == NULL) {
+        return MRAA_ERROR_UNSPECIFIED;
+    }
+
+    if (ext != NULL && strcmp(ext, ".vcd") == 0) {
+        status = mraa_gpio_capture_write_vcd(capture, path);
+    } else {
+        status = mraa_gpio_capture_write_raw(capture, path);
+    }
+    if (status == MRAA_SUCCESS) {
+        fprintf(stdout, "%u samples, trigger at %u, %llu periods missed, written to %s\n",
+                capture->num_samples, capture->trigger_index, (unsigned long long) capture->missed, path);
+    }
+    mraa_gpio_capture_free(capture);
+
+    return status;
+}
+
 int
 main(int argc, char** argv)
 {
@@ -215,6 +334,14 @@ main(int argc, char** argv)
             } else {
                 print_command_error();
             }
+        } else if (strcmp(argv[1], "capture") == 0) {
+            if (argc >= 8) {
+                if (gpio_capture(argc - 2, argv + 2) != MRAA_SUCCESS) {
+                    fprintf(stdout, "Capture failed\n");
+                }
+            } else {
+                print_command_error();
+            }
         } else {
             print_command_error();
         }
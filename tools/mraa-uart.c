@@ -5,11 +5,16 @@
  * SPDX-License-Identifier: MIT
  */
 
+#define _GNU_SOURCE
 #include <ctype.h>
+#include <fcntl.h>
+#include <signal.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <sys/time.h>
+#include <sys/wait.h>
+#include <termios.h>
 #include <unistd.h>
 
 #include "mraa.h"
@@ -82,9 +87,126 @@ uarttool_read_and_print(mraa_uart_context uart, double receive_timeout) {
 
 /* ------------------------------------------------------------------------ */
 
+#define LATENCY_FRAME_SIZE 16
+
+/* Round trips of count frames through whatever echoes them back */
+int
+uarttool_latency_run(mraa_uart_context uart, const char *mode, int count) {
+    char tx[LATENCY_FRAME_SIZE], rx[LATENCY_FRAME_SIZE];
+    double min = 1e9, max = 0.0, total = 0.0;
+    long reads = 0;
+    int i;
+
+    memset(tx, 0x55, sizeof(tx));
+    for (i = 0; i < count; i++) {
+        int got = 0;
+        double start = now(), rtt;
+
+        if (mraa_uart_write(uart, tx, sizeof(tx)) != sizeof(tx)) {
+            fprintf(stderr, "latency: write failed\n");
+            return -1;
+        }
+        while (got < (int) sizeof(rx)) {
+            int n;
+            if (!mraa_uart_data_available(uart, 1000)) {
+                fprintf(stderr, "latency: no echo after 1s, frame %i\n", i);
+                return -1;
+            }
+            n = mraa_uart_read(uart, rx + got, sizeof(rx) - got);
+            if (n <= 0) {
+                fprintf(stderr, "latency: read failed\n");
+                return -1;
+            }
+            got += n;
+            reads++;
+        }
+        rtt = now() - start;
+        total += rtt;
+        if (rtt < min) min = rtt;
+        if (rtt > max) max = rtt;
+    }
+
+    printf("%-12s: %i frames of %i bytes, round trip min %.1f us mean %.1f us max %.1f us, %.2f reads per frame\n",
+           mode, count, LATENCY_FRAME_SIZE, min * 1e6, total / count * 1e6, max * 1e6, (double) reads / count);
+    return 0;
+}
+
+/*
+ * Latency benchmark, with and without low latency mode. Runs on the given
+ * uart, which must have its TX looped back to RX, or without one against a
+ * pty pair whose other end a child process echoes.
+ */
+int
+uarttool_latency(mraa_uart_context uart, int count) {
+    mraa_uart_context pty_uart = NULL;
+    pid_t echo = -1;
+    int master = -1, ret = -1;
+
+    if (uart == NULL) {
+        struct termios term;
+        const char *slave;
+
+        master = posix_openpt(O_RDWR | O_NOCTTY);
+        if (master < 0 || grantpt(master) || unlockpt(master) || (slave = ptsname(master)) == NULL) {
+            fprintf(stderr, "latency: cannot create a pty pair\n");
+            goto latency_done;
+        }
+        tcgetattr(master, &term);
+        cfmakeraw(&term);
+        tcsetattr(master, TCSANOW, &term);
+
+        echo = fork();
+        if (echo == 0) {
+            char buf[256];
+            ssize_t n;
+            while ((n = read(master, buf, sizeof(buf))) > 0) {
+                if (write(master, buf, n) != n) break;
+            }
+            _exit(0);
+        }
+        if (echo < 0) {
+            fprintf(stderr, "latency: cannot start the echo process\n");
+            goto latency_done;
+        }
+
+        pty_uart = mraa_uart_init_raw(slave);
+        if (pty_uart == NULL) {
+            fprintf(stderr, "latency: cannot open %s\n", slave);
+            goto latency_done;
+        }
+        uart = pty_uart;
+    }
+
+    mraa_uart_set_low_latency(uart, FALSE, 0);
+    if (uarttool_latency_run(uart, "normal", count) != 0) {
+        goto latency_done;
+    }
+    if (mraa_uart_set_low_latency(uart, TRUE, LATENCY_FRAME_SIZE) != MRAA_SUCCESS) {
+        fprintf(stderr, "latency: cannot enable low latency mode\n");
+        goto latency_done;
+    }
+    ret = uarttool_latency_run(uart, "low latency", count);
+    mraa_uart_set_low_latency(uart, FALSE, 0);
+
+latency_done:
+    if (pty_uart != NULL) {
+        mraa_uart_stop(pty_uart);
+    }
+    if (echo > 0) {
+        kill(echo, SIGTERM);
+        waitpid(echo, NULL, 0);
+    }
+    if (master >= 0) {
+        close(master);
+    }
+    return ret;
+}
+
+/* ------------------------------------------------------------------------ */
+
 void
 uarttool_usage(const char *name) {
-     printf("Usage: %s { list | dev device } [ baud bps ] [ databits d ] [ parity p ] [ stopbits s ] [ ctsrts mode ] [ send string ] [ recv timeout ] [ show ]\n\n", name);
+     printf("Usage: %s { list | dev device } [ baud bps ] [ databits d ] [ parity p ] [ stopbits s ] [ ctsrts mode ] [ lowlatency mode ] [ send string ] [ recv timeout ] [ latency count ] [ show ]\n\n", name);
      printf("Simple tool to test UART functionality. Needs either list or dev arguments, the others are optional\n");
      printf("   list     : lists uarts on the system (non intrusive)\n");
      printf("   dev      : select uart device, can be by name, by device name or by index (as listed in list)\n");
@@ -92,8 +214,11 @@ uarttool_usage(const char *name) {
      printf("   parity   : set parity mode to given parameter - can be E, O, or N\n");
      printf("   stopbits : set the number of stopbits - can be 1 or 2\n");
      printf("   ctsrts   : set CTS/RTS flow control to either on or off\n");
+     printf("   lowlatency : set low latency mode to either on or off\n");
      printf("   send     : transmits a string\n");
      printf("   recv     : reads data on uart for timeout seconds, and displays the result on stdout\n");
+     printf("   latency  : measures round trip latency of count frames, with and without low latency mode.\n");
+     printf("              Needs TX looped back to RX on the selected uart, without dev it runs on a pty\n");
      printf("   show     : show settings of selected uart\n");
 }
 
@@ -114,6 +239,7 @@ main(int argc, const char** argv) {
     int send = FALSE; /* whether we are requested to send or not */
     const char *to_send; /* data to send, assigned during parsing of command line */
     int show = FALSE; /* whether to show uart settings after everything else*/
+    int latency = 0; /* round trips to benchmark, 0 for none */
 
     /* Initialize MRAA. Init is done automatically if libmraa is compiled
        with a compiler that supports __attribute__((constructor)), like
@@ -178,6 +304,19 @@ main(int argc, const char** argv) {
                 i++;
             } else
 
+            if (!strcmp(argv[i], "lowlatency")) {
+                if (i+1 >= argc || (strcmp(argv[i+1], "on") && strcmp(argv[i+1], "off"))) {
+                    fprintf(stderr, "%s : lowlatency needs either on or off as argument\n", argv[0]);
+                    break;
+                }
+                if (uart != NULL && mraa_uart_set_low_latency(uart, !strcmp(argv[i+1], "on"), 0) != MRAA_SUCCESS) {
+                    fprintf(stderr, "%s : cannot turn low latency mode %s\n", argv[0], argv[i+1]);
+                    mraa_deinit();
+                    return EXIT_FAILURE;
+                }
+                i++;
+            } else
+
             /* Number of stopbits */
             if (!strcmp(argv[i], "stopbits")) {
                 if (i+1 >= argc || !isdigit(argv[i+1][0])) {
@@ -255,10 +394,26 @@ main(int argc, const char** argv) {
                 recieve = TRUE;
                 recieve_timeout = atof(argv[i+1]);
                 i++;
+            } else
+
+            if (!strcmp(argv[i], "latency")) {
+                if (i+1 >= argc || !isdigit(argv[i+1][0]) || atoi(argv[i+1]) <= 0) {
+                    fprintf(stderr, "%s : %s needs a frame count as argument\n", argv[0], argv[i]);
+                    break;
+                }
+                latency = atoi(argv[i+1]);
+                i++;
             }
         }
 
+        if (i == argc && uart == NULL && latency > 0) {
+            uarttool_latency(NULL, latency);
+        } else
         if (i == argc && uart != NULL) {
+            if (latency > 0) {
+                uarttool_latency(uart, latency);
+            }
+
             if (send) {
                 mraa_uart_write(uart, to_send, strlen(to_send)+1);
             }